@@ -0,0 +1,420 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#include "AudioBatch.hpp"
+#include "thread.h"
+
+AudioBatch::AudioBatch(const audiobatch_params_t *p_params)
+{
+	this->setParameters(p_params);
+}
+
+AudioBatch::~AudioBatch(VOID)
+{
+	this->deinitialize();
+}
+
+BOOL WINAPI AudioBatch::setParameters(const audiobatch_params_t *p_params)
+{
+	SYSTEM_INFO sysinfo;
+
+	if(this->status > 0)
+	{
+		this->err_msg = TEXT("AudioBatch::setParameters: Error: cannot set parameters, AudioBatch object already initialized.");
+		return FALSE;
+	}
+
+	if(p_params == NULL)
+	{
+		this->err_msg = TEXT("AudioBatch::setParameters: Error: given params object is invalid.");
+		return FALSE;
+	}
+
+	if((p_params->p_jobs == NULL) || (!p_params->n_jobs) || (p_params->n_jobs > this->N_JOBS_MAX))
+	{
+		this->err_msg = TEXT("AudioBatch::setParameters: Error: given job list is invalid.");
+		return FALSE;
+	}
+
+	this->status = this->STATUS_UNINITIALIZED;
+
+	this->p_jobs = p_params->p_jobs;
+	this->N_JOBS = p_params->n_jobs;
+
+	ZeroMemory(&(this->render_params), sizeof(audiorender_params_t));
+
+	this->render_params.filein_dir = this->p_jobs[0].filein_dir;
+	this->render_params.fileout_dir = this->p_jobs[0].fileout_dir;
+	this->render_params.segment_size_frames = p_params->segment_size_frames;
+	this->render_params.delay_buffer_size_frames = p_params->delay_buffer_size_frames;
+	this->render_params.n_ff_delays = p_params->n_ff_delays;
+	this->render_params.n_fb_delays = p_params->n_fb_delays;
+	this->render_params.delay_xfade_size_frames = 0u; /*Parameters never change during a render: no crossfades.*/
+	this->render_params.tail_size_ms = p_params->tail_size_ms;
+	this->render_params.readblock_size_bytes = p_params->readblock_size_bytes;
+	this->render_params.n_threads = 1u;
+
+	this->N_THREADS = p_params->n_threads;
+	if(!this->N_THREADS)
+	{
+		GetSystemInfo(&sysinfo);
+		this->N_THREADS = (ULONG_PTR) sysinfo.dwNumberOfProcessors;
+	}
+
+	if(this->N_THREADS > this->N_THREADS_MAX) this->N_THREADS = this->N_THREADS_MAX;
+	if(!this->N_THREADS) this->N_THREADS = 1u;
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioBatch::initialize(VOID)
+{
+	ULONG_PTR n_worker = 0u;
+
+	if(this->status > 0) return TRUE;
+
+	this->status = this->STATUS_UNINITIALIZED;
+
+	if(this->p_jobs == NULL)
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioBatch::initialize: Error: no job list.");
+		return FALSE;
+	}
+
+	if(p_processheap == NULL)
+	{
+		this->status = this->STATUS_ERROR_MEMORY;
+		this->err_msg = TEXT("AudioBatch::initialize: Error: p_processheap is NULL.");
+		return FALSE;
+	}
+
+	ZeroMemory(&(this->stats), sizeof(audiobatch_stats_t));
+
+	this->N_WORKERS = this->N_THREADS;
+	if(this->N_WORKERS > this->N_JOBS) this->N_WORKERS = this->N_JOBS;
+
+	this->p_workers = (audiobatch_worker_t*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, (this->N_WORKERS)*sizeof(audiobatch_worker_t));
+	this->p_results = (audiobatch_jobresult_t*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, (this->N_JOBS)*sizeof(audiobatch_jobresult_t));
+	this->p_job_err_msg = new __string[this->N_JOBS];
+
+	if((this->p_workers == NULL) || (this->p_results == NULL) || (this->p_job_err_msg == NULL))
+	{
+		this->err_msg = TEXT("AudioBatch::initialize: Error: failed to allocate heap memory.");
+		goto _l_initialize_error;
+	}
+
+	for(n_worker = 0u; n_worker < this->N_WORKERS; n_worker++)
+	{
+		this->p_workers[n_worker].p_batch = this;
+		this->p_workers[n_worker].n_worker = n_worker;
+
+		if(!this->worker_init(&(this->p_workers[n_worker]))) goto _l_initialize_error;
+	}
+
+	this->status = this->STATUS_READY;
+	return TRUE;
+
+_l_initialize_error:
+	this->deinitialize();
+	this->status = this->STATUS_ERROR_MEMORY;
+	return FALSE;
+}
+
+BOOL WINAPI AudioBatch::runBatch(VOID)
+{
+	LARGE_INTEGER perf_freq;
+	LARGE_INTEGER perf_begin;
+	LARGE_INTEGER perf_end;
+	ULONG_PTR n_worker = 0u;
+	ULONG_PTR n_job = 0u;
+	ULONG64 job_first = 0u;
+	ULONG64 job_end = 0u;
+
+	if(this->status != this->STATUS_READY)
+	{
+		this->err_msg = TEXT("AudioBatch::runBatch: Error: AudioBatch object is either not initialized or already running.");
+		return FALSE;
+	}
+
+	this->status = this->STATUS_RUNNING;
+
+	ZeroMemory(this->p_results, (this->N_JOBS)*sizeof(audiobatch_jobresult_t));
+	for(n_job = 0u; n_job < this->N_JOBS; n_job++) this->p_job_err_msg[n_job] = TEXT("");
+
+	/*Every worker starts with its own contiguous run of jobs.*/
+
+	for(n_worker = 0u; n_worker < this->N_WORKERS; n_worker++)
+	{
+		job_first = ((ULONG64) n_worker)*((ULONG64) this->N_JOBS)/((ULONG64) this->N_WORKERS);
+		job_end = ((ULONG64) (n_worker + 1u))*((ULONG64) this->N_JOBS)/((ULONG64) this->N_WORKERS);
+
+		InterlockedExchange64(&(this->p_workers[n_worker].jobs), (LONG64) ((job_end << 32) | job_first));
+	}
+
+	this->n_jobs_stolen = 0;
+
+	QueryPerformanceFrequency(&perf_freq);
+	QueryPerformanceCounter(&perf_begin);
+
+	for(n_worker = 0u; n_worker < this->N_WORKERS; n_worker++)
+		this->p_workers[n_worker].p_thread = thread_create_default(&AudioBatch::worker_thread_proc, &(this->p_workers[n_worker]), NULL);
+
+	/*A worker thread that could not be created is run from here. Its jobs may also be stolen by the other workers meanwhile.*/
+
+	for(n_worker = 0u; n_worker < this->N_WORKERS; n_worker++)
+	{
+		if(this->p_workers[n_worker].p_thread == NULL) this->worker_loop(&(this->p_workers[n_worker]));
+	}
+
+	for(n_worker = 0u; n_worker < this->N_WORKERS; n_worker++)
+	{
+		if(this->p_workers[n_worker].p_thread != NULL) thread_wait(&(this->p_workers[n_worker].p_thread));
+	}
+
+	QueryPerformanceCounter(&perf_end);
+
+	ZeroMemory(&(this->stats), sizeof(audiobatch_stats_t));
+
+	for(n_job = 0u; n_job < this->N_JOBS; n_job++)
+	{
+		if(!this->p_results[n_job].success)
+		{
+			this->stats.n_jobs_failed++;
+			continue;
+		}
+
+		this->stats.n_jobs_done++;
+		this->stats.n_frames += this->p_results[n_job].stats.n_frames;
+		this->stats.audio_s += this->p_results[n_job].audio_s;
+	}
+
+	this->stats.n_jobs_stolen = (ULONG_PTR) this->n_jobs_stolen;
+	this->stats.n_threads = this->N_WORKERS;
+	this->stats.time_s = ((DOUBLE) (perf_end.QuadPart - perf_begin.QuadPart))/((DOUBLE) perf_freq.QuadPart);
+
+	if(this->stats.time_s > 0.0)
+	{
+		this->stats.frames_per_s = ((DOUBLE) this->stats.n_frames)/(this->stats.time_s);
+		this->stats.realtime_factor = (this->stats.audio_s)/(this->stats.time_s);
+	}
+
+	this->status = this->STATUS_READY;
+	return TRUE;
+}
+
+BOOL WINAPI AudioBatch::getJobResult(ULONG_PTR n_job, audiobatch_jobresult_t *p_result)
+{
+	if(this->status < 1) return FALSE;
+	if(n_job >= this->N_JOBS) return FALSE;
+	if(p_result == NULL) return FALSE;
+
+	*p_result = this->p_results[n_job];
+	return TRUE;
+}
+
+__string WINAPI AudioBatch::getJobErrorMessage(ULONG_PTR n_job)
+{
+	if(this->status < 1) return TEXT("");
+	if(n_job >= this->N_JOBS) return TEXT("");
+
+	return this->p_job_err_msg[n_job];
+}
+
+BOOL WINAPI AudioBatch::getBatchStats(audiobatch_stats_t *p_stats)
+{
+	if(p_stats == NULL) return FALSE;
+
+	*p_stats = this->stats;
+	return TRUE;
+}
+
+INT WINAPI AudioBatch::getStatus(VOID)
+{
+	return this->status;
+}
+
+__string WINAPI AudioBatch::getLastErrorMessage(VOID)
+{
+	if(this->status == this->STATUS_UNINITIALIZED)
+		return TEXT("AudioBatch object not initialized\r\nExtended error message: ") + this->err_msg;
+
+	return this->err_msg;
+}
+
+VOID WINAPI AudioBatch::deinitialize(VOID)
+{
+	ULONG_PTR n_worker = 0u;
+
+	this->status = this->STATUS_UNINITIALIZED;
+
+	if(this->p_workers != NULL)
+	{
+		for(n_worker = 0u; n_worker < this->N_WORKERS; n_worker++) this->worker_deinit(&(this->p_workers[n_worker]));
+
+		HeapFree(p_processheap, 0u, this->p_workers);
+		this->p_workers = NULL;
+	}
+
+	if(this->p_results != NULL)
+	{
+		HeapFree(p_processheap, 0u, this->p_results);
+		this->p_results = NULL;
+	}
+
+	if(this->p_job_err_msg != NULL)
+	{
+		delete[] this->p_job_err_msg;
+		this->p_job_err_msg = NULL;
+	}
+
+	return;
+}
+
+BOOL WINAPI AudioBatch::worker_init(audiobatch_worker_t *p_worker)
+{
+	p_worker->p_render = new AudioRender(&(this->render_params));
+	if(p_worker->p_render == NULL)
+	{
+		this->err_msg = TEXT("AudioBatch::worker_init: Error: AudioRender object instance failed.");
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+VOID WINAPI AudioBatch::worker_deinit(audiobatch_worker_t *p_worker)
+{
+	if(p_worker->p_render != NULL)
+	{
+		delete p_worker->p_render;
+		p_worker->p_render = NULL;
+	}
+
+	return;
+}
+
+DWORD WINAPI AudioBatch::worker_thread_proc(VOID *p_args)
+{
+	audiobatch_worker_t *p_worker = (audiobatch_worker_t*) p_args;
+
+	p_worker->p_batch->worker_loop(p_worker);
+	return 0u;
+}
+
+VOID WINAPI AudioBatch::worker_loop(audiobatch_worker_t *p_worker)
+{
+	ULONG_PTR n_job = 0u;
+
+	while(this->job_take(p_worker, &n_job)) this->job_run(p_worker, n_job);
+
+	return;
+}
+
+/*Own jobs first (front of the run), then the other workers' jobs (back of their runs), starting with the next worker.*/
+
+BOOL WINAPI AudioBatch::job_take(audiobatch_worker_t *p_worker, ULONG_PTR *p_job)
+{
+	ULONG_PTR n_worker = 0u;
+
+	if(this->job_take_from(p_worker, FALSE, p_job)) return TRUE;
+
+	for(n_worker = 1u; n_worker < this->N_WORKERS; n_worker++)
+	{
+		if(this->job_take_from(&(this->p_workers[(p_worker->n_worker + n_worker) % (this->N_WORKERS)]), TRUE, p_job))
+		{
+			InterlockedIncrement(&(this->n_jobs_stolen));
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+BOOL WINAPI AudioBatch::job_take_from(audiobatch_worker_t *p_worker, BOOL from_back, ULONG_PTR *p_job)
+{
+	LONG64 jobs = 0;
+	LONG64 jobs_new = 0;
+	ULONG64 job_first = 0u;
+	ULONG64 job_end = 0u;
+
+	jobs = InterlockedCompareExchange64(&(p_worker->jobs), 0, 0);
+
+	while(TRUE)
+	{
+		job_first = ((ULONG64) jobs) & 0xffffffffu;
+		job_end = ((ULONG64) jobs) >> 32;
+
+		if(job_first >= job_end) return FALSE;
+
+		if(from_back)
+		{
+			job_end--;
+			*p_job = (ULONG_PTR) job_end;
+		}
+		else
+		{
+			*p_job = (ULONG_PTR) job_first;
+			job_first++;
+		}
+
+		jobs_new = (LONG64) ((job_end << 32) | job_first);
+
+		jobs_new = InterlockedCompareExchange64(&(p_worker->jobs), jobs_new, jobs);
+		if(jobs_new == jobs) break;
+
+		jobs = jobs_new;
+	}
+
+	return TRUE;
+}
+
+VOID WINAPI AudioBatch::job_run(audiobatch_worker_t *p_worker, ULONG_PTR n_job)
+{
+	audiorender_params_t render_params;
+	audiobatch_jobresult_t *p_result = NULL;
+	AudioRender *p_render = NULL;
+
+	render_params = this->render_params;
+	render_params.filein_dir = this->p_jobs[n_job].filein_dir;
+	render_params.fileout_dir = this->p_jobs[n_job].fileout_dir;
+
+	p_result = &(this->p_results[n_job]);
+	p_result->n_worker = p_worker->n_worker;
+
+	if(p_worker->p_render == NULL)
+	{
+		p_worker->p_render = new AudioRender(&render_params);
+		if(p_worker->p_render == NULL)
+		{
+			this->p_job_err_msg[n_job] = TEXT("AudioBatch::job_run: Error: AudioRender object instance failed.");
+			return;
+		}
+	}
+
+	p_render = p_worker->p_render;
+
+	if(p_render->setParameters(&render_params) && p_render->initialize() && p_render->setPreset(this->p_jobs[n_job].p_preset) && p_render->runRender())
+	{
+		p_render->getRenderStats(&(p_result->stats));
+		p_result->audio_s = ((DOUBLE) p_result->stats.n_frames)/((DOUBLE) p_render->getSampleRate());
+		p_result->success = TRUE;
+		return;
+	}
+
+	this->p_job_err_msg[n_job] = p_render->getLastErrorMessage();
+
+	/*Failed after initialize(): the render object still holds the input file. The next job gets a new one.*/
+	if(p_render->getStatus() > 0)
+	{
+		delete p_render;
+		p_worker->p_render = NULL;
+	}
+
+	return;
+}
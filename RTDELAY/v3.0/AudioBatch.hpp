@@ -0,0 +1,159 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*
+	Batch offline render: runs a list of jobs (one input file through one preset into one output file) on a pool of worker threads.
+
+	Every worker owns an AudioRender object, kept for all the jobs it runs. Jobs with the same channel count reuse the worker's
+	AudioDelay buffers (see AudioRender::initialize()), so after the first job a worker renders with no effect buffer allocation.
+
+	Scheduling is work stealing: the job list is split into one contiguous run of jobs per worker. A worker takes jobs from the front
+	of its own run, and once it is empty, takes jobs from the back of the other workers' runs. Each run is a single 64 bit word
+	(first job, end job), updated with InterlockedCompareExchange64(), so taking a job never blocks.
+
+	Each job is rendered sequentially (AudioRender n_threads = 1): the pool already keeps every CPU busy.
+*/
+
+#ifndef AUDIOBATCH_HPP
+#define AUDIOBATCH_HPP
+
+#include "globldef.h"
+#include "strdef.hpp"
+
+#include "AudioRender.hpp"
+
+struct _audiobatch_job {
+	const TCHAR *filein_dir;
+	const TCHAR *fileout_dir;
+	const audiorender_preset_t *p_preset;
+};
+
+typedef struct _audiobatch_job audiobatch_job_t;
+
+/*Render settings are shared by all jobs (see audiorender_params_t).*/
+
+struct _audiobatch_params {
+	const audiobatch_job_t *p_jobs;
+	ULONG_PTR n_jobs;
+	ULONG_PTR segment_size_frames;
+	ULONG_PTR delay_buffer_size_frames;
+	ULONG_PTR n_ff_delays;
+	ULONG_PTR n_fb_delays;
+	ULONG_PTR tail_size_ms;
+	ULONG_PTR readblock_size_bytes;
+	ULONG_PTR n_threads; /*Worker threads. 0 for one per CPU.*/
+};
+
+typedef struct _audiobatch_params audiobatch_params_t;
+
+struct _audiobatch_jobresult {
+	BOOL success;
+	ULONG_PTR n_worker; /*worker that ran the job*/
+	DOUBLE audio_s; /*output audio duration (seconds)*/
+	audiorender_stats_t stats;
+};
+
+typedef struct _audiobatch_jobresult audiobatch_jobresult_t;
+
+struct _audiobatch_stats {
+	ULONG_PTR n_jobs_done;
+	ULONG_PTR n_jobs_failed;
+	ULONG_PTR n_jobs_stolen; /*jobs run by another worker than the one they were given to*/
+	ULONG_PTR n_threads;
+	ULONG64 n_frames; /*output frames rendered, all jobs*/
+	DOUBLE audio_s; /*output audio duration, all jobs (seconds)*/
+	DOUBLE time_s; /*wall clock batch time (seconds)*/
+	DOUBLE frames_per_s; /*aggregate render throughput*/
+	DOUBLE realtime_factor; /*audio duration/batch time*/
+};
+
+typedef struct _audiobatch_stats audiobatch_stats_t;
+
+class AudioBatch;
+
+struct _audiobatch_worker {
+	AudioBatch *p_batch;
+	HANDLE p_thread;
+	AudioRender *p_render;
+	ULONG_PTR n_worker;
+	volatile LONG64 jobs; /*(end job << 32) | first job*/
+};
+
+typedef struct _audiobatch_worker audiobatch_worker_t;
+
+class AudioBatch {
+	public:
+		AudioBatch(const audiobatch_params_t *p_params);
+		~AudioBatch(VOID);
+
+		BOOL WINAPI setParameters(const audiobatch_params_t *p_params);
+
+		/*Sets up the workers. The job list must stay valid until the object is deinitialized or destroyed.*/
+		BOOL WINAPI initialize(VOID);
+
+		/*
+			Runs all the jobs. Blocks until done.
+			Returns FALSE if the batch could not be run at all. Jobs that fail do not stop the batch, see getJobResult().
+		*/
+		BOOL WINAPI runBatch(VOID);
+
+		BOOL WINAPI getJobResult(ULONG_PTR n_job, audiobatch_jobresult_t *p_result);
+		__string WINAPI getJobErrorMessage(ULONG_PTR n_job);
+
+		BOOL WINAPI getBatchStats(audiobatch_stats_t *p_stats);
+
+		INT WINAPI getStatus(VOID);
+		__string WINAPI getLastErrorMessage(VOID);
+
+		enum Status {
+			STATUS_ERROR_INVALIDPARAMS = -3,
+			STATUS_ERROR_MEMORY = -2,
+			STATUS_ERROR_GENERIC = -1,
+			STATUS_UNINITIALIZED = 0,
+			STATUS_READY = 1,
+			STATUS_RUNNING = 2
+		};
+
+	private:
+		static constexpr ULONG_PTR N_THREADS_MAX = 256u;
+		static constexpr ULONG_PTR N_JOBS_MAX = 0x7fffffffu;
+
+		__declspec(align(PTR_SIZE_BYTES)) const audiobatch_job_t *p_jobs = NULL;
+
+		__declspec(align(PTR_SIZE_BYTES)) audiobatch_worker_t *p_workers = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) audiobatch_jobresult_t *p_results = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) __string *p_job_err_msg = NULL;
+
+		__declspec(align(PTR_SIZE_BYTES)) audiorender_params_t render_params;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR N_JOBS = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR N_THREADS = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR N_WORKERS = 0u;
+
+		__declspec(align(4)) volatile LONG n_jobs_stolen = 0;
+
+		__declspec(align(PTR_SIZE_BYTES)) audiobatch_stats_t stats;
+
+		__declspec(align(PTR_SIZE_BYTES)) __string err_msg = TEXT("");
+
+		__declspec(align(4)) INT status = this->STATUS_UNINITIALIZED;
+
+		VOID WINAPI deinitialize(VOID);
+
+		BOOL WINAPI worker_init(audiobatch_worker_t *p_worker);
+		VOID WINAPI worker_deinit(audiobatch_worker_t *p_worker);
+
+		static DWORD WINAPI worker_thread_proc(VOID *p_args);
+		VOID WINAPI worker_loop(audiobatch_worker_t *p_worker);
+
+		BOOL WINAPI job_take(audiobatch_worker_t *p_worker, ULONG_PTR *p_job);
+		BOOL WINAPI job_take_from(audiobatch_worker_t *p_worker, BOOL from_back, ULONG_PTR *p_job);
+		VOID WINAPI job_run(audiobatch_worker_t *p_worker, ULONG_PTR n_job);
+};
+
+#endif /*AUDIOBATCH_HPP*/
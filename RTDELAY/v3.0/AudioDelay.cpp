@@ -1,573 +1,1916 @@
-/*
-	Audio Delay 2 application for Windows
-	Version 3.0
-
-	Author: Rafael Sabe
-	Email: rafaelmsabe@gmail.com
-*/
-
-#include "AudioDelay.hpp"
-
-AudioDelay::AudioDelay(const audiodelay_init_params_t *p_params)
-{
-	this->setInitParameters(p_params);
-}
-
-AudioDelay::~AudioDelay(VOID)
-{
-	this->deinitialize();
-}
-
-BOOL WINAPI AudioDelay::setInitParameters(const audiodelay_init_params_t *p_params)
-{
-	this->status = this->STATUS_UNINITIALIZED;
-
-	if(p_params == NULL)
-	{
-		this->err_msg = TEXT("AudioDelay::setInitParameters: Error: init params object pointer is NULL.");
-		return FALSE;
-	}
-
-	this->BUFFER_SIZE_FRAMES = _get_closest_power2_ceil(p_params->buffer_size_frames);
-	this->BUFFER_N_SEGMENTS = _get_closest_power2_ceil(p_params->buffer_n_segments);
-	this->N_CHANNELS = p_params->n_channels;
-	this->P_FF_PARAMS_LENGTH = p_params->n_ff_delays;
-	this->P_FB_PARAMS_LENGTH = p_params->n_fb_delays;
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioDelay::initialize(VOID)
-{
-	if(this->status == this->STATUS_INITIALIZED) return TRUE;
-
-	this->status = this->STATUS_UNINITIALIZED;
-
-	if(this->BUFFER_SIZE_FRAMES < this->BUFFER_SIZE_FRAMES_MIN)
-	{
-		this->status = this->STATUS_ERROR_INVALIDPARAMS;
-		this->err_msg = TEXT("AudioDelay::initialize: Error: invalid buffer size.");
-		return FALSE;
-	}
-
-	if(this->BUFFER_N_SEGMENTS < this->BUFFER_N_SEGMENTS_MIN)
-	{
-		this->status = this->STATUS_ERROR_INVALIDPARAMS;
-		this->err_msg = TEXT("AudioDelay::initialize: Error: invalid buffer segment count.");
-		return FALSE;
-	}
-
-	if(this->N_CHANNELS < this->N_CHANNELS_MIN)
-	{
-		this->status = this->STATUS_ERROR_INVALIDPARAMS;
-		this->err_msg = TEXT("AudioDelay::initialize: Error: invalid number of channels.");
-		return FALSE;
-	}
-
-	this->BUFFER_SIZE_SAMPLES = (this->BUFFER_SIZE_FRAMES)*(this->N_CHANNELS);
-	this->BUFFER_SIZE_BYTES = (this->BUFFER_SIZE_SAMPLES)*sizeof(FLOAT);
-
-	this->BUFFER_SEGMENT_SIZE_FRAMES = (this->BUFFER_SIZE_FRAMES)/(this->BUFFER_N_SEGMENTS);
-	this->BUFFER_SEGMENT_SIZE_SAMPLES = (this->BUFFER_SEGMENT_SIZE_FRAMES)*(this->N_CHANNELS);
-	this->BUFFER_SEGMENT_SIZE_BYTES = (this->BUFFER_SEGMENT_SIZE_SAMPLES)*sizeof(FLOAT);
-
-	this->P_FF_PARAMS_SIZE = (this->P_FF_PARAMS_LENGTH)*sizeof(audiodelay_fx_params_t);
-	this->P_FB_PARAMS_SIZE = (this->P_FB_PARAMS_LENGTH)*sizeof(audiodelay_fx_params_t);
-
-	if(!this->buffer_alloc())
-	{
-		this->status = this->STATUS_ERROR_MEMORY;
-		return FALSE;
-	}
-
-	this->status = this->STATUS_INITIALIZED;
-	return TRUE;
-}
-
-BOOL WINAPI AudioDelay::runDSP(ULONG_PTR n_segment)
-{
-	FLOAT *p_curr_seg_in = NULL;
-	FLOAT *p_curr_seg_out = NULL;
-
-	ULONG_PTR n_prevsample = 0u;
-	ULONG_PTR n_currsample = 0u;
-	ULONG_PTR n_channel = 0u;
-
-	ULONG_PTR n_frame = 0u;
-	ULONG_PTR n_fx = 0u;
-	ULONG_PTR prev_buf_nframe = 0u;
-
-	ULONG_PTR n_delay = 0u;
-	FLOAT f_amp = 0.0f;
-
-	if(this->status < 1) return FALSE;
-
-	if(n_segment >= this->BUFFER_N_SEGMENTS)
-	{
-		this->err_msg = TEXT("AudioDelay::runDSP: Error: given segment index is out of bounds.");
-		return FALSE;
-	}
-
-	p_curr_seg_in = (FLOAT*) (((ULONG_PTR) (this->p_bufferinput)) + n_segment*(this->BUFFER_SEGMENT_SIZE_BYTES));
-	p_curr_seg_out = (FLOAT*) (((ULONG_PTR) (this->p_bufferoutput)) + n_segment*(this->BUFFER_SEGMENT_SIZE_BYTES));
-
-	for(n_frame = 0u; n_frame < this->BUFFER_SEGMENT_SIZE_FRAMES; n_frame++)
-	{
-		n_currsample = n_frame*(this->N_CHANNELS);
-		f_amp = this->dryinput_amp;
-
-		for(n_channel = 0u; n_channel < this->N_CHANNELS; n_channel++)
-		{
-			p_curr_seg_out[n_currsample] = f_amp*(p_curr_seg_in[n_currsample]);
-			n_currsample++;
-		}
-
-		n_fx = 0u;
-		while(n_fx < this->P_FF_PARAMS_LENGTH)
-		{
-			n_delay = (ULONG_PTR) this->p_ff_params[n_fx].delay;
-			f_amp = this->p_ff_params[n_fx].amp;
-
-			if(f_amp == 0.0f)
-			{
-				n_fx++;
-				continue;
-			}
-
-			this->retrieve_prev_nframe(n_segment, n_frame, n_delay, &prev_buf_nframe, NULL, NULL);
-
-			n_currsample = n_frame*(this->N_CHANNELS);
-			n_prevsample = prev_buf_nframe*(this->N_CHANNELS);
-
-			for(n_channel = 0u; n_channel < this->N_CHANNELS; n_channel++)
-			{
-				p_curr_seg_out[n_currsample] += f_amp*(this->p_bufferinput[n_prevsample]);
-				n_currsample++;
-				n_prevsample++;
-			}
-
-			n_fx++;
-		}
-
-		n_fx = 0u;
-		while(n_fx < this->P_FB_PARAMS_LENGTH)
-		{
-			n_delay = (ULONG_PTR) this->p_fb_params[n_fx].delay;
-			f_amp = this->p_fb_params[n_fx].amp;
-
-			if(f_amp == 0.0f)
-			{
-				n_fx++;
-				continue;
-			}
-
-			this->retrieve_prev_nframe(n_segment, n_frame, n_delay, &prev_buf_nframe, NULL, NULL);
-
-			n_currsample = n_frame*(this->N_CHANNELS);
-			n_prevsample = prev_buf_nframe*(this->N_CHANNELS);
-
-			for(n_channel = 0u; n_channel < this->N_CHANNELS; n_channel++)
-			{
-				p_curr_seg_out[n_currsample] += f_amp*(this->p_bufferoutput[n_prevsample]);
-				n_currsample++;
-				n_prevsample++;
-			}
-
-			n_fx++;
-		}
-
-		n_currsample = n_frame*(this->N_CHANNELS);
-		f_amp = this->output_amp;
-
-		for(n_channel = 0u; n_channel < this->N_CHANNELS; n_channel++)
-		{
-			p_curr_seg_out[n_currsample] *= f_amp;
-			n_currsample++;
-		}
-	}
-
-	return TRUE;
-}
-
-FLOAT* WINAPI AudioDelay::getInputBuffer(VOID)
-{
-	if(this->status < 1) return NULL;
-
-	return this->p_bufferinput;
-}
-
-FLOAT* WINAPI AudioDelay::getOutputBuffer(VOID)
-{
-	if(this->status < 1) return NULL;
-
-	return this->p_bufferoutput;
-}
-
-FLOAT* WINAPI AudioDelay::getInputBufferSegment(ULONG_PTR n_segment)
-{
-	if(this->status < 1) return NULL;
-	if(n_segment >= this->BUFFER_N_SEGMENTS)
-	{
-		this->err_msg = TEXT("AudioDelay::getInputBufferSegment: Error: given segment index is out of bounds.");
-		return NULL;
-	}
-
-	return (FLOAT*) (((ULONG_PTR) (this->p_bufferinput)) + n_segment*(this->BUFFER_SEGMENT_SIZE_BYTES));
-}
-
-FLOAT* WINAPI AudioDelay::getOutputBufferSegment(ULONG_PTR n_segment)
-{
-	if(this->status < 1) return NULL;
-	if(n_segment >= this->BUFFER_N_SEGMENTS)
-	{
-		this->err_msg = TEXT("AudioDelay::getOutputBufferSegment: Error: given segment index is out of bounds.");
-		return NULL;
-	}
-
-	return (FLOAT*) (((ULONG_PTR) (this->p_bufferoutput)) + n_segment*(this->BUFFER_SEGMENT_SIZE_BYTES));
-}
-
-FLOAT WINAPI AudioDelay::getDryInputAmplitude(VOID)
-{
-	return this->dryinput_amp;
-}
-
-FLOAT WINAPI AudioDelay::getOutputAmplitude(VOID)
-{
-	return this->output_amp;
-}
-
-BOOL WINAPI AudioDelay::getFFParams(ULONG_PTR n_fx, audiodelay_fx_params_t *p_params)
-{
-	if(this->status < 1) return FALSE;
-
-	if(n_fx >= this->P_FF_PARAMS_LENGTH)
-	{
-		this->err_msg = TEXT("AudioDelay::getFFParams: Error: given fx index is out of bounds.");
-		return FALSE;
-	}
-
-	if(p_params == NULL)
-	{
-		this->err_msg = TEXT("AudioDelay::getFFParams: Error: given params object pointer is NULL.");
-		return FALSE;
-	}
-
-	CopyMemory(p_params, &(this->p_ff_params[n_fx]), sizeof(audiodelay_fx_params_t));
-	return TRUE;
-}
-
-BOOL WINAPI AudioDelay::getFBParams(ULONG_PTR n_fx, audiodelay_fx_params_t *p_params)
-{
-	if(this->status < 1) return FALSE;
-
-	if(n_fx >= this->P_FB_PARAMS_LENGTH)
-	{
-		this->err_msg = TEXT("AudioDelay::getFBParams: Error: given fx index is out of bounds.");
-		return FALSE;
-	}
-
-	if(p_params == NULL)
-	{
-		this->err_msg = TEXT("AudioDelay::getFBParams: Error: given params object pointer is NULL.");
-		return FALSE;
-	}
-
-	CopyMemory(p_params, &(this->p_fb_params[n_fx]), sizeof(audiodelay_fx_params_t));
-	return TRUE;
-}
-
-BOOL WINAPI AudioDelay::setDryInputAmplitude(FLOAT amp)
-{
-	if(this->status < 1) return FALSE;
-
-	this->dryinput_amp = amp;
-	return TRUE;
-}
-
-BOOL WINAPI AudioDelay::setOutputAmplitude(FLOAT amp)
-{
-	if(this->status < 1) return FALSE;
-
-	this->output_amp = amp;
-	return TRUE;
-}
-
-BOOL WINAPI AudioDelay::setFFDelay(ULONG_PTR n_fx, ULONG_PTR delay)
-{
-	if(this->status < 1) return FALSE;
-
-	if(n_fx >= this->P_FF_PARAMS_LENGTH)
-	{
-		this->err_msg = TEXT("AudioDelay::setFFDelay: Error: given fx index is out of bounds.");
-		return FALSE;
-	}
-
-	if(delay >= this->BUFFER_SIZE_FRAMES)
-	{
-		this->err_msg = TEXT("AudioDelay::setFFDelay: Error: given delay time value is too big.");
-		return FALSE;
-	}
-
-	this->p_ff_params[n_fx].delay = (UINT32) delay;
-	return TRUE;
-}
-
-BOOL WINAPI AudioDelay::setFFAmplitude(ULONG_PTR n_fx, FLOAT amp)
-{
-	if(this->status < 1) return FALSE;
-
-	if(n_fx >= this->P_FF_PARAMS_LENGTH)
-	{
-		this->err_msg = TEXT("AudioDelay::setFFAmplitude: Error: given fx index is out of bounds.");
-		return FALSE;
-	}
-
-	this->p_ff_params[n_fx].amp = amp;
-	return TRUE;
-}
-
-BOOL WINAPI AudioDelay::setFBDelay(ULONG_PTR n_fx, ULONG_PTR delay)
-{
-	if(this->status < 1) return FALSE;
-
-	if(n_fx >= this->P_FB_PARAMS_LENGTH)
-	{
-		this->err_msg = TEXT("AudioDelay::setFBDelay: Error: given fx index is out of bounds.");
-		return FALSE;
-	}
-
-	if(delay >= this->BUFFER_SIZE_FRAMES)
-	{
-		this->err_msg = TEXT("AudioDelay::setFBDelay: Error: given delay time value is too big.");
-		return FALSE;
-	}
-
-	this->p_fb_params[n_fx].delay = (UINT32) delay;
-	return TRUE;
-}
-
-BOOL WINAPI AudioDelay::setFBAmplitude(ULONG_PTR n_fx, FLOAT amp)
-{
-	if(this->status < 1) return FALSE;
-
-	if(n_fx >= this->P_FB_PARAMS_LENGTH)
-	{
-		this->err_msg = TEXT("AudioDelay::setFBAmplitude: Error: given fx index is out of bounds.");
-		return FALSE;
-	}
-
-	this->p_fb_params[n_fx].amp = amp;
-	return TRUE;
-}
-
-BOOL WINAPI AudioDelay::resetFFParams(VOID)
-{
-	if(this->status < 1) return FALSE;
-
-	if(this->P_FF_PARAMS_LENGTH) ZeroMemory(this->p_ff_params, this->P_FF_PARAMS_SIZE);
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioDelay::resetFBParams(VOID)
-{
-	if(this->status < 1) return FALSE;
-
-	if(this->P_FB_PARAMS_LENGTH) ZeroMemory(this->p_fb_params, this->P_FB_PARAMS_SIZE);
-
-	return TRUE;
-}
-
-INT WINAPI AudioDelay::getStatus(VOID)
-{
-	return this->status;
-}
-
-__string WINAPI AudioDelay::getLastErrorMessage(VOID)
-{
-	if(this->status == this->STATUS_UNINITIALIZED)
-		return TEXT("AudioDelay object not initialized\r\nExtended error message: ") + this->err_msg;
-
-	return this->err_msg;
-}
-
-VOID WINAPI AudioDelay::deinitialize(VOID)
-{
-	this->status = this->STATUS_UNINITIALIZED;
-	this->buffer_free();
-
-	return;
-}
-
-BOOL WINAPI AudioDelay::buffer_alloc(VOID)
-{
-	/*Clear any previous allocations*/
-	if(!this->buffer_free()) return FALSE;
-
-	if(!this->buffer_fxparams_alloc()) return FALSE;
-
-	if(p_processheap == NULL)
-	{
-		this->err_msg = TEXT("AudioDelay::buffer_alloc: Error: p_processheap is NULL.");
-		return FALSE;
-	}
-
-	this->p_bufferinput = (FLOAT*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->BUFFER_SIZE_BYTES);
-	this->p_bufferoutput = (FLOAT*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->BUFFER_SIZE_BYTES);
-
-	if(this->p_bufferinput == NULL)
-	{
-		this->buffer_free();
-		this->err_msg = TEXT("AudioDelay::buffer_alloc: Error: failed to allocate heap memory.");
-		return FALSE;
-	}
-
-	if(this->p_bufferoutput == NULL)
-	{
-		this->buffer_free();
-		this->err_msg = TEXT("AudioDelay::buffer_alloc: Error: failed to allocate heap memory.");
-		return FALSE;
-	}
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioDelay::buffer_free(VOID)
-{
-	if(p_processheap == NULL)
-	{
-		this->err_msg = TEXT("AudioDelay::buffer_free: Error: p_processheap is NULL.");
-		return FALSE;
-	}
-
-	if(this->p_bufferinput != NULL)
-	{
-		if(!HeapFree(p_processheap, 0u, this->p_bufferinput))
-		{
-			this->err_msg = TEXT("AudioDelay::buffer_free: Error: failed to release heap memory.");
-			return FALSE;
-		}
-
-		this->p_bufferinput = NULL;
-	}
-
-	if(this->p_bufferoutput != NULL)
-	{
-		if(!HeapFree(p_processheap, 0u, this->p_bufferoutput))
-		{
-			this->err_msg = TEXT("AudioDelay::buffer_free: Error: failed to release heap memory.");
-			return FALSE;
-		}
-
-		this->p_bufferoutput = NULL;
-	}
-
-	return this->buffer_fxparams_free();
-}
-
-BOOL WINAPI AudioDelay::buffer_fxparams_alloc(VOID)
-{
-	/*Clear any previous allocations*/
-	if(!this->buffer_fxparams_free()) return FALSE;
-
-	if(p_processheap == NULL)
-	{
-		this->err_msg = TEXT("AudioDelay::buffer_fxparams_alloc: Error: p_processheap is NULL.");
-		return FALSE;
-	}
-
-	if(this->P_FF_PARAMS_LENGTH)
-	{
-		this->p_ff_params = (audiodelay_fx_params_t*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->P_FF_PARAMS_SIZE);
-		if(this->p_ff_params == NULL)
-		{
-			this->buffer_fxparams_free();
-			this->err_msg = TEXT("AudioDelay::buffer_fxparams_alloc: Error: failed to allocate heap memory.");
-			return FALSE;
-		}
-	}
-
-	if(this->P_FB_PARAMS_LENGTH)
-	{
-		this->p_fb_params = (audiodelay_fx_params_t*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->P_FB_PARAMS_SIZE);
-		if(this->p_fb_params == NULL)
-		{
-			this->buffer_fxparams_free();
-			this->err_msg = TEXT("AudioDelay::buffer_fxparams_alloc: Error: failed to allocate heap memory.");
-			return FALSE;
-		}
-	}
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioDelay::buffer_fxparams_free(VOID)
-{
-	if(p_processheap == NULL)
-	{
-		this->err_msg = TEXT("AudioDelay::buffer_fxparams_free: Error: p_processheap is NULL.");
-		return FALSE;
-	}
-
-	if(this->p_ff_params != NULL)
-	{
-		if(!HeapFree(p_processheap, 0u, this->p_ff_params))
-		{
-			this->err_msg = TEXT("AudioDelay::buffer_fxparams_free: Error: failed to release heap memory.");
-			return FALSE;
-		}
-
-		this->p_ff_params = NULL;
-	}
-
-	if(this->p_fb_params != NULL)
-	{
-		if(!HeapFree(p_processheap, 0u, this->p_fb_params))
-		{
-			this->err_msg = TEXT("AudioDelay::buffer_fxparams_free: Error: failed to release heap memory.");
-			return FALSE;
-		}
-
-		this->p_fb_params = NULL;
-	}
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioDelay::retrieve_prev_nframe(ULONG_PTR curr_buf_nframe, ULONG_PTR n_delay, ULONG_PTR *p_prev_buf_nframe, ULONG_PTR *p_prev_nseg, ULONG_PTR *p_prev_seg_nframe)
-{
-	const ULONG_PTR _BUFFER_SIZE_BITMASK = (this->BUFFER_SIZE_FRAMES - 1u);
-	ULONG_PTR prev_buf_nframe = 0u;
-	ULONG_PTR prev_nseg = 0u;
-	ULONG_PTR prev_seg_nframe = 0u;
-
-	if(curr_buf_nframe >= this->BUFFER_SIZE_FRAMES) return FALSE;
-	if(n_delay >= this->BUFFER_SIZE_FRAMES) return FALSE;
-
-	prev_buf_nframe = ((curr_buf_nframe - n_delay) & _BUFFER_SIZE_BITMASK); /*Safe to use as long as BUFFER_SIZE_FRAMES is a power of 2.*/
-
-	/*if(n_delay > curr_buf_nframe) prev_buf_nframe = this->BUFFER_SIZE_FRAMES - (n_delay - curr_buf_nframe);
-	else prev_buf_nframe = curr_buf_nframe - n_delay;*/
-
-	prev_nseg = prev_buf_nframe/(this->BUFFER_SEGMENT_SIZE_FRAMES);
-	prev_seg_nframe = prev_buf_nframe%(this->BUFFER_SEGMENT_SIZE_FRAMES);
-
-	if(p_prev_buf_nframe != NULL) *p_prev_buf_nframe = prev_buf_nframe;
-	if(p_prev_nseg != NULL) *p_prev_nseg = prev_nseg;
-	if(p_prev_seg_nframe != NULL) *p_prev_seg_nframe = prev_seg_nframe;
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioDelay::retrieve_prev_nframe(ULONG_PTR curr_nseg, ULONG_PTR curr_seg_nframe, ULONG_PTR n_delay, ULONG_PTR *p_prev_buf_nframe, ULONG_PTR *p_prev_nseg, ULONG_PTR *p_prev_seg_nframe)
-{
-	ULONG_PTR curr_buf_nframe = 0u;
-
-	if(curr_nseg >= this->BUFFER_N_SEGMENTS) return FALSE;
-	if(curr_seg_nframe >= this->BUFFER_SEGMENT_SIZE_FRAMES) return FALSE;
-
-	curr_buf_nframe = curr_nseg*(this->BUFFER_SEGMENT_SIZE_FRAMES) + curr_seg_nframe;
-
-	return this->retrieve_prev_nframe(curr_buf_nframe, n_delay, p_prev_buf_nframe, p_prev_nseg, p_prev_seg_nframe);
-}
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#include "AudioDelay.hpp"
+
+#include <math.h>
+
+AudioDelay::AudioDelay(const audiodelay_init_params_t *p_params)
+{
+	InitializeCriticalSection(&(this->params_lock));
+	this->setInitParameters(p_params);
+}
+
+AudioDelay::~AudioDelay(VOID)
+{
+	this->deinitialize();
+	DeleteCriticalSection(&(this->params_lock));
+}
+
+BOOL WINAPI AudioDelay::setInitParameters(const audiodelay_init_params_t *p_params)
+{
+	this->status = this->STATUS_UNINITIALIZED;
+
+	if(p_params == NULL)
+	{
+		this->err_msg = TEXT("AudioDelay::setInitParameters: Error: init params object pointer is NULL.");
+		return FALSE;
+	}
+
+	this->BUFFER_SIZE_FRAMES = _get_closest_power2_ceil(p_params->buffer_size_frames);
+	this->BUFFER_N_SEGMENTS = _get_closest_power2_ceil(p_params->buffer_n_segments);
+	this->N_CHANNELS = p_params->n_channels;
+	this->P_FF_PARAMS_LENGTH = p_params->n_ff_delays;
+	this->P_FB_PARAMS_LENGTH = p_params->n_fb_delays;
+	this->KERNEL_ISA_REQUESTED = p_params->kernel_isa;
+	this->GAIN_RAMP_MODE = p_params->gain_ramp_mode;
+	this->XFADE_SIZE_FRAMES = p_params->xfade_size_frames;
+	this->INTERP_MODE = p_params->interp_mode;
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::initialize(VOID)
+{
+	if(this->status == this->STATUS_INITIALIZED) return TRUE;
+
+	this->status = this->STATUS_UNINITIALIZED;
+
+	if(this->BUFFER_SIZE_FRAMES < this->BUFFER_SIZE_FRAMES_MIN)
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioDelay::initialize: Error: invalid buffer size.");
+		return FALSE;
+	}
+
+	if(this->BUFFER_N_SEGMENTS < this->BUFFER_N_SEGMENTS_MIN)
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioDelay::initialize: Error: invalid buffer segment count.");
+		return FALSE;
+	}
+
+	if(this->N_CHANNELS < this->N_CHANNELS_MIN)
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioDelay::initialize: Error: invalid number of channels.");
+		return FALSE;
+	}
+
+	if(this->XFADE_SIZE_FRAMES > this->BUFFER_SIZE_FRAMES)
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioDelay::initialize: Error: crossfade size is longer than the buffer.");
+		return FALSE;
+	}
+
+	switch(this->INTERP_MODE)
+	{
+		case this->INTERP_LINEAR:
+			this->INTERP_LOOKAHEAD = 0u;
+			break;
+
+		case this->INTERP_HERMITE:
+		case this->INTERP_LAGRANGE:
+			this->INTERP_LOOKAHEAD = 1u;
+			break;
+
+		default:
+			this->status = this->STATUS_ERROR_INVALIDPARAMS;
+			this->err_msg = TEXT("AudioDelay::initialize: Error: invalid interpolation mode.");
+			return FALSE;
+	}
+
+	this->BUFFER_SIZE_SAMPLES = (this->BUFFER_SIZE_FRAMES)*(this->N_CHANNELS);
+	this->BUFFER_SIZE_BYTES = (this->BUFFER_SIZE_SAMPLES)*sizeof(FLOAT);
+
+	this->BUFFER_SEGMENT_SIZE_FRAMES = (this->BUFFER_SIZE_FRAMES)/(this->BUFFER_N_SEGMENTS);
+	this->BUFFER_SEGMENT_SIZE_SAMPLES = (this->BUFFER_SEGMENT_SIZE_FRAMES)*(this->N_CHANNELS);
+	this->BUFFER_SEGMENT_SIZE_BYTES = (this->BUFFER_SEGMENT_SIZE_SAMPLES)*sizeof(FLOAT);
+
+	this->XFADE_SIZE_SAMPLES = (this->XFADE_SIZE_FRAMES)*(this->N_CHANNELS);
+
+	this->P_FF_PARAMS_SIZE = (this->P_FF_PARAMS_LENGTH)*sizeof(audiodelay_fx_params_t);
+	this->P_FB_PARAMS_SIZE = (this->P_FB_PARAMS_LENGTH)*sizeof(audiodelay_fx_params_t);
+
+	if(!this->buffer_alloc())
+	{
+		this->status = this->STATUS_ERROR_MEMORY;
+		return FALSE;
+	}
+
+	this->p_kernel = dspkernel_get_table(dspkernel_select_isa(this->KERNEL_ISA_REQUESTED));
+
+	switch(this->N_CHANNELS)
+	{
+		case 1u:
+			this->pf_delayline_read_mod = &AudioDelay::delayline_read_mod<1u>;
+			break;
+
+		case 2u:
+			this->pf_delayline_read_mod = &AudioDelay::delayline_read_mod<2u>;
+			break;
+
+		case 6u:
+			this->pf_delayline_read_mod = &AudioDelay::delayline_read_mod<6u>;
+			break;
+
+		case 8u:
+			this->pf_delayline_read_mod = &AudioDelay::delayline_read_mod<8u>;
+			break;
+
+		default:
+			this->pf_delayline_read_mod = &AudioDelay::delayline_read_mod<0u>;
+			break;
+	}
+
+	this->paramblock_write = 0;
+	this->paramblock_shared = 1;
+	this->paramblock_read = 2;
+	this->params_update_depth = 0u;
+	this->params_publish();
+
+	this->params_snap = TRUE;
+	this->tapactive_rebuild = TRUE;
+
+	this->status = this->STATUS_INITIALIZED;
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::runDSP(ULONG_PTR n_segment)
+{
+	FLOAT *p_curr_seg_in = NULL;
+	FLOAT *p_curr_seg_out = NULL;
+	FLOAT *p_accum = NULL;
+
+	const audiodelay_paramblock_t *p_params = NULL;
+	audiodelay_tapstate_t *p_tapstate = NULL;
+
+	ULONG_PTR n_fx = 0u;
+	ULONG_PTR n_active = 0u;
+	ULONG_PTR n_delay = 0u;
+	ULONG_PTR shortfb_delay_min = 0u;
+
+	if(this->status < 1) return FALSE;
+
+	if(n_segment >= this->BUFFER_N_SEGMENTS)
+	{
+		this->err_msg = TEXT("AudioDelay::runDSP: Error: given segment index is out of bounds.");
+		return FALSE;
+	}
+
+	/*
+		The block engine processes one tap at a time across the whole segment, accumulating into p_bufferaccum.
+		The output segment is only written at the end, so feedback taps longer than (BUFFER_SIZE_FRAMES - BUFFER_SEGMENT_SIZE_FRAMES)
+		still read the previous contents of the current output segment.
+
+		Feedback taps shorter than one segment ("short" taps) read output frames from the segment being processed.
+		These are applied afterwards by rundsp_shortfb().
+
+		Gain changes (dry input, output and tap amplitudes) are ramped across the segment (see gainramp_update()).
+		Gains that did not change use the plain scale/mac kernels.
+		Delay time changes crossfade from the old to the new tap position (see tapstate_update()).
+		Only active taps are processed (see tapactive_update()), so silent taps cost nothing and do not run their LFO.
+		Modulated taps get their LFO output for the whole segment first (see tapstate_modulate()).
+		Consecutive plain taps are accumulated together, in one pass over p_bufferaccum (see tapgroup_add()).
+	*/
+
+	p_params = this->params_acquire();
+
+	if(this->tapactive_rebuild) this->tapactive_update(p_params);
+
+	p_curr_seg_in = (FLOAT*) (((ULONG_PTR) (this->p_bufferinput)) + n_segment*(this->BUFFER_SEGMENT_SIZE_BYTES));
+	p_curr_seg_out = (FLOAT*) (((ULONG_PTR) (this->p_bufferoutput)) + n_segment*(this->BUFFER_SEGMENT_SIZE_BYTES));
+
+	p_accum = this->p_bufferaccum;
+
+	this->gainramp_update(&(this->gainramp_dry), p_params->dryinput_amp);
+	this->gainramp_update(&(this->gainramp_out), p_params->output_amp);
+
+	this->gain_scale(p_accum, p_curr_seg_in, &(this->gainramp_dry), 0u, this->BUFFER_SEGMENT_SIZE_SAMPLES);
+
+	for(n_active = 0u; n_active < this->ff_active_n; n_active++)
+	{
+		n_fx = this->p_ff_active[n_active];
+		p_tapstate = &(this->p_ff_tapstate[n_fx]);
+
+		this->tapstate_update(p_tapstate, &(p_params->p_ff_params[n_fx]), 0u);
+		if(p_tapstate->gainramp.curr == 0.0f) this->tapactive_rebuild = TRUE; /*Ramping down to silence: inactive from the next segment.*/
+
+		this->tapstate_modulate(p_tapstate, &(p_params->p_ff_params[n_fx]), 0u);
+
+		if(this->tapgroup_add(p_tapstate, n_segment, 0u)) continue;
+
+		this->tapgroup_flush(p_accum, this->p_bufferinput, this->BUFFER_SEGMENT_SIZE_FRAMES);
+		this->delaytap_accumulate(p_accum, this->p_bufferinput, n_segment, 0u, this->BUFFER_SEGMENT_SIZE_FRAMES, p_tapstate);
+	}
+
+	this->tapgroup_flush(p_accum, this->p_bufferinput, this->BUFFER_SEGMENT_SIZE_FRAMES);
+
+	for(n_active = 0u; n_active < this->fb_active_n; n_active++)
+	{
+		n_fx = this->p_fb_active[n_active];
+		p_tapstate = &(this->p_fb_tapstate[n_fx]);
+
+		this->tapstate_update(p_tapstate, &(p_params->p_fb_params[n_fx]), this->FB_SHORT_DELAY_MIN);
+		if(p_tapstate->gainramp.curr == 0.0f) this->tapactive_rebuild = TRUE;
+
+		this->tapstate_modulate(p_tapstate, &(p_params->p_fb_params[n_fx]), this->FB_SHORT_DELAY_MIN);
+
+		/*While crossfading, the tap is short if either of its positions is. Modulated taps are short if their shortest modulated delay is.*/
+
+		n_delay = this->tapstate_get_read_delay_min(p_tapstate);
+
+		p_tapstate->isshort = (n_delay < this->BUFFER_SEGMENT_SIZE_FRAMES);
+
+		if(p_tapstate->isshort)
+		{
+			if((!shortfb_delay_min) || (n_delay < shortfb_delay_min)) shortfb_delay_min = n_delay;
+			continue;
+		}
+
+		if(this->tapgroup_add(p_tapstate, n_segment, 0u)) continue;
+
+		this->tapgroup_flush(p_accum, this->p_bufferoutput, this->BUFFER_SEGMENT_SIZE_FRAMES);
+		this->delaytap_accumulate(p_accum, this->p_bufferoutput, n_segment, 0u, this->BUFFER_SEGMENT_SIZE_FRAMES, p_tapstate);
+	}
+
+	this->tapgroup_flush(p_accum, this->p_bufferoutput, this->BUFFER_SEGMENT_SIZE_FRAMES);
+
+	this->params_snap = FALSE;
+
+	if(shortfb_delay_min)
+	{
+		this->rundsp_shortfb(n_segment, shortfb_delay_min);
+		return TRUE;
+	}
+
+	this->gain_scale(p_curr_seg_out, p_accum, &(this->gainramp_out), 0u, this->BUFFER_SEGMENT_SIZE_SAMPLES);
+
+	return TRUE;
+}
+
+FLOAT* WINAPI AudioDelay::getInputBuffer(VOID)
+{
+	if(this->status < 1) return NULL;
+
+	return this->p_bufferinput;
+}
+
+FLOAT* WINAPI AudioDelay::getOutputBuffer(VOID)
+{
+	if(this->status < 1) return NULL;
+
+	return this->p_bufferoutput;
+}
+
+FLOAT* WINAPI AudioDelay::getInputBufferSegment(ULONG_PTR n_segment)
+{
+	if(this->status < 1) return NULL;
+	if(n_segment >= this->BUFFER_N_SEGMENTS)
+	{
+		this->err_msg = TEXT("AudioDelay::getInputBufferSegment: Error: given segment index is out of bounds.");
+		return NULL;
+	}
+
+	return (FLOAT*) (((ULONG_PTR) (this->p_bufferinput)) + n_segment*(this->BUFFER_SEGMENT_SIZE_BYTES));
+}
+
+FLOAT* WINAPI AudioDelay::getOutputBufferSegment(ULONG_PTR n_segment)
+{
+	if(this->status < 1) return NULL;
+	if(n_segment >= this->BUFFER_N_SEGMENTS)
+	{
+		this->err_msg = TEXT("AudioDelay::getOutputBufferSegment: Error: given segment index is out of bounds.");
+		return NULL;
+	}
+
+	return (FLOAT*) (((ULONG_PTR) (this->p_bufferoutput)) + n_segment*(this->BUFFER_SEGMENT_SIZE_BYTES));
+}
+
+FLOAT WINAPI AudioDelay::getDryInputAmplitude(VOID)
+{
+	return this->dryinput_amp;
+}
+
+FLOAT WINAPI AudioDelay::getOutputAmplitude(VOID)
+{
+	return this->output_amp;
+}
+
+BOOL WINAPI AudioDelay::getFFParams(ULONG_PTR n_fx, audiodelay_fx_params_t *p_params)
+{
+	if(this->status < 1) return FALSE;
+
+	if(n_fx >= this->P_FF_PARAMS_LENGTH)
+	{
+		this->err_msg = TEXT("AudioDelay::getFFParams: Error: given fx index is out of bounds.");
+		return FALSE;
+	}
+
+	if(p_params == NULL)
+	{
+		this->err_msg = TEXT("AudioDelay::getFFParams: Error: given params object pointer is NULL.");
+		return FALSE;
+	}
+
+	CopyMemory(p_params, &(this->p_ff_params[n_fx]), sizeof(audiodelay_fx_params_t));
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::getFBParams(ULONG_PTR n_fx, audiodelay_fx_params_t *p_params)
+{
+	if(this->status < 1) return FALSE;
+
+	if(n_fx >= this->P_FB_PARAMS_LENGTH)
+	{
+		this->err_msg = TEXT("AudioDelay::getFBParams: Error: given fx index is out of bounds.");
+		return FALSE;
+	}
+
+	if(p_params == NULL)
+	{
+		this->err_msg = TEXT("AudioDelay::getFBParams: Error: given params object pointer is NULL.");
+		return FALSE;
+	}
+
+	CopyMemory(p_params, &(this->p_fb_params[n_fx]), sizeof(audiodelay_fx_params_t));
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::setDryInputAmplitude(FLOAT amp)
+{
+	if(this->status < 1) return FALSE;
+
+	EnterCriticalSection(&(this->params_lock));
+	this->dryinput_amp = amp;
+	this->params_publish();
+	LeaveCriticalSection(&(this->params_lock));
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::setOutputAmplitude(FLOAT amp)
+{
+	if(this->status < 1) return FALSE;
+
+	EnterCriticalSection(&(this->params_lock));
+	this->output_amp = amp;
+	this->params_publish();
+	LeaveCriticalSection(&(this->params_lock));
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::setFFDelay(ULONG_PTR n_fx, ULONG_PTR delay)
+{
+	if(this->status < 1) return FALSE;
+
+	if(n_fx >= this->P_FF_PARAMS_LENGTH)
+	{
+		this->err_msg = TEXT("AudioDelay::setFFDelay: Error: given fx index is out of bounds.");
+		return FALSE;
+	}
+
+	if(delay >= this->BUFFER_SIZE_FRAMES)
+	{
+		this->err_msg = TEXT("AudioDelay::setFFDelay: Error: given delay time value is too big.");
+		return FALSE;
+	}
+
+	EnterCriticalSection(&(this->params_lock));
+	this->p_ff_params[n_fx].delay = (UINT32) delay;
+	this->p_ff_params[n_fx].delay_frac = 0u;
+	this->params_publish();
+	LeaveCriticalSection(&(this->params_lock));
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::setFFAmplitude(ULONG_PTR n_fx, FLOAT amp)
+{
+	if(this->status < 1) return FALSE;
+
+	if(n_fx >= this->P_FF_PARAMS_LENGTH)
+	{
+		this->err_msg = TEXT("AudioDelay::setFFAmplitude: Error: given fx index is out of bounds.");
+		return FALSE;
+	}
+
+	EnterCriticalSection(&(this->params_lock));
+	this->p_ff_params[n_fx].amp = amp;
+	this->params_publish();
+	LeaveCriticalSection(&(this->params_lock));
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::setFBDelay(ULONG_PTR n_fx, ULONG_PTR delay)
+{
+	if(this->status < 1) return FALSE;
+
+	if(n_fx >= this->P_FB_PARAMS_LENGTH)
+	{
+		this->err_msg = TEXT("AudioDelay::setFBDelay: Error: given fx index is out of bounds.");
+		return FALSE;
+	}
+
+	if(delay >= this->BUFFER_SIZE_FRAMES)
+	{
+		this->err_msg = TEXT("AudioDelay::setFBDelay: Error: given delay time value is too big.");
+		return FALSE;
+	}
+
+	EnterCriticalSection(&(this->params_lock));
+	this->p_fb_params[n_fx].delay = (UINT32) delay;
+	this->p_fb_params[n_fx].delay_frac = 0u;
+	this->params_publish();
+	LeaveCriticalSection(&(this->params_lock));
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::setFBAmplitude(ULONG_PTR n_fx, FLOAT amp)
+{
+	if(this->status < 1) return FALSE;
+
+	if(n_fx >= this->P_FB_PARAMS_LENGTH)
+	{
+		this->err_msg = TEXT("AudioDelay::setFBAmplitude: Error: given fx index is out of bounds.");
+		return FALSE;
+	}
+
+	EnterCriticalSection(&(this->params_lock));
+	this->p_fb_params[n_fx].amp = amp;
+	this->params_publish();
+	LeaveCriticalSection(&(this->params_lock));
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::setFFDelayFractional(ULONG_PTR n_fx, DOUBLE delay)
+{
+	ULONG_PTR n_delay = 0u;
+
+	if(this->status < 1) return FALSE;
+
+	if(n_fx >= this->P_FF_PARAMS_LENGTH)
+	{
+		this->err_msg = TEXT("AudioDelay::setFFDelayFractional: Error: given fx index is out of bounds.");
+		return FALSE;
+	}
+
+	if(!(delay >= 0.0))
+	{
+		this->err_msg = TEXT("AudioDelay::setFFDelayFractional: Error: given delay time value is invalid.");
+		return FALSE;
+	}
+
+	/*The last interpolation point is 2 frames past the delay time.*/
+
+	if(delay >= ((DOUBLE) (this->BUFFER_SIZE_FRAMES - 2u)))
+	{
+		this->err_msg = TEXT("AudioDelay::setFFDelayFractional: Error: given delay time value is too big.");
+		return FALSE;
+	}
+
+	n_delay = (ULONG_PTR) delay;
+
+	EnterCriticalSection(&(this->params_lock));
+	this->p_ff_params[n_fx].delay = (UINT32) n_delay;
+	this->p_ff_params[n_fx].delay_frac = (UINT32) ((delay - ((DOUBLE) n_delay))*4294967296.0);
+	this->params_publish();
+	LeaveCriticalSection(&(this->params_lock));
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::setFBDelayFractional(ULONG_PTR n_fx, DOUBLE delay)
+{
+	ULONG_PTR n_delay = 0u;
+
+	if(this->status < 1) return FALSE;
+
+	if(n_fx >= this->P_FB_PARAMS_LENGTH)
+	{
+		this->err_msg = TEXT("AudioDelay::setFBDelayFractional: Error: given fx index is out of bounds.");
+		return FALSE;
+	}
+
+	if(!(delay >= 0.0))
+	{
+		this->err_msg = TEXT("AudioDelay::setFBDelayFractional: Error: given delay time value is invalid.");
+		return FALSE;
+	}
+
+	if(delay >= ((DOUBLE) (this->BUFFER_SIZE_FRAMES - 2u)))
+	{
+		this->err_msg = TEXT("AudioDelay::setFBDelayFractional: Error: given delay time value is too big.");
+		return FALSE;
+	}
+
+	n_delay = (ULONG_PTR) delay;
+
+	EnterCriticalSection(&(this->params_lock));
+	this->p_fb_params[n_fx].delay = (UINT32) n_delay;
+	this->p_fb_params[n_fx].delay_frac = (UINT32) ((delay - ((DOUBLE) n_delay))*4294967296.0);
+	this->params_publish();
+	LeaveCriticalSection(&(this->params_lock));
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::setFFModulation(ULONG_PTR n_fx, INT shape, FLOAT depth, FLOAT rate)
+{
+	if(this->status < 1) return FALSE;
+
+	if(n_fx >= this->P_FF_PARAMS_LENGTH)
+	{
+		this->err_msg = TEXT("AudioDelay::setFFModulation: Error: given fx index is out of bounds.");
+		return FALSE;
+	}
+
+	if((shape != this->MOD_NONE) && (shape != this->MOD_SINE) && (shape != this->MOD_TRIANGLE))
+	{
+		this->err_msg = TEXT("AudioDelay::setFFModulation: Error: invalid modulation shape.");
+		return FALSE;
+	}
+
+	if(!((depth >= 0.0f) && (depth < ((FLOAT) this->BUFFER_SIZE_FRAMES))))
+	{
+		this->err_msg = TEXT("AudioDelay::setFFModulation: Error: given modulation depth value is invalid.");
+		return FALSE;
+	}
+
+	if(!((rate >= 0.0f) && (rate <= 0.5f)))
+	{
+		this->err_msg = TEXT("AudioDelay::setFFModulation: Error: given modulation rate value is invalid.");
+		return FALSE;
+	}
+
+	EnterCriticalSection(&(this->params_lock));
+	this->p_ff_params[n_fx].mod_shape = shape;
+	this->p_ff_params[n_fx].mod_depth = depth;
+	this->p_ff_params[n_fx].mod_rate = rate;
+	this->params_publish();
+	LeaveCriticalSection(&(this->params_lock));
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::setFBModulation(ULONG_PTR n_fx, INT shape, FLOAT depth, FLOAT rate)
+{
+	if(this->status < 1) return FALSE;
+
+	if(n_fx >= this->P_FB_PARAMS_LENGTH)
+	{
+		this->err_msg = TEXT("AudioDelay::setFBModulation: Error: given fx index is out of bounds.");
+		return FALSE;
+	}
+
+	if((shape != this->MOD_NONE) && (shape != this->MOD_SINE) && (shape != this->MOD_TRIANGLE))
+	{
+		this->err_msg = TEXT("AudioDelay::setFBModulation: Error: invalid modulation shape.");
+		return FALSE;
+	}
+
+	if(!((depth >= 0.0f) && (depth < ((FLOAT) this->BUFFER_SIZE_FRAMES))))
+	{
+		this->err_msg = TEXT("AudioDelay::setFBModulation: Error: given modulation depth value is invalid.");
+		return FALSE;
+	}
+
+	if(!((rate >= 0.0f) && (rate <= 0.5f)))
+	{
+		this->err_msg = TEXT("AudioDelay::setFBModulation: Error: given modulation rate value is invalid.");
+		return FALSE;
+	}
+
+	EnterCriticalSection(&(this->params_lock));
+	this->p_fb_params[n_fx].mod_shape = shape;
+	this->p_fb_params[n_fx].mod_depth = depth;
+	this->p_fb_params[n_fx].mod_rate = rate;
+	this->params_publish();
+	LeaveCriticalSection(&(this->params_lock));
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::resetFFParams(VOID)
+{
+	if(this->status < 1) return FALSE;
+
+	EnterCriticalSection(&(this->params_lock));
+	if(this->P_FF_PARAMS_LENGTH) ZeroMemory(this->p_ff_params, this->P_FF_PARAMS_SIZE);
+
+	this->params_publish();
+	LeaveCriticalSection(&(this->params_lock));
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::resetFBParams(VOID)
+{
+	if(this->status < 1) return FALSE;
+
+	EnterCriticalSection(&(this->params_lock));
+	if(this->P_FB_PARAMS_LENGTH) ZeroMemory(this->p_fb_params, this->P_FB_PARAMS_SIZE);
+
+	this->params_publish();
+	LeaveCriticalSection(&(this->params_lock));
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::beginParamsUpdate(VOID)
+{
+	if(this->status < 1) return FALSE;
+
+	EnterCriticalSection(&(this->params_lock));
+	this->params_update_depth++;
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::commitParamsUpdate(VOID)
+{
+	if(this->status < 1) return FALSE;
+
+	if(!this->params_update_depth)
+	{
+		this->err_msg = TEXT("AudioDelay::commitParamsUpdate: Error: no parameter update in progress.");
+		return FALSE;
+	}
+
+	this->params_update_depth--;
+	this->params_publish();
+	LeaveCriticalSection(&(this->params_lock));
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::reset(VOID)
+{
+	ULONG_PTR n_tap = 0u;
+	FLOAT *p_expshape = NULL;
+	FLOAT *p_mod_offset = NULL;
+
+	if(this->status < 1) return FALSE;
+
+	EnterCriticalSection(&(this->params_lock));
+
+	if(this->P_FF_PARAMS_LENGTH) ZeroMemory(this->p_ff_params, this->P_FF_PARAMS_SIZE);
+	if(this->P_FB_PARAMS_LENGTH) ZeroMemory(this->p_fb_params, this->P_FB_PARAMS_SIZE);
+
+	this->dryinput_amp = 0.0f;
+	this->output_amp = 0.0f;
+
+	this->paramblock_write = 0;
+	this->paramblock_shared = 1;
+	this->paramblock_read = 2;
+	this->params_update_depth = 0u;
+	this->params_publish();
+
+	LeaveCriticalSection(&(this->params_lock));
+
+	/*runDSP() side: same state as buffer_alloc() leaves it, the buffer pointers are kept.*/
+
+	ZeroMemory(this->p_bufferinput, this->BUFFER_SIZE_BYTES);
+	ZeroMemory(this->p_bufferoutput, this->BUFFER_SIZE_BYTES);
+	ZeroMemory(this->p_bufferaccum, this->BUFFER_SEGMENT_SIZE_BYTES);
+	ZeroMemory(this->p_buffertap, this->BUFFER_SEGMENT_SIZE_BYTES);
+	ZeroMemory(this->p_buffertap_prev, this->BUFFER_SEGMENT_SIZE_BYTES);
+
+	if(this->p_buffermod != NULL) ZeroMemory(this->p_buffermod, (this->P_FF_PARAMS_LENGTH + this->P_FB_PARAMS_LENGTH)*(this->BUFFER_SEGMENT_SIZE_FRAMES)*sizeof(FLOAT));
+	if(this->p_bufferexpramp != NULL) ZeroMemory(this->p_bufferexpramp, (2u + this->P_FF_PARAMS_LENGTH + this->P_FB_PARAMS_LENGTH)*(this->BUFFER_SEGMENT_SIZE_BYTES));
+
+	p_expshape = this->gainramp_dry.p_expshape;
+	ZeroMemory(&(this->gainramp_dry), sizeof(audiodelay_gainramp_t));
+	this->gainramp_dry.p_expshape = p_expshape;
+
+	p_expshape = this->gainramp_out.p_expshape;
+	ZeroMemory(&(this->gainramp_out), sizeof(audiodelay_gainramp_t));
+	this->gainramp_out.p_expshape = p_expshape;
+
+	for(n_tap = 0u; n_tap < (this->P_FF_PARAMS_LENGTH + this->P_FB_PARAMS_LENGTH); n_tap++)
+	{
+		p_expshape = this->p_ff_tapstate[n_tap].gainramp.p_expshape;
+		p_mod_offset = this->p_ff_tapstate[n_tap].p_mod_offset;
+
+		ZeroMemory(&(this->p_ff_tapstate[n_tap]), sizeof(audiodelay_tapstate_t));
+
+		this->p_ff_tapstate[n_tap].gainramp.p_expshape = p_expshape;
+		this->p_ff_tapstate[n_tap].p_mod_offset = p_mod_offset;
+		this->p_ff_tapstate[n_tap].xfade_nframe = this->XFADE_SIZE_FRAMES;
+	}
+
+	for(n_tap = 0u; n_tap < this->P_FB_PARAMS_LENGTH; n_tap++) this->p_fb_tapstate[n_tap].delay = this->FB_SHORT_DELAY_MIN;
+
+	this->ff_active_n = 0u;
+	this->fb_active_n = 0u;
+	this->tapgroup_n_taps = 0u;
+
+	this->params_snap = TRUE;
+	this->tapactive_rebuild = TRUE;
+
+	return TRUE;
+}
+
+INT WINAPI AudioDelay::getKernelISA(VOID)
+{
+	if(this->status < 1) return -1;
+
+	return this->p_kernel->isa;
+}
+
+INT WINAPI AudioDelay::getStatus(VOID)
+{
+	return this->status;
+}
+
+__string WINAPI AudioDelay::getLastErrorMessage(VOID)
+{
+	if(this->status == this->STATUS_UNINITIALIZED)
+		return TEXT("AudioDelay object not initialized\r\nExtended error message: ") + this->err_msg;
+
+	return this->err_msg;
+}
+
+VOID WINAPI AudioDelay::deinitialize(VOID)
+{
+	this->status = this->STATUS_UNINITIALIZED;
+	this->buffer_free();
+
+	return;
+}
+
+BOOL WINAPI AudioDelay::buffer_alloc(VOID)
+{
+	ULONG_PTR n_frame;
+	ULONG_PTR n_channel;
+	ULONG_PTR n_gains;
+	ULONG_PTR n_gain;
+	ULONG_PTR n_taps;
+	FLOAT f_ramp;
+
+	/*Clear any previous allocations*/
+	if(!this->buffer_free()) return FALSE;
+
+	if(!this->buffer_fxparams_alloc()) return FALSE;
+
+	if(p_processheap == NULL)
+	{
+		this->err_msg = TEXT("AudioDelay::buffer_alloc: Error: p_processheap is NULL.");
+		return FALSE;
+	}
+
+	this->p_bufferinput = (FLOAT*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->BUFFER_SIZE_BYTES);
+	this->p_bufferoutput = (FLOAT*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->BUFFER_SIZE_BYTES);
+	this->p_bufferaccum = (FLOAT*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->BUFFER_SEGMENT_SIZE_BYTES);
+	this->p_bufferramp = (FLOAT*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->BUFFER_SEGMENT_SIZE_BYTES);
+	this->p_buffertap = (FLOAT*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->BUFFER_SEGMENT_SIZE_BYTES);
+	this->p_buffertap_prev = (FLOAT*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->BUFFER_SEGMENT_SIZE_BYTES);
+
+	if(this->p_bufferinput == NULL)
+	{
+		this->buffer_free();
+		this->err_msg = TEXT("AudioDelay::buffer_alloc: Error: failed to allocate heap memory.");
+		return FALSE;
+	}
+
+	if(this->p_bufferoutput == NULL)
+	{
+		this->buffer_free();
+		this->err_msg = TEXT("AudioDelay::buffer_alloc: Error: failed to allocate heap memory.");
+		return FALSE;
+	}
+
+	if(this->p_bufferaccum == NULL)
+	{
+		this->buffer_free();
+		this->err_msg = TEXT("AudioDelay::buffer_alloc: Error: failed to allocate heap memory.");
+		return FALSE;
+	}
+
+	if(this->p_bufferramp == NULL)
+	{
+		this->buffer_free();
+		this->err_msg = TEXT("AudioDelay::buffer_alloc: Error: failed to allocate heap memory.");
+		return FALSE;
+	}
+
+	if((this->p_buffertap == NULL) || (this->p_buffertap_prev == NULL))
+	{
+		this->buffer_free();
+		this->err_msg = TEXT("AudioDelay::buffer_alloc: Error: failed to allocate heap memory.");
+		return FALSE;
+	}
+
+	for(n_frame = 0u; n_frame < this->BUFFER_SEGMENT_SIZE_FRAMES; n_frame++)
+	{
+		f_ramp = ((FLOAT) (n_frame + 1u))/((FLOAT) this->BUFFER_SEGMENT_SIZE_FRAMES);
+
+		for(n_channel = 0u; n_channel < this->N_CHANNELS; n_channel++) this->p_bufferramp[n_frame*(this->N_CHANNELS) + n_channel] = f_ramp;
+	}
+
+	/*Gain ramp states: dry input, output, then the ff taps and the fb taps (within the tap states). Each one gets its own exponential ramp shape segment.*/
+
+	n_gains = 2u + (this->P_FF_PARAMS_LENGTH) + (this->P_FB_PARAMS_LENGTH);
+
+	if(n_gains > 2u)
+	{
+		this->p_ff_tapstate = (audiodelay_tapstate_t*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, (n_gains - 2u)*sizeof(audiodelay_tapstate_t));
+		if(this->p_ff_tapstate == NULL)
+		{
+			this->buffer_free();
+			this->err_msg = TEXT("AudioDelay::buffer_alloc: Error: failed to allocate heap memory.");
+			return FALSE;
+		}
+
+		this->p_fb_tapstate = &(this->p_ff_tapstate[this->P_FF_PARAMS_LENGTH]);
+	}
+
+	/*Active tap lists: ff list, then fb list.*/
+
+	if(n_gains > 2u)
+	{
+		this->p_ff_active = (ULONG_PTR*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, (n_gains - 2u)*sizeof(ULONG_PTR));
+		if(this->p_ff_active == NULL)
+		{
+			this->buffer_free();
+			this->err_msg = TEXT("AudioDelay::buffer_alloc: Error: failed to allocate heap memory.");
+			return FALSE;
+		}
+
+		this->p_fb_active = &(this->p_ff_active[this->P_FF_PARAMS_LENGTH]);
+	}
+
+	this->ff_active_n = 0u;
+	this->fb_active_n = 0u;
+
+	/*No crossfade in progress. Feedback taps start at the shortest delay time allowed.*/
+
+	for(n_gain = 0u; n_gain < (n_gains - 2u); n_gain++) this->p_ff_tapstate[n_gain].xfade_nframe = this->XFADE_SIZE_FRAMES;
+	for(n_gain = 0u; n_gain < this->P_FB_PARAMS_LENGTH; n_gain++) this->p_fb_tapstate[n_gain].delay = this->FB_SHORT_DELAY_MIN;
+
+	/*LFO outputs: one segment (one value per frame) for every tap.*/
+
+	if(n_gains > 2u)
+	{
+		this->p_buffermod = (FLOAT*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, (n_gains - 2u)*(this->BUFFER_SEGMENT_SIZE_FRAMES)*sizeof(FLOAT));
+		if(this->p_buffermod == NULL)
+		{
+			this->buffer_free();
+			this->err_msg = TEXT("AudioDelay::buffer_alloc: Error: failed to allocate heap memory.");
+			return FALSE;
+		}
+
+		for(n_gain = 0u; n_gain < (n_gains - 2u); n_gain++) this->p_ff_tapstate[n_gain].p_mod_offset = &(this->p_buffermod[n_gain*(this->BUFFER_SEGMENT_SIZE_FRAMES)]);
+	}
+
+	/*Tap group: source pointers first, then frame indexes, then amplitudes (pointer aligned throughout).*/
+
+	n_taps = this->P_FF_PARAMS_LENGTH;
+	if(this->P_FB_PARAMS_LENGTH > n_taps) n_taps = this->P_FB_PARAMS_LENGTH;
+
+	if(n_taps)
+	{
+		this->p_tapgroup_buffer = HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, n_taps*(sizeof(const FLOAT*) + sizeof(ULONG_PTR) + sizeof(FLOAT)));
+		if(this->p_tapgroup_buffer == NULL)
+		{
+			this->buffer_free();
+			this->err_msg = TEXT("AudioDelay::buffer_alloc: Error: failed to allocate heap memory.");
+			return FALSE;
+		}
+
+		this->pp_tapgroup_src = (const FLOAT**) this->p_tapgroup_buffer;
+		this->p_tapgroup_buf_nframe = (ULONG_PTR*) &(this->pp_tapgroup_src[n_taps]);
+		this->p_tapgroup_amp = (FLOAT*) &(this->p_tapgroup_buf_nframe[n_taps]);
+	}
+
+	this->tapgroup_n_taps = 0u;
+
+	if(this->XFADE_SIZE_FRAMES)
+	{
+		this->p_bufferxfade = (FLOAT*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, (this->XFADE_SIZE_SAMPLES)*sizeof(FLOAT));
+		if(this->p_bufferxfade == NULL)
+		{
+			this->buffer_free();
+			this->err_msg = TEXT("AudioDelay::buffer_alloc: Error: failed to allocate heap memory.");
+			return FALSE;
+		}
+
+		for(n_frame = 0u; n_frame < this->XFADE_SIZE_FRAMES; n_frame++)
+		{
+			f_ramp = ((FLOAT) (n_frame + 1u))/((FLOAT) this->XFADE_SIZE_FRAMES);
+
+			for(n_channel = 0u; n_channel < this->N_CHANNELS; n_channel++) this->p_bufferxfade[n_frame*(this->N_CHANNELS) + n_channel] = f_ramp;
+		}
+	}
+
+	if(this->GAIN_RAMP_MODE == this->GAINRAMP_EXPONENTIAL)
+	{
+		this->p_bufferexpramp = (FLOAT*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, n_gains*(this->BUFFER_SEGMENT_SIZE_BYTES));
+		if(this->p_bufferexpramp == NULL)
+		{
+			this->buffer_free();
+			this->err_msg = TEXT("AudioDelay::buffer_alloc: Error: failed to allocate heap memory.");
+			return FALSE;
+		}
+	}
+
+	ZeroMemory(&(this->gainramp_dry), sizeof(audiodelay_gainramp_t));
+	ZeroMemory(&(this->gainramp_out), sizeof(audiodelay_gainramp_t));
+
+	if(this->p_bufferexpramp != NULL)
+	{
+		this->gainramp_dry.p_expshape = this->p_bufferexpramp;
+		this->gainramp_out.p_expshape = &(this->p_bufferexpramp[this->BUFFER_SEGMENT_SIZE_SAMPLES]);
+
+		for(n_gain = 0u; n_gain < (n_gains - 2u); n_gain++)
+			this->p_ff_tapstate[n_gain].gainramp.p_expshape = &(this->p_bufferexpramp[(n_gain + 2u)*(this->BUFFER_SEGMENT_SIZE_SAMPLES)]);
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::buffer_free(VOID)
+{
+	if(p_processheap == NULL)
+	{
+		this->err_msg = TEXT("AudioDelay::buffer_free: Error: p_processheap is NULL.");
+		return FALSE;
+	}
+
+	if(this->p_bufferinput != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->p_bufferinput))
+		{
+			this->err_msg = TEXT("AudioDelay::buffer_free: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->p_bufferinput = NULL;
+	}
+
+	if(this->p_bufferoutput != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->p_bufferoutput))
+		{
+			this->err_msg = TEXT("AudioDelay::buffer_free: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->p_bufferoutput = NULL;
+	}
+
+	if(this->p_bufferaccum != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->p_bufferaccum))
+		{
+			this->err_msg = TEXT("AudioDelay::buffer_free: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->p_bufferaccum = NULL;
+	}
+
+	if(this->p_bufferramp != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->p_bufferramp))
+		{
+			this->err_msg = TEXT("AudioDelay::buffer_free: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->p_bufferramp = NULL;
+	}
+
+	if(this->p_bufferexpramp != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->p_bufferexpramp))
+		{
+			this->err_msg = TEXT("AudioDelay::buffer_free: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->p_bufferexpramp = NULL;
+	}
+
+	if(this->p_buffertap != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->p_buffertap))
+		{
+			this->err_msg = TEXT("AudioDelay::buffer_free: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->p_buffertap = NULL;
+	}
+
+	if(this->p_buffertap_prev != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->p_buffertap_prev))
+		{
+			this->err_msg = TEXT("AudioDelay::buffer_free: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->p_buffertap_prev = NULL;
+	}
+
+	if(this->p_bufferxfade != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->p_bufferxfade))
+		{
+			this->err_msg = TEXT("AudioDelay::buffer_free: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->p_bufferxfade = NULL;
+	}
+
+	if(this->p_buffermod != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->p_buffermod))
+		{
+			this->err_msg = TEXT("AudioDelay::buffer_free: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->p_buffermod = NULL;
+	}
+
+	if(this->p_ff_active != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->p_ff_active))
+		{
+			this->err_msg = TEXT("AudioDelay::buffer_free: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->p_ff_active = NULL;
+		this->p_fb_active = NULL;
+	}
+
+	if(this->p_tapgroup_buffer != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->p_tapgroup_buffer))
+		{
+			this->err_msg = TEXT("AudioDelay::buffer_free: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->p_tapgroup_buffer = NULL;
+		this->pp_tapgroup_src = NULL;
+		this->p_tapgroup_buf_nframe = NULL;
+		this->p_tapgroup_amp = NULL;
+	}
+
+	if(this->p_ff_tapstate != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->p_ff_tapstate))
+		{
+			this->err_msg = TEXT("AudioDelay::buffer_free: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->p_ff_tapstate = NULL;
+		this->p_fb_tapstate = NULL;
+	}
+
+	return this->buffer_fxparams_free();
+}
+
+BOOL WINAPI AudioDelay::buffer_fxparams_alloc(VOID)
+{
+	ULONG_PTR n_block;
+	ULONG_PTR block_size;
+	ULONG_PTR block_addr;
+
+	/*Clear any previous allocations*/
+	if(!this->buffer_fxparams_free()) return FALSE;
+
+	if(p_processheap == NULL)
+	{
+		this->err_msg = TEXT("AudioDelay::buffer_fxparams_alloc: Error: p_processheap is NULL.");
+		return FALSE;
+	}
+
+	if(this->P_FF_PARAMS_LENGTH)
+	{
+		this->p_ff_params = (audiodelay_fx_params_t*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->P_FF_PARAMS_SIZE);
+		if(this->p_ff_params == NULL)
+		{
+			this->buffer_fxparams_free();
+			this->err_msg = TEXT("AudioDelay::buffer_fxparams_alloc: Error: failed to allocate heap memory.");
+			return FALSE;
+		}
+	}
+
+	if(this->P_FB_PARAMS_LENGTH)
+	{
+		this->p_fb_params = (audiodelay_fx_params_t*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->P_FB_PARAMS_SIZE);
+		if(this->p_fb_params == NULL)
+		{
+			this->buffer_fxparams_free();
+			this->err_msg = TEXT("AudioDelay::buffer_fxparams_alloc: Error: failed to allocate heap memory.");
+			return FALSE;
+		}
+	}
+
+	/*
+		Parameter blocks: N_PARAMBLOCKS copies of the ff params and fb params, in a single allocation.
+		Sizes are rounded up to PTR_SIZE_BYTES so every array stays pointer aligned.
+	*/
+
+	block_size = ((this->P_FF_PARAMS_SIZE + PTR_SIZE_BYTES - 1u) & ~(PTR_SIZE_BYTES - 1u));
+	block_size += ((this->P_FB_PARAMS_SIZE + PTR_SIZE_BYTES - 1u) & ~(PTR_SIZE_BYTES - 1u));
+
+	if(block_size)
+	{
+		this->p_paramblock_buffer = HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, (this->N_PARAMBLOCKS)*block_size);
+		if(this->p_paramblock_buffer == NULL)
+		{
+			this->buffer_fxparams_free();
+			this->err_msg = TEXT("AudioDelay::buffer_fxparams_alloc: Error: failed to allocate heap memory.");
+			return FALSE;
+		}
+	}
+
+	for(n_block = 0u; n_block < this->N_PARAMBLOCKS; n_block++)
+	{
+		block_addr = ((ULONG_PTR) this->p_paramblock_buffer) + n_block*block_size;
+
+		this->paramblock[n_block].dryinput_amp = 0.0f;
+		this->paramblock[n_block].output_amp = 0.0f;
+
+		this->paramblock[n_block].p_ff_params = (audiodelay_fx_params_t*) block_addr;
+		block_addr += ((this->P_FF_PARAMS_SIZE + PTR_SIZE_BYTES - 1u) & ~(PTR_SIZE_BYTES - 1u));
+
+		this->paramblock[n_block].p_fb_params = (audiodelay_fx_params_t*) block_addr;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::buffer_fxparams_free(VOID)
+{
+	if(p_processheap == NULL)
+	{
+		this->err_msg = TEXT("AudioDelay::buffer_fxparams_free: Error: p_processheap is NULL.");
+		return FALSE;
+	}
+
+	if(this->p_ff_params != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->p_ff_params))
+		{
+			this->err_msg = TEXT("AudioDelay::buffer_fxparams_free: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->p_ff_params = NULL;
+	}
+
+	if(this->p_fb_params != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->p_fb_params))
+		{
+			this->err_msg = TEXT("AudioDelay::buffer_fxparams_free: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->p_fb_params = NULL;
+	}
+
+	if(this->p_paramblock_buffer != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->p_paramblock_buffer))
+		{
+			this->err_msg = TEXT("AudioDelay::buffer_fxparams_free: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->p_paramblock_buffer = NULL;
+	}
+
+	return TRUE;
+}
+
+VOID WINAPI AudioDelay::rundsp_shortfb(ULONG_PTR n_segment, ULONG_PTR chunk_size_frames)
+{
+	FLOAT *p_curr_seg_out = NULL;
+	FLOAT *p_accum = NULL;
+
+	ULONG_PTR seg_nframe = 0u;
+	ULONG_PTR n_frames = 0u;
+	ULONG_PTR n_active = 0u;
+
+	audiodelay_tapstate_t *p_tapstate = NULL;
+
+	/*
+		Exact recursive processing for short feedback taps.
+		The segment is split into chunks no longer than the shortest short feedback delay.
+		Every output frame read while processing a chunk belongs to a previous chunk (or segment), which is already final,
+		so each chunk is still processed tap by tap with the block kernels.
+	*/
+
+	p_curr_seg_out = (FLOAT*) (((ULONG_PTR) (this->p_bufferoutput)) + n_segment*(this->BUFFER_SEGMENT_SIZE_BYTES));
+
+	for(seg_nframe = 0u; seg_nframe < this->BUFFER_SEGMENT_SIZE_FRAMES; seg_nframe += n_frames)
+	{
+		n_frames = this->BUFFER_SEGMENT_SIZE_FRAMES - seg_nframe;
+		if(n_frames > chunk_size_frames) n_frames = chunk_size_frames;
+
+		p_accum = &(this->p_bufferaccum[seg_nframe*(this->N_CHANNELS)]);
+
+		for(n_active = 0u; n_active < this->fb_active_n; n_active++)
+		{
+			p_tapstate = &(this->p_fb_tapstate[this->p_fb_active[n_active]]);
+
+			if(!p_tapstate->isshort) continue;
+
+			if(this->tapgroup_add(p_tapstate, n_segment, seg_nframe)) continue;
+
+			this->tapgroup_flush(p_accum, this->p_bufferoutput, n_frames);
+			this->delaytap_accumulate(p_accum, this->p_bufferoutput, n_segment, seg_nframe, n_frames, p_tapstate);
+		}
+
+		this->tapgroup_flush(p_accum, this->p_bufferoutput, n_frames);
+
+		this->gain_scale(&(p_curr_seg_out[seg_nframe*(this->N_CHANNELS)]), p_accum, &(this->gainramp_out), seg_nframe*(this->N_CHANNELS), n_frames*(this->N_CHANNELS));
+	}
+
+	return;
+}
+
+VOID WINAPI AudioDelay::params_publish(VOID)
+{
+	audiodelay_paramblock_t *p_block = NULL;
+	LONG prev_shared = 0;
+
+	if(this->params_update_depth) return;
+
+	p_block = &(this->paramblock[this->paramblock_write]);
+
+	p_block->dryinput_amp = this->dryinput_amp;
+	p_block->output_amp = this->output_amp;
+
+	if(this->P_FF_PARAMS_LENGTH) CopyMemory(p_block->p_ff_params, this->p_ff_params, this->P_FF_PARAMS_SIZE);
+
+	if(this->P_FB_PARAMS_LENGTH) CopyMemory(p_block->p_fb_params, this->p_fb_params, this->P_FB_PARAMS_SIZE);
+
+	/*InterlockedExchange() is a full memory barrier: the block contents are visible before its index is.*/
+	prev_shared = InterlockedExchange(&(this->paramblock_shared), (this->paramblock_write | this->PARAMBLOCK_NEW));
+	this->paramblock_write = (prev_shared & this->PARAMBLOCK_INDEX_MASK);
+
+	return;
+}
+
+const audiodelay_paramblock_t* WINAPI AudioDelay::params_acquire(VOID)
+{
+	LONG prev_shared = 0;
+
+	if(this->paramblock_shared & this->PARAMBLOCK_NEW)
+	{
+		prev_shared = InterlockedExchange(&(this->paramblock_shared), this->paramblock_read);
+		this->paramblock_read = (prev_shared & this->PARAMBLOCK_INDEX_MASK);
+		this->tapactive_rebuild = TRUE;
+	}
+
+	return &(this->paramblock[this->paramblock_read]);
+}
+
+VOID WINAPI AudioDelay::tapactive_update(const audiodelay_paramblock_t *p_params)
+{
+	ULONG_PTR n_fx = 0u;
+	ULONG_PTR n_active = 0u;
+
+	n_active = 0u;
+	for(n_fx = 0u; n_fx < this->P_FF_PARAMS_LENGTH; n_fx++)
+	{
+		if((p_params->p_ff_params[n_fx].amp == 0.0f) && (this->p_ff_tapstate[n_fx].gainramp.curr == 0.0f)) continue;
+
+		this->p_ff_active[n_active] = n_fx;
+		n_active++;
+	}
+
+	this->ff_active_n = n_active;
+
+	n_active = 0u;
+	for(n_fx = 0u; n_fx < this->P_FB_PARAMS_LENGTH; n_fx++)
+	{
+		if((p_params->p_fb_params[n_fx].amp == 0.0f) && (this->p_fb_tapstate[n_fx].gainramp.curr == 0.0f)) continue;
+
+		this->p_fb_active[n_active] = n_fx;
+		n_active++;
+	}
+
+	this->fb_active_n = n_active;
+	this->tapactive_rebuild = FALSE;
+
+	return;
+}
+
+VOID WINAPI AudioDelay::gainramp_update(audiodelay_gainramp_t *p_gainramp, FLOAT target_gain)
+{
+	ULONG_PTR n_frame = 0u;
+	ULONG_PTR n_channel = 0u;
+	FLOAT *p_shape = NULL;
+	FLOAT ratio = 0.0f;
+	FLOAT log_ratio = 0.0f;
+	FLOAT f_shape = 0.0f;
+
+	if(this->params_snap || (target_gain == p_gainramp->curr))
+	{
+		p_gainramp->curr = target_gain;
+		p_gainramp->g0 = target_gain;
+		p_gainramp->dg = 0.0f;
+		p_gainramp->p_shape = NULL;
+		return;
+	}
+
+	p_gainramp->g0 = p_gainramp->curr;
+	p_gainramp->dg = target_gain - p_gainramp->curr;
+	p_gainramp->p_shape = this->p_bufferramp;
+	p_gainramp->curr = target_gain;
+
+	if(this->GAIN_RAMP_MODE != this->GAINRAMP_EXPONENTIAL) return;
+	if(p_gainramp->p_expshape == NULL) return;
+
+	/*
+		Exponential ramp: gain = g0*(ratio^t), with t = (n_frame + 1)/BUFFER_SEGMENT_SIZE_FRAMES.
+		Written as g0 + dg*shape, with shape = (ratio^t - 1)/(ratio - 1), so the same ramp kernels apply.
+		Only possible if both ends have the same sign and neither is 0.0.
+	*/
+
+	ratio = target_gain/(p_gainramp->g0);
+	if(!(ratio > 0.0f)) return;
+
+	log_ratio = logf(ratio);
+	if(fabsf(log_ratio) < 1.0e-4f) return; /*Practically linear, avoid (ratio - 1) cancellation.*/
+
+	p_shape = p_gainramp->p_expshape;
+
+	for(n_frame = 0u; n_frame < this->BUFFER_SEGMENT_SIZE_FRAMES; n_frame++)
+	{
+		f_shape = expm1f(log_ratio*((FLOAT) (n_frame + 1u))/((FLOAT) this->BUFFER_SEGMENT_SIZE_FRAMES))/(ratio - 1.0f);
+
+		for(n_channel = 0u; n_channel < this->N_CHANNELS; n_channel++) *p_shape++ = f_shape;
+	}
+
+	p_gainramp->p_shape = p_gainramp->p_expshape;
+	return;
+}
+
+VOID WINAPI AudioDelay::tapstate_update(audiodelay_tapstate_t *p_tapstate, const audiodelay_fx_params_t *p_fx_params, ULONG_PTR delay_min)
+{
+	ULONG_PTR target_delay = 0u;
+	UINT32 target_delay_frac = 0u;
+	BOOL was_silent = FALSE;
+
+	was_silent = (p_tapstate->gainramp.curr == 0.0f);
+
+	this->gainramp_update(&(p_tapstate->gainramp), p_fx_params->amp);
+
+	target_delay = (ULONG_PTR) p_fx_params->delay;
+	target_delay_frac = p_fx_params->delay_frac;
+
+	if(target_delay_frac)
+	{
+		/*Interpolation points ahead of the delayed position must not reach the frame being computed.*/
+		if(target_delay < (delay_min + this->INTERP_LOOKAHEAD))
+		{
+			target_delay = delay_min + this->INTERP_LOOKAHEAD;
+			target_delay_frac = 0u;
+		}
+	}
+	else if(target_delay < delay_min) target_delay = delay_min;
+
+	/*
+		Taps that were silent (inactive) and the first segment just jump to the new position.
+		A tap coming back from silence ramps up from 0.0, so it has nothing to crossfade from.
+	*/
+
+	if(this->params_snap || (!this->XFADE_SIZE_FRAMES) || was_silent)
+	{
+		p_tapstate->delay = target_delay;
+		p_tapstate->delay_frac = target_delay_frac;
+		p_tapstate->xfade_nframe = this->XFADE_SIZE_FRAMES;
+		return;
+	}
+
+	if((target_delay == p_tapstate->delay) && (target_delay_frac == p_tapstate->delay_frac)) return;
+	if(p_tapstate->xfade_nframe < this->XFADE_SIZE_FRAMES) return; /*Crossfade in progress. The new delay time is taken once it is complete.*/
+
+	p_tapstate->delay_prev = p_tapstate->delay;
+	p_tapstate->delay_prev_frac = p_tapstate->delay_frac;
+	p_tapstate->delay = target_delay;
+	p_tapstate->delay_frac = target_delay_frac;
+	p_tapstate->xfade_nframe = 0u;
+
+	return;
+}
+
+ULONG_PTR WINAPI AudioDelay::tapstate_get_read_delay_min(const audiodelay_tapstate_t *p_tapstate)
+{
+	ULONG_PTR n_delay = 0u;
+	ULONG_PTR n_delay_prev = 0u;
+	DOUBLE delay_lo = 0.0;
+
+	/*
+		Modulated taps: shortest modulated delay time, less the interpolation lookahead, less one frame for rounding.
+		Never shorter than mod_delay_lo allows (delayline_read_mod() enforces it).
+	*/
+
+	if(p_tapstate->mod_depth > 0.0f)
+	{
+		delay_lo = ((DOUBLE) p_tapstate->delay) + ((DOUBLE) p_tapstate->delay_frac)/4294967296.0;
+
+		if(p_tapstate->xfade_nframe < this->XFADE_SIZE_FRAMES)
+		{
+			if((((DOUBLE) p_tapstate->delay_prev) + ((DOUBLE) p_tapstate->delay_prev_frac)/4294967296.0) < delay_lo)
+				delay_lo = ((DOUBLE) p_tapstate->delay_prev) + ((DOUBLE) p_tapstate->delay_prev_frac)/4294967296.0;
+		}
+
+		delay_lo -= ((DOUBLE) p_tapstate->mod_depth) + ((DOUBLE) this->INTERP_LOOKAHEAD) + 1.0;
+
+		n_delay = p_tapstate->mod_delay_lo - this->INTERP_LOOKAHEAD;
+		if(delay_lo > ((DOUBLE) n_delay)) n_delay = (ULONG_PTR) delay_lo;
+
+		return n_delay;
+	}
+
+	n_delay = p_tapstate->delay;
+	if(p_tapstate->delay_frac) n_delay -= this->INTERP_LOOKAHEAD;
+
+	if(p_tapstate->xfade_nframe >= this->XFADE_SIZE_FRAMES) return n_delay;
+
+	n_delay_prev = p_tapstate->delay_prev;
+	if(p_tapstate->delay_prev_frac) n_delay_prev -= this->INTERP_LOOKAHEAD;
+
+	if(n_delay_prev < n_delay) return n_delay_prev;
+
+	return n_delay;
+}
+
+VOID WINAPI AudioDelay::tapstate_modulate(audiodelay_tapstate_t *p_tapstate, const audiodelay_fx_params_t *p_fx_params, ULONG_PTR delay_min)
+{
+	DOUBLE delay_lo = 0.0;
+	DOUBLE delay_hi = 0.0;
+	DOUBLE delay_prev = 0.0;
+	FLOAT depth = 0.0f;
+
+	p_tapstate->mod_depth = 0.0f;
+
+	if(p_fx_params->mod_shape == this->MOD_NONE) return;
+
+	p_tapstate->mod_delay_lo = delay_min + this->INTERP_LOOKAHEAD;
+	p_tapstate->mod_delay_hi = this->BUFFER_SIZE_FRAMES - 3u;
+
+	/*Depth limits: the modulated delay time must stay within the tap limits for both positions (while crossfading).*/
+
+	delay_lo = ((DOUBLE) p_tapstate->delay) + ((DOUBLE) p_tapstate->delay_frac)/4294967296.0;
+	delay_hi = delay_lo;
+
+	if(p_tapstate->xfade_nframe < this->XFADE_SIZE_FRAMES)
+	{
+		delay_prev = ((DOUBLE) p_tapstate->delay_prev) + ((DOUBLE) p_tapstate->delay_prev_frac)/4294967296.0;
+
+		if(delay_prev < delay_lo) delay_lo = delay_prev;
+		if(delay_prev > delay_hi) delay_hi = delay_prev;
+	}
+
+	delay_lo -= (DOUBLE) p_tapstate->mod_delay_lo;
+	delay_hi = ((DOUBLE) p_tapstate->mod_delay_hi) - delay_hi;
+
+	depth = p_fx_params->mod_depth;
+	if(((DOUBLE) depth) > delay_lo) depth = (FLOAT) delay_lo;
+	if(((DOUBLE) depth) > delay_hi) depth = (FLOAT) delay_hi;
+
+	if(depth > 0.0f)
+	{
+		p_tapstate->mod_depth = depth;
+
+		if(p_fx_params->mod_shape == this->MOD_TRIANGLE) this->p_kernel->lfo_triangle(p_tapstate->p_mod_offset, (FLOAT) p_tapstate->mod_phase, p_fx_params->mod_rate, depth, this->BUFFER_SEGMENT_SIZE_FRAMES);
+		else this->p_kernel->lfo_sine(p_tapstate->p_mod_offset, (FLOAT) p_tapstate->mod_phase, p_fx_params->mod_rate, depth, this->BUFFER_SEGMENT_SIZE_FRAMES);
+	}
+
+	/*The phase is kept in double precision, and wrapped to [0.0, 1.0) every segment.*/
+
+	p_tapstate->mod_phase += ((DOUBLE) p_fx_params->mod_rate)*((DOUBLE) this->BUFFER_SEGMENT_SIZE_FRAMES);
+	p_tapstate->mod_phase -= floor(p_tapstate->mod_phase);
+
+	return;
+}
+
+VOID WINAPI AudioDelay::gain_scale(FLOAT *p_dst, const FLOAT *p_src, const audiodelay_gainramp_t *p_gainramp, ULONG_PTR seg_nsample, ULONG_PTR n_samples)
+{
+	if(p_gainramp->p_shape == NULL) this->p_kernel->scale(p_dst, p_src, p_gainramp->g0, n_samples);
+	else this->p_kernel->scale_ramp(p_dst, p_src, p_gainramp->g0, p_gainramp->dg, &(p_gainramp->p_shape[seg_nsample]), n_samples);
+
+	return;
+}
+
+VOID WINAPI AudioDelay::gain_mac(FLOAT *p_dst, const FLOAT *p_src, const audiodelay_gainramp_t *p_gainramp, ULONG_PTR seg_nsample, ULONG_PTR n_samples)
+{
+	if(p_gainramp->p_shape == NULL) this->p_kernel->mac(p_dst, p_src, p_gainramp->g0, n_samples);
+	else this->p_kernel->mac_ramp(p_dst, p_src, p_gainramp->g0, p_gainramp->dg, &(p_gainramp->p_shape[seg_nsample]), n_samples);
+
+	return;
+}
+
+VOID WINAPI AudioDelay::delaytap_accumulate(FLOAT *p_accum, const FLOAT *p_buffer, ULONG_PTR n_segment, ULONG_PTR seg_nframe, ULONG_PTR n_frames, audiodelay_tapstate_t *p_tapstate)
+{
+	ULONG_PTR prev_buf_nframe = 0u;
+	ULONG_PTR span_size_frames = 0u;
+
+	/*Crossfading frames first, if any.*/
+
+	if(p_tapstate->xfade_nframe < this->XFADE_SIZE_FRAMES)
+	{
+		span_size_frames = this->XFADE_SIZE_FRAMES - p_tapstate->xfade_nframe;
+		if(span_size_frames > n_frames) span_size_frames = n_frames;
+
+		this->delaytap_xfade(p_accum, p_buffer, n_segment, seg_nframe, span_size_frames, p_tapstate);
+		p_tapstate->xfade_nframe += span_size_frames;
+
+		if(span_size_frames == n_frames) return;
+
+		p_accum = &(p_accum[span_size_frames*(this->N_CHANNELS)]);
+		seg_nframe += span_size_frames;
+		n_frames -= span_size_frames;
+	}
+
+	if(p_tapstate->mod_depth > 0.0f)
+	{
+		(this->*(this->pf_delayline_read_mod))(this->p_buffertap, p_buffer, n_segment, seg_nframe, n_frames, p_tapstate->delay, p_tapstate->delay_frac, p_tapstate);
+		this->gain_mac(p_accum, this->p_buffertap, &(p_tapstate->gainramp), seg_nframe*(this->N_CHANNELS), n_frames*(this->N_CHANNELS));
+		return;
+	}
+
+	if(p_tapstate->delay_frac)
+	{
+		this->delayline_read(this->p_buffertap, p_buffer, n_segment, seg_nframe, n_frames, p_tapstate->delay, p_tapstate->delay_frac);
+		this->gain_mac(p_accum, this->p_buffertap, &(p_tapstate->gainramp), seg_nframe*(this->N_CHANNELS), n_frames*(this->N_CHANNELS));
+		return;
+	}
+
+	this->retrieve_prev_nframe(n_segment, seg_nframe, p_tapstate->delay, &prev_buf_nframe, NULL, NULL);
+
+	/*First span: from the delayed frame up to n_frames or the end of the ring buffer, whichever comes first.*/
+
+	span_size_frames = this->BUFFER_SIZE_FRAMES - prev_buf_nframe;
+	if(span_size_frames > n_frames) span_size_frames = n_frames;
+
+	this->gain_mac(p_accum, &(p_buffer[prev_buf_nframe*(this->N_CHANNELS)]), &(p_tapstate->gainramp), seg_nframe*(this->N_CHANNELS), span_size_frames*(this->N_CHANNELS));
+
+	/*Second span: remainder, wrapped around to the beginning of the ring buffer.*/
+
+	if(span_size_frames == n_frames) return;
+
+	this->gain_mac(&(p_accum[span_size_frames*(this->N_CHANNELS)]), p_buffer, &(p_tapstate->gainramp), (seg_nframe + span_size_frames)*(this->N_CHANNELS), (n_frames - span_size_frames)*(this->N_CHANNELS));
+
+	return;
+}
+
+BOOL WINAPI AudioDelay::tapgroup_add(const audiodelay_tapstate_t *p_tapstate, ULONG_PTR n_segment, ULONG_PTR seg_nframe)
+{
+	ULONG_PTR n_tap = 0u;
+
+	if(p_tapstate->gainramp.p_shape != NULL) return FALSE;
+	if(p_tapstate->delay_frac) return FALSE;
+	if(p_tapstate->xfade_nframe < this->XFADE_SIZE_FRAMES) return FALSE;
+	if(p_tapstate->mod_depth > 0.0f) return FALSE;
+
+	n_tap = this->tapgroup_n_taps;
+
+	this->retrieve_prev_nframe(n_segment, seg_nframe, p_tapstate->delay, &(this->p_tapgroup_buf_nframe[n_tap]), NULL, NULL);
+	this->p_tapgroup_amp[n_tap] = p_tapstate->gainramp.g0;
+
+	this->tapgroup_n_taps++;
+	return TRUE;
+}
+
+VOID WINAPI AudioDelay::tapgroup_flush(FLOAT *p_accum, const FLOAT *p_buffer, ULONG_PTR n_frames)
+{
+	const ULONG_PTR _BUFFER_SIZE_BITMASK = (this->BUFFER_SIZE_FRAMES - 1u);
+	ULONG_PTR n_taps = 0u;
+	ULONG_PTR n_tap = 0u;
+	ULONG_PTR span_size_frames = 0u;
+
+	n_taps = this->tapgroup_n_taps;
+	if(!n_taps) return;
+
+	this->tapgroup_n_taps = 0u;
+
+	while(n_frames)
+	{
+		span_size_frames = n_frames;
+
+		for(n_tap = 0u; n_tap < n_taps; n_tap++)
+		{
+			if(span_size_frames > (this->BUFFER_SIZE_FRAMES - this->p_tapgroup_buf_nframe[n_tap])) span_size_frames = this->BUFFER_SIZE_FRAMES - this->p_tapgroup_buf_nframe[n_tap];
+			this->pp_tapgroup_src[n_tap] = &(p_buffer[(this->p_tapgroup_buf_nframe[n_tap])*(this->N_CHANNELS)]);
+		}
+
+		if(n_taps <= DSPKERNEL_MAC_TAPS_MAX) this->p_kernel->mac_taps[n_taps](p_accum, this->pp_tapgroup_src, this->p_tapgroup_amp, n_taps, span_size_frames*(this->N_CHANNELS));
+		else this->p_kernel->mac_taps[0](p_accum, this->pp_tapgroup_src, this->p_tapgroup_amp, n_taps, span_size_frames*(this->N_CHANNELS));
+
+		for(n_tap = 0u; n_tap < n_taps; n_tap++) this->p_tapgroup_buf_nframe[n_tap] = ((this->p_tapgroup_buf_nframe[n_tap] + span_size_frames) & _BUFFER_SIZE_BITMASK);
+
+		p_accum = &(p_accum[span_size_frames*(this->N_CHANNELS)]);
+		n_frames -= span_size_frames;
+	}
+
+	return;
+}
+
+VOID WINAPI AudioDelay::delaytap_xfade(FLOAT *p_accum, const FLOAT *p_buffer, ULONG_PTR n_segment, ULONG_PTR seg_nframe, ULONG_PTR n_frames, const audiodelay_tapstate_t *p_tapstate)
+{
+	const ULONG_PTR _BUFFER_SIZE_BITMASK = (this->BUFFER_SIZE_FRAMES - 1u);
+	ULONG_PTR old_buf_nframe = 0u;
+	ULONG_PTR new_buf_nframe = 0u;
+	ULONG_PTR xfade_nframe = 0u;
+	ULONG_PTR span_size_frames = 0u;
+
+	const FLOAT *p_ramp = NULL;
+	FLOAT damp = 0.0f;
+
+	if((p_tapstate->mod_depth > 0.0f) || p_tapstate->delay_frac || p_tapstate->delay_prev_frac)
+	{
+		if(p_tapstate->mod_depth > 0.0f)
+		{
+			(this->*(this->pf_delayline_read_mod))(this->p_buffertap_prev, p_buffer, n_segment, seg_nframe, n_frames, p_tapstate->delay_prev, p_tapstate->delay_prev_frac, p_tapstate);
+			(this->*(this->pf_delayline_read_mod))(this->p_buffertap, p_buffer, n_segment, seg_nframe, n_frames, p_tapstate->delay, p_tapstate->delay_frac, p_tapstate);
+		}
+		else
+		{
+			this->delayline_read(this->p_buffertap_prev, p_buffer, n_segment, seg_nframe, n_frames, p_tapstate->delay_prev, p_tapstate->delay_prev_frac);
+			this->delayline_read(this->p_buffertap, p_buffer, n_segment, seg_nframe, n_frames, p_tapstate->delay, p_tapstate->delay_frac);
+		}
+
+		if(p_tapstate->gainramp.p_shape == NULL)
+		{
+			p_ramp = &(this->p_bufferxfade[(p_tapstate->xfade_nframe)*(this->N_CHANNELS)]);
+			damp = 0.0f;
+		}
+		else
+		{
+			p_ramp = &(p_tapstate->gainramp.p_shape[seg_nframe*(this->N_CHANNELS)]);
+			damp = p_tapstate->gainramp.dg;
+		}
+
+		this->p_kernel->mac_xfade(p_accum, this->p_buffertap_prev, this->p_buffertap, p_tapstate->gainramp.g0, damp, p_ramp, &(this->p_bufferxfade[(p_tapstate->xfade_nframe)*(this->N_CHANNELS)]), n_frames*(this->N_CHANNELS));
+		return;
+	}
+
+	this->retrieve_prev_nframe(n_segment, seg_nframe, p_tapstate->delay_prev, &old_buf_nframe, NULL, NULL);
+	this->retrieve_prev_nframe(n_segment, seg_nframe, p_tapstate->delay, &new_buf_nframe, NULL, NULL);
+
+	xfade_nframe = p_tapstate->xfade_nframe;
+
+	while(n_frames)
+	{
+		span_size_frames = n_frames;
+		if(span_size_frames > (this->BUFFER_SIZE_FRAMES - old_buf_nframe)) span_size_frames = this->BUFFER_SIZE_FRAMES - old_buf_nframe;
+		if(span_size_frames > (this->BUFFER_SIZE_FRAMES - new_buf_nframe)) span_size_frames = this->BUFFER_SIZE_FRAMES - new_buf_nframe;
+
+		/*Static gain: damp is 0.0, p_ramp only needs to be readable.*/
+
+		if(p_tapstate->gainramp.p_shape == NULL)
+		{
+			p_ramp = &(this->p_bufferxfade[xfade_nframe*(this->N_CHANNELS)]);
+			damp = 0.0f;
+		}
+		else
+		{
+			p_ramp = &(p_tapstate->gainramp.p_shape[seg_nframe*(this->N_CHANNELS)]);
+			damp = p_tapstate->gainramp.dg;
+		}
+
+		this->p_kernel->mac_xfade(p_accum, &(p_buffer[old_buf_nframe*(this->N_CHANNELS)]), &(p_buffer[new_buf_nframe*(this->N_CHANNELS)]), p_tapstate->gainramp.g0, damp, p_ramp, &(this->p_bufferxfade[xfade_nframe*(this->N_CHANNELS)]), span_size_frames*(this->N_CHANNELS));
+
+		p_accum = &(p_accum[span_size_frames*(this->N_CHANNELS)]);
+		seg_nframe += span_size_frames;
+		xfade_nframe += span_size_frames;
+		old_buf_nframe = ((old_buf_nframe + span_size_frames) & _BUFFER_SIZE_BITMASK);
+		new_buf_nframe = ((new_buf_nframe + span_size_frames) & _BUFFER_SIZE_BITMASK);
+		n_frames -= span_size_frames;
+	}
+
+	return;
+}
+
+VOID WINAPI AudioDelay::delayline_read(FLOAT *p_dst, const FLOAT *p_buffer, ULONG_PTR n_segment, ULONG_PTR seg_nframe, ULONG_PTR n_frames, ULONG_PTR n_delay, UINT32 delay_frac)
+{
+	const ULONG_PTR _BUFFER_SIZE_BITMASK = (this->BUFFER_SIZE_FRAMES - 1u);
+	const FLOAT *pp_src[4] = {NULL, NULL, NULL, NULL};
+	ULONG_PTR point_buf_nframe[4] = {0u, 0u, 0u, 0u};
+	ULONG_PTR n_points = 0u;
+	ULONG_PTR n_point = 0u;
+	ULONG_PTR span_size_frames = 0u;
+
+	FLOAT coef[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+	if(!delay_frac)
+	{
+		this->retrieve_prev_nframe(n_segment, seg_nframe, n_delay, &(point_buf_nframe[0]), NULL, NULL);
+
+		span_size_frames = this->BUFFER_SIZE_FRAMES - point_buf_nframe[0];
+		if(span_size_frames > n_frames) span_size_frames = n_frames;
+
+		CopyMemory(p_dst, &(p_buffer[point_buf_nframe[0]*(this->N_CHANNELS)]), span_size_frames*(this->N_CHANNELS)*sizeof(FLOAT));
+
+		if(span_size_frames < n_frames) CopyMemory(&(p_dst[span_size_frames*(this->N_CHANNELS)]), p_buffer, (n_frames - span_size_frames)*(this->N_CHANNELS)*sizeof(FLOAT));
+
+		return;
+	}
+
+	/*
+		The delayed position lies f frames before the frame at n_delay, between the frames at n_delay and (n_delay + 1).
+		The 4 point interpolators use the frames at (n_delay - 1), n_delay, (n_delay + 1) and (n_delay + 2).
+		The coefficients are constant across the range.
+	*/
+
+	n_points = this->interp_get_coef((FLOAT) (((DOUBLE) delay_frac)/4294967296.0), coef);
+	if(n_points == 4u) n_delay--;
+
+	/*Point n_point is delayed by (n_delay + n_point) frames.*/
+
+	this->retrieve_prev_nframe(n_segment, seg_nframe, n_delay, &(point_buf_nframe[0]), NULL, NULL);
+	for(n_point = 1u; n_point < n_points; n_point++) point_buf_nframe[n_point] = ((point_buf_nframe[0] - n_point) & _BUFFER_SIZE_BITMASK);
+
+	while(n_frames)
+	{
+		span_size_frames = n_frames;
+
+		for(n_point = 0u; n_point < n_points; n_point++)
+		{
+			if(span_size_frames > (this->BUFFER_SIZE_FRAMES - point_buf_nframe[n_point])) span_size_frames = this->BUFFER_SIZE_FRAMES - point_buf_nframe[n_point];
+			pp_src[n_point] = &(p_buffer[point_buf_nframe[n_point]*(this->N_CHANNELS)]);
+		}
+
+		if(n_points == 4u) this->p_kernel->interp4(p_dst, pp_src, coef, span_size_frames*(this->N_CHANNELS));
+		else this->p_kernel->interp2(p_dst, pp_src, coef, span_size_frames*(this->N_CHANNELS));
+
+		for(n_point = 0u; n_point < n_points; n_point++) point_buf_nframe[n_point] = ((point_buf_nframe[n_point] + span_size_frames) & _BUFFER_SIZE_BITMASK);
+
+		p_dst = &(p_dst[span_size_frames*(this->N_CHANNELS)]);
+		n_frames -= span_size_frames;
+	}
+
+	return;
+}
+
+template <ULONG_PTR N_CH> VOID WINAPI AudioDelay::delayline_read_mod(FLOAT *p_dst, const FLOAT *p_buffer, ULONG_PTR n_segment, ULONG_PTR seg_nframe, ULONG_PTR n_frames, ULONG_PTR n_delay, UINT32 delay_frac, const audiodelay_tapstate_t *p_tapstate)
+{
+	const ULONG_PTR _BUFFER_SIZE_BITMASK = (this->BUFFER_SIZE_FRAMES - 1u);
+	const ULONG_PTR _N_CHANNELS = (N_CH)? N_CH : this->N_CHANNELS;
+	const FLOAT *p_offset = NULL;
+	const FLOAT *pp_src[4] = {NULL, NULL, NULL, NULL};
+	ULONG_PTR curr_buf_nframe = 0u;
+	ULONG_PTR point_buf_nframe = 0u;
+	ULONG_PTR n_points = 0u;
+	ULONG_PTR n_frame = 0u;
+	ULONG_PTR n_channel = 0u;
+
+	FLOAT coef[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	FLOAT f_base = 0.0f;
+	FLOAT t_min = 0.0f;
+	FLOAT t_max = 0.0f;
+	FLOAT t = 0.0f;
+	FLOAT t_floor = 0.0f;
+
+	/*
+		Delay time of each frame: n_delay + t, with t = (delay_frac + offset) kept apart from the whole frames for precision.
+		t is clamped to the tap limits (mod_delay_lo, mod_delay_hi), in case rounding carries the LFO output past the clamped depth.
+	*/
+
+	p_offset = &(p_tapstate->p_mod_offset[seg_nframe]);
+
+	f_base = (FLOAT) (((DOUBLE) delay_frac)/4294967296.0);
+	t_min = (FLOAT) (((LONG_PTR) p_tapstate->mod_delay_lo) - ((LONG_PTR) n_delay));
+	t_max = (FLOAT) (((LONG_PTR) p_tapstate->mod_delay_hi) - ((LONG_PTR) n_delay));
+
+	curr_buf_nframe = n_segment*(this->BUFFER_SEGMENT_SIZE_FRAMES) + seg_nframe;
+
+	for(n_frame = 0u; n_frame < n_frames; n_frame++)
+	{
+		t = f_base + p_offset[n_frame];
+		if(t < t_min) t = t_min;
+		if(t > t_max) t = t_max;
+
+		t_floor = floorf(t);
+		n_points = this->interp_get_coef(t - t_floor, coef);
+
+		/*Frame at (n_delay + t_floor), minus one more frame for the 4 point interpolators.*/
+
+		point_buf_nframe = ((curr_buf_nframe + n_frame - (n_delay + ((ULONG_PTR) ((LONG_PTR) t_floor)))) & _BUFFER_SIZE_BITMASK);
+		if(n_points == 4u) point_buf_nframe = ((point_buf_nframe + 1u) & _BUFFER_SIZE_BITMASK);
+
+		pp_src[0] = &(p_buffer[point_buf_nframe*(_N_CHANNELS)]);
+		pp_src[1] = &(p_buffer[((point_buf_nframe - 1u) & _BUFFER_SIZE_BITMASK)*(_N_CHANNELS)]);
+
+		if(n_points == 4u)
+		{
+			pp_src[2] = &(p_buffer[((point_buf_nframe - 2u) & _BUFFER_SIZE_BITMASK)*(_N_CHANNELS)]);
+			pp_src[3] = &(p_buffer[((point_buf_nframe - 3u) & _BUFFER_SIZE_BITMASK)*(_N_CHANNELS)]);
+
+			for(n_channel = 0u; n_channel < _N_CHANNELS; n_channel++)
+				p_dst[n_channel] = coef[0]*(pp_src[0][n_channel]) + coef[1]*(pp_src[1][n_channel]) + coef[2]*(pp_src[2][n_channel]) + coef[3]*(pp_src[3][n_channel]);
+		}
+		else
+		{
+			for(n_channel = 0u; n_channel < _N_CHANNELS; n_channel++)
+				p_dst[n_channel] = coef[0]*(pp_src[0][n_channel]) + coef[1]*(pp_src[1][n_channel]);
+		}
+
+		p_dst = &(p_dst[_N_CHANNELS]);
+	}
+
+	return;
+}
+
+ULONG_PTR WINAPI AudioDelay::interp_get_coef(FLOAT f, FLOAT *p_coef)
+{
+	FLOAT f2 = 0.0f;
+	FLOAT f3 = 0.0f;
+
+	f2 = f*f;
+	f3 = f2*f;
+
+	switch(this->INTERP_MODE)
+	{
+		case this->INTERP_HERMITE:
+			p_coef[0] = -0.5f*f + f2 - 0.5f*f3;
+			p_coef[1] = 1.0f - 2.5f*f2 + 1.5f*f3;
+			p_coef[2] = 0.5f*f + 2.0f*f2 - 1.5f*f3;
+			p_coef[3] = -0.5f*f2 + 0.5f*f3;
+			return 4u;
+
+		case this->INTERP_LAGRANGE:
+			p_coef[0] = -f*(f - 1.0f)*(f - 2.0f)/6.0f;
+			p_coef[1] = (f + 1.0f)*(f - 1.0f)*(f - 2.0f)/2.0f;
+			p_coef[2] = -(f + 1.0f)*f*(f - 2.0f)/2.0f;
+			p_coef[3] = (f + 1.0f)*f*(f - 1.0f)/6.0f;
+			return 4u;
+	}
+
+	p_coef[0] = 1.0f - f;
+	p_coef[1] = f;
+	return 2u;
+}
+
+BOOL WINAPI AudioDelay::retrieve_prev_nframe(ULONG_PTR curr_buf_nframe, ULONG_PTR n_delay, ULONG_PTR *p_prev_buf_nframe, ULONG_PTR *p_prev_nseg, ULONG_PTR *p_prev_seg_nframe)
+{
+	const ULONG_PTR _BUFFER_SIZE_BITMASK = (this->BUFFER_SIZE_FRAMES - 1u);
+	ULONG_PTR prev_buf_nframe = 0u;
+	ULONG_PTR prev_nseg = 0u;
+	ULONG_PTR prev_seg_nframe = 0u;
+
+	if(curr_buf_nframe >= this->BUFFER_SIZE_FRAMES) return FALSE;
+	if(n_delay >= this->BUFFER_SIZE_FRAMES) return FALSE;
+
+	prev_buf_nframe = ((curr_buf_nframe - n_delay) & _BUFFER_SIZE_BITMASK); /*Safe to use as long as BUFFER_SIZE_FRAMES is a power of 2.*/
+
+	/*if(n_delay > curr_buf_nframe) prev_buf_nframe = this->BUFFER_SIZE_FRAMES - (n_delay - curr_buf_nframe);
+	else prev_buf_nframe = curr_buf_nframe - n_delay;*/
+
+	prev_nseg = prev_buf_nframe/(this->BUFFER_SEGMENT_SIZE_FRAMES);
+	prev_seg_nframe = prev_buf_nframe%(this->BUFFER_SEGMENT_SIZE_FRAMES);
+
+	if(p_prev_buf_nframe != NULL) *p_prev_buf_nframe = prev_buf_nframe;
+	if(p_prev_nseg != NULL) *p_prev_nseg = prev_nseg;
+	if(p_prev_seg_nframe != NULL) *p_prev_seg_nframe = prev_seg_nframe;
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioDelay::retrieve_prev_nframe(ULONG_PTR curr_nseg, ULONG_PTR curr_seg_nframe, ULONG_PTR n_delay, ULONG_PTR *p_prev_buf_nframe, ULONG_PTR *p_prev_nseg, ULONG_PTR *p_prev_seg_nframe)
+{
+	ULONG_PTR curr_buf_nframe = 0u;
+
+	if(curr_nseg >= this->BUFFER_N_SEGMENTS) return FALSE;
+	if(curr_seg_nframe >= this->BUFFER_SEGMENT_SIZE_FRAMES) return FALSE;
+
+	curr_buf_nframe = curr_nseg*(this->BUFFER_SEGMENT_SIZE_FRAMES) + curr_seg_nframe;
+
+	return this->retrieve_prev_nframe(curr_buf_nframe, n_delay, p_prev_buf_nframe, p_prev_nseg, p_prev_seg_nframe);
+}
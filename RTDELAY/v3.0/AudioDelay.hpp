@@ -1,162 +1,512 @@
-/*
-	Audio Delay 2 application for Windows
-	Version 3.0
-
-	Author: Rafael Sabe
-	Email: rafaelmsabe@gmail.com
-*/
-
-#ifndef AUDIODELAY_HPP
-#define AUDIODELAY_HPP
-
-#include "globldef.h"
-#include "strdef.hpp"
-#include "shared.hpp"
-
-struct _audiodelay_init_params {
-	ULONG_PTR buffer_size_frames;
-	ULONG_PTR buffer_n_segments;
-	ULONG_PTR n_channels;
-	ULONG_PTR n_ff_delays;
-	ULONG_PTR n_fb_delays;
-};
-
-struct _audiodelay_fx_params {
-	UINT32 delay;
-	FLOAT amp;
-};
-
-typedef struct _audiodelay_init_params audiodelay_init_params_t;
-typedef struct _audiodelay_fx_params audiodelay_fx_params_t;
-
-class AudioDelay {
-	public:
-		AudioDelay(const audiodelay_init_params_t *p_params);
-		~AudioDelay(VOID);
-
-		BOOL WINAPI setInitParameters(const audiodelay_init_params_t *p_params);
-		BOOL WINAPI initialize(VOID);
-		BOOL WINAPI runDSP(ULONG_PTR n_segment);
-
-		FLOAT* WINAPI getInputBuffer(VOID);
-		FLOAT* WINAPI getOutputBuffer(VOID);
-
-		FLOAT* WINAPI getInputBufferSegment(ULONG_PTR n_segment);
-		FLOAT* WINAPI getOutputBufferSegment(ULONG_PTR n_segment);
-
-		FLOAT WINAPI getDryInputAmplitude(VOID);
-		FLOAT WINAPI getOutputAmplitude(VOID);
-
-		BOOL WINAPI getFFParams(ULONG_PTR n_fx, audiodelay_fx_params_t *p_params);
-		BOOL WINAPI getFBParams(ULONG_PTR n_fx, audiodelay_fx_params_t *p_params);
-
-		BOOL WINAPI setDryInputAmplitude(FLOAT amp);
-		BOOL WINAPI setOutputAmplitude(FLOAT amp);
-
-		BOOL WINAPI setFFDelay(ULONG_PTR n_fx, ULONG_PTR delay);
-		BOOL WINAPI setFFAmplitude(ULONG_PTR n_fx, FLOAT amp);
-
-		BOOL WINAPI setFBDelay(ULONG_PTR n_fx, ULONG_PTR delay);
-		BOOL WINAPI setFBAmplitude(ULONG_PTR n_fx, FLOAT amp);
-
-		BOOL WINAPI resetFFParams(VOID);
-		BOOL WINAPI resetFBParams(VOID);
-
-		INT WINAPI getStatus(VOID);
-		__string WINAPI getLastErrorMessage(VOID);
-
-		enum Status {
-			STATUS_ERROR_INVALIDPARAMS = -3,
-			STATUS_ERROR_MEMORY = -2,
-			STATUS_ERROR_GENERIC = -1,
-			STATUS_UNINITIALIZED = 0,
-			STATUS_INITIALIZED = 1
-		};
-
-	private:
-		static constexpr ULONG_PTR BUFFER_SIZE_FRAMES_MIN = 128u; /*Probably not a good idea having a buffer smaller than this anyway*/
-		static constexpr ULONG_PTR BUFFER_N_SEGMENTS_MIN = 1u; /*Must have at least 1 segment*/
-		static constexpr ULONG_PTR N_CHANNELS_MIN = 1u;
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BUFFER_SIZE_FRAMES = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BUFFER_SIZE_SAMPLES = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BUFFER_SIZE_BYTES = 0u;
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BUFFER_N_SEGMENTS = 0u;
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BUFFER_SEGMENT_SIZE_FRAMES = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BUFFER_SEGMENT_SIZE_SAMPLES = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BUFFER_SEGMENT_SIZE_BYTES = 0u;
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR N_CHANNELS = 0u;
-
-		/*
-			..._PARAMS_LENGTH = size (in number of elements)
-			..._PARAMS_SIZE = size (in number of bytes)
-		*/
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR P_FF_PARAMS_LENGTH = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR P_FF_PARAMS_SIZE = 0u;
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR P_FB_PARAMS_LENGTH = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR P_FB_PARAMS_SIZE = 0u;
-
-		__declspec(align(PTR_SIZE_BYTES)) FLOAT *p_bufferinput = NULL;
-		__declspec(align(PTR_SIZE_BYTES)) FLOAT *p_bufferoutput = NULL;
-
-		__declspec(align(PTR_SIZE_BYTES)) audiodelay_fx_params_t *p_ff_params = NULL;
-		__declspec(align(PTR_SIZE_BYTES)) audiodelay_fx_params_t *p_fb_params = NULL;
-
-		__declspec(align(4)) FLOAT dryinput_amp = 0.0f;
-		__declspec(align(4)) FLOAT output_amp = 0.0f;
-
-		__declspec(align(PTR_SIZE_BYTES)) __string err_msg = TEXT("");
-		__declspec(align(4)) INT status = this->STATUS_UNINITIALIZED;
-
-		VOID WINAPI deinitialize(VOID);
-
-		BOOL WINAPI buffer_alloc(VOID);
-		BOOL WINAPI buffer_free(VOID);
-
-		BOOL WINAPI buffer_fxparams_alloc(VOID);
-		BOOL WINAPI buffer_fxparams_free(VOID);
-
-		/*
-			retrieve_prev_nframe(): calculate the previous (delayed) frame index from the current frame index and the delay time value (number of frames).
-
-			Naming:
-
-			..._nframe: frame index in context.
-
-			..._buf_nframe: frame index within the whole buffer.
-			..._seg_nframe: frame index within a specific buffer segment
-			..._nseg: buffer segment index in context.
-
-			curr_...: current index.
-			prev_...: previous (delayed) index.
-
-			Inputs:
-
-			retrieve_prev_nframe(curr_buf_nframe, n_delay, ...):
-			curr_buf_nframe: the current buffer frame index.
-			n_delay: number of frames to be delayed.
-
-			retrieve_prev_nframe(curr_nseg, curr_seg_nframe, n_delay, ...):
-			curr_nseg & curr_seg_nframe: the current segment index and frame index within that segment.
-			n_delay: number of frames to be delayed.
-
-			Outputs:
-
-			p_prev_buf_nframe: pointer to variable that receives the delayed buffer frame index. Set to NULL if unused.
-			p_prev_nseg: pointer to variable that receives the delayed segment index. Set to NULL if unused.
-			p_prev_seg_nframe: pointer to variable that receives the delayed segment frame index. Set to NULL if unused.
-
-			returns TRUE if successful, FALSE otherwise.
-		*/
-
-		BOOL WINAPI retrieve_prev_nframe(ULONG_PTR curr_buf_nframe, ULONG_PTR n_delay, ULONG_PTR *p_prev_buf_nframe, ULONG_PTR *p_prev_nseg, ULONG_PTR *p_prev_seg_nframe);
-		BOOL WINAPI retrieve_prev_nframe(ULONG_PTR curr_nseg, ULONG_PTR curr_seg_nframe, ULONG_PTR n_delay, ULONG_PTR *p_prev_buf_nframe, ULONG_PTR *p_prev_nseg, ULONG_PTR *p_prev_seg_nframe);
-
-};
-
-#endif /*AUDIODELAY_HPP*/
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#ifndef AUDIODELAY_HPP
+#define AUDIODELAY_HPP
+
+#include "globldef.h"
+#include "strdef.hpp"
+#include "shared.hpp"
+
+#include "dspkernel.hpp"
+
+struct _audiodelay_init_params {
+	ULONG_PTR buffer_size_frames;
+	ULONG_PTR buffer_n_segments;
+	ULONG_PTR n_channels;
+	ULONG_PTR n_ff_delays;
+	ULONG_PTR n_fb_delays;
+	INT kernel_isa; /*DSPKERNEL_ISA_AUTO to pick the best kernels for the CPU, or a DSPKERNEL_ISA_... value to force a given level.*/
+	INT gain_ramp_mode; /*AudioDelay::GAINRAMP_LINEAR or AudioDelay::GAINRAMP_EXPONENTIAL*/
+	ULONG_PTR xfade_size_frames; /*Delay time changes crossfade from the old to the new tap position over this many frames. 0 for instant changes.*/
+	INT interp_mode; /*Fractional delay interpolation: AudioDelay::INTERP_LINEAR, AudioDelay::INTERP_HERMITE or AudioDelay::INTERP_LAGRANGE*/
+};
+
+struct _audiodelay_fx_params {
+	UINT32 delay;
+	FLOAT amp;
+	UINT32 delay_frac; /*Fractional part of the delay time, in 1/2^32 frame units (delay.delay_frac is a Q32.32 number). 0 for whole frame delays.*/
+	INT mod_shape; /*Delay time modulation LFO: AudioDelay::MOD_NONE, AudioDelay::MOD_SINE or AudioDelay::MOD_TRIANGLE*/
+	FLOAT mod_depth; /*Modulation depth (number of frames): the delay time swings between (delay - mod_depth) and (delay + mod_depth).*/
+	FLOAT mod_rate; /*Modulation rate (LFO cycles per frame).*/
+};
+
+typedef struct _audiodelay_init_params audiodelay_init_params_t;
+typedef struct _audiodelay_fx_params audiodelay_fx_params_t;
+
+/*
+	Parameter block: a complete snapshot of the effect parameters, as seen by runDSP().
+	The control side publishes a new block after every parameter change, and runDSP() picks up the newest one at the start of each segment.
+*/
+
+struct _audiodelay_paramblock {
+	FLOAT dryinput_amp;
+	FLOAT output_amp;
+	audiodelay_fx_params_t *p_ff_params;
+	audiodelay_fx_params_t *p_fb_params;
+};
+
+typedef struct _audiodelay_paramblock audiodelay_paramblock_t;
+
+/*
+	Gain ramp state (runDSP() side) for one gain: dry input, output or tap amplitude.
+	Within a segment the gain is (g0 + dg*p_shape[n]), or just g0 if p_shape is NULL (static gain).
+*/
+
+struct _audiodelay_gainramp {
+	FLOAT curr; /*Gain at the end of the last processed segment.*/
+	FLOAT g0;
+	FLOAT dg;
+	const FLOAT *p_shape;
+	FLOAT *p_expshape; /*Exponential ramp shape buffer for this gain (GAINRAMP_EXPONENTIAL only).*/
+};
+
+typedef struct _audiodelay_gainramp audiodelay_gainramp_t;
+
+/*
+	Delay tap state (runDSP() side).
+	When the delay time changes, the tap keeps reading from delay_prev and crossfades into delay over XFADE_SIZE_FRAMES frames.
+	Taps coming back from silence jump straight to their new delay time.
+	A new delay time change is only taken once the crossfade in progress is complete.
+*/
+
+struct _audiodelay_tapstate {
+	audiodelay_gainramp_t gainramp;
+	ULONG_PTR delay; /*Delay time in use (number of frames).*/
+	ULONG_PTR delay_prev; /*Delay time being faded out.*/
+	UINT32 delay_frac; /*Fractional part of delay.*/
+	UINT32 delay_prev_frac; /*Fractional part of delay_prev.*/
+	ULONG_PTR xfade_nframe; /*Crossfade progress (number of frames). Equal to XFADE_SIZE_FRAMES when no crossfade is in progress.*/
+	BOOL isshort; /*(Feedback taps only) TRUE if the tap reads from within the segment being processed, see rundsp_shortfb().*/
+	FLOAT mod_depth; /*Modulation depth in use for the current segment, after clamping. 0.0 if the tap is not modulated.*/
+	DOUBLE mod_phase; /*LFO phase (cycles) at the start of the current segment.*/
+	ULONG_PTR mod_delay_lo; /*Modulated delay time limits (number of frames).*/
+	ULONG_PTR mod_delay_hi;
+	FLOAT *p_mod_offset; /*LFO output for the current segment: delay time offset for every frame.*/
+};
+
+typedef struct _audiodelay_tapstate audiodelay_tapstate_t;
+
+class AudioDelay {
+	public:
+		AudioDelay(const audiodelay_init_params_t *p_params);
+		~AudioDelay(VOID);
+
+		BOOL WINAPI setInitParameters(const audiodelay_init_params_t *p_params);
+		BOOL WINAPI initialize(VOID);
+		BOOL WINAPI runDSP(ULONG_PTR n_segment);
+
+		FLOAT* WINAPI getInputBuffer(VOID);
+		FLOAT* WINAPI getOutputBuffer(VOID);
+
+		FLOAT* WINAPI getInputBufferSegment(ULONG_PTR n_segment);
+		FLOAT* WINAPI getOutputBufferSegment(ULONG_PTR n_segment);
+
+		FLOAT WINAPI getDryInputAmplitude(VOID);
+		FLOAT WINAPI getOutputAmplitude(VOID);
+
+		BOOL WINAPI getFFParams(ULONG_PTR n_fx, audiodelay_fx_params_t *p_params);
+		BOOL WINAPI getFBParams(ULONG_PTR n_fx, audiodelay_fx_params_t *p_params);
+
+		BOOL WINAPI setDryInputAmplitude(FLOAT amp);
+		BOOL WINAPI setOutputAmplitude(FLOAT amp);
+
+		BOOL WINAPI setFFDelay(ULONG_PTR n_fx, ULONG_PTR delay);
+		BOOL WINAPI setFFAmplitude(ULONG_PTR n_fx, FLOAT amp);
+
+		BOOL WINAPI setFBDelay(ULONG_PTR n_fx, ULONG_PTR delay);
+		BOOL WINAPI setFBAmplitude(ULONG_PTR n_fx, FLOAT amp);
+
+		/*
+			Fractional delay times (number of frames, not necessarily whole).
+			Fractional taps read 2 (INTERP_LINEAR) or 4 (INTERP_HERMITE, INTERP_LAGRANGE) frames around the delayed position.
+			Whole frame delays set through these are the same as setFFDelay()/setFBDelay().
+		*/
+
+		BOOL WINAPI setFFDelayFractional(ULONG_PTR n_fx, DOUBLE delay);
+		BOOL WINAPI setFBDelayFractional(ULONG_PTR n_fx, DOUBLE delay);
+
+		/*
+			Delay time modulation (chorus/flanger/vibrato): the delay time follows an LFO, evaluated by runDSP() one segment at a time.
+			shape: MOD_NONE, MOD_SINE or MOD_TRIANGLE
+			depth: LFO amplitude (number of frames). It is reduced as needed to keep the modulated delay time within the tap limits.
+			rate: LFO frequency (cycles per frame, up to 0.5).
+			Modulated taps are always interpolated (see Interp).
+		*/
+
+		BOOL WINAPI setFFModulation(ULONG_PTR n_fx, INT shape, FLOAT depth, FLOAT rate);
+		BOOL WINAPI setFBModulation(ULONG_PTR n_fx, INT shape, FLOAT depth, FLOAT rate);
+
+		BOOL WINAPI resetFFParams(VOID);
+		BOOL WINAPI resetFBParams(VOID);
+
+		/*
+			reset()
+			Puts the effect back to its state right after initialize(): silent delay lines and all parameters set to 0.
+			The first segment processed afterwards applies the new parameters without ramping or crossfading.
+			Nothing is reallocated, so the same object can process one stream after another at no allocation cost.
+			Must not be called while runDSP() is running.
+		*/
+
+		BOOL WINAPI reset(VOID);
+
+		/*
+			Parameter changes are published to the audio thread as a complete snapshot.
+			By default every set...()/reset...() call publishes its own snapshot.
+			Calls made between beginParamsUpdate() and commitParamsUpdate() are published together, as a single snapshot, on commit.
+			Every beginParamsUpdate() must be matched by a commitParamsUpdate() from the same thread.
+		*/
+
+		BOOL WINAPI beginParamsUpdate(VOID);
+		BOOL WINAPI commitParamsUpdate(VOID);
+
+		/*Returns the ISA level (DSPKERNEL_ISA_...) of the kernels in use, or -1 if not initialized.*/
+		INT WINAPI getKernelISA(VOID);
+
+		INT WINAPI getStatus(VOID);
+		__string WINAPI getLastErrorMessage(VOID);
+
+		/*
+			Gain ramp modes. Gain changes are ramped across one buffer segment.
+			GAINRAMP_EXPONENTIAL falls back to a linear ramp when the ramp crosses or touches 0.0.
+		*/
+
+		enum GainRamp {
+			GAINRAMP_LINEAR = 0,
+			GAINRAMP_EXPONENTIAL = 1
+		};
+
+		/*
+			Fractional delay interpolation modes.
+			INTERP_HERMITE is a 4 point cubic Hermite (Catmull-Rom) interpolator, INTERP_LAGRANGE is a 4 point (3rd order) Lagrange interpolator.
+			The 4 point modes read one frame ahead of the delayed position, so fractional feedforward taps are at least 1 frame long
+			and fractional feedback taps at least 2 frames long. Shorter fractional delays are raised to that.
+		*/
+
+		enum Interp {
+			INTERP_LINEAR = 0,
+			INTERP_HERMITE = 1,
+			INTERP_LAGRANGE = 2
+		};
+
+		enum Modulation {
+			MOD_NONE = 0,
+			MOD_SINE = 1,
+			MOD_TRIANGLE = 2
+		};
+
+		enum Status {
+			STATUS_ERROR_INVALIDPARAMS = -3,
+			STATUS_ERROR_MEMORY = -2,
+			STATUS_ERROR_GENERIC = -1,
+			STATUS_UNINITIALIZED = 0,
+			STATUS_INITIALIZED = 1
+		};
+
+	private:
+		static constexpr ULONG_PTR BUFFER_SIZE_FRAMES_MIN = 128u; /*Probably not a good idea having a buffer smaller than this anyway*/
+		static constexpr ULONG_PTR BUFFER_N_SEGMENTS_MIN = 1u; /*Must have at least 1 segment*/
+		static constexpr ULONG_PTR N_CHANNELS_MIN = 1u;
+
+		static constexpr ULONG_PTR N_PARAMBLOCKS = 3u;
+		static constexpr LONG PARAMBLOCK_INDEX_MASK = 0x3;
+		static constexpr LONG PARAMBLOCK_NEW = 0x4;
+		static constexpr ULONG_PTR FB_SHORT_DELAY_MIN = 1u; /*A 0 frame feedback delay would read the frame being computed. It is processed as 1 frame.*/
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BUFFER_SIZE_FRAMES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BUFFER_SIZE_SAMPLES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BUFFER_SIZE_BYTES = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BUFFER_N_SEGMENTS = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BUFFER_SEGMENT_SIZE_FRAMES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BUFFER_SEGMENT_SIZE_SAMPLES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BUFFER_SEGMENT_SIZE_BYTES = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR N_CHANNELS = 0u;
+
+		/*
+			..._PARAMS_LENGTH = size (in number of elements)
+			..._PARAMS_SIZE = size (in number of bytes)
+		*/
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR P_FF_PARAMS_LENGTH = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR P_FF_PARAMS_SIZE = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR P_FB_PARAMS_LENGTH = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR P_FB_PARAMS_SIZE = 0u;
+
+		__declspec(align(4)) INT KERNEL_ISA_REQUESTED = DSPKERNEL_ISA_AUTO;
+		__declspec(align(4)) INT GAIN_RAMP_MODE = this->GAINRAMP_LINEAR;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR XFADE_SIZE_FRAMES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR XFADE_SIZE_SAMPLES = 0u;
+
+		__declspec(align(4)) INT INTERP_MODE = this->INTERP_LINEAR;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR INTERP_LOOKAHEAD = 0u; /*Number of frames fractional taps read ahead of their delayed position.*/
+
+		__declspec(align(PTR_SIZE_BYTES)) const dspkernel_table_t *p_kernel = NULL;
+
+		__declspec(align(PTR_SIZE_BYTES)) FLOAT *p_bufferinput = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) FLOAT *p_bufferoutput = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) FLOAT *p_bufferaccum = NULL; /*Block engine accumulator, one segment long.*/
+		__declspec(align(PTR_SIZE_BYTES)) FLOAT *p_bufferramp = NULL; /*Linear ramp shape, one segment long: (n_frame + 1)/BUFFER_SEGMENT_SIZE_FRAMES for every sample.*/
+		__declspec(align(PTR_SIZE_BYTES)) FLOAT *p_bufferexpramp = NULL; /*Exponential ramp shapes, one segment per gain (GAINRAMP_EXPONENTIAL only).*/
+		__declspec(align(PTR_SIZE_BYTES)) FLOAT *p_buffertap = NULL; /*Fractional tap reads, one segment long.*/
+		__declspec(align(PTR_SIZE_BYTES)) FLOAT *p_buffertap_prev = NULL; /*Fractional tap reads (position being faded out), one segment long.*/
+		__declspec(align(PTR_SIZE_BYTES)) FLOAT *p_bufferxfade = NULL; /*Crossfade shape, XFADE_SIZE_FRAMES long: (n_frame + 1)/XFADE_SIZE_FRAMES for every sample.*/
+		__declspec(align(PTR_SIZE_BYTES)) FLOAT *p_buffermod = NULL; /*LFO outputs, one value per frame, one segment per tap.*/
+
+		/*
+			Tap group: plain taps (static gain, whole frame delay, no crossfade, no modulation) waiting to be accumulated together by the mac_taps kernels.
+			pp_tapgroup_src, p_tapgroup_amp and p_tapgroup_buf_nframe share a single allocation (p_tapgroup_buffer), sized for the largest tap count.
+		*/
+
+		__declspec(align(PTR_SIZE_BYTES)) VOID *p_tapgroup_buffer = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) const FLOAT **pp_tapgroup_src = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) FLOAT *p_tapgroup_amp = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR *p_tapgroup_buf_nframe = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR tapgroup_n_taps = 0u;
+
+		/*
+			delayline_read_mod() version for the current channel count, selected by initialize():
+			specialized for 1, 2, 6 and 8 channels, generic for any other channel count.
+		*/
+
+		__declspec(align(PTR_SIZE_BYTES)) VOID (WINAPI AudioDelay::*pf_delayline_read_mod)(FLOAT *p_dst, const FLOAT *p_buffer, ULONG_PTR n_segment, ULONG_PTR seg_nframe, ULONG_PTR n_frames, ULONG_PTR n_delay, UINT32 delay_frac, const audiodelay_tapstate_t *p_tapstate) = NULL;
+
+		/*
+			Gain ramp and delay tap states, only used by runDSP().
+			params_snap is set by initialize(): the first segment applies the initial parameters without ramping or crossfading.
+		*/
+
+		__declspec(align(PTR_SIZE_BYTES)) audiodelay_gainramp_t gainramp_dry;
+		__declspec(align(PTR_SIZE_BYTES)) audiodelay_gainramp_t gainramp_out;
+		__declspec(align(PTR_SIZE_BYTES)) audiodelay_tapstate_t *p_ff_tapstate = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) audiodelay_tapstate_t *p_fb_tapstate = NULL;
+		__declspec(align(4)) BOOL params_snap = TRUE;
+
+		/*
+			Active tap lists (runDSP() side): indexes of the taps that contribute to the output, in tap order.
+			A tap is active if its amplitude or its current gain (still ramping down) is not 0.0.
+			The lists are rebuilt by tapactive_update() only when a new parameter block is picked up or a tap has ramped down to silence.
+			p_fb_active shares the p_ff_active allocation.
+		*/
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR *p_ff_active = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR *p_fb_active = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR ff_active_n = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR fb_active_n = 0u;
+		__declspec(align(4)) BOOL tapactive_rebuild = TRUE;
+
+		__declspec(align(PTR_SIZE_BYTES)) audiodelay_fx_params_t *p_ff_params = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) audiodelay_fx_params_t *p_fb_params = NULL;
+
+		__declspec(align(4)) FLOAT dryinput_amp = 0.0f;
+		__declspec(align(4)) FLOAT output_amp = 0.0f;
+
+		/*
+			Triple buffered parameter blocks.
+			The members above (dryinput_amp, output_amp, p_ff_params, p_fb_params) are the control side copy.
+			paramblock_write: block owned by the control side (written by params_publish()).
+			paramblock_read: block owned by runDSP().
+			paramblock_shared: last published block, with PARAMBLOCK_NEW set if runDSP() has not picked it up yet.
+			The blocks are only ever exchanged with InterlockedExchange(), so runDSP() never waits for the control side.
+			params_lock only serializes control side writers.
+		*/
+
+		__declspec(align(PTR_SIZE_BYTES)) audiodelay_paramblock_t paramblock[N_PARAMBLOCKS];
+		__declspec(align(PTR_SIZE_BYTES)) VOID *p_paramblock_buffer = NULL;
+
+		__declspec(align(4)) LONG paramblock_write = 0;
+		__declspec(align(4)) volatile LONG paramblock_shared = 1;
+		__declspec(align(4)) LONG paramblock_read = 2;
+
+		__declspec(align(PTR_SIZE_BYTES)) CRITICAL_SECTION params_lock;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR params_update_depth = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) __string err_msg = TEXT("");
+		__declspec(align(4)) INT status = this->STATUS_UNINITIALIZED;
+
+		VOID WINAPI deinitialize(VOID);
+
+		BOOL WINAPI buffer_alloc(VOID);
+		BOOL WINAPI buffer_free(VOID);
+
+		BOOL WINAPI buffer_fxparams_alloc(VOID);
+		BOOL WINAPI buffer_fxparams_free(VOID);
+
+		/*
+			params_publish(): copy the control side parameters into the control side block and publish it. Must be called with params_lock held.
+			params_acquire(): (runDSP() only) swap in the newest published block, if any, and return the block to be used for the current segment.
+			A new block sets tapactive_rebuild.
+		*/
+
+		VOID WINAPI params_publish(VOID);
+		const audiodelay_paramblock_t* WINAPI params_acquire(VOID);
+
+		/*
+			tapactive_update(): (runDSP() only) rebuild the active tap lists for the given parameter block.
+		*/
+
+		VOID WINAPI tapactive_update(const audiodelay_paramblock_t *p_params);
+
+		/*
+			gainramp_update(): (runDSP() only) set up the gain ramp for the current segment, from the current gain to target_gain.
+			No ramp is set up (static gain) if the gain does not change.
+		*/
+
+		VOID WINAPI gainramp_update(audiodelay_gainramp_t *p_gainramp, FLOAT target_gain);
+
+		/*
+			tapstate_update(): (runDSP() only) update a delay tap state for the current segment: amplitude ramp and delay time crossfade.
+			delay_min: lowest delay time allowed for the tap.
+		*/
+
+		VOID WINAPI tapstate_update(audiodelay_tapstate_t *p_tapstate, const audiodelay_fx_params_t *p_fx_params, ULONG_PTR delay_min);
+
+		/*
+			tapstate_get_read_delay_min(): shortest delay time (number of frames) the tap reads from, including interpolation points and the position being faded out.
+		*/
+
+		ULONG_PTR WINAPI tapstate_get_read_delay_min(const audiodelay_tapstate_t *p_tapstate);
+
+		/*
+			tapstate_modulate(): (runDSP() only) run the tap LFO for the current segment, into p_mod_offset.
+			The depth is clamped so the modulated delay time (of both positions, while crossfading) stays between
+			(delay_min + INTERP_LOOKAHEAD) and (BUFFER_SIZE_FRAMES - 3).
+		*/
+
+		VOID WINAPI tapstate_modulate(audiodelay_tapstate_t *p_tapstate, const audiodelay_fx_params_t *p_fx_params, ULONG_PTR delay_min);
+
+		/*
+			gain_scale(): p_dst[n] = gain*p_src[n]
+			gain_mac(): p_dst[n] += gain*p_src[n]
+
+			seg_nsample: position of p_dst[0] within the segment (sample index), used to index the ramp shape.
+		*/
+
+		VOID WINAPI gain_scale(FLOAT *p_dst, const FLOAT *p_src, const audiodelay_gainramp_t *p_gainramp, ULONG_PTR seg_nsample, ULONG_PTR n_samples);
+		VOID WINAPI gain_mac(FLOAT *p_dst, const FLOAT *p_src, const audiodelay_gainramp_t *p_gainramp, ULONG_PTR seg_nsample, ULONG_PTR n_samples);
+
+		/*
+			rundsp_shortfb(): apply the short feedback taps and the output amplitude to the current segment.
+			Called by runDSP() after the block engine, when at least one active feedback tap is shorter than one buffer segment.
+
+			chunk_size_frames: shortest delay among the active short feedback taps.
+		*/
+
+		VOID WINAPI rundsp_shortfb(ULONG_PTR n_segment, ULONG_PTR chunk_size_frames);
+
+		/*
+			delaytap_accumulate(): accumulate one delay tap across a range of frames within a buffer segment.
+
+			p_accum: accumulator for the first frame of the range.
+			p_buffer: ring buffer the tap reads from (p_bufferinput for feedforward, p_bufferoutput for feedback).
+			n_segment: index of the segment being processed.
+			seg_nframe: first frame of the range within the segment.
+			n_frames: number of frames in the range.
+			p_tapstate: tap state (delay time and amplitude). Crossfade progress is updated.
+
+			The delayed range is read as one contiguous span, or two spans if it wraps around the end of the ring buffer.
+			Fractional delays are read into p_buffertap first (see delayline_read()).
+			Frames within a crossfade are handed to delaytap_xfade().
+		*/
+
+		VOID WINAPI delaytap_accumulate(FLOAT *p_accum, const FLOAT *p_buffer, ULONG_PTR n_segment, ULONG_PTR seg_nframe, ULONG_PTR n_frames, audiodelay_tapstate_t *p_tapstate);
+
+		/*
+			tapgroup_add(): add a tap to the tap group if it is a plain tap. returns TRUE if added, FALSE otherwise.
+			n_segment, seg_nframe: first frame of the range the group will be accumulated across.
+
+			tapgroup_flush(): accumulate the tap group across a range of frames (same parameters as delaytap_accumulate()), then empty it.
+			The range is split into spans wherever any tap wraps around the end of the ring buffer.
+
+			Taps are accumulated in the same order either way: a group must be flushed before accumulating any tap that was not added to it.
+		*/
+
+		BOOL WINAPI tapgroup_add(const audiodelay_tapstate_t *p_tapstate, ULONG_PTR n_segment, ULONG_PTR seg_nframe);
+		VOID WINAPI tapgroup_flush(FLOAT *p_accum, const FLOAT *p_buffer, ULONG_PTR n_frames);
+
+		/*
+			delaytap_xfade(): accumulate one delay tap across a range of frames that lies entirely within its crossfade.
+			Same parameters as delaytap_accumulate(). Does not update the crossfade progress.
+
+			Both tap positions are read together and blended by the mac_xfade kernel.
+			Fractional positions are first read into p_buffertap/p_buffertap_prev by delayline_read().
+			The range is split into spans wherever either position wraps around the end of the ring buffer.
+		*/
+
+		VOID WINAPI delaytap_xfade(FLOAT *p_accum, const FLOAT *p_buffer, ULONG_PTR n_segment, ULONG_PTR seg_nframe, ULONG_PTR n_frames, const audiodelay_tapstate_t *p_tapstate);
+
+		/*
+			delayline_read(): read (copy or interpolate) a delayed range of frames into p_dst, without any gain.
+
+			n_delay, delay_frac: delay time, whole frames and fractional part (1/2^32 frame units).
+			Other parameters same as delaytap_accumulate().
+
+			Whole frame delays are copied. Fractional delays are interpolated by the interp2/interp4 kernels,
+			with the range split into spans wherever any interpolation point wraps around the end of the ring buffer.
+		*/
+
+		VOID WINAPI delayline_read(FLOAT *p_dst, const FLOAT *p_buffer, ULONG_PTR n_segment, ULONG_PTR seg_nframe, ULONG_PTR n_frames, ULONG_PTR n_delay, UINT32 delay_frac);
+
+		/*
+			delayline_read_mod(): same as delayline_read(), for a modulated tap.
+			The delay time of each frame is offset by the tap LFO output (p_tapstate->p_mod_offset), so the interpolation coefficients are computed per frame.
+			N_CH: channel count (for fully unrolled channel loops), or 0 for the generic version (N_CHANNELS). Called through pf_delayline_read_mod.
+		*/
+
+		template <ULONG_PTR N_CH> VOID WINAPI delayline_read_mod(FLOAT *p_dst, const FLOAT *p_buffer, ULONG_PTR n_segment, ULONG_PTR seg_nframe, ULONG_PTR n_frames, ULONG_PTR n_delay, UINT32 delay_frac, const audiodelay_tapstate_t *p_tapstate);
+
+		/*
+			interp_get_coef(): interpolation coefficients (INTERP_MODE) for a position f frames (0.0 to 1.0) past a frame.
+			returns the number of points (2 or 4). With 4 points, p_coef[0] is for the frame one frame less delayed than that frame.
+		*/
+
+		ULONG_PTR WINAPI interp_get_coef(FLOAT f, FLOAT *p_coef);
+
+		/*
+			retrieve_prev_nframe(): calculate the previous (delayed) frame index from the current frame index and the delay time value (number of frames).
+
+			Naming:
+
+			..._nframe: frame index in context.
+
+			..._buf_nframe: frame index within the whole buffer.
+			..._seg_nframe: frame index within a specific buffer segment
+			..._nseg: buffer segment index in context.
+
+			curr_...: current index.
+			prev_...: previous (delayed) index.
+
+			Inputs:
+
+			retrieve_prev_nframe(curr_buf_nframe, n_delay, ...):
+			curr_buf_nframe: the current buffer frame index.
+			n_delay: number of frames to be delayed.
+
+			retrieve_prev_nframe(curr_nseg, curr_seg_nframe, n_delay, ...):
+			curr_nseg & curr_seg_nframe: the current segment index and frame index within that segment.
+			n_delay: number of frames to be delayed.
+
+			Outputs:
+
+			p_prev_buf_nframe: pointer to variable that receives the delayed buffer frame index. Set to NULL if unused.
+			p_prev_nseg: pointer to variable that receives the delayed segment index. Set to NULL if unused.
+			p_prev_seg_nframe: pointer to variable that receives the delayed segment frame index. Set to NULL if unused.
+
+			returns TRUE if successful, FALSE otherwise.
+		*/
+
+		BOOL WINAPI retrieve_prev_nframe(ULONG_PTR curr_buf_nframe, ULONG_PTR n_delay, ULONG_PTR *p_prev_buf_nframe, ULONG_PTR *p_prev_nseg, ULONG_PTR *p_prev_seg_nframe);
+		BOOL WINAPI retrieve_prev_nframe(ULONG_PTR curr_nseg, ULONG_PTR curr_seg_nframe, ULONG_PTR n_delay, ULONG_PTR *p_prev_buf_nframe, ULONG_PTR *p_prev_nseg, ULONG_PTR *p_prev_seg_nframe);
+
+};
+
+#endif /*AUDIODELAY_HPP*/
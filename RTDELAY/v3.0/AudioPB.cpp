@@ -1,1052 +1,1697 @@
-/*
-	Real-Time Audio Delay 2 application for Windows
-	Version 3.0
-
-	Author: Rafael Sabe
-	Email: rafaelmsabe@gmail.com
-*/
-
-#include "AudioPB.hpp"
-#include "cstrdef.h"
-
-#include <combaseapi.h>
-
-AudioPB::AudioPB(const audiopb_params_t *p_params)
-{
-	this->setParameters(p_params);
-}
-
-BOOL WINAPI AudioPB::setParameters(const audiopb_params_t *p_params)
-{
-	if(this->status > 0)
-	{
-		this->err_msg = TEXT("AudioPB::setParameters: Error: cannot set parameters, AudioPB object already initialized.");
-		return FALSE;
-	}
-
-	if(p_params == NULL)
-	{
-		this->err_msg = TEXT("AudioPB::setParameters: Error: given params object is invalid.");
-		return FALSE;
-	}
-
-	if(p_params->file_dir == NULL)
-	{
-		this->err_msg = TEXT("AudioPB::setParameters: Error: given parameter file_dir is invalid.");
-		return FALSE;
-	}
-
-	this->status = this->STATUS_UNINITIALIZED;
-
-	this->AUDIO_DATA_BEGIN = p_params->audio_data_begin;
-	this->AUDIO_DATA_END = p_params->audio_data_end;
-	this->FILEIN_DIR = p_params->file_dir;
-	this->SAMPLE_RATE = p_params->sample_rate;
-	this->N_CHANNELS = p_params->n_channels;
-	this->AUDIOBUFFER_SIZE_FRAMES = _get_closest_power2_ceil(p_params->audiobuffer_size_frames);
-	this->STREAMBUFFER_SEGMENT_SIZE_FRAMES = _get_closest_power2_ceil(p_params->streambuffer_segment_size_frames);
-	this->STREAMBUFFER_N_SEGMENTS = _get_closest_power2_ceil(p_params->streambuffer_n_segments);
-	this->AUDIODELAY_BUFFER_SIZE_FRAMES = _get_closest_power2_ceil(p_params->delay_buffer_size_frames);
-	this->AUDIODELAY_FF_PARAMS_LENGTH = p_params->n_ff_delays;
-	this->AUDIODELAY_FB_PARAMS_LENGTH = p_params->n_fb_delays;
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioPB::initialize(VOID)
-{
-	audiodelay_init_params_t delay_params;
-
-	if(this->status > 0) return TRUE;
-
-	this->status = this->STATUS_UNINITIALIZED;
-
-	if(!this->SAMPLE_RATE)
-	{
-		this->status = this->STATUS_ERROR_INVALIDPARAMS;
-		this->err_msg = TEXT("AudioPB::initialize: Error: invalid sample rate.");
-		return FALSE;
-	}
-
-	if(this->N_CHANNELS < this->N_CHANNELS_MIN)
-	{
-		this->status = this->STATUS_ERROR_INVALIDPARAMS;
-		this->err_msg = TEXT("AudioPB::initialize: Error: invalid number of channels.");
-		return FALSE;
-	}
-
-	if(this->STREAMBUFFER_SEGMENT_SIZE_FRAMES < this->STREAMBUFFER_SEGMENT_SIZE_FRAMES_MIN)
-	{
-		this->status = this->STATUS_ERROR_INVALIDPARAMS;
-		this->err_msg = TEXT("AudioPB::initialize: Error: invalid stream buffer segment size.");
-		return FALSE;
-	}
-
-	if(this->STREAMBUFFER_N_SEGMENTS < this->STREAMBUFFER_N_SEGMENTS_MIN)
-	{
-		this->status = this->STATUS_ERROR_INVALIDPARAMS;
-		this->err_msg = TEXT("AudioPB::initialize: Error: invalid stream buffer segment count.");
-		return FALSE;
-	}
-
-	if(this->AUDIOBUFFER_SIZE_FRAMES < this->STREAMBUFFER_SEGMENT_SIZE_FRAMES)
-	{
-		this->status = this->STATUS_ERROR_INVALIDPARAMS;
-		this->err_msg = TEXT("AudioPB::initialize: Error: invalid audio buffer size. (audio buffer is smaller than stream buffer segment).");
-		return FALSE;
-	}
-
-	if(this->AUDIODELAY_BUFFER_SIZE_FRAMES < this->STREAMBUFFER_SEGMENT_SIZE_FRAMES)
-	{
-		this->status = this->STATUS_ERROR_INVALIDPARAMS;
-		this->err_msg = TEXT("AudioPB::initialize: Error: invalid delay buffer size. (delay buffer is smaller than stream buffer segment).");
-		return FALSE;
-	}
-
-	this->AUDIOBUFFER_SIZE_SAMPLES = (this->AUDIOBUFFER_SIZE_FRAMES)*(this->N_CHANNELS);
-	this->AUDIOBUFFER_SIZE_BYTES = (this->AUDIOBUFFER_SIZE_SAMPLES)*(this->AUDIO_BYTES_PER_SAMPLE);
-
-	this->STREAMBUFFER_SEGMENT_SIZE_SAMPLES = (this->STREAMBUFFER_SEGMENT_SIZE_FRAMES)*(this->N_CHANNELS);
-	this->STREAMBUFFER_SEGMENT_SIZE_BYTES = (this->STREAMBUFFER_SEGMENT_SIZE_SAMPLES)*(this->AUDIO_BYTES_PER_SAMPLE);
-
-	this->STREAMBUFFER_SIZE_FRAMES = (this->STREAMBUFFER_N_SEGMENTS)*(this->STREAMBUFFER_SEGMENT_SIZE_FRAMES);
-	this->STREAMBUFFER_SIZE_SAMPLES = (this->STREAMBUFFER_SIZE_FRAMES)*(this->N_CHANNELS);
-	this->STREAMBUFFER_SIZE_BYTES = (this->STREAMBUFFER_SIZE_SAMPLES)*(this->AUDIO_BYTES_PER_SAMPLE);
-
-	this->INPUTBUFFER_SIZE_BYTES = (this->STREAMBUFFER_SEGMENT_SIZE_SAMPLES)*(this->FILE_BYTES_PER_SAMPLE);
-
-	this->AUDIODELAY_BUFFER_N_SEGMENTS = (this->AUDIODELAY_BUFFER_SIZE_FRAMES)/(this->STREAMBUFFER_SEGMENT_SIZE_FRAMES);
-
-	if(!this->filein_open())
-	{
-		this->status = this->STATUS_ERROR_NOFILE;
-		this->err_msg = TEXT("AudioPB::initialize: Error: open input file failed.");
-		return FALSE;
-	}
-
-	if(!this->audiodevice_init())
-	{
-		this->status = this->STATUS_ERROR_AUDIOHW;
-		this->filein_close();
-		return FALSE;
-	}
-
-	if(!this->buffer_alloc())
-	{
-		this->status = this->STATUS_ERROR_MEMORY;
-		this->filein_close();
-		this->audiodevice_deinit();
-		return FALSE;
-	}
-
-	delay_params.buffer_size_frames = this->AUDIODELAY_BUFFER_SIZE_FRAMES;
-	delay_params.buffer_n_segments = this->AUDIODELAY_BUFFER_N_SEGMENTS;
-	delay_params.n_channels = this->N_CHANNELS;
-	delay_params.n_ff_delays = this->AUDIODELAY_FF_PARAMS_LENGTH;
-	delay_params.n_fb_delays = this->AUDIODELAY_FB_PARAMS_LENGTH;
-
-	if(this->p_delay == NULL)
-	{
-		this->p_delay = new AudioDelay(&delay_params);
-		if(this->p_delay == NULL)
-		{
-			this->status = this->STATUS_ERROR_MEMORY;
-			this->err_msg = TEXT("AudioPB::initialize: Error: AudioDelay object instance failed.");
-			this->filein_close();
-			this->audiodevice_deinit();
-			this->buffer_free();
-			return FALSE;
-		}
-	}
-	else this->p_delay->setInitParameters(&delay_params);
-
-	if(!this->p_delay->initialize())
-	{
-		this->status = this->STATUS_ERROR_GENERIC;
-		this->err_msg = this->p_delay->getLastErrorMessage();
-		this->filein_close();
-		this->audiodevice_deinit();
-		this->buffer_free();
-		return FALSE;
-	}
-
-	this->status = this->STATUS_READY;
-	return TRUE;
-}
-
-BOOL WINAPI AudioPB::runPlayback(VOID)
-{
-	if(this->status != this->STATUS_READY)
-	{
-		this->err_msg = TEXT("AudioPB::runPlayback: Error: AudioPB object is either not initialized or already running playback.");
-		return FALSE;
-	}
-
-	this->playback_proc();
-
-	this->filein_close();
-	this->audiodevice_deinit();
-	this->buffer_free();
-
-	this->status = this->STATUS_UNINITIALIZED;
-	return TRUE;
-}
-
-VOID WINAPI AudioPB::pausePlayback(VOID)
-{
-	if(this->status == this->STATUS_RUNNING)
-	{
-		this->status = this->STATUS_PAUSED;
-		this->audiodevice_wait();
-		this->audiodev.p_audioclient->Stop();
-	}
-
-	return;
-}
-
-VOID WINAPI AudioPB::resumePlayback(VOID)
-{
-	if(this->status == this->STATUS_PAUSED)
-	{
-		this->audiodev.p_audioclient->Start();
-		this->status = this->STATUS_RUNNING;
-	}
-
-	return;
-}
-
-VOID WINAPI AudioPB::stopPlayback(VOID)
-{
-	if(this->status > this->STATUS_READY) this->status = this->STATUS_STOPPED;
-	return;
-}
-
-LONG64 WINAPI AudioPB::getAudioDataSizeFrames(VOID)
-{
-	ULONG_PTR _bytes_per_frame;
-
-	if(this->status < 1) return -1;
-
-	_bytes_per_frame = (this->FILE_BYTES_PER_SAMPLE)*(this->N_CHANNELS);
-
-	return (LONG64) ((this->AUDIO_DATA_END - this->AUDIO_DATA_BEGIN)/((ULONG64) _bytes_per_frame));
-}
-
-LONG64 WINAPI AudioPB::getAudioDataPositionFrames(VOID)
-{
-	ULONG_PTR _bytes_per_frame;
-
-	if(this->status < 1) return -1;
-
-	_bytes_per_frame = (this->FILE_BYTES_PER_SAMPLE)*(this->N_CHANNELS);
-
-	return (LONG64) ((*((ULONG64*) &(this->filein_pos_64)) - this->AUDIO_DATA_BEGIN)/((ULONG64) _bytes_per_frame));
-}
-
-BOOL WINAPI AudioPB::setAudioDataPositionFrames(ULONG64 position)
-{
-	ULONG64 _audiodata_size_frames;
-	ULONG_PTR _bytes_per_frame;
-
-	if(this->status < 1) return FALSE;
-
-	_audiodata_size_frames = (ULONG64) this->getAudioDataSizeFrames();
-	if(position >= _audiodata_size_frames)
-	{
-		this->err_msg = TEXT("AudioPB::setAudioDataPositionFrames: Error: invalid position value.");
-		return FALSE;
-	}
-
-	_bytes_per_frame = (this->FILE_BYTES_PER_SAMPLE)*(this->N_CHANNELS);
-
-	*((ULONG64*) &(this->filein_pos_64)) = this->AUDIO_DATA_BEGIN + position*((ULONG64) _bytes_per_frame);
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioPB::loadAudioDeviceList(VOID)
-{
-	const PROPERTYKEY* const P_PKEY = (const PROPERTYKEY*) P_PKEY_Device_FriendlyName;
-	IMMDevice *p_dev = NULL;
-	IPropertyStore *p_devprop = NULL;
-	ULONG_PTR audiodevicelist_byteoffset = 0u;
-	HRESULT n_ret = 0;
-	UINT n_dev = 0u;
-	PROPVARIANT propvar;
-
-	this->audiodevicelist_deinit();
-
-	if(this->p_audiodevenum == NULL)
-	{
-		n_ret = CoCreateInstance(__uuidof(MMDeviceEnumerator), NULL, CLSCTX_ALL, __uuidof(IMMDeviceEnumerator), (VOID**) &(this->p_audiodevenum));
-		if(n_ret != S_OK)
-		{
-			this->status = this->STATUS_ERROR_AUDIOHW;
-			this->err_msg = TEXT("AudioPB::loadAudioDeviceList: Error: CoCreateInstance (IMMDeviceEnumerator) failed.");
-			return FALSE;
-		}
-	}
-
-	if(!this->audiodevicelist_init()) return FALSE;
-
-	audiodevicelist_byteoffset = 0u;
-
-	for(n_dev = 0u; n_dev < (UINT) this->audiodevlist.devlist_n_entries; n_dev++)
-	{
-		n_ret = this->audiodevlist.p_devcoll->Item(n_dev, &p_dev);
-		if(n_ret != S_OK)
-		{
-			this->audiodevicelist_deinit();
-			this->status = this->STATUS_ERROR_AUDIOHW;
-			this->err_msg = TEXT("AudioPB::loadAudioDeviceList: Error: IMMDeviceCollection::Item failed.");
-			return FALSE;
-		}
-
-		n_ret = p_dev->OpenPropertyStore(STGM_READ, &p_devprop);
-		if(n_ret != S_OK)
-		{
-			p_dev->Release();
-			this->audiodevicelist_deinit();
-			this->status = this->STATUS_ERROR_AUDIOHW;
-			this->err_msg = TEXT("AudioPB::loadAudioDeviceList: Error: IMMDevice::OpenPropertyStore failed.");
-			return FALSE;
-		}
-
-		PropVariantInit(&propvar);
-
-		n_ret = p_devprop->GetValue(*P_PKEY, &propvar);
-		if(n_ret != S_OK)
-		{
-			p_devprop->Release();
-			p_dev->Release();
-			this->audiodevicelist_deinit();
-			this->status = this->STATUS_ERROR_AUDIOHW;
-			this->err_msg = TEXT("AudioPB::loadAudioDeviceList: Error: IPropertyStore::GetValue failed.");
-			return FALSE;
-		}
-
-		if(propvar.vt == VT_EMPTY) __SPRINTF((TCHAR*) (((ULONG_PTR) this->audiodevlist.p_devlist) + audiodevicelist_byteoffset), this->AUDIODEVICELIST_ENTRYLENGTH, TEXT("Unknown Audio Device"));
-		else cstr_copy_wchar_to_tchar(propvar.pwszVal, (TCHAR*) (((ULONG_PTR) this->audiodevlist.p_devlist) + audiodevicelist_byteoffset), this->AUDIODEVICELIST_ENTRYLENGTH);
-
-		PropVariantClear(&propvar);
-
-		p_devprop->Release();
-		p_devprop = NULL;
-
-		p_dev->Release();
-		p_dev = NULL;
-
-		audiodevicelist_byteoffset += (this->AUDIODEVICELIST_ENTRYLENGTH)*(sizeof(TCHAR));
-	}
-
-	PropVariantClear(&propvar);
-
-	if(p_devprop != NULL) p_devprop->Release();
-	if(p_dev != NULL) p_dev->Release();
-
-	this->status = this->STATUS_UNINITIALIZED;
-	return TRUE;
-}
-
-LONG_PTR WINAPI AudioPB::getAudioDeviceListEntryCount(VOID)
-{
-	return (LONG_PTR) this->audiodevlist.devlist_n_entries;
-}
-
-const TCHAR* WINAPI AudioPB::getAudioDeviceListEntry(ULONG_PTR index)
-{
-	if(this->audiodevlist.p_devlist == NULL)
-	{
-		this->err_msg = TEXT("AudioPB::getAudioDeviceListEntry: Error: list is not loaded.");
-		return NULL;
-	}
-
-	if(index >= this->audiodevlist.devlist_n_entries)
-	{
-		this->err_msg = TEXT("AudioPB::getAudioDeviceListEntry: Error: given entry index is out of bounds.");
-		return NULL;
-	}
-
-	return (const TCHAR*) (((ULONG_PTR) (this->audiodevlist.p_devlist)) + index*(this->AUDIODEVICELIST_ENTRYLENGTH)*sizeof(TCHAR));
-}
-
-BOOL WINAPI AudioPB::chooseDevice(ULONG_PTR index)
-{
-	HRESULT n_ret = 0;
-
-	if(this->status > 0)
-	{
-		this->err_msg = TEXT("AudioPB::chooseDevice: Error: cannot run method, AudioPB object is already initialized.");
-		return FALSE;
-	}
-
-	if(this->audiodevlist.p_devcoll == NULL)
-	{
-		this->err_msg = TEXT("AudioPB::chooseDevice: Error: audio device list is not loaded.");
-		return FALSE;
-	}
-
-	this->audiodevice_deinit();
-
-	n_ret = this->audiodevlist.p_devcoll->Item((UINT) index, &(this->audiodev.p_device));
-	if(n_ret != S_OK)
-	{
-		this->status = this->STATUS_ERROR_AUDIOHW;
-		this->err_msg = TEXT("AudioPB::chooseDevice: Error: IMMDeviceCollection::Item failed.");
-		return FALSE;
-	}
-
-	this->status = this->STATUS_UNINITIALIZED;
-	return TRUE;
-}
-
-BOOL WINAPI AudioPB::chooseDefaultDevice(VOID)
-{
-	HRESULT n_ret = 0;
-
-	if(this->status > 0)
-	{
-		this->err_msg = TEXT("AudioPB::chooseDefaultDevice: Error: cannot run method, AudioPB object is already initialized.");
-		return FALSE;
-	}
-
-	if(this->p_audiodevenum == NULL)
-	{
-		this->err_msg = TEXT("AudioPB::chooseDefaultDevice: Error: audio device enumerator is not loaded.");
-		return FALSE;
-	}
-
-	this->audiodevice_deinit();
-
-	n_ret = this->p_audiodevenum->GetDefaultAudioEndpoint(eRender, eMultimedia, &(this->audiodev.p_device));
-	if(n_ret != S_OK)
-	{
-		this->status = this->STATUS_ERROR_AUDIOHW;
-		this->err_msg = TEXT("AudioPB::chooseDefaultDevice: Error: IMMDeviceEnumerator::GetDefaultAudioEndpoint failed.");
-		return FALSE;
-	}
-
-	this->status = this->STATUS_UNINITIALIZED;
-	return TRUE;
-}
-
-INT WINAPI AudioPB::getStatus(VOID)
-{
-	return this->status;
-}
-
-__string WINAPI AudioPB::getLastErrorMessage(VOID)
-{
-	if(this->status == this->STATUS_UNINITIALIZED)
-		return (TEXT("Error: AudioPB object not initialized\r\nExtended error message: ") + this->err_msg);
-
-	return this->err_msg;
-}
-
-FLOAT WINAPI AudioPB::delayGetDryInputAmplitude(VOID)
-{
-	if(this->status < 1) return 0.0f;
-
-	return this->p_delay->getDryInputAmplitude();
-}
-
-FLOAT WINAPI AudioPB::delayGetOutputAmplitude(VOID)
-{
-	if(this->status < 1) return 0.0f;
-
-	return this->p_delay->getOutputAmplitude();
-}
-
-BOOL WINAPI AudioPB::delaySetDryInputAmplitude(FLOAT amp)
-{
-	if(this->status < 1) return FALSE;
-
-	if(!this->p_delay->setDryInputAmplitude(amp))
-	{
-		this->err_msg = this->p_delay->getLastErrorMessage();
-		return FALSE;
-	}
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioPB::delaySetOutputAmplitude(FLOAT amp)
-{
-	if(this->status < 1) return FALSE;
-
-	if(!this->p_delay->setOutputAmplitude(amp))
-	{
-		this->err_msg = this->p_delay->getLastErrorMessage();
-		return FALSE;
-	}
-
-	return TRUE;
-}
-
-LONG_PTR WINAPI AudioPB::delayGetFFDelay(ULONG_PTR n_fx)
-{
-	audiodelay_fx_params_t _params;
-
-	if(this->status < 1) return -1;
-
-	if(!this->p_delay->getFFParams(n_fx, &_params))
-	{
-		this->err_msg = this->p_delay->getLastErrorMessage();
-		return -1;
-	}
-
-	return (LONG_PTR) _params.delay;
-}
-
-FLOAT WINAPI AudioPB::delayGetFFAmplitude(ULONG_PTR n_fx)
-{
-	audiodelay_fx_params_t _params;
-
-	if(this->status < 1) return 0.0f;
-
-	if(!this->p_delay->getFFParams(n_fx, &_params))
-	{
-		this->err_msg = this->p_delay->getLastErrorMessage();
-		return 0.0f;
-	}
-
-	return _params.amp;
-}
-
-BOOL WINAPI AudioPB::delaySetFFDelay(ULONG_PTR n_fx, ULONG_PTR delay)
-{
-	if(this->status < 1) return FALSE;
-
-	if(!this->p_delay->setFFDelay(n_fx, delay))
-	{
-		this->err_msg = this->p_delay->getLastErrorMessage();
-		return FALSE;
-	}
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioPB::delaySetFFAmplitude(ULONG_PTR n_fx, FLOAT amp)
-{
-	if(this->status < 1) return FALSE;
-
-	if(!this->p_delay->setFFAmplitude(n_fx, amp))
-	{
-		this->err_msg = this->p_delay->getLastErrorMessage();
-		return FALSE;
-	}
-
-	return TRUE;
-}
-
-LONG_PTR WINAPI AudioPB::delayGetFBDelay(ULONG_PTR n_fx)
-{
-	audiodelay_fx_params_t _params;
-
-	if(this->status < 1) return -1;
-
-	if(!this->p_delay->getFBParams(n_fx, &_params))
-	{
-		this->err_msg = this->p_delay->getLastErrorMessage();
-		return -1;
-	}
-
-	return (LONG_PTR) _params.delay;
-}
-
-FLOAT WINAPI AudioPB::delayGetFBAmplitude(ULONG_PTR n_fx)
-{
-	audiodelay_fx_params_t _params;
-
-	if(this->status < 1) return 0.0f;
-
-	if(!this->p_delay->getFBParams(n_fx, &_params))
-	{
-		this->err_msg = this->p_delay->getLastErrorMessage();
-		return 0.0f;
-	}
-
-	return _params.amp;
-}
-
-BOOL WINAPI AudioPB::delaySetFBDelay(ULONG_PTR n_fx, ULONG_PTR delay)
-{
-	if(this->status < 1) return FALSE;
-
-	if(!this->p_delay->setFBDelay(n_fx, delay))
-	{
-		this->err_msg = this->p_delay->getLastErrorMessage();
-		return FALSE;
-	}
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioPB::delaySetFBAmplitude(ULONG_PTR n_fx, FLOAT amp)
-{
-	if(this->status < 1) return FALSE;
-
-	if(!this->p_delay->setFBAmplitude(n_fx, amp))
-	{
-		this->err_msg = this->p_delay->getLastErrorMessage();
-		return FALSE;
-	}
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioPB::delayResetFFParams(VOID)
-{
-	if(this->status < 1) return FALSE;
-
-	if(!this->p_delay->resetFFParams())
-	{
-		this->err_msg = this->p_delay->getLastErrorMessage();
-		return FALSE;
-	}
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioPB::delayResetFBParams(VOID)
-{
-	if(this->status < 1) return FALSE;
-
-	if(!this->p_delay->resetFBParams())
-	{
-		this->err_msg = this->p_delay->getLastErrorMessage();
-		return FALSE;
-	}
-
-	return TRUE;
-}
-
-VOID WINAPI AudioPB::deinitialize(VOID)
-{
-	this->status = this->STATUS_UNINITIALIZED;
-
-	this->filein_close();
-	this->audiodevice_deinit();
-	this->buffer_free();
-
-	this->audiodevicelist_deinit();
-
-	if(this->p_audiodevenum != NULL)
-	{
-		this->p_audiodevenum->Release();
-		this->p_audiodevenum = NULL;
-	}
-
-	if(this->p_delay != NULL)
-	{
-		delete this->p_delay;
-		this->p_delay = NULL;
-	}
-
-	return;
-}
-
-BOOL WINAPI AudioPB::filein_open(VOID)
-{
-	this->filein_close();
-
-	this->h_filein = CreateFile(this->FILEIN_DIR.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, INVALID_HANDLE_VALUE);
-	if(this->h_filein == INVALID_HANDLE_VALUE) return FALSE;
-
-	this->filein_size_64.l32 = (ULONG32) GetFileSize(this->h_filein, (DWORD*) &(this->filein_size_64.h32));
-	return TRUE;
-}
-
-VOID WINAPI AudioPB::filein_close(VOID)
-{
-	if(this->h_filein == INVALID_HANDLE_VALUE) return;
-
-	CloseHandle(this->h_filein);
-	this->h_filein = INVALID_HANDLE_VALUE;
-	*((ULONG64*) &(this->filein_size_64)) = 0u;
-
-	return;
-}
-
-BOOL WINAPI AudioPB::audiodevice_init(VOID)
-{
-	ULONG64 audiobuffer_time;
-
-	ULONG_PTR n_channel;
-	HRESULT n_ret;
-	UINT32 u32;
-
-	DWORD channel_mask;
-
-	WAVEFORMATEXTENSIBLE wavfmt;
-
-	if(this->audiodev.p_audioservice != NULL)
-	{
-		this->audiodev.p_audioservice->Release();
-		this->audiodev.p_audioservice = NULL;
-	}
-
-	if(this->audiodev.p_audioclient != NULL)
-	{
-		this->audiodev.p_audioclient->Stop();
-		this->audiodev.p_audioclient->Release();
-		this->audiodev.p_audioclient = NULL;
-	}
-
-	if(this->audiodev.p_device == NULL)
-	{
-		this->err_msg = TEXT("AudioPB::audiodevice_init: Error: audio device is not loaded.");
-		return FALSE;
-	}
-
-	n_ret = this->audiodev.p_device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, NULL, (VOID**) &(this->audiodev.p_audioclient));
-	if(n_ret != S_OK)
-	{
-		this->audiodevice_deinit();
-		this->err_msg = TEXT("AudioPB::audiodevice_init: Error: IMMDevice::Activate failed.");
-		return FALSE;
-	}
-
-	channel_mask = 0u;
-	for(n_channel = 0u; n_channel < this->N_CHANNELS; n_channel++) channel_mask |= (1 << n_channel);
-
-	ZeroMemory(&wavfmt, sizeof(WAVEFORMATEXTENSIBLE));
-
-	wavfmt.Format.wFormatTag = WAVE_FORMAT_EXTENSIBLE;
-	wavfmt.Format.nChannels = (WORD) this->N_CHANNELS;
-	wavfmt.Format.wBitsPerSample = (WORD) (this->AUDIO_BYTES_PER_SAMPLE)*8u;
-	wavfmt.Format.nBlockAlign = (wavfmt.Format.nChannels)*((WORD) this->AUDIO_BYTES_PER_SAMPLE);
-	wavfmt.Format.nSamplesPerSec = (DWORD) this->SAMPLE_RATE;
-	wavfmt.Format.nAvgBytesPerSec = (wavfmt.Format.nSamplesPerSec)*((DWORD) wavfmt.Format.nBlockAlign);
-	wavfmt.Format.cbSize = sizeof(WAVEFORMATEXTENSIBLE) - sizeof(WAVEFORMATEX);
-	wavfmt.Samples.wValidBitsPerSample = (WORD) this->AUDIODATA_BITS_PER_SAMPLE;
-	wavfmt.dwChannelMask = channel_mask;
-	wavfmt.SubFormat = KSDATAFORMAT_SUBTYPE_PCM;
-
-	n_ret = this->audiodev.p_audioclient->IsFormatSupported(AUDCLNT_SHAREMODE_EXCLUSIVE, (WAVEFORMATEX*) &wavfmt, NULL);
-	if(n_ret != S_OK)
-	{
-		this->audiodevice_deinit();
-		this->err_msg = TEXT("AudioPB::audiodevice_init: Error: audio stream format not supported.");
-		return FALSE;
-	}
-
-	audiobuffer_time = ((ULONG64) this->AUDIOBUFFER_SIZE_FRAMES)*10000000/((ULONG64) this->SAMPLE_RATE);
-
-	n_ret = this->audiodev.p_audioclient->Initialize(AUDCLNT_SHAREMODE_EXCLUSIVE, 0, (REFERENCE_TIME) audiobuffer_time, 0, (WAVEFORMATEX*) &wavfmt, NULL);
-	if(n_ret != S_OK)
-	{
-		this->audiodevice_deinit();
-		this->err_msg = TEXT("AudioPB::audiodevice_init: Error: IAudioClient::Initialize failed.");
-		return FALSE;
-	}
-
-	/*n_ret = this->p_audiomgr->GetBufferSize(&u32);
-	if(n_ret != S_OK)
-	{
-		this->audio_hw_deinit_device();
-		this->err_msg = TEXT("AudioPB::audiodevice_init: Error: IAudioClient::GetBufferSize failed.");
-		return FALSE;
-	}*/
-
-	n_ret = this->audiodev.p_audioclient->GetService(__uuidof(IAudioRenderClient), (VOID**) &(this->audiodev.p_audioservice));
-	if(n_ret != S_OK)
-	{
-		this->audiodevice_deinit();
-		this->err_msg = TEXT("AudioPB::audiodevice_init: Error: IAudioClient::GetService failed.");
-		return FALSE;
-	}
-
-	return TRUE;
-}
-
-VOID WINAPI AudioPB::audiodevice_deinit(VOID)
-{
-	if(this->audiodev.p_audioservice != NULL)
-	{
-		this->audiodev.p_audioservice->Release();
-		this->audiodev.p_audioservice = NULL;
-	}
-
-	if(this->audiodev.p_audioclient != NULL)
-	{
-		this->audiodev.p_audioclient->Stop();
-		this->audiodev.p_audioclient->Release();
-		this->audiodev.p_audioclient = NULL;
-	}
-
-	if(this->audiodev.p_device != NULL)
-	{
-		this->audiodev.p_device->Release();
-		this->audiodev.p_device = NULL;
-	}
-
-	return;
-}
-
-BOOL WINAPI AudioPB::audiodevicelist_init(VOID)
-{
-	HRESULT n_ret;
-	UINT devcoll_count;
-
-	if(p_processheap == NULL)
-	{
-		this->err_msg = TEXT("AudioPB::audiodevicelist_init: Error: p_processheap is NULL.");
-		return FALSE;
-	}
-
-	if(this->p_audiodevenum == NULL)
-	{
-		this->err_msg = TEXT("AudioPB::audiodevicelist_init: Error: audio device enumerator not initialized.");
-		return FALSE;
-	}
-
-	if(!this->audiodevicelist_deinit()) return FALSE;
-
-	n_ret = this->p_audiodevenum->EnumAudioEndpoints(eRender, DEVICE_STATE_ACTIVE, &(this->audiodevlist.p_devcoll));
-	if(n_ret != S_OK)
-	{
-		this->status = this->STATUS_ERROR_AUDIOHW;
-		this->err_msg = TEXT("AudioPB::audiodevicelist_init: Error: IMMDeviceEnumerator::EnumAudioEndpoints failed.");
-		return FALSE;
-	}
-
-	n_ret = this->audiodevlist.p_devcoll->GetCount(&devcoll_count);
-	if(n_ret != S_OK)
-	{
-		this->audiodevicelist_deinit();
-		this->status = this->STATUS_ERROR_AUDIOHW;
-		this->err_msg = TEXT("AudioPB::audiodevicelist_init: Error: IMMDeviceCollection::GetCount failed.");
-		return FALSE;
-	}
-
-	if(!devcoll_count)
-	{
-		this->audiodevicelist_deinit();
-		this->err_msg = TEXT("AudioPB::audiodevicelist_init: Error: no audio devices found.");
-		return FALSE;
-	}
-
-	this->audiodevlist.devlist_n_entries = (ULONG_PTR) devcoll_count;
-
-	this->audiodevlist.p_devlist = (TCHAR*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, (this->audiodevlist.devlist_n_entries)*(this->AUDIODEVICELIST_ENTRYLENGTH)*sizeof(TCHAR));
-	if(this->audiodevlist.p_devlist == NULL)
-	{
-		this->audiodevicelist_deinit();
-		this->status = this->STATUS_ERROR_MEMORY;
-		this->err_msg = TEXT("AudioPB::audiodevicelist_init: Error: failed to allocate heap memory.");
-		return FALSE;
-	}
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioPB::audiodevicelist_deinit(VOID)
-{
-	if(p_processheap == NULL)
-	{
-		this->err_msg = TEXT("AudioPB::audiodevicelist_deinit: Error: p_processheap is NULL.");
-		return FALSE;
-	}
-
-	if(this->audiodevlist.p_devlist != NULL)
-	{
-		if(!HeapFree(p_processheap, 0u, this->audiodevlist.p_devlist))
-		{
-			this->status = this->STATUS_ERROR_MEMORY;
-			this->err_msg = TEXT("AudioPB::audiodevicelist_deinit: Error: failed to release heap memory.");
-			return FALSE;
-		}
-
-		this->audiodevlist.p_devlist = NULL;
-	}
-
-	this->audiodevlist.devlist_n_entries = 0u;
-
-	if(this->audiodevlist.p_devcoll != NULL)
-	{
-		this->audiodevlist.p_devcoll->Release();
-		this->audiodevlist.p_devcoll = NULL;
-	}
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioPB::buffer_alloc(VOID)
-{
-	if(!this->buffer_free()) return FALSE;
-
-	if(p_processheap == NULL)
-	{
-		this->err_msg = TEXT("AudioPB::buffer_alloc: Error: p_processheap is NULL.");
-		return FALSE;
-	}
-
-	this->p_streambuffer = HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->STREAMBUFFER_SIZE_BYTES);
-	this->p_inputbuffer = HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->INPUTBUFFER_SIZE_BYTES);
-
-	if(this->p_streambuffer == NULL)
-	{
-		this->buffer_free();
-		this->err_msg = TEXT("AudioPB::buffer_alloc: Error: failed to allocate heap memory.");
-		return FALSE;
-	}
-
-	if(this->p_inputbuffer == NULL)
-	{
-		this->buffer_free();
-		this->err_msg = TEXT("AudioPB::buffer_alloc: Error: failed to allocate heap memory.");
-		return FALSE;
-	}
-
-	return TRUE;
-}
-
-BOOL WINAPI AudioPB::buffer_free(VOID)
-{
-	if(p_processheap == NULL)
-	{
-		this->err_msg = TEXT("AudioPB::buffer_free: Error: p_processheap is NULL.");
-		return FALSE;
-	}
-
-	if(this->p_streambuffer != NULL)
-	{
-		if(!HeapFree(p_processheap, 0u, this->p_streambuffer))
-		{
-			this->err_msg = TEXT("AudioPB::buffer_free: Error: failed to release heap memory.");
-			return FALSE;
-		}
-
-		this->p_streambuffer = NULL;
-	}
-
-	if(this->p_inputbuffer != NULL)
-	{
-		if(!HeapFree(p_processheap, 0u, this->p_inputbuffer))
-		{
-			this->err_msg = TEXT("AudioPB::buffer_free: Error: failed to release heap memory.");
-			return FALSE;
-		}
-
-		this->p_inputbuffer = NULL;
-	}
-
-	return TRUE;
-}
-
-VOID WINAPI AudioPB::playback_proc(VOID)
-{
-	this->playback_init();
-	this->playback_loop();
-
-	this->audiodev.p_audioclient->Stop();
-	return;
-}
-
-VOID WINAPI AudioPB::playback_init(VOID)
-{
-	BYTE *p_audiobuffer = NULL;
-
-	*((ULONG64*) &(this->filein_pos_64)) = this->AUDIO_DATA_BEGIN;
-
-	this->p_delay->setDryInputAmplitude(1.0f);
-	this->p_delay->setOutputAmplitude(1.0f);
-
-	this->p_delay->resetFFParams();
-	this->p_delay->resetFBParams();
-
-	this->streambuffer_nseg_playout = 0u;
-	this->delaybuffer_nseg = 0u;
-
-	((IAudioRenderClient*) (this->audiodev.p_audioservice))->GetBuffer((UINT32) this->AUDIOBUFFER_SIZE_FRAMES, &p_audiobuffer);
-
-	ZeroMemory(p_audiobuffer, this->AUDIOBUFFER_SIZE_BYTES);
-
-	((IAudioRenderClient*) (this->audiodev.p_audioservice))->ReleaseBuffer((UINT32) this->AUDIOBUFFER_SIZE_FRAMES, 0u);
-
-	this->audiodev.p_audioclient->Start();
-
-	this->status = this->STATUS_RUNNING;
-
-	this->audiodevice_wait();
-	return;
-}
-
-VOID WINAPI AudioPB::playback_loop(VOID)
-{
-	while(TRUE)
-	{
-		if((this->status < 1) || (this->status == this->STATUS_STOPPED)) break;
-
-		if(this->status == this->STATUS_PAUSED)
-		{
-			Sleep(1u);
-			continue;
-		}
-
-		this->buffer_play();
-
-		this->delaybuffer_loadin();
-		this->p_delay->runDSP(this->delaybuffer_nseg);
-		this->delaybuffer_loadout();
-
-		this->streambuffer_nseg_playout_update();
-		this->delaybuffer_nseg_update();
-
-		this->audiodevice_wait();
-	}
-
-	return;
-}
-
-VOID WINAPI AudioPB::streambuffer_nseg_playout_update(VOID)
-{
-	this->streambuffer_nseg_playout++;
-	this->streambuffer_nseg_playout %= this->STREAMBUFFER_N_SEGMENTS;
-
-	return;
-}
-
-VOID WINAPI AudioPB::delaybuffer_nseg_update(VOID)
-{
-	this->delaybuffer_nseg++;
-	this->delaybuffer_nseg %= this->AUDIODELAY_BUFFER_N_SEGMENTS;
-
-	return;
-}
-
-VOID WINAPI AudioPB::buffer_play(VOID)
-{
-	VOID *p_out = NULL;
-	BYTE *p_audiobuffer = NULL;
-	HRESULT n_ret = 0;
-
-	p_out = (VOID*) (((ULONG_PTR) (this->p_streambuffer)) + (this->streambuffer_nseg_playout)*(this->STREAMBUFFER_SEGMENT_SIZE_BYTES));
-
-	n_ret = ((IAudioRenderClient*) (this->audiodev.p_audioservice))->GetBuffer((UINT32) this->STREAMBUFFER_SEGMENT_SIZE_FRAMES, &p_audiobuffer);
-	if(n_ret != S_OK) app_exit((UINT) -1, TEXT("AudioPB::buffer_play: Error: IAudioRenderClient::GetBuffer failed."));
-
-	CopyMemory(p_audiobuffer, p_out, this->STREAMBUFFER_SEGMENT_SIZE_BYTES);
-
-	n_ret = ((IAudioRenderClient*) (this->audiodev.p_audioservice))->ReleaseBuffer((UINT32) this->STREAMBUFFER_SEGMENT_SIZE_FRAMES, 0u);
-	if(n_ret != S_OK) app_exit((UINT) -1, TEXT("AudioPB::buffer_play: Error: IAudioRenderClient::ReleaseBuffer failed."));
-
-	return;
-}
-
-VOID WINAPI AudioPB::audiodevice_wait(VOID)
-{
-	ULONG_PTR n_frames_free = 0u;
-	UINT32 u32 = 0u;
-
-	do{
-		this->audiodev.p_audioclient->GetCurrentPadding(&u32);
-
-		n_frames_free = this->AUDIOBUFFER_SIZE_FRAMES - ((ULONG_PTR) u32);
-
-		Sleep(1u);
-	}while(n_frames_free < this->STREAMBUFFER_SEGMENT_SIZE_FRAMES);
-
-	return;
-}
+/*
+	Real-Time Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#include "AudioPB.hpp"
+#include "cstrdef.h"
+#include "thread.h"
+
+#include <combaseapi.h>
+
+AudioPB::AudioPB(const audiopb_params_t *p_params)
+{
+	this->p_sink = &(this->sink_wasapi);
+	this->setParameters(p_params);
+}
+
+/*The format classes release everything (deinitialize()) in their own destructors.*/
+AudioPB::~AudioPB(VOID)
+{
+}
+
+BOOL WINAPI AudioPB::setParameters(const audiopb_params_t *p_params)
+{
+	if(this->status > 0)
+	{
+		this->err_msg = TEXT("AudioPB::setParameters: Error: cannot set parameters, AudioPB object already initialized.");
+		return FALSE;
+	}
+
+	if(p_params == NULL)
+	{
+		this->err_msg = TEXT("AudioPB::setParameters: Error: given params object is invalid.");
+		return FALSE;
+	}
+
+	if(p_params->file_dir == NULL)
+	{
+		this->err_msg = TEXT("AudioPB::setParameters: Error: given parameter file_dir is invalid.");
+		return FALSE;
+	}
+
+	this->status = this->STATUS_UNINITIALIZED;
+
+	this->AUDIO_DATA_BEGIN = p_params->audio_data_begin;
+	this->AUDIO_DATA_END = p_params->audio_data_end;
+	this->FILEIN_DIR = p_params->file_dir;
+	this->SAMPLE_RATE = p_params->sample_rate;
+	this->N_CHANNELS = p_params->n_channels;
+	this->AUDIOBUFFER_SIZE_FRAMES_BASE = _get_closest_power2_ceil(p_params->audiobuffer_size_frames);
+	this->STREAMBUFFER_SEGMENT_SIZE_FRAMES = _get_closest_power2_ceil(p_params->streambuffer_segment_size_frames);
+	this->STREAMBUFFER_N_SEGMENTS = _get_closest_power2_ceil(p_params->streambuffer_n_segments);
+	this->AUDIODELAY_BUFFER_SIZE_FRAMES = _get_closest_power2_ceil(p_params->delay_buffer_size_frames);
+	this->AUDIODELAY_FF_PARAMS_LENGTH = p_params->n_ff_delays;
+	this->AUDIODELAY_FB_PARAMS_LENGTH = p_params->n_fb_delays;
+	this->AUDIODELAY_XFADE_SIZE_FRAMES = p_params->delay_xfade_size_frames;
+	this->READAHEAD_SIZE_FRAMES = p_params->readahead_size_frames;
+	this->READBLOCK_SIZE_BYTES = p_params->readblock_size_bytes;
+	this->DITHER = p_params->dither;
+	this->XRUN_POLICY = p_params->xrun_policy;
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::initialize(VOID)
+{
+	audiodelay_init_params_t delay_params;
+
+	if(this->status > 0) return TRUE;
+
+	this->status = this->STATUS_UNINITIALIZED;
+
+	if(!this->SAMPLE_RATE)
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioPB::initialize: Error: invalid sample rate.");
+		return FALSE;
+	}
+
+	if(this->N_CHANNELS < this->N_CHANNELS_MIN)
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioPB::initialize: Error: invalid number of channels.");
+		return FALSE;
+	}
+
+	if(this->STREAMBUFFER_SEGMENT_SIZE_FRAMES < this->STREAMBUFFER_SEGMENT_SIZE_FRAMES_MIN)
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioPB::initialize: Error: invalid stream buffer segment size.");
+		return FALSE;
+	}
+
+	if(this->STREAMBUFFER_N_SEGMENTS < this->STREAMBUFFER_N_SEGMENTS_MIN)
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioPB::initialize: Error: invalid stream buffer segment count.");
+		return FALSE;
+	}
+
+	if((this->XRUN_POLICY < this->XRUN_POLICY_SILENCE) || (this->XRUN_POLICY > this->XRUN_POLICY_GROW))
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioPB::initialize: Error: invalid underrun recovery policy.");
+		return FALSE;
+	}
+
+	/*Starts from the configured size again if the last playback grew it.*/
+	this->AUDIOBUFFER_SIZE_FRAMES = this->AUDIOBUFFER_SIZE_FRAMES_BASE;
+
+	if(this->AUDIOBUFFER_SIZE_FRAMES < this->STREAMBUFFER_SEGMENT_SIZE_FRAMES)
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioPB::initialize: Error: invalid audio buffer size. (audio buffer is smaller than stream buffer segment).");
+		return FALSE;
+	}
+
+	if(this->AUDIODELAY_BUFFER_SIZE_FRAMES < this->STREAMBUFFER_SEGMENT_SIZE_FRAMES)
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioPB::initialize: Error: invalid delay buffer size. (delay buffer is smaller than stream buffer segment).");
+		return FALSE;
+	}
+
+	this->audiodevice_set_size(this->AUDIOBUFFER_SIZE_FRAMES);
+
+	this->STREAMBUFFER_SEGMENT_SIZE_SAMPLES = (this->STREAMBUFFER_SEGMENT_SIZE_FRAMES)*(this->N_CHANNELS);
+	this->STREAMBUFFER_SEGMENT_SIZE_BYTES = (this->STREAMBUFFER_SEGMENT_SIZE_SAMPLES)*(this->AUDIO_BYTES_PER_SAMPLE);
+
+	this->INPUTBUFFER_SIZE_BYTES = (this->STREAMBUFFER_SEGMENT_SIZE_SAMPLES)*(this->FILE_BYTES_PER_SAMPLE);
+
+	if(this->INPUTBUFFER_SIZE_BYTES > this->filein.getRegionSizeMax())
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioPB::initialize: Error: invalid stream buffer segment size. (segment is too large for the input file view).");
+		return FALSE;
+	}
+
+	this->READAHEAD_N_SEGMENTS = (this->READAHEAD_SIZE_FRAMES + this->STREAMBUFFER_SEGMENT_SIZE_FRAMES - 1u)/(this->STREAMBUFFER_SEGMENT_SIZE_FRAMES);
+	if(this->READAHEAD_N_SEGMENTS < this->READAHEAD_N_SEGMENTS_MIN) this->READAHEAD_N_SEGMENTS = this->READAHEAD_N_SEGMENTS_MIN;
+
+	this->AUDIODELAY_BUFFER_N_SEGMENTS = (this->AUDIODELAY_BUFFER_SIZE_FRAMES)/(this->STREAMBUFFER_SEGMENT_SIZE_FRAMES);
+
+	if(!this->filein_open())
+	{
+		this->status = this->STATUS_ERROR_NOFILE;
+		this->err_msg = TEXT("AudioPB::initialize: Error: open input file failed.");
+		return FALSE;
+	}
+
+	if(!this->audiodevice_init())
+	{
+		this->status = this->STATUS_ERROR_AUDIOHW;
+		this->filein_close();
+		return FALSE;
+	}
+
+	if(!this->buffer_alloc())
+	{
+		this->status = this->STATUS_ERROR_MEMORY;
+		this->filein_close();
+		this->audiodevice_deinit();
+		return FALSE;
+	}
+
+	delay_params.buffer_size_frames = this->AUDIODELAY_BUFFER_SIZE_FRAMES;
+	delay_params.buffer_n_segments = this->AUDIODELAY_BUFFER_N_SEGMENTS;
+	delay_params.n_channels = this->N_CHANNELS;
+	delay_params.n_ff_delays = this->AUDIODELAY_FF_PARAMS_LENGTH;
+	delay_params.n_fb_delays = this->AUDIODELAY_FB_PARAMS_LENGTH;
+	delay_params.kernel_isa = DSPKERNEL_ISA_AUTO;
+	delay_params.gain_ramp_mode = AudioDelay::GAINRAMP_LINEAR;
+	delay_params.xfade_size_frames = this->AUDIODELAY_XFADE_SIZE_FRAMES;
+	delay_params.interp_mode = AudioDelay::INTERP_HERMITE;
+
+	if(this->p_delay == NULL)
+	{
+		this->p_delay = new AudioDelay(&delay_params);
+		if(this->p_delay == NULL)
+		{
+			this->status = this->STATUS_ERROR_MEMORY;
+			this->err_msg = TEXT("AudioPB::initialize: Error: AudioDelay object instance failed.");
+			this->filein_close();
+			this->audiodevice_deinit();
+			this->buffer_free();
+			return FALSE;
+		}
+	}
+	else this->p_delay->setInitParameters(&delay_params);
+
+	if(!this->p_delay->initialize())
+	{
+		this->status = this->STATUS_ERROR_GENERIC;
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		this->filein_close();
+		this->audiodevice_deinit();
+		this->buffer_free();
+		return FALSE;
+	}
+
+	this->status = this->STATUS_READY;
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::runPlayback(VOID)
+{
+	if(this->status != this->STATUS_READY)
+	{
+		this->err_msg = TEXT("AudioPB::runPlayback: Error: AudioPB object is either not initialized or already running playback.");
+		return FALSE;
+	}
+
+	this->playback_proc();
+
+	this->filein_close();
+	this->audiodevice_deinit();
+	this->buffer_free();
+
+	/*Playback stopped on an error (see audiodevice_grow()): the error status and message are kept.*/
+	if(this->status < 1) return FALSE;
+
+	this->status = this->STATUS_UNINITIALIZED;
+	return TRUE;
+}
+
+VOID WINAPI AudioPB::pausePlayback(VOID)
+{
+	/*The playback thread stops the sink (see playback_loop()). The exchange fails if playback stopped meanwhile.*/
+	InterlockedCompareExchange(&(this->status), this->STATUS_PAUSED, this->STATUS_RUNNING);
+	return;
+}
+
+VOID WINAPI AudioPB::resumePlayback(VOID)
+{
+	InterlockedCompareExchange(&(this->status), this->STATUS_RUNNING, this->STATUS_PAUSED);
+	return;
+}
+
+VOID WINAPI AudioPB::stopPlayback(VOID)
+{
+	if(this->status > this->STATUS_READY) this->status = this->STATUS_STOPPED;
+	return;
+}
+
+LONG64 WINAPI AudioPB::getAudioDataSizeFrames(VOID)
+{
+	ULONG_PTR _bytes_per_frame;
+
+	if(this->status < 1) return -1;
+
+	_bytes_per_frame = (this->FILE_BYTES_PER_SAMPLE)*(this->N_CHANNELS);
+
+	return (LONG64) ((this->AUDIO_DATA_END - this->AUDIO_DATA_BEGIN)/((ULONG64) _bytes_per_frame));
+}
+
+LONG64 WINAPI AudioPB::getAudioDataPositionFrames(VOID)
+{
+	ULONG_PTR _bytes_per_frame;
+
+	if(this->status < 1) return -1;
+
+	_bytes_per_frame = (this->FILE_BYTES_PER_SAMPLE)*(this->N_CHANNELS);
+
+	return (LONG64) ((*((ULONG64*) &(this->filein_pos_64)) - this->AUDIO_DATA_BEGIN)/((ULONG64) _bytes_per_frame));
+}
+
+BOOL WINAPI AudioPB::setAudioDataPositionFrames(ULONG64 position)
+{
+	ULONG64 _audiodata_size_frames;
+	ULONG_PTR _bytes_per_frame;
+
+	if(this->status < 1) return FALSE;
+
+	_audiodata_size_frames = (ULONG64) this->getAudioDataSizeFrames();
+	if(position >= _audiodata_size_frames)
+	{
+		this->err_msg = TEXT("AudioPB::setAudioDataPositionFrames: Error: invalid position value.");
+		return FALSE;
+	}
+
+	_bytes_per_frame = (this->FILE_BYTES_PER_SAMPLE)*(this->N_CHANNELS);
+
+	*((ULONG64*) &(this->filein_pos_64)) = this->AUDIO_DATA_BEGIN + position*((ULONG64) _bytes_per_frame);
+
+	this->readahead_seek(*((ULONG64*) &(this->filein_pos_64)));
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::getReadAheadStats(audiopb_readahead_stats_t *p_stats)
+{
+	if(p_stats == NULL)
+	{
+		this->err_msg = TEXT("AudioPB::getReadAheadStats: Error: given stats object is invalid.");
+		return FALSE;
+	}
+
+	if(this->status < 1)
+	{
+		this->err_msg = TEXT("AudioPB::getReadAheadStats: Error: AudioPB object is not initialized.");
+		return FALSE;
+	}
+
+	p_stats->depth_segments = this->readahead_ring.getSlotCount();
+	p_stats->fill_segments = this->readahead_ring.getFill();
+	p_stats->fill_min_segments = this->readahead_fill_min;
+	p_stats->n_segments_read = this->readahead_n_segments_read;
+	p_stats->n_starved = this->readahead_n_starved;
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::getPipelineStats(audiopb_pipeline_stats_t *p_stats)
+{
+	if(p_stats == NULL)
+	{
+		this->err_msg = TEXT("AudioPB::getPipelineStats: Error: given stats object is invalid.");
+		return FALSE;
+	}
+
+	if(this->status < 1)
+	{
+		this->err_msg = TEXT("AudioPB::getPipelineStats: Error: AudioPB object is not initialized.");
+		return FALSE;
+	}
+
+	p_stats->depth_segments = this->stream_ring.getSlotCount();
+	p_stats->fill_segments = this->stream_ring.getFill();
+	p_stats->fill_min_segments = this->stream_fill_min;
+	p_stats->n_segments_processed = this->dsp_n_segments_processed;
+	p_stats->n_starved = this->stream_n_starved;
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::getXrunStats(audiopb_xrun_stats_t *p_stats)
+{
+	LARGE_INTEGER perf_now;
+	LONG64 time_end = 0;
+	ULONG_PTR n_event = 0u;
+	ULONG64 n_first = 0u;
+	LONG seq = 0;
+
+	if(p_stats == NULL)
+	{
+		this->err_msg = TEXT("AudioPB::getXrunStats: Error: given stats object is invalid.");
+		return FALSE;
+	}
+
+	QueryPerformanceCounter(&perf_now);
+
+	while(TRUE)
+	{
+		seq = InterlockedCompareExchange(&(this->xrun_seq), 0, 0);
+		if(seq & 1)
+		{
+			/*The playback thread is in the middle of an update.*/
+			Sleep(0u);
+			continue;
+		}
+
+		p_stats->n_xruns = this->xrun_n;
+		p_stats->n_frames_lost = this->xrun_frames_lost;
+		p_stats->n_segments_skipped = this->xrun_n_segments_skipped;
+		p_stats->n_buffer_grows = this->xrun_n_grows;
+		p_stats->buffer_size_frames = this->AUDIOBUFFER_SIZE_FRAMES;
+
+		time_end = this->xrun_time_end;
+		if(!time_end) time_end = perf_now.QuadPart;
+
+		if(this->xrun_time_start) p_stats->run_time_s = ((DOUBLE) (time_end - this->xrun_time_start))/((DOUBLE) this->xrun_perf_freq);
+		else p_stats->run_time_s = 0.0;
+
+		p_stats->n_events = (ULONG_PTR) this->xrun_n;
+		if(p_stats->n_events > AUDIOPB_XRUN_HISTORY_LENGTH) p_stats->n_events = AUDIOPB_XRUN_HISTORY_LENGTH;
+
+		n_first = this->xrun_n - ((ULONG64) p_stats->n_events);
+
+		for(n_event = 0u; n_event < p_stats->n_events; n_event++)
+			p_stats->events[n_event] = this->xrun_events[(n_first + ((ULONG64) n_event))%AUDIOPB_XRUN_HISTORY_LENGTH];
+
+		if(InterlockedCompareExchange(&(this->xrun_seq), 0, 0) == seq) break;
+	}
+
+	if(p_stats->run_time_s > 0.0) p_stats->xruns_per_hour = ((DOUBLE) p_stats->n_xruns)*3600.0/(p_stats->run_time_s);
+	else p_stats->xruns_per_hour = 0.0;
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::getStageStats(audiopb_stage_stats_t *p_stats)
+{
+	ULONG_PTR n_stage = 0u;
+
+	if(p_stats == NULL)
+	{
+		this->err_msg = TEXT("AudioPB::getStageStats: Error: given stats object is invalid.");
+		return FALSE;
+	}
+
+	for(n_stage = 0u; n_stage < AUDIOPB_N_STAGES; n_stage++) this->stage_hist[n_stage].getStats(&(p_stats->stages[n_stage]));
+	this->dsp_segment_hist.getStats(&(p_stats->dsp_segment));
+
+	p_stats->segment_budget_us = 0.0;
+	p_stats->dsp_load_mean_pct = 0.0;
+	p_stats->dsp_load_p99_pct = 0.0;
+	p_stats->dsp_load_max_pct = 0.0;
+
+	if(!this->SAMPLE_RATE) return TRUE;
+
+	p_stats->segment_budget_us = ((DOUBLE) this->STREAMBUFFER_SEGMENT_SIZE_FRAMES)*1000000.0/((DOUBLE) this->SAMPLE_RATE);
+	if(p_stats->segment_budget_us <= 0.0) return TRUE;
+
+	p_stats->dsp_load_mean_pct = 100.0*(p_stats->dsp_segment.mean_us)/(p_stats->segment_budget_us);
+	p_stats->dsp_load_p99_pct = 100.0*(p_stats->dsp_segment.p99_us)/(p_stats->segment_budget_us);
+	p_stats->dsp_load_max_pct = 100.0*(p_stats->dsp_segment.max_us)/(p_stats->segment_budget_us);
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::getDeviceWaitStats(audiosink_wait_stats_t *p_stats)
+{
+	if(!this->p_sink->getWaitStats(p_stats))
+	{
+		this->err_msg = TEXT("AudioPB::getDeviceWaitStats: Error: AudioSink::getWaitStats failed.\r\nExtended Error Message: ") + this->p_sink->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::setSink(AudioSink *p_sink)
+{
+	if(this->status > 0)
+	{
+		this->err_msg = TEXT("AudioPB::setSink: Error: cannot run method, AudioPB object is already initialized.");
+		return FALSE;
+	}
+
+	if(p_sink == NULL) this->p_sink = &(this->sink_wasapi);
+	else this->p_sink = p_sink;
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::loadAudioDeviceList(VOID)
+{
+	if(!this->sink_wasapi.loadDeviceList())
+	{
+		this->status = this->STATUS_ERROR_AUDIOHW;
+		this->err_msg = TEXT("AudioPB::loadAudioDeviceList: Error: failed to load audio device list.\r\nExtended Error Message: ") + this->sink_wasapi.getLastErrorMessage();
+		return FALSE;
+	}
+
+	this->status = this->STATUS_UNINITIALIZED;
+	return TRUE;
+}
+
+LONG_PTR WINAPI AudioPB::getAudioDeviceListEntryCount(VOID)
+{
+	return this->sink_wasapi.getDeviceListEntryCount();
+}
+
+const TCHAR* WINAPI AudioPB::getAudioDeviceListEntry(ULONG_PTR index)
+{
+	const TCHAR *p_entry = NULL;
+
+	p_entry = this->sink_wasapi.getDeviceListEntry(index);
+	if(p_entry == NULL) this->err_msg = TEXT("AudioPB::getAudioDeviceListEntry: Error: ") + this->sink_wasapi.getLastErrorMessage();
+
+	return p_entry;
+}
+
+BOOL WINAPI AudioPB::chooseDevice(ULONG_PTR index)
+{
+	if(this->status > 0)
+	{
+		this->err_msg = TEXT("AudioPB::chooseDevice: Error: cannot run method, AudioPB object is already initialized.");
+		return FALSE;
+	}
+
+	if(!this->sink_wasapi.chooseDevice(index))
+	{
+		this->status = this->STATUS_ERROR_AUDIOHW;
+		this->err_msg = TEXT("AudioPB::chooseDevice: Error: failed to choose audio device.\r\nExtended Error Message: ") + this->sink_wasapi.getLastErrorMessage();
+		return FALSE;
+	}
+
+	this->status = this->STATUS_UNINITIALIZED;
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::chooseDefaultDevice(VOID)
+{
+	if(this->status > 0)
+	{
+		this->err_msg = TEXT("AudioPB::chooseDefaultDevice: Error: cannot run method, AudioPB object is already initialized.");
+		return FALSE;
+	}
+
+	if(!this->sink_wasapi.chooseDefaultDevice())
+	{
+		this->status = this->STATUS_ERROR_AUDIOHW;
+		this->err_msg = TEXT("AudioPB::chooseDefaultDevice: Error: failed to choose default audio device.\r\nExtended Error Message: ") + this->sink_wasapi.getLastErrorMessage();
+		return FALSE;
+	}
+
+	this->status = this->STATUS_UNINITIALIZED;
+	return TRUE;
+}
+
+INT WINAPI AudioPB::getStatus(VOID)
+{
+	return (INT) this->status;
+}
+
+__string WINAPI AudioPB::getLastErrorMessage(VOID)
+{
+	if(this->status == this->STATUS_UNINITIALIZED)
+		return (TEXT("Error: AudioPB object not initialized\r\nExtended error message: ") + this->err_msg);
+
+	return this->err_msg;
+}
+
+FLOAT WINAPI AudioPB::delayGetDryInputAmplitude(VOID)
+{
+	if(this->status < 1) return 0.0f;
+
+	return this->p_delay->getDryInputAmplitude();
+}
+
+FLOAT WINAPI AudioPB::delayGetOutputAmplitude(VOID)
+{
+	if(this->status < 1) return 0.0f;
+
+	return this->p_delay->getOutputAmplitude();
+}
+
+BOOL WINAPI AudioPB::delaySetDryInputAmplitude(FLOAT amp)
+{
+	if(this->status < 1) return FALSE;
+
+	if(!this->p_delay->setDryInputAmplitude(amp))
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::delaySetOutputAmplitude(FLOAT amp)
+{
+	if(this->status < 1) return FALSE;
+
+	if(!this->p_delay->setOutputAmplitude(amp))
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+LONG_PTR WINAPI AudioPB::delayGetFFDelay(ULONG_PTR n_fx)
+{
+	audiodelay_fx_params_t _params;
+
+	if(this->status < 1) return -1;
+
+	if(!this->p_delay->getFFParams(n_fx, &_params))
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return -1;
+	}
+
+	return (LONG_PTR) _params.delay;
+}
+
+FLOAT WINAPI AudioPB::delayGetFFAmplitude(ULONG_PTR n_fx)
+{
+	audiodelay_fx_params_t _params;
+
+	if(this->status < 1) return 0.0f;
+
+	if(!this->p_delay->getFFParams(n_fx, &_params))
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return 0.0f;
+	}
+
+	return _params.amp;
+}
+
+BOOL WINAPI AudioPB::delaySetFFDelay(ULONG_PTR n_fx, ULONG_PTR delay)
+{
+	if(this->status < 1) return FALSE;
+
+	if(!this->p_delay->setFFDelay(n_fx, delay))
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::delaySetFFAmplitude(ULONG_PTR n_fx, FLOAT amp)
+{
+	if(this->status < 1) return FALSE;
+
+	if(!this->p_delay->setFFAmplitude(n_fx, amp))
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+LONG_PTR WINAPI AudioPB::delayGetFBDelay(ULONG_PTR n_fx)
+{
+	audiodelay_fx_params_t _params;
+
+	if(this->status < 1) return -1;
+
+	if(!this->p_delay->getFBParams(n_fx, &_params))
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return -1;
+	}
+
+	return (LONG_PTR) _params.delay;
+}
+
+FLOAT WINAPI AudioPB::delayGetFBAmplitude(ULONG_PTR n_fx)
+{
+	audiodelay_fx_params_t _params;
+
+	if(this->status < 1) return 0.0f;
+
+	if(!this->p_delay->getFBParams(n_fx, &_params))
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return 0.0f;
+	}
+
+	return _params.amp;
+}
+
+BOOL WINAPI AudioPB::delaySetFBDelay(ULONG_PTR n_fx, ULONG_PTR delay)
+{
+	if(this->status < 1) return FALSE;
+
+	if(!this->p_delay->setFBDelay(n_fx, delay))
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::delaySetFBAmplitude(ULONG_PTR n_fx, FLOAT amp)
+{
+	if(this->status < 1) return FALSE;
+
+	if(!this->p_delay->setFBAmplitude(n_fx, amp))
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::delaySetFFDelayFractional(ULONG_PTR n_fx, DOUBLE delay)
+{
+	if(this->status < 1) return FALSE;
+
+	if(!this->p_delay->setFFDelayFractional(n_fx, delay))
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::delaySetFBDelayFractional(ULONG_PTR n_fx, DOUBLE delay)
+{
+	if(this->status < 1) return FALSE;
+
+	if(!this->p_delay->setFBDelayFractional(n_fx, delay))
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::delaySetFFModulation(ULONG_PTR n_fx, INT shape, FLOAT depth, FLOAT rate_hz)
+{
+	if(this->status < 1) return FALSE;
+
+	if(!this->p_delay->setFFModulation(n_fx, shape, depth, rate_hz/((FLOAT) this->SAMPLE_RATE)))
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::delaySetFBModulation(ULONG_PTR n_fx, INT shape, FLOAT depth, FLOAT rate_hz)
+{
+	if(this->status < 1) return FALSE;
+
+	if(!this->p_delay->setFBModulation(n_fx, shape, depth, rate_hz/((FLOAT) this->SAMPLE_RATE)))
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::delayResetFFParams(VOID)
+{
+	if(this->status < 1) return FALSE;
+
+	if(!this->p_delay->resetFFParams())
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::delayResetFBParams(VOID)
+{
+	if(this->status < 1) return FALSE;
+
+	if(!this->p_delay->resetFBParams())
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::delayBeginParamsUpdate(VOID)
+{
+	if(this->status < 1) return FALSE;
+
+	if(!this->p_delay->beginParamsUpdate())
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::delayCommitParamsUpdate(VOID)
+{
+	if(this->status < 1) return FALSE;
+
+	if(!this->p_delay->commitParamsUpdate())
+	{
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+VOID WINAPI AudioPB::deinitialize(VOID)
+{
+	this->status = this->STATUS_UNINITIALIZED;
+
+	this->filein_close();
+	this->audiodevice_deinit();
+	this->buffer_free();
+
+	if(this->p_delay != NULL)
+	{
+		delete this->p_delay;
+		this->p_delay = NULL;
+	}
+
+	return;
+}
+
+BOOL WINAPI AudioPB::filein_open(VOID)
+{
+	this->filein_close();
+
+	if(!this->filein.open(this->FILEIN_DIR.c_str())) return FALSE;
+
+	this->filein.setReadBlockSize(this->READBLOCK_SIZE_BYTES);
+
+	if(this->FILEIN_DIRECT)
+	{
+		if(!this->filein_dsp.open(this->FILEIN_DIR.c_str()))
+		{
+			this->filein.close();
+			return FALSE;
+		}
+
+		this->filein_dsp.setReadBlockSize(this->READBLOCK_SIZE_BYTES);
+	}
+
+	*((ULONG64*) &(this->filein_size_64)) = this->filein.getFileSize();
+	return TRUE;
+}
+
+VOID WINAPI AudioPB::filein_close(VOID)
+{
+	if(!this->filein.isOpen()) return;
+
+	this->filein.close();
+	this->filein_dsp.close();
+	*((ULONG64*) &(this->filein_size_64)) = 0u;
+
+	return;
+}
+
+const BYTE* WINAPI AudioPB::filein_get_segment(FileMap *p_file, ULONG64 pos, ULONG_PTR *p_n_samples)
+{
+	ULONG64 size_64 = 0u;
+	ULONG_PTR size = 0u;
+	const BYTE *p_data = NULL;
+
+	*p_n_samples = 0u;
+
+	if(pos >= this->AUDIO_DATA_END) return NULL;
+
+	/*Bytes past the end of the audio data (trailing chunks) are not read.*/
+	size_64 = this->AUDIO_DATA_END - pos;
+	if(size_64 > ((ULONG64) this->INPUTBUFFER_SIZE_BYTES)) size_64 = (ULONG64) this->INPUTBUFFER_SIZE_BYTES;
+
+	p_data = p_file->getRegion(pos, (ULONG_PTR) size_64, &size);
+	if(p_data == NULL) return NULL;
+
+	*p_n_samples = size/(this->FILE_BYTES_PER_SAMPLE);
+	return p_data;
+}
+
+BOOL WINAPI AudioPB::audiodevice_init(VOID)
+{
+	audiosink_format_t format;
+
+	format.sample_rate = this->SAMPLE_RATE;
+	format.n_channels = this->N_CHANNELS;
+	format.bytes_per_sample = this->AUDIO_BYTES_PER_SAMPLE;
+	format.bits_per_sample = this->AUDIODATA_BITS_PER_SAMPLE;
+	format.is_float = this->AUDIODATA_IS_FLOAT;
+	format.buffer_size_frames = this->AUDIOBUFFER_SIZE_FRAMES;
+	format.period_frames = this->STREAMBUFFER_SEGMENT_SIZE_FRAMES;
+
+	if(!this->p_sink->open(&format))
+	{
+		this->err_msg = TEXT("AudioPB::audiodevice_init: Error: failed to open audio sink.\r\nExtended Error Message: ") + this->p_sink->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+VOID WINAPI AudioPB::audiodevice_deinit(VOID)
+{
+	this->p_sink->close();
+	return;
+}
+
+BOOL WINAPI AudioPB::audiodevice_prefill(VOID)
+{
+	BYTE *p_audiobuffer = NULL;
+
+	p_audiobuffer = this->p_sink->getBuffer(this->AUDIOBUFFER_SIZE_FRAMES);
+	if(p_audiobuffer == NULL)
+	{
+		this->err_msg = TEXT("AudioPB::audiodevice_prefill: Error: AudioSink::getBuffer failed.\r\nExtended Error Message: ") + this->p_sink->getLastErrorMessage();
+		return FALSE;
+	}
+
+	ZeroMemory(p_audiobuffer, this->AUDIOBUFFER_SIZE_BYTES);
+
+	this->p_sink->releaseBuffer(this->AUDIOBUFFER_SIZE_FRAMES);
+
+	if(!this->p_sink->start())
+	{
+		this->err_msg = TEXT("AudioPB::audiodevice_prefill: Error: AudioSink::start failed.\r\nExtended Error Message: ") + this->p_sink->getLastErrorMessage();
+		return FALSE;
+	}
+
+	this->xrun_padding_update();
+
+	/*The sink position restarts with the stream.*/
+	this->xrun_frames_written = (ULONG64) this->AUDIOBUFFER_SIZE_FRAMES;
+	this->xrun_deficit = 0;
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::audiodevice_grow(VOID)
+{
+	ULONG_PTR size_frames = 0u;
+
+	size_frames = (this->AUDIOBUFFER_SIZE_FRAMES) << 1;
+	if(size_frames > (this->AUDIOBUFFER_SIZE_FRAMES_BASE)*(this->XRUN_GROW_MAX_FACTOR)) return FALSE;
+
+	/*open() on an open sink sets it up again, on the same device.*/
+	this->p_sink->stop();
+	this->audiodevice_set_size(size_frames);
+
+	if(this->audiodevice_init())
+	{
+		if(this->audiodevice_prefill()) return TRUE;
+
+		this->status = this->STATUS_ERROR_AUDIOHW;
+		return FALSE;
+	}
+
+	/*The device does not take the larger buffer: back to the previous size (a failed open() keeps the device).*/
+	this->audiodevice_set_size(size_frames >> 1);
+
+	/*No sink to play to anymore: the playback loop ends on the error status.*/
+	if(!this->audiodevice_init() || !this->audiodevice_prefill()) this->status = this->STATUS_ERROR_AUDIOHW;
+
+	return FALSE;
+}
+
+VOID WINAPI AudioPB::audiodevice_set_size(ULONG_PTR size_frames)
+{
+	this->AUDIOBUFFER_SIZE_FRAMES = size_frames;
+	this->AUDIOBUFFER_SIZE_SAMPLES = (this->AUDIOBUFFER_SIZE_FRAMES)*(this->N_CHANNELS);
+	this->AUDIOBUFFER_SIZE_BYTES = (this->AUDIOBUFFER_SIZE_SAMPLES)*(this->AUDIO_BYTES_PER_SAMPLE);
+
+	return;
+}
+
+BOOL WINAPI AudioPB::buffer_alloc(VOID)
+{
+	if(!this->buffer_free()) return FALSE;
+
+	if(!this->readahead_ring.initialize(this->READAHEAD_N_SEGMENTS, (this->STREAMBUFFER_SEGMENT_SIZE_SAMPLES)*sizeof(FLOAT)))
+	{
+		this->buffer_free();
+		this->err_msg = TEXT("AudioPB::buffer_alloc: Error: read-ahead ring initialization failed.\r\nExtended Error Message: ") + this->readahead_ring.getLastErrorMessage();
+		return FALSE;
+	}
+
+	if(!this->stream_ring.initialize(this->STREAMBUFFER_N_SEGMENTS, this->STREAMBUFFER_SEGMENT_SIZE_BYTES))
+	{
+		this->buffer_free();
+		this->err_msg = TEXT("AudioPB::buffer_alloc: Error: stream ring initialization failed.\r\nExtended Error Message: ") + this->stream_ring.getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioPB::buffer_free(VOID)
+{
+	this->readahead_ring.deinitialize();
+	this->stream_ring.deinitialize();
+	return TRUE;
+}
+
+VOID WINAPI AudioPB::playback_proc(VOID)
+{
+	LARGE_INTEGER perf_now;
+
+	this->playback_init();
+	this->playback_loop();
+
+	this->p_sink->stop();
+	this->dsp_stop();
+	this->readahead_stop();
+
+	QueryPerformanceCounter(&perf_now);
+	InterlockedExchange64(&(this->xrun_time_end), perf_now.QuadPart);
+	return;
+}
+
+VOID WINAPI AudioPB::playback_init(VOID)
+{
+	ULONG_PTR n_stage = 0u;
+
+	*((ULONG64*) &(this->filein_pos_64)) = this->AUDIO_DATA_BEGIN;
+
+	for(n_stage = 0u; n_stage < AUDIOPB_N_STAGES; n_stage++) this->stage_hist[n_stage].reset();
+	this->dsp_segment_hist.reset();
+
+	this->p_delay->setDryInputAmplitude(1.0f);
+	this->p_delay->setOutputAmplitude(1.0f);
+
+	this->p_delay->resetFFParams();
+	this->p_delay->resetFBParams();
+
+	this->delaybuffer_nseg = 0u;
+
+	if(!this->readahead_start()) app_exit((UINT) -1, this->err_msg.c_str());
+	if(!this->dsp_start()) app_exit((UINT) -1, this->err_msg.c_str());
+
+	this->xrun_reset();
+
+	if(!this->audiodevice_prefill()) app_exit((UINT) -1, this->err_msg.c_str());
+
+	this->status = this->STATUS_RUNNING;
+
+	this->audiodevice_wait();
+	return;
+}
+
+VOID WINAPI AudioPB::playback_loop(VOID)
+{
+	LARGE_INTEGER perf_begin;
+	LARGE_INTEGER perf_play;
+	LARGE_INTEGER perf_wait;
+
+	/*
+		Only this thread touches the sink while playback runs: pausePlayback()/resumePlayback() just change the status,
+		the sink is stopped or started here, between two device waits (the segment written last is queued before the stop).
+	*/
+	this->sink_paused = FALSE;
+
+	while(TRUE)
+	{
+		if((this->status < 1) || (this->status == this->STATUS_STOPPED)) break;
+
+		if(this->status == this->STATUS_PAUSED)
+		{
+			if(!this->sink_paused)
+			{
+				this->p_sink->stop();
+				this->sink_paused = TRUE;
+			}
+
+			/*The device is stopped: the time of the last write says nothing about underruns anymore.*/
+			this->xrun_padding_time = 0;
+			Sleep(1u);
+			continue;
+		}
+
+		if(this->sink_paused)
+		{
+			this->sink_paused = FALSE;
+
+			if(!this->p_sink->start())
+			{
+				this->err_msg = TEXT("AudioPB::playback_loop: Error: AudioSink::start failed.\r\nExtended Error Message: ") + this->p_sink->getLastErrorMessage();
+				this->status = this->STATUS_ERROR_AUDIOHW;
+				break;
+			}
+		}
+
+		this->xrun_check();
+		if(this->status < 1) break;
+
+		QueryPerformanceCounter(&perf_begin);
+		this->buffer_play();
+		QueryPerformanceCounter(&perf_play);
+		this->audiodevice_wait();
+		QueryPerformanceCounter(&perf_wait);
+
+		this->stage_hist[this->STAGE_BUFFER_PLAY].add(perf_play.QuadPart - perf_begin.QuadPart);
+		this->stage_hist[this->STAGE_DEVICE_WAIT].add(perf_wait.QuadPart - perf_play.QuadPart);
+	}
+
+	return;
+}
+
+DWORD WINAPI AudioPB::dsp_thread_proc(VOID *p_args)
+{
+	((AudioPB*) p_args)->dsp_loop();
+	return 0u;
+}
+
+BOOL WINAPI AudioPB::dsp_start(VOID)
+{
+	DWORD time_start = 0u;
+
+	this->dsp_stop();
+
+	this->stream_ring.reset();
+
+	this->stream_gen_play = InterlockedCompareExchange(&(this->readahead_seek_gen), 0, 0);
+
+	InterlockedExchange(&(this->dsp_quit), 0);
+
+	this->stream_fill_min = this->stream_ring.getSlotCount();
+	this->stream_n_starved = 0u;
+	this->dsp_n_segments_processed = 0u;
+
+	this->p_dsp_thread = thread_create_default(&AudioPB::dsp_thread_proc, this, NULL);
+	if(this->p_dsp_thread == NULL)
+	{
+		this->err_msg = TEXT("AudioPB::dsp_start: Error: failed to create DSP thread.");
+		return FALSE;
+	}
+
+	/*Prefill: wait until the ring is full or the DSP thread consumed the whole audio data.*/
+	time_start = GetTickCount();
+	while(this->stream_ring.getFill() < this->stream_ring.getSlotCount())
+	{
+		if(this->readahead_end && !this->readahead_ring.getFill()) break;
+		if((GetTickCount() - time_start) >= this->PIPELINE_PREFILL_TIMEOUT_MS) break;
+		Sleep(1u);
+	}
+
+	return TRUE;
+}
+
+VOID WINAPI AudioPB::dsp_stop(VOID)
+{
+	if(this->p_dsp_thread == NULL) return;
+
+	InterlockedExchange(&(this->dsp_quit), 1);
+	this->stream_ring.wake();
+	this->readahead_ring.wake();
+
+	thread_wait(&(this->p_dsp_thread));
+	return;
+}
+
+VOID WINAPI AudioPB::dsp_loop(VOID)
+{
+	segring_slot_t *p_slot = NULL;
+	LARGE_INTEGER perf_begin;
+	LARGE_INTEGER perf_loadin;
+	LARGE_INTEGER perf_dsp;
+	LARGE_INTEGER perf_loadout;
+
+	while(!this->dsp_quit)
+	{
+		p_slot = this->stream_ring.pushBegin();
+		if(p_slot == NULL)
+		{
+			this->stream_ring.waitSpace(this->PIPELINE_WAIT_MS);
+			continue;
+		}
+
+		/*A loadin with no decoded segment ready is not timed: the wait for the reader thread shows in the read-ahead stats.*/
+		QueryPerformanceCounter(&perf_begin);
+		if(!this->delaybuffer_loadin(p_slot))
+		{
+			this->readahead_ring.waitData(this->PIPELINE_WAIT_MS);
+			continue;
+		}
+		QueryPerformanceCounter(&perf_loadin);
+
+		this->stage_hist[this->STAGE_LOADIN].add(perf_loadin.QuadPart - perf_begin.QuadPart);
+
+		if(!(p_slot->flags & this->READAHEAD_FLAG_END))
+		{
+			this->p_delay->runDSP(this->delaybuffer_nseg);
+			QueryPerformanceCounter(&perf_dsp);
+			this->delaybuffer_loadout((BYTE*) p_slot->p_data);
+			QueryPerformanceCounter(&perf_loadout);
+			this->delaybuffer_nseg_update();
+
+			this->stage_hist[this->STAGE_RUNDSP].add(perf_dsp.QuadPart - perf_loadin.QuadPart);
+			this->stage_hist[this->STAGE_LOADOUT].add(perf_loadout.QuadPart - perf_dsp.QuadPart);
+			this->dsp_segment_hist.add(perf_loadout.QuadPart - perf_begin.QuadPart);
+
+			this->dsp_n_segments_processed++;
+		}
+
+		this->stream_ring.pushCommit();
+	}
+
+	return;
+}
+
+VOID WINAPI AudioPB::delaybuffer_nseg_update(VOID)
+{
+	this->delaybuffer_nseg++;
+	this->delaybuffer_nseg %= this->AUDIODELAY_BUFFER_N_SEGMENTS;
+
+	return;
+}
+
+BOOL WINAPI AudioPB::delaybuffer_loadin(segring_slot_t *p_stream_slot)
+{
+	FLOAT *p_loadseg_f32 = NULL;
+	const BYTE *p_data = NULL;
+	segring_slot_t *p_slot = NULL;
+	ULONG_PTR n_samples = 0u;
+	ULONG_PTR fill = 0u;
+	LONG gen = 0;
+
+	p_loadseg_f32 = this->p_delay->getInputBufferSegment(this->delaybuffer_nseg);
+	if(p_loadseg_f32 == NULL)
+	{
+		this->err_msg = TEXT("AudioPB::delaybuffer_loadin: Error: AudioDelay::getInputBufferSegment returned NULL.\r\nExtended Error Message: ") + this->p_delay->getLastErrorMessage();
+		app_exit((UINT) -1, this->err_msg.c_str());
+	}
+
+	gen = InterlockedCompareExchange(&(this->readahead_seek_gen), 0, 0);
+
+	while(TRUE)
+	{
+		p_slot = this->readahead_ring.popBegin();
+		if(p_slot == NULL) break;
+
+		if(p_slot->tag == gen) break;
+
+		/*Decoded before the last position change*/
+		this->readahead_ring.popCommit();
+	}
+
+	if(p_slot == NULL)
+	{
+		/*
+			Nothing decoded yet: the DSP thread waits for the reader, the device feed plays silence if it runs out meanwhile.
+			Right after a position change, or once the reader reached the end of the audio data, this is expected and not counted as starvation.
+		*/
+		if((this->readahead_gen_play == gen) && !this->readahead_end)
+		{
+			this->readahead_n_starved++;
+			this->readahead_fill_min = 0u;
+		}
+
+		return FALSE;
+	}
+
+	this->readahead_gen_play = gen;
+
+	/*
+		Segments left after this one (p_slot is not released yet, so fill is at least 1).
+		Once the reader reached the end of the audio data the ring drains normally, that is not tracked.
+	*/
+	fill = this->readahead_ring.getFill() - 1u;
+	if((fill < this->readahead_fill_min) && !this->readahead_end) this->readahead_fill_min = fill;
+
+	p_stream_slot->tag = gen;
+	p_stream_slot->flags = p_slot->flags;
+	p_stream_slot->position = p_slot->position + ((ULONG64) this->INPUTBUFFER_SIZE_BYTES);
+	p_stream_slot->size = p_slot->size;
+
+	if(p_slot->flags & this->READAHEAD_FLAG_END)
+	{
+		this->readahead_ring.popCommit();
+		return TRUE;
+	}
+
+	if(this->FILEIN_DIRECT)
+	{
+		/*Decoded straight from the mapped file: the input is copied only once.*/
+		p_data = this->filein_get_segment(&(this->filein_dsp), p_slot->position, &n_samples);
+		if(p_data != NULL) this->filein_decode(p_loadseg_f32, p_data, n_samples);
+
+		if(n_samples < this->STREAMBUFFER_SEGMENT_SIZE_SAMPLES) ZeroMemory(&(p_loadseg_f32[n_samples]), (this->STREAMBUFFER_SEGMENT_SIZE_SAMPLES - n_samples)*sizeof(FLOAT));
+	}
+	else CopyMemory(p_loadseg_f32, p_slot->p_data, (this->STREAMBUFFER_SEGMENT_SIZE_SAMPLES)*sizeof(FLOAT));
+
+	this->readahead_ring.popCommit();
+	return TRUE;
+}
+
+DWORD WINAPI AudioPB::readahead_thread_proc(VOID *p_args)
+{
+	((AudioPB*) p_args)->readahead_loop();
+	return 0u;
+}
+
+BOOL WINAPI AudioPB::readahead_start(VOID)
+{
+	ULONG64 pos = 0u;
+	DWORD time_start = 0u;
+
+	this->readahead_stop();
+
+	pos = *((ULONG64*) &(this->filein_pos_64));
+
+	this->readahead_ring.reset();
+
+	InterlockedExchange64(&(this->readahead_seek_pos), (LONG64) pos);
+	this->readahead_gen = InterlockedCompareExchange(&(this->readahead_seek_gen), 0, 0);
+	this->readahead_gen_play = this->readahead_gen;
+	this->readahead_pos = pos;
+
+	InterlockedExchange(&(this->readahead_end), 0);
+	InterlockedExchange(&(this->readahead_quit), 0);
+
+	this->readahead_fill_min = this->readahead_ring.getSlotCount();
+	this->readahead_n_segments_read = 0u;
+	this->readahead_n_starved = 0u;
+
+	this->p_readahead_thread = thread_create_default(&AudioPB::readahead_thread_proc, this, NULL);
+	if(this->p_readahead_thread == NULL)
+	{
+		this->err_msg = TEXT("AudioPB::readahead_start: Error: failed to create reader thread.");
+		return FALSE;
+	}
+
+	/*Prefill: wait until the ring is full or the whole audio data was read, so playback does not start starved.*/
+	time_start = GetTickCount();
+	while((this->readahead_ring.getFill() < this->readahead_ring.getSlotCount()) && !this->readahead_end)
+	{
+		if((GetTickCount() - time_start) >= this->READAHEAD_PREFILL_TIMEOUT_MS) break;
+		Sleep(1u);
+	}
+
+	return TRUE;
+}
+
+VOID WINAPI AudioPB::readahead_stop(VOID)
+{
+	if(this->p_readahead_thread == NULL) return;
+
+	InterlockedExchange(&(this->readahead_quit), 1);
+	this->readahead_ring.wake();
+
+	thread_wait(&(this->p_readahead_thread));
+	return;
+}
+
+VOID WINAPI AudioPB::readahead_seek(ULONG64 pos)
+{
+	/*Position first, then generation: a reader that sees the new generation also sees the new position.*/
+	InterlockedExchange64(&(this->readahead_seek_pos), (LONG64) pos);
+	InterlockedIncrement(&(this->readahead_seek_gen));
+	this->readahead_ring.wake();
+
+	return;
+}
+
+VOID WINAPI AudioPB::readahead_loop(VOID)
+{
+	segring_slot_t *p_slot = NULL;
+	LONG gen = 0;
+
+	while(!this->readahead_quit)
+	{
+		gen = InterlockedCompareExchange(&(this->readahead_seek_gen), 0, 0);
+		if(gen != this->readahead_gen)
+		{
+			this->readahead_gen = gen;
+			this->readahead_pos = (ULONG64) InterlockedCompareExchange64(&(this->readahead_seek_pos), 0, 0);
+			InterlockedExchange(&(this->readahead_end), 0);
+		}
+
+		if(this->readahead_end)
+		{
+			this->readahead_ring.waitSpace(this->READAHEAD_WAIT_MS);
+			continue;
+		}
+
+		p_slot = this->readahead_ring.pushBegin();
+		if(p_slot == NULL)
+		{
+			this->readahead_ring.waitSpace(this->READAHEAD_WAIT_MS);
+			continue;
+		}
+
+		p_slot->tag = gen;
+		this->readahead_read(p_slot);
+
+		this->readahead_ring.pushCommit();
+	}
+
+	return;
+}
+
+VOID WINAPI AudioPB::readahead_read(segring_slot_t *p_slot)
+{
+	const BYTE *p_data = NULL;
+	FLOAT *p_dst = NULL;
+	ULONG_PTR n_samples = 0u;
+
+	p_slot->position = this->readahead_pos;
+	p_slot->flags = 0;
+	p_slot->size = 0u;
+
+	if(this->readahead_pos >= this->AUDIO_DATA_END)
+	{
+		p_slot->flags = this->READAHEAD_FLAG_END;
+		InterlockedExchange(&(this->readahead_end), 1);
+		return;
+	}
+
+	p_dst = (FLOAT*) p_slot->p_data;
+
+	/*With FILEIN_DIRECT set, mapping the segment only prefetches it, the DSP thread decodes it (see delaybuffer_loadin()).*/
+	p_data = this->filein_get_segment(&(this->filein), this->readahead_pos, &n_samples);
+
+	if(!this->FILEIN_DIRECT)
+	{
+		if(p_data != NULL) this->filein_decode(p_dst, p_data, n_samples);
+
+		if(n_samples < this->STREAMBUFFER_SEGMENT_SIZE_SAMPLES) ZeroMemory(&(p_dst[n_samples]), (this->STREAMBUFFER_SEGMENT_SIZE_SAMPLES - n_samples)*sizeof(FLOAT));
+	}
+
+	p_slot->size = n_samples;
+
+	this->readahead_pos += (ULONG64) this->INPUTBUFFER_SIZE_BYTES;
+	this->readahead_n_segments_read++;
+
+	return;
+}
+
+VOID WINAPI AudioPB::buffer_play(VOID)
+{
+	segring_slot_t *p_slot = NULL;
+	BYTE *p_audiobuffer = NULL;
+	ULONG_PTR fill = 0u;
+	LONG gen = 0;
+
+	gen = InterlockedCompareExchange(&(this->readahead_seek_gen), 0, 0);
+
+	while(TRUE)
+	{
+		p_slot = this->stream_ring.popBegin();
+		if(p_slot == NULL) break;
+
+		if(p_slot->tag == gen) break;
+
+		/*Processed before the last position change*/
+		this->stream_ring.popCommit();
+	}
+
+	if(p_slot != NULL)
+	{
+		if(p_slot->flags & this->READAHEAD_FLAG_END)
+		{
+			this->stream_ring.popCommit();
+			this->status = this->STATUS_STOPPED;
+			return;
+		}
+
+		this->stream_gen_play = gen;
+
+		fill = this->stream_ring.getFill() - 1u;
+		if(fill < this->stream_fill_min) this->stream_fill_min = fill;
+	}
+	else
+	{
+		/*
+			Nothing processed yet, but the device still has a segment queued: give the DSP thread time instead of playing silence.
+			A device that frees several segments at once asks for them back to back, faster than they are processed.
+		*/
+		if(this->p_sink->getPadding() >= ((LONG_PTR) this->STREAMBUFFER_SEGMENT_SIZE_FRAMES))
+		{
+			this->stream_ring.waitData(this->PIPELINE_FEED_WAIT_MS);
+			return;
+		}
+
+		/*The DSP thread fell behind: play silence and keep the stream running (not counted right after a position change).*/
+		if(this->stream_gen_play == gen)
+		{
+			this->stream_n_starved++;
+			this->stream_fill_min = 0u;
+		}
+	}
+
+	p_audiobuffer = this->p_sink->getBuffer(this->STREAMBUFFER_SEGMENT_SIZE_FRAMES);
+	if(p_audiobuffer == NULL)
+	{
+		this->err_msg = TEXT("AudioPB::buffer_play: Error: AudioSink::getBuffer failed.\r\nExtended Error Message: ") + this->p_sink->getLastErrorMessage();
+		app_exit((UINT) -1, this->err_msg.c_str());
+	}
+
+	if(p_slot != NULL)
+	{
+		CopyMemory(p_audiobuffer, p_slot->p_data, this->STREAMBUFFER_SEGMENT_SIZE_BYTES);
+		*((ULONG64*) &(this->filein_pos_64)) = p_slot->position;
+
+		this->stream_ring.popCommit();
+	}
+	else ZeroMemory(p_audiobuffer, this->STREAMBUFFER_SEGMENT_SIZE_BYTES);
+
+	if(!this->p_sink->releaseBuffer(this->STREAMBUFFER_SEGMENT_SIZE_FRAMES))
+	{
+		this->err_msg = TEXT("AudioPB::buffer_play: Error: AudioSink::releaseBuffer failed.\r\nExtended Error Message: ") + this->p_sink->getLastErrorMessage();
+		app_exit((UINT) -1, this->err_msg.c_str());
+	}
+
+	this->xrun_padding_update();
+	this->xrun_frames_written += (ULONG64) this->STREAMBUFFER_SEGMENT_SIZE_FRAMES;
+
+	return;
+}
+
+VOID WINAPI AudioPB::audiodevice_wait(VOID)
+{
+	/*
+		The sink wakes this thread up when the device has freed one segment of buffer space.
+		It only times out while the device is not playing (paused): give up when playback is stopped, or if the sink failed.
+	*/
+	while(!this->p_sink->waitBufferSpace(this->STREAMBUFFER_SEGMENT_SIZE_FRAMES, this->AUDIODEVICE_WAIT_TIMEOUT_MS))
+	{
+		if((this->status < 1) || (this->status == this->STATUS_STOPPED)) break;
+		if(this->p_sink->getPadding() < 0) break;
+	}
+
+	return;
+}
+
+VOID WINAPI AudioPB::xrun_reset(VOID)
+{
+	LARGE_INTEGER perf_freq;
+	LARGE_INTEGER perf_now;
+
+	QueryPerformanceFrequency(&perf_freq);
+	QueryPerformanceCounter(&perf_now);
+
+	InterlockedIncrement(&(this->xrun_seq));
+
+	this->xrun_perf_freq = perf_freq.QuadPart;
+	this->xrun_time_start = perf_now.QuadPart;
+	this->xrun_time_end = 0;
+
+	this->xrun_padding_time = 0;
+	this->xrun_padding_frames = 0u;
+	this->xrun_frames_written = 0u;
+	this->xrun_deficit = 0;
+
+	this->xrun_n = 0u;
+	this->xrun_frames_lost = 0u;
+	this->xrun_n_segments_skipped = 0u;
+	this->xrun_n_grows = 0u;
+	this->xrun_grow_stop = FALSE;
+
+	InterlockedIncrement(&(this->xrun_seq));
+	return;
+}
+
+VOID WINAPI AudioPB::xrun_check(VOID)
+{
+	ULONG_PTR lost_frames = 0u;
+
+	/*A pause or stop requested meanwhile is carried out first (see playback_loop()).*/
+	if(this->status != this->STATUS_RUNNING) return;
+
+	lost_frames = this->xrun_detect();
+	if(!lost_frames) return;
+
+	this->xrun_record(lost_frames);
+
+	switch(this->XRUN_POLICY)
+	{
+		case this->XRUN_POLICY_SKIP:
+			this->xrun_skip(lost_frames);
+			break;
+
+		case this->XRUN_POLICY_GROW:
+			if(this->xrun_grow_stop) break;
+
+			if(!this->audiodevice_grow())
+			{
+				this->xrun_grow_stop = TRUE;
+				break;
+			}
+
+			InterlockedIncrement(&(this->xrun_seq));
+			this->xrun_n_grows++;
+			InterlockedIncrement(&(this->xrun_seq));
+
+			/*The new buffer starts full of silence.*/
+			this->audiodevice_wait();
+			break;
+	}
+
+	return;
+}
+
+ULONG_PTR WINAPI AudioPB::xrun_detect(VOID)
+{
+	LARGE_INTEGER perf_now;
+	LONG_PTR padding = 0;
+	LONG64 position = 0;
+	LONG64 n_frames = 0;
+	LONG64 deficit_prev = 0;
+
+	/*Sink errors are reported by buffer_play().*/
+	padding = this->p_sink->getPadding();
+	QueryPerformanceCounter(&perf_now);
+	if(padding < 0) return 0u;
+
+	position = this->p_sink->getPosition();
+	if(position >= 0)
+	{
+		/*The device played past the frames written so far: the difference is silence. Only its growth since the last check is new.*/
+		n_frames = position - ((LONG64) this->xrun_frames_written);
+		if(n_frames <= this->xrun_deficit) return 0u;
+
+		deficit_prev = this->xrun_deficit;
+		this->xrun_deficit = n_frames;
+
+		return (ULONG_PTR) (n_frames - deficit_prev);
+	}
+
+	/*No device position: a drained buffer and the time since the last padding sample tell.*/
+	if(padding || !this->xrun_padding_time)
+	{
+		this->xrun_padding_time = perf_now.QuadPart;
+		this->xrun_padding_frames = (ULONG_PTR) padding;
+		return 0u;
+	}
+
+	/*The buffer ran dry: the frames queued at the last sample played out, the rest of the time since then was silence.*/
+	n_frames = (LONG64) (((DOUBLE) (perf_now.QuadPart - this->xrun_padding_time))*((DOUBLE) this->SAMPLE_RATE)/((DOUBLE) this->xrun_perf_freq));
+	n_frames -= (LONG64) this->xrun_padding_frames;
+
+	this->xrun_padding_time = perf_now.QuadPart;
+	this->xrun_padding_frames = 0u;
+
+	if(n_frames <= ((LONG64) ((this->SAMPLE_RATE)*(this->XRUN_SLACK_US)/1000000u))) return 0u;
+
+	return (ULONG_PTR) n_frames;
+}
+
+VOID WINAPI AudioPB::xrun_padding_update(VOID)
+{
+	LARGE_INTEGER perf_now;
+	LONG_PTR padding = 0;
+
+	padding = this->p_sink->getPadding();
+	QueryPerformanceCounter(&perf_now);
+
+	if(padding < 0)
+	{
+		this->xrun_padding_time = 0;
+		return;
+	}
+
+	this->xrun_padding_time = perf_now.QuadPart;
+	this->xrun_padding_frames = (ULONG_PTR) padding;
+
+	return;
+}
+
+VOID WINAPI AudioPB::xrun_record(ULONG_PTR lost_frames)
+{
+	LARGE_INTEGER perf_now;
+	audiopb_xrun_event_t *p_event = NULL;
+
+	QueryPerformanceCounter(&perf_now);
+
+	InterlockedIncrement(&(this->xrun_seq));
+
+	p_event = &(this->xrun_events[(this->xrun_n)%AUDIOPB_XRUN_HISTORY_LENGTH]);
+
+	p_event->time_s = ((DOUBLE) (perf_now.QuadPart - this->xrun_time_start))/((DOUBLE) this->xrun_perf_freq);
+	p_event->position_frames = (ULONG64) this->getAudioDataPositionFrames();
+	p_event->lost_frames = lost_frames;
+
+	this->xrun_n++;
+	this->xrun_frames_lost += (ULONG64) lost_frames;
+
+	InterlockedIncrement(&(this->xrun_seq));
+	return;
+}
+
+VOID WINAPI AudioPB::xrun_skip(ULONG_PTR lost_frames)
+{
+	segring_slot_t *p_slot = NULL;
+	ULONG_PTR n_skip = 0u;
+	ULONG64 n_skipped = 0u;
+	LONG gen = 0;
+
+	/*Only whole segments, and only the ones already processed: the DSP thread is not held back.*/
+	n_skip = lost_frames/(this->STREAMBUFFER_SEGMENT_SIZE_FRAMES);
+	gen = InterlockedCompareExchange(&(this->readahead_seek_gen), 0, 0);
+
+	while(n_skip)
+	{
+		p_slot = this->stream_ring.popBegin();
+		if(p_slot == NULL) break;
+
+		if(p_slot->flags & this->READAHEAD_FLAG_END) break;
+
+		if(p_slot->tag == gen)
+		{
+			*((ULONG64*) &(this->filein_pos_64)) = p_slot->position;
+			n_skip--;
+			n_skipped++;
+		}
+
+		this->stream_ring.popCommit();
+	}
+
+	InterlockedIncrement(&(this->xrun_seq));
+	this->xrun_n_segments_skipped += n_skipped;
+	InterlockedIncrement(&(this->xrun_seq));
+
+	return;
+}
@@ -1,220 +1,477 @@
-/*
-	Real-Time Audio Delay 2 application for Windows
-	Version 3.0
-
-	Author: Rafael Sabe
-	Email: rafaelmsabe@gmail.com
-*/
-
-#ifndef AUDIOPB_HPP
-#define AUDIOPB_HPP
-
-#include "globldef.h"
-#include "strdef.hpp"
-#include "shared.hpp"
-
-#include "AudioDelay.hpp"
-
-#include <mmdeviceapi.h>
-#include <audioclient.h>
-
-struct _audiopb_params {
-	ULONG64 audio_data_begin;
-	ULONG64 audio_data_end;
-	const TCHAR *file_dir;
-	ULONG_PTR sample_rate;
-	ULONG_PTR n_channels;
-	ULONG_PTR audiobuffer_size_frames;
-	ULONG_PTR streambuffer_segment_size_frames;
-	ULONG_PTR streambuffer_n_segments;
-	ULONG_PTR delay_buffer_size_frames;
-	ULONG_PTR n_ff_delays;
-	ULONG_PTR n_fb_delays;
-};
-
-typedef struct _audiopb_params audiopb_params_t;
-
-struct _audiodevicelist {
-	IMMDeviceCollection *p_devcoll;
-	TCHAR *p_devlist;
-	ULONG_PTR devlist_n_entries;
-};
-
-typedef struct _audiodevicelist audiodevicelist_t;
-
-struct _audiodevice {
-	IMMDevice *p_device;
-	IAudioClient *p_audioclient;
-	IUnknown *p_audioservice;
-};
-
-typedef struct _audiodevice audiodevice_t;
-
-class AudioPB {
-	public:
-		AudioPB(const audiopb_params_t *p_params);
-
-		BOOL WINAPI setParameters(const audiopb_params_t *p_params);
-		BOOL WINAPI initialize(VOID);
-		BOOL WINAPI runPlayback(VOID);
-
-		VOID WINAPI pausePlayback(VOID);
-		VOID WINAPI resumePlayback(VOID);
-		VOID WINAPI stopPlayback(VOID);
-
-		LONG64 WINAPI getAudioDataSizeFrames(VOID);
-		LONG64 WINAPI getAudioDataPositionFrames(VOID);
-		BOOL WINAPI setAudioDataPositionFrames(ULONG64 position);
-
-		BOOL WINAPI loadAudioDeviceList(VOID);
-		LONG_PTR WINAPI getAudioDeviceListEntryCount(VOID);
-		const TCHAR* WINAPI getAudioDeviceListEntry(ULONG_PTR index);
-
-		BOOL WINAPI chooseDevice(ULONG_PTR index);
-		BOOL WINAPI chooseDefaultDevice(VOID);
-
-		INT WINAPI getStatus(VOID);
-		__string WINAPI getLastErrorMessage(VOID);
-
-		/* INTERNAL AudioDelay object routing methods */
-
-		FLOAT WINAPI delayGetDryInputAmplitude(VOID);
-		FLOAT WINAPI delayGetOutputAmplitude(VOID);
-
-		BOOL WINAPI delaySetDryInputAmplitude(FLOAT amp);
-		BOOL WINAPI delaySetOutputAmplitude(FLOAT amp);
-
-		LONG_PTR WINAPI delayGetFFDelay(ULONG_PTR n_fx);
-		FLOAT WINAPI delayGetFFAmplitude(ULONG_PTR n_fx);
-
-		BOOL WINAPI delaySetFFDelay(ULONG_PTR n_fx, ULONG_PTR delay);
-		BOOL WINAPI delaySetFFAmplitude(ULONG_PTR n_fx, FLOAT amp);
-
-		LONG_PTR WINAPI delayGetFBDelay(ULONG_PTR n_fx);
-		FLOAT WINAPI delayGetFBAmplitude(ULONG_PTR n_fx);
-
-		BOOL WINAPI delaySetFBDelay(ULONG_PTR n_fx, ULONG_PTR delay);
-		BOOL WINAPI delaySetFBAmplitude(ULONG_PTR n_fx, FLOAT amp);
-
-		BOOL WINAPI delayResetFFParams(VOID);
-		BOOL WINAPI delayResetFBParams(VOID);
-
-		enum Status {
-			STATUS_ERROR_INVALIDPARAMS = -5,
-			STATUS_ERROR_MEMORY = -4,
-			STATUS_ERROR_AUDIOHW = -3,
-			STATUS_ERROR_NOFILE = -2,
-			STATUS_ERROR_GENERIC = -1,
-			STATUS_UNINITIALIZED = 0,
-			STATUS_READY = 1,
-			STATUS_RUNNING = 2,
-			STATUS_PAUSED = 3,
-			STATUS_STOPPED = 4
-		};
-
-	protected:
-		static constexpr ULONG_PTR N_CHANNELS_MIN = 1u;
-		static constexpr ULONG_PTR STREAMBUFFER_N_SEGMENTS_MIN = 2u;
-		static constexpr ULONG_PTR STREAMBUFFER_SEGMENT_SIZE_FRAMES_MIN = 32u;
-
-		static constexpr ULONG_PTR AUDIODEVICELIST_ENTRYLENGTH = 256u;
-
-		__declspec(align(PTR_SIZE_BYTES)) fileptr64_t filein_size_64 = {
-			.l32 = 0u,
-			.h32 = 0u
-		};
-
-		__declspec(align(PTR_SIZE_BYTES)) fileptr64_t filein_pos_64 = {
-			.l32 = 0u,
-			.h32 = 0u
-		};
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG64 AUDIO_DATA_BEGIN = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG64 AUDIO_DATA_END = 0u;
-
-		__declspec(align(PTR_SIZE_BYTES)) HANDLE h_filein = INVALID_HANDLE_VALUE;
-
-		__declspec(align(PTR_SIZE_BYTES)) AudioDelay *p_delay = NULL;
-
-		__declspec(align(PTR_SIZE_BYTES)) IMMDeviceEnumerator *p_audiodevenum = NULL;
-
-		__declspec(align(PTR_SIZE_BYTES)) audiodevicelist_t audiodevlist = {
-			.p_devcoll = NULL,
-			.p_devlist = NULL,
-			.devlist_n_entries = 0u
-		};
-
-		__declspec(align(PTR_SIZE_BYTES)) audiodevice_t audiodev = {
-			.p_device = NULL,
-			.p_audioclient = NULL,
-			.p_audioservice = NULL
-		};
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIOBUFFER_SIZE_FRAMES = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIOBUFFER_SIZE_SAMPLES = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIOBUFFER_SIZE_BYTES = 0u;
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR STREAMBUFFER_SIZE_FRAMES = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR STREAMBUFFER_SIZE_SAMPLES = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR STREAMBUFFER_SIZE_BYTES = 0u;
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR STREAMBUFFER_SEGMENT_SIZE_FRAMES = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR STREAMBUFFER_SEGMENT_SIZE_SAMPLES = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR STREAMBUFFER_SEGMENT_SIZE_BYTES = 0u;
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR STREAMBUFFER_N_SEGMENTS = 0u;
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR INPUTBUFFER_SIZE_BYTES = 0u;
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODELAY_BUFFER_SIZE_FRAMES = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODELAY_BUFFER_N_SEGMENTS = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODELAY_FF_PARAMS_LENGTH = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODELAY_FB_PARAMS_LENGTH = 0u;
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR SAMPLE_RATE = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR N_CHANNELS = 0u;
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR FILE_BYTES_PER_SAMPLE = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIO_BYTES_PER_SAMPLE = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODATA_BITS_PER_SAMPLE = 0u;
-
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR streambuffer_nseg_playout = 0u;
-		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR delaybuffer_nseg = 0u;
-
-		__declspec(align(PTR_SIZE_BYTES)) VOID *p_inputbuffer = NULL;
-		__declspec(align(PTR_SIZE_BYTES)) VOID *p_streambuffer = NULL;
-
-		__declspec(align(PTR_SIZE_BYTES)) __string FILEIN_DIR = TEXT("");
-		__declspec(align(PTR_SIZE_BYTES)) __string err_msg = TEXT("");
-
-		__declspec(align(4)) INT status = this->STATUS_UNINITIALIZED;
-
-		VOID WINAPI deinitialize(VOID);
-
-		BOOL WINAPI filein_open(VOID);
-		VOID WINAPI filein_close(VOID);
-
-		BOOL WINAPI audiodevice_init(VOID);
-		VOID WINAPI audiodevice_deinit(VOID);
-
-		BOOL WINAPI audiodevicelist_init(VOID);
-		BOOL WINAPI audiodevicelist_deinit(VOID);
-
-		BOOL WINAPI buffer_alloc(VOID);
-		BOOL WINAPI buffer_free(VOID);
-
-		VOID WINAPI playback_proc(VOID);
-		VOID WINAPI playback_init(VOID);
-		VOID WINAPI playback_loop(VOID);
-
-		VOID WINAPI streambuffer_nseg_playout_update(VOID);
-		VOID WINAPI delaybuffer_nseg_update(VOID);
-
-		virtual VOID WINAPI delaybuffer_loadin(VOID) = 0;
-		virtual VOID WINAPI delaybuffer_loadout(VOID) = 0;
-
-		VOID WINAPI buffer_play(VOID);
-		VOID WINAPI audiodevice_wait(VOID);
-};
-
-#endif /*AUDIOPB_HPP*/
+/*
+	Real-Time Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#ifndef AUDIOPB_HPP
+#define AUDIOPB_HPP
+
+#include "globldef.h"
+#include "strdef.hpp"
+#include "shared.hpp"
+
+#include "AudioDelay.hpp"
+#include "FileMap.hpp"
+#include "SegmentRing.hpp"
+#include "LatencyHistogram.hpp"
+#include "AudioSink_WASAPI.hpp"
+
+struct _audiopb_params {
+	ULONG64 audio_data_begin;
+	ULONG64 audio_data_end;
+	const TCHAR *file_dir;
+	ULONG_PTR sample_rate;
+	ULONG_PTR n_channels;
+	ULONG_PTR audiobuffer_size_frames;
+	ULONG_PTR streambuffer_segment_size_frames;
+	ULONG_PTR streambuffer_n_segments; /*Pipeline depth: processed segments the DSP thread queues ahead of the device feed. Rounded up to a power of 2.*/
+	ULONG_PTR delay_buffer_size_frames;
+	ULONG_PTR n_ff_delays;
+	ULONG_PTR n_fb_delays;
+	ULONG_PTR delay_xfade_size_frames;
+	ULONG_PTR readahead_size_frames; /*The input reader thread decodes up to this many frames ahead of playback.*/
+	ULONG_PTR readblock_size_bytes; /*Input file read granularity, 256 KiB to 4 MiB (see FileMap::setReadBlockSize()). 0 for the default size.*/
+	BOOL dither; /*TPDF dither on 16 bit output (see pcmconv_f32_to_i16_dither()). Ignored by the other formats.*/
+	INT xrun_policy; /*Device underrun recovery, one of AudioPB::XRUN_POLICY_* (0: XRUN_POLICY_SILENCE).*/
+};
+
+typedef struct _audiopb_params audiopb_params_t;
+
+struct _audiopb_readahead_stats {
+	ULONG_PTR depth_segments; /*read-ahead ring size*/
+	ULONG_PTR fill_segments; /*decoded segments ready right now*/
+	ULONG_PTR fill_min_segments; /*lowest fill level seen by the playback loop since playback started*/
+	ULONG64 n_segments_read; /*segments decoded by the reader thread*/
+	ULONG64 n_starved; /*times the DSP thread found no decoded segment ready and had to wait for the reader thread*/
+};
+
+typedef struct _audiopb_readahead_stats audiopb_readahead_stats_t;
+
+struct _audiopb_pipeline_stats {
+	ULONG_PTR depth_segments; /*DSP to device feed ring size*/
+	ULONG_PTR fill_segments; /*processed segments ready right now*/
+	ULONG_PTR fill_min_segments; /*lowest fill level seen by the device feed since playback started*/
+	ULONG64 n_segments_processed; /*segments run through the delay by the DSP thread*/
+	ULONG64 n_starved; /*times the device feed found no processed segment ready (a silent segment was played instead)*/
+};
+
+typedef struct _audiopb_pipeline_stats audiopb_pipeline_stats_t;
+
+#define AUDIOPB_XRUN_HISTORY_LENGTH 16U
+
+struct _audiopb_xrun_event {
+	DOUBLE time_s; /*time since playback started*/
+	ULONG64 position_frames; /*audio data position played right after the underrun*/
+	ULONG_PTR lost_frames; /*silence the device played, in frames (estimated if the sink has no stream position)*/
+};
+
+typedef struct _audiopb_xrun_event audiopb_xrun_event_t;
+
+struct _audiopb_xrun_stats {
+	ULONG64 n_xruns; /*device underruns since playback started*/
+	ULONG64 n_frames_lost; /*sum of lost_frames*/
+	ULONG64 n_segments_skipped; /*segments dropped to catch up with the device (XRUN_POLICY_SKIP)*/
+	ULONG_PTR n_buffer_grows; /*times the device buffer was doubled (XRUN_POLICY_GROW)*/
+	ULONG_PTR buffer_size_frames; /*device buffer size right now*/
+	DOUBLE run_time_s; /*time since playback started (until it ended)*/
+	DOUBLE xruns_per_hour;
+	ULONG_PTR n_events; /*valid entries in events, oldest first*/
+	audiopb_xrun_event_t events[AUDIOPB_XRUN_HISTORY_LENGTH]; /*latest underruns*/
+};
+
+typedef struct _audiopb_xrun_stats audiopb_xrun_stats_t;
+
+#define AUDIOPB_N_STAGES 5U
+
+struct _audiopb_stage_stats {
+	latencyhist_stats_t stages[AUDIOPB_N_STAGES]; /*time per call, indexed by AudioPB::STAGE_* */
+	latencyhist_stats_t dsp_segment; /*DSP thread time per processed segment (loadin + runDSP + loadout)*/
+	DOUBLE segment_budget_us; /*real-time length of one stream segment*/
+	DOUBLE dsp_load_mean_pct; /*DSP load: dsp_segment time in percent of segment_budget_us*/
+	DOUBLE dsp_load_p99_pct;
+	DOUBLE dsp_load_max_pct;
+};
+
+typedef struct _audiopb_stage_stats audiopb_stage_stats_t;
+
+class AudioPB {
+	public:
+		AudioPB(const audiopb_params_t *p_params);
+		virtual ~AudioPB(VOID);
+
+		BOOL WINAPI setParameters(const audiopb_params_t *p_params);
+		BOOL WINAPI initialize(VOID);
+		BOOL WINAPI runPlayback(VOID);
+
+		/*
+			Pause and resume are requests: they only change the status, the playback thread stops or starts the device once its current wait is over.
+			getStatus() reports the requested state right away.
+		*/
+		VOID WINAPI pausePlayback(VOID);
+		VOID WINAPI resumePlayback(VOID);
+		VOID WINAPI stopPlayback(VOID);
+
+		LONG64 WINAPI getAudioDataSizeFrames(VOID);
+		LONG64 WINAPI getAudioDataPositionFrames(VOID);
+		BOOL WINAPI setAudioDataPositionFrames(ULONG64 position);
+
+		BOOL WINAPI getReadAheadStats(audiopb_readahead_stats_t *p_stats);
+		BOOL WINAPI getPipelineStats(audiopb_pipeline_stats_t *p_stats);
+
+		/*Device underruns. Can be called from any thread. Kept after playback ends, until the next playback starts.*/
+		BOOL WINAPI getXrunStats(audiopb_xrun_stats_t *p_stats);
+
+		/*
+			Playback loop stage timings and DSP load. Can be called from any thread while playback runs.
+			Kept after playback ends, until the next playback starts.
+		*/
+		BOOL WINAPI getStageStats(audiopb_stage_stats_t *p_stats);
+
+		/*Device wait wake-up lateness (see AudioSink::getWaitStats()). Kept after playback ends, until the next initialize().*/
+		BOOL WINAPI getDeviceWaitStats(audiosink_wait_stats_t *p_stats);
+
+		/*
+			Plays to p_sink instead of the WASAPI device (NULL to go back to the WASAPI device). Only while not initialized.
+			The sink is not owned by AudioPB. It must stay valid until it is replaced by another setSink() call or the AudioPB object is destroyed.
+			The audio device list methods below always refer to the WASAPI device.
+		*/
+		BOOL WINAPI setSink(AudioSink *p_sink);
+
+		BOOL WINAPI loadAudioDeviceList(VOID);
+		LONG_PTR WINAPI getAudioDeviceListEntryCount(VOID);
+		const TCHAR* WINAPI getAudioDeviceListEntry(ULONG_PTR index);
+
+		BOOL WINAPI chooseDevice(ULONG_PTR index);
+		BOOL WINAPI chooseDefaultDevice(VOID);
+
+		INT WINAPI getStatus(VOID);
+		__string WINAPI getLastErrorMessage(VOID);
+
+		/* INTERNAL AudioDelay object routing methods */
+
+		FLOAT WINAPI delayGetDryInputAmplitude(VOID);
+		FLOAT WINAPI delayGetOutputAmplitude(VOID);
+
+		BOOL WINAPI delaySetDryInputAmplitude(FLOAT amp);
+		BOOL WINAPI delaySetOutputAmplitude(FLOAT amp);
+
+		LONG_PTR WINAPI delayGetFFDelay(ULONG_PTR n_fx);
+		FLOAT WINAPI delayGetFFAmplitude(ULONG_PTR n_fx);
+
+		BOOL WINAPI delaySetFFDelay(ULONG_PTR n_fx, ULONG_PTR delay);
+		BOOL WINAPI delaySetFFAmplitude(ULONG_PTR n_fx, FLOAT amp);
+
+		LONG_PTR WINAPI delayGetFBDelay(ULONG_PTR n_fx);
+		FLOAT WINAPI delayGetFBAmplitude(ULONG_PTR n_fx);
+
+		BOOL WINAPI delaySetFBDelay(ULONG_PTR n_fx, ULONG_PTR delay);
+		BOOL WINAPI delaySetFBAmplitude(ULONG_PTR n_fx, FLOAT amp);
+
+		BOOL WINAPI delaySetFFDelayFractional(ULONG_PTR n_fx, DOUBLE delay);
+		BOOL WINAPI delaySetFBDelayFractional(ULONG_PTR n_fx, DOUBLE delay);
+
+		/*Delay time modulation. depth in frames, rate in Hz (see AudioDelay::setFFModulation()).*/
+		BOOL WINAPI delaySetFFModulation(ULONG_PTR n_fx, INT shape, FLOAT depth, FLOAT rate_hz);
+		BOOL WINAPI delaySetFBModulation(ULONG_PTR n_fx, INT shape, FLOAT depth, FLOAT rate_hz);
+
+		BOOL WINAPI delayResetFFParams(VOID);
+		BOOL WINAPI delayResetFBParams(VOID);
+
+		BOOL WINAPI delayBeginParamsUpdate(VOID);
+		BOOL WINAPI delayCommitParamsUpdate(VOID);
+
+		enum Status {
+			STATUS_ERROR_INVALIDPARAMS = -5,
+			STATUS_ERROR_MEMORY = -4,
+			STATUS_ERROR_AUDIOHW = -3,
+			STATUS_ERROR_NOFILE = -2,
+			STATUS_ERROR_GENERIC = -1,
+			STATUS_UNINITIALIZED = 0,
+			STATUS_READY = 1,
+			STATUS_RUNNING = 2,
+			STATUS_PAUSED = 3,
+			STATUS_STOPPED = 4
+		};
+
+		enum XrunPolicy {
+			XRUN_POLICY_SILENCE = 0, /*Carry on where the stream was: the device played silence for the dropout, the output is late by that much.*/
+			XRUN_POLICY_SKIP = 1, /*Drop the processed segments the device missed, so the output stays in sync with the device clock.*/
+			XRUN_POLICY_GROW = 2 /*Double the device buffer (the sink is re-opened and restarts from silence), up to XRUN_GROW_MAX_FACTOR times its initial size.*/
+		};
+
+		enum Stage {
+			STAGE_BUFFER_PLAY = 0, /*Playback thread: copy the next processed segment to the device (includes waiting for the DSP thread when the pipeline is empty).*/
+			STAGE_LOADIN = 1, /*DSP thread: decoded segment into the delay input buffer.*/
+			STAGE_RUNDSP = 2, /*DSP thread: AudioDelay::runDSP().*/
+			STAGE_LOADOUT = 3, /*DSP thread: delay output to the device format.*/
+			STAGE_DEVICE_WAIT = 4 /*Playback thread: wait for device buffer space.*/
+		};
+
+	protected:
+		static constexpr ULONG_PTR N_CHANNELS_MIN = 1u;
+		static constexpr ULONG_PTR STREAMBUFFER_N_SEGMENTS_MIN = 2u;
+		static constexpr ULONG_PTR STREAMBUFFER_SEGMENT_SIZE_FRAMES_MIN = 32u;
+
+		static constexpr ULONG_PTR READAHEAD_N_SEGMENTS_MIN = 2u;
+		static constexpr DWORD READAHEAD_WAIT_MS = 100u;
+		static constexpr DWORD READAHEAD_PREFILL_TIMEOUT_MS = 1000u;
+		static constexpr LONG READAHEAD_FLAG_END = 0x1;
+
+		static constexpr DWORD PIPELINE_WAIT_MS = 100u;
+		static constexpr DWORD PIPELINE_PREFILL_TIMEOUT_MS = 1000u;
+		static constexpr DWORD PIPELINE_FEED_WAIT_MS = 1u;
+
+		static constexpr DWORD AUDIODEVICE_WAIT_TIMEOUT_MS = 100u;
+
+		static constexpr ULONG_PTR XRUN_GROW_MAX_FACTOR = 8u;
+		static constexpr DWORD XRUN_SLACK_US = 100u; /*With no device position, a drained buffer only counts as an underrun when the estimated loss is longer than this (timing noise).*/
+
+		__declspec(align(PTR_SIZE_BYTES)) fileptr64_t filein_size_64 = {
+			.l32 = 0u,
+			.h32 = 0u
+		};
+
+		__declspec(align(PTR_SIZE_BYTES)) fileptr64_t filein_pos_64 = {
+			.l32 = 0u,
+			.h32 = 0u
+		};
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 AUDIO_DATA_BEGIN = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 AUDIO_DATA_END = 0u;
+
+		FileMap filein;
+
+		/*
+			FileMap is not thread safe: with FILEIN_DIRECT set the DSP thread reads the input through its own view.
+			Only open while FILEIN_DIRECT is set.
+		*/
+		FileMap filein_dsp;
+
+		/*
+			Input read-ahead.
+			The reader thread decodes the input file into readahead_ring, READAHEAD_N_SEGMENTS stream segments ahead of playback.
+			The DSP thread only pops decoded segments, it never touches the file.
+			With FILEIN_DIRECT set the reader only maps the segment (which prefetches it) and the slot carries its position and size,
+			the DSP thread then decodes it from filein_dsp straight into the delay input buffer.
+			A position change (seek) bumps readahead_seek_gen: the reader restarts from readahead_seek_pos,
+			and the DSP thread drops the slots tagged with an older generation.
+		*/
+		SegmentRing readahead_ring;
+
+		__declspec(align(PTR_SIZE_BYTES)) HANDLE p_readahead_thread = NULL;
+
+		__declspec(align(8)) volatile LONG64 readahead_seek_pos = 0;
+		__declspec(align(4)) volatile LONG readahead_seek_gen = 0;
+		__declspec(align(4)) volatile LONG readahead_quit = 0;
+
+		/*Reader thread state*/
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 readahead_pos = 0u;
+		__declspec(align(4)) LONG readahead_gen = 0;
+		__declspec(align(4)) volatile LONG readahead_end = 0;
+
+		/*DSP thread state*/
+		__declspec(align(4)) LONG readahead_gen_play = 0;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR readahead_fill_min = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 readahead_n_segments_read = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 readahead_n_starved = 0u;
+
+		/*
+			Processing pipeline: reader thread -> readahead_ring -> DSP thread -> stream_ring -> playback thread -> device.
+			The DSP thread runs the delay and converts to the device format, STREAMBUFFER_N_SEGMENTS segments ahead of the device feed.
+			The playback thread only copies processed segments to the device and waits for buffer space,
+			so file reads and DSP overlap the device wait instead of adding up in front of it.
+			stream_ring slots keep the read-ahead generation: the playback thread drops the segments processed before a position change.
+		*/
+		SegmentRing stream_ring;
+
+		__declspec(align(PTR_SIZE_BYTES)) HANDLE p_dsp_thread = NULL;
+		__declspec(align(4)) volatile LONG dsp_quit = 0;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 dsp_n_segments_processed = 0u;
+
+		/*Playback thread state*/
+		__declspec(align(4)) LONG stream_gen_play = 0;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR stream_fill_min = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 stream_n_starved = 0u;
+
+		/*
+			Device underruns (xruns).
+			The playback thread checks the device before writing each segment.
+			If the sink reports its stream position, a position past the frames written so far means the device played silence (exact loss).
+			Otherwise a sink padding of 0 is an underrun if the time since the previous padding sample is longer than the frames queued then take to play
+			(a device that reads whole periods at once drains the buffer all the time), and the difference is the estimated loss.
+			The counters and the event history are only written by the playback thread. xrun_seq is odd while they are being updated,
+			so getXrunStats() reads a consistent copy from any thread without stopping playback.
+		*/
+		__declspec(align(4)) volatile LONG xrun_seq = 0;
+		__declspec(align(4)) INT XRUN_POLICY = this->XRUN_POLICY_SILENCE;
+
+		__declspec(align(8)) LONG64 xrun_perf_freq = 1;
+		__declspec(align(8)) LONG64 xrun_time_start = 0;
+		__declspec(align(8)) LONG64 xrun_time_end = 0; /*0 while playback runs*/
+
+		/*Frames written since the sink was started, and the silence the device played (position - written) at the last check.*/
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 xrun_frames_written = 0u;
+		__declspec(align(8)) LONG64 xrun_deficit = 0;
+
+		/*
+			Last sink padding sample (right after each write, and at each check) and the time it was measured at.
+			xrun_padding_time is 0 when unknown (after a pause).
+		*/
+		__declspec(align(8)) LONG64 xrun_padding_time = 0;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR xrun_padding_frames = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 xrun_n = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 xrun_frames_lost = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 xrun_n_segments_skipped = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR xrun_n_grows = 0u;
+		__declspec(align(4)) BOOL xrun_grow_stop = FALSE; /*buffer at its maximum size, or the device refused a larger one*/
+
+		__declspec(align(PTR_SIZE_BYTES)) audiopb_xrun_event_t xrun_events[AUDIOPB_XRUN_HISTORY_LENGTH]; /*ring, entry xrun_n % AUDIOPB_XRUN_HISTORY_LENGTH is the next one*/
+
+		/*
+			Stage timings.
+			Each stage is timed with the performance counter around the call, on the thread that runs it,
+			into a lock-free histogram (see LatencyHistogram), so they are read while playback runs.
+			Reset when playback starts, before the pipeline threads.
+		*/
+		LatencyHistogram stage_hist[AUDIOPB_N_STAGES];
+		LatencyHistogram dsp_segment_hist;
+
+		__declspec(align(PTR_SIZE_BYTES)) AudioDelay *p_delay = NULL;
+
+		AudioSink_WASAPI sink_wasapi;
+
+		__declspec(align(PTR_SIZE_BYTES)) AudioSink *p_sink = NULL; /*&sink_wasapi or the sink given to setSink()*/
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIOBUFFER_SIZE_FRAMES_BASE = 0u; /*buffer size from the parameters, AUDIOBUFFER_SIZE_FRAMES may grow from it (XRUN_POLICY_GROW)*/
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIOBUFFER_SIZE_FRAMES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIOBUFFER_SIZE_SAMPLES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIOBUFFER_SIZE_BYTES = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR STREAMBUFFER_SEGMENT_SIZE_FRAMES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR STREAMBUFFER_SEGMENT_SIZE_SAMPLES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR STREAMBUFFER_SEGMENT_SIZE_BYTES = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR STREAMBUFFER_N_SEGMENTS = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR INPUTBUFFER_SIZE_BYTES = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR READAHEAD_SIZE_FRAMES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR READAHEAD_N_SEGMENTS = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR READBLOCK_SIZE_BYTES = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODELAY_BUFFER_SIZE_FRAMES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODELAY_BUFFER_N_SEGMENTS = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODELAY_FF_PARAMS_LENGTH = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODELAY_FB_PARAMS_LENGTH = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODELAY_XFADE_SIZE_FRAMES = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR SAMPLE_RATE = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR N_CHANNELS = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR FILE_BYTES_PER_SAMPLE = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIO_BYTES_PER_SAMPLE = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODATA_BITS_PER_SAMPLE = 0u;
+		__declspec(align(4)) BOOL AUDIODATA_IS_FLOAT = FALSE; /*device stream is IEEE float instead of PCM*/
+		__declspec(align(4)) BOOL DITHER = FALSE;
+		__declspec(align(4)) BOOL FILEIN_DIRECT = FALSE; /*input is decoded by the DSP thread, not through the read-ahead slots (see filein_dsp)*/
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR delaybuffer_nseg = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) __string FILEIN_DIR = TEXT("");
+		__declspec(align(PTR_SIZE_BYTES)) __string err_msg = TEXT("");
+
+		/*Written by the control thread only through pausePlayback()/resumePlayback() (interlocked), and by stopPlayback().*/
+		__declspec(align(4)) volatile LONG status = this->STATUS_UNINITIALIZED;
+
+		/*The sink was stopped by a pause request (playback thread only).*/
+		__declspec(align(4)) BOOL sink_paused = FALSE;
+
+		VOID WINAPI deinitialize(VOID);
+
+		BOOL WINAPI filein_open(VOID);
+		VOID WINAPI filein_close(VOID);
+
+		/*
+			filein_get_segment()
+			returns a pointer to the input file data of the stream segment at file position pos (read straight from the mapped file p_file).
+			*p_n_samples receives the number of whole samples available, which is less than a full segment at the end of the audio data.
+			Returns NULL if no data is available.
+		*/
+		const BYTE* WINAPI filein_get_segment(FileMap *p_file, ULONG64 pos, ULONG_PTR *p_n_samples);
+
+		/*Converts n_samples input file samples to FLOAT.*/
+		virtual VOID WINAPI filein_decode(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples) = 0;
+
+		static DWORD WINAPI readahead_thread_proc(VOID *p_args);
+
+		BOOL WINAPI readahead_start(VOID);
+		VOID WINAPI readahead_stop(VOID);
+		VOID WINAPI readahead_seek(ULONG64 pos);
+		VOID WINAPI readahead_loop(VOID);
+		VOID WINAPI readahead_read(segring_slot_t *p_slot);
+
+		BOOL WINAPI audiodevice_init(VOID);
+		VOID WINAPI audiodevice_deinit(VOID);
+
+		/*Fills the whole device buffer with silence and starts the sink.*/
+		BOOL WINAPI audiodevice_prefill(VOID);
+
+		/*
+			audiodevice_grow()
+			re-opens the sink with twice the buffer size, back to the previous size if the device does not take it.
+			returns TRUE if the buffer grew, FALSE if it is at its maximum size or the device refused it.
+			If the sink cannot be re-opened at all, status is set to STATUS_ERROR_AUDIOHW (playback stops, runPlayback() returns FALSE).
+		*/
+		BOOL WINAPI audiodevice_grow(VOID);
+		VOID WINAPI audiodevice_set_size(ULONG_PTR size_frames);
+
+		BOOL WINAPI buffer_alloc(VOID);
+		BOOL WINAPI buffer_free(VOID);
+
+		VOID WINAPI playback_proc(VOID);
+		VOID WINAPI playback_init(VOID);
+		VOID WINAPI playback_loop(VOID);
+
+		static DWORD WINAPI dsp_thread_proc(VOID *p_args);
+
+		BOOL WINAPI dsp_start(VOID);
+		VOID WINAPI dsp_stop(VOID);
+		VOID WINAPI dsp_loop(VOID);
+
+		VOID WINAPI delaybuffer_nseg_update(VOID);
+
+		/*
+			delaybuffer_loadin()
+			pops the next decoded segment into the delay input buffer, and fills in the stream_ring slot info (generation, file position, end flag).
+			returns FALSE if no decoded segment is ready.
+		*/
+		BOOL WINAPI delaybuffer_loadin(segring_slot_t *p_stream_slot);
+
+		/*Converts the delay output buffer segment to the device format, into p_output (one stream segment).*/
+		virtual VOID WINAPI delaybuffer_loadout(BYTE *p_output) = 0;
+
+		VOID WINAPI buffer_play(VOID);
+		VOID WINAPI audiodevice_wait(VOID);
+
+		VOID WINAPI xrun_reset(VOID);
+
+		/*Checks the device for an underrun before the next segment is written, records it and applies XRUN_POLICY.*/
+		VOID WINAPI xrun_check(VOID);
+
+		/*Returns the frames of silence the device played since the last check (0: no underrun).*/
+		ULONG_PTR WINAPI xrun_detect(VOID);
+		/*Samples the sink padding into xrun_padding_frames/xrun_padding_time.*/
+		VOID WINAPI xrun_padding_update(VOID);
+
+		VOID WINAPI xrun_record(ULONG_PTR lost_frames);
+		VOID WINAPI xrun_skip(ULONG_PTR lost_frames);
+};
+
+#endif /*AUDIOPB_HPP*/
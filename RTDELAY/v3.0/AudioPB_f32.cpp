@@ -0,0 +1,45 @@
+/*
+	Real-Time Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#include "AudioPB_f32.hpp"
+#include "pcmconv.hpp"
+
+AudioPB_f32::AudioPB_f32(const audiopb_params_t *p_params) : AudioPB(p_params)
+{
+	this->AUDIO_BYTES_PER_SAMPLE = 4u;
+	this->FILE_BYTES_PER_SAMPLE = 4u;
+	this->AUDIODATA_BITS_PER_SAMPLE = 32u;
+	this->AUDIODATA_IS_FLOAT = TRUE;
+	this->FILEIN_DIRECT = TRUE;
+}
+
+AudioPB_f32::~AudioPB_f32(VOID)
+{
+	this->deinitialize();
+}
+
+VOID WINAPI AudioPB_f32::filein_decode(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	pcmconv_float32_to_f32(p_dst, p_src, n_samples);
+	return;
+}
+
+VOID WINAPI AudioPB_f32::delaybuffer_loadout(BYTE *p_output)
+{
+	FLOAT *p_loadseg_f32 = NULL;
+
+	p_loadseg_f32 = this->p_delay->getOutputBufferSegment(this->delaybuffer_nseg);
+	if(p_loadseg_f32 == NULL)
+	{
+		this->err_msg = TEXT("AudioPB_f32::delaybuffer_loadout: Error: AudioDelay::getOutputBufferSegment returned NULL.\r\nExtended Error Message: ") + this->p_delay->getLastErrorMessage();
+		app_exit((UINT) -1, this->err_msg.c_str());
+	}
+
+	pcmconv_f32_to_float32(p_output, p_loadseg_f32, this->STREAMBUFFER_SEGMENT_SIZE_SAMPLES);
+	return;
+}
@@ -0,0 +1,30 @@
+/*
+	Real-Time Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*
+	32 bit IEEE float input, played as 32 bit IEEE float.
+	There is no conversion, so the DSP thread copies the input from the mapped file straight into the delay input buffer (FILEIN_DIRECT),
+	the read-ahead ring only carries the segment positions.
+*/
+
+#ifndef AUDIOPB_F32_HPP
+#define AUDIOPB_F32_HPP
+
+#include "AudioPB.hpp"
+
+class AudioPB_f32 : public AudioPB {
+	public:
+		AudioPB_f32(const audiopb_params_t *p_params);
+		~AudioPB_f32(VOID);
+
+	private:
+		VOID WINAPI filein_decode(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples) override;
+		VOID WINAPI delaybuffer_loadout(BYTE *p_output) override;
+};
+
+#endif /*AUDIOPB_F32_HPP*/
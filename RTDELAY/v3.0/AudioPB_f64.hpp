@@ -0,0 +1,26 @@
+/*
+	Real-Time Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*64 bit IEEE float input, played as 32 bit IEEE float (exclusive mode devices do not take 64 bit samples).*/
+
+#ifndef AUDIOPB_F64_HPP
+#define AUDIOPB_F64_HPP
+
+#include "AudioPB.hpp"
+
+class AudioPB_f64 : public AudioPB {
+	public:
+		AudioPB_f64(const audiopb_params_t *p_params);
+		~AudioPB_f64(VOID);
+
+	private:
+		VOID WINAPI filein_decode(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples) override;
+		VOID WINAPI delaybuffer_loadout(BYTE *p_output) override;
+};
+
+#endif /*AUDIOPB_F64_HPP*/
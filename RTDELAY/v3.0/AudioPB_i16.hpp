@@ -1,26 +1,29 @@
-/*
-	Real-Time Audio Delay 2 application for Windows
-	Version 3.0
-
-	Author: Rafael Sabe
-	Email: rafaelmsabe@gmail.com
-*/
-
-#ifndef AUDIOPB_I16_HPP
-#define AUDIOPB_I16_HPP
-
-#include "AudioPB.hpp"
-
-class AudioPB_i16 : public AudioPB {
-	public:
-		AudioPB_i16(const audiopb_params_t *p_params);
-		~AudioPB_i16(VOID);
-
-	private:
-		static constexpr FLOAT SAMPLE_FACTOR = 32768.0f;
-
-		VOID WINAPI delaybuffer_loadin(VOID) override;
-		VOID WINAPI delaybuffer_loadout(VOID) override;
-};
-
-#endif /*AUDIOPB_I16_HPP*/
+/*
+	Real-Time Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#ifndef AUDIOPB_I16_HPP
+#define AUDIOPB_I16_HPP
+
+#include "AudioPB.hpp"
+#include "pcmconv.hpp"
+
+class AudioPB_i16 : public AudioPB {
+	public:
+		AudioPB_i16(const audiopb_params_t *p_params);
+		~AudioPB_i16(VOID);
+
+	private:
+		static constexpr UINT32 DITHER_SEED = 0x2545f491u;
+
+		__declspec(align(PTR_SIZE_BYTES)) pcmconv_dither_t dither;
+
+		VOID WINAPI filein_decode(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples) override;
+		VOID WINAPI delaybuffer_loadout(BYTE *p_output) override;
+};
+
+#endif /*AUDIOPB_I16_HPP*/
@@ -0,0 +1,26 @@
+/*
+	Real-Time Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*32 bit PCM input, played as 32 bit PCM.*/
+
+#ifndef AUDIOPB_I32_HPP
+#define AUDIOPB_I32_HPP
+
+#include "AudioPB.hpp"
+
+class AudioPB_i32 : public AudioPB {
+	public:
+		AudioPB_i32(const audiopb_params_t *p_params);
+		~AudioPB_i32(VOID);
+
+	private:
+		VOID WINAPI filein_decode(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples) override;
+		VOID WINAPI delaybuffer_loadout(BYTE *p_output) override;
+};
+
+#endif /*AUDIOPB_I32_HPP*/
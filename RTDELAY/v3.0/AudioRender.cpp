@@ -0,0 +1,1048 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#include "AudioRender.hpp"
+#include "pcmconv.hpp"
+#include "wavfile.hpp"
+#include "thread.h"
+
+AudioRender::AudioRender(const audiorender_params_t *p_params)
+{
+	this->setParameters(p_params);
+}
+
+AudioRender::~AudioRender(VOID)
+{
+	this->deinitialize();
+}
+
+BOOL WINAPI AudioRender::setParameters(const audiorender_params_t *p_params)
+{
+	SYSTEM_INFO sysinfo;
+
+	if(this->status > 0)
+	{
+		this->err_msg = TEXT("AudioRender::setParameters: Error: cannot set parameters, AudioRender object already initialized.");
+		return FALSE;
+	}
+
+	if(p_params == NULL)
+	{
+		this->err_msg = TEXT("AudioRender::setParameters: Error: given params object is invalid.");
+		return FALSE;
+	}
+
+	if((p_params->filein_dir == NULL) || (p_params->fileout_dir == NULL))
+	{
+		this->err_msg = TEXT("AudioRender::setParameters: Error: given file directory is invalid.");
+		return FALSE;
+	}
+
+	this->status = this->STATUS_UNINITIALIZED;
+
+	this->FILEIN_DIR = p_params->filein_dir;
+	this->FILEOUT_DIR = p_params->fileout_dir;
+	this->SEGMENT_SIZE_FRAMES = _get_closest_power2_ceil(p_params->segment_size_frames);
+	this->AUDIODELAY_BUFFER_SIZE_FRAMES = _get_closest_power2_ceil(p_params->delay_buffer_size_frames);
+	this->AUDIODELAY_FF_PARAMS_LENGTH = p_params->n_ff_delays;
+	this->AUDIODELAY_FB_PARAMS_LENGTH = p_params->n_fb_delays;
+	this->AUDIODELAY_XFADE_SIZE_FRAMES = p_params->delay_xfade_size_frames;
+	this->TAIL_SIZE_MS = p_params->tail_size_ms;
+	this->READBLOCK_SIZE_BYTES = p_params->readblock_size_bytes;
+
+	this->N_THREADS = p_params->n_threads;
+	if(!this->N_THREADS)
+	{
+		GetSystemInfo(&sysinfo);
+		this->N_THREADS = (ULONG_PTR) sysinfo.dwNumberOfProcessors;
+	}
+
+	if(this->N_THREADS > this->N_THREADS_MAX) this->N_THREADS = this->N_THREADS_MAX;
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioRender::initialize(VOID)
+{
+	audiodelay_init_params_t delay_params;
+
+	if(this->status > 0) return TRUE;
+
+	this->status = this->STATUS_UNINITIALIZED;
+
+	if(this->SEGMENT_SIZE_FRAMES < this->SEGMENT_SIZE_FRAMES_MIN)
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioRender::initialize: Error: invalid segment size.");
+		return FALSE;
+	}
+
+	if(this->AUDIODELAY_BUFFER_SIZE_FRAMES < this->SEGMENT_SIZE_FRAMES)
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioRender::initialize: Error: invalid delay buffer size. (delay buffer is smaller than segment).");
+		return FALSE;
+	}
+
+	if(!this->filein_open())
+	{
+		this->status = this->STATUS_ERROR_FILE;
+		return FALSE;
+	}
+
+	this->SEGMENT_SIZE_SAMPLES = (this->SEGMENT_SIZE_FRAMES)*(this->N_CHANNELS);
+	this->SEGMENT_SIZE_BYTES = (this->SEGMENT_SIZE_SAMPLES)*(this->BYTES_PER_SAMPLE);
+
+	if(this->SEGMENT_SIZE_BYTES > this->filein.getRegionSizeMax())
+	{
+		this->status = this->STATUS_ERROR_INVALIDPARAMS;
+		this->err_msg = TEXT("AudioRender::initialize: Error: invalid segment size. (segment is too large for the input file view).");
+		this->filein_close();
+		return FALSE;
+	}
+
+	this->WRITEBUFFER_N_SEGMENTS = (this->WRITEBUFFER_SIZE_BYTES_TARGET)/(this->SEGMENT_SIZE_BYTES);
+	if(!this->WRITEBUFFER_N_SEGMENTS) this->WRITEBUFFER_N_SEGMENTS = 1u;
+
+	this->WRITEBUFFER_SIZE_BYTES = (this->WRITEBUFFER_N_SEGMENTS)*(this->SEGMENT_SIZE_BYTES);
+
+	this->AUDIODELAY_BUFFER_N_SEGMENTS = (this->AUDIODELAY_BUFFER_SIZE_FRAMES)/(this->SEGMENT_SIZE_FRAMES);
+
+	if(!this->buffer_alloc())
+	{
+		this->status = this->STATUS_ERROR_MEMORY;
+		this->filein_close();
+		return FALSE;
+	}
+
+	delay_params.buffer_size_frames = this->AUDIODELAY_BUFFER_SIZE_FRAMES;
+	delay_params.buffer_n_segments = this->AUDIODELAY_BUFFER_N_SEGMENTS;
+	delay_params.n_channels = this->N_CHANNELS;
+	delay_params.n_ff_delays = this->AUDIODELAY_FF_PARAMS_LENGTH;
+	delay_params.n_fb_delays = this->AUDIODELAY_FB_PARAMS_LENGTH;
+	delay_params.kernel_isa = DSPKERNEL_ISA_AUTO;
+	delay_params.gain_ramp_mode = AudioDelay::GAINRAMP_LINEAR;
+	delay_params.xfade_size_frames = this->AUDIODELAY_XFADE_SIZE_FRAMES;
+	delay_params.interp_mode = AudioDelay::INTERP_HERMITE;
+
+	/*
+		The AudioDelay object is kept from one render to the next.
+		With the same layout as the previous render, its buffers are cleared (reset()) and reused instead of being reallocated.
+	*/
+
+	if(this->p_delay == NULL)
+	{
+		this->p_delay = new AudioDelay(&delay_params);
+		if(this->p_delay == NULL)
+		{
+			this->status = this->STATUS_ERROR_MEMORY;
+			this->err_msg = TEXT("AudioRender::initialize: Error: AudioDelay object instance failed.");
+			this->filein_close();
+			this->buffer_free();
+			return FALSE;
+		}
+	}
+	else if(!this->delay_params_match(&delay_params) || !this->p_delay->reset()) this->p_delay->setInitParameters(&delay_params);
+
+	this->delay_params = delay_params;
+
+	if(!this->p_delay->initialize())
+	{
+		this->status = this->STATUS_ERROR_GENERIC;
+		this->err_msg = this->p_delay->getLastErrorMessage();
+		this->filein_close();
+		this->buffer_free();
+		return FALSE;
+	}
+
+	this->status = this->STATUS_READY;
+	return TRUE;
+}
+
+BOOL WINAPI AudioRender::setPreset(const audiorender_preset_t *p_preset)
+{
+	if(this->status != this->STATUS_READY)
+	{
+		this->err_msg = TEXT("AudioRender::setPreset: Error: AudioRender object is either not initialized or already rendering.");
+		return FALSE;
+	}
+
+	if(p_preset == NULL)
+	{
+		this->err_msg = TEXT("AudioRender::setPreset: Error: given preset object is invalid.");
+		return FALSE;
+	}
+
+	/*A NULL tap list means no taps (reset, zeroed parameters).*/
+
+	if(this->AUDIODELAY_FF_PARAMS_LENGTH)
+	{
+		if(p_preset->p_ff_params != NULL) CopyMemory(this->p_ff_preset, p_preset->p_ff_params, (this->AUDIODELAY_FF_PARAMS_LENGTH)*sizeof(audiodelay_fx_params_t));
+		else ZeroMemory(this->p_ff_preset, (this->AUDIODELAY_FF_PARAMS_LENGTH)*sizeof(audiodelay_fx_params_t));
+	}
+
+	if(this->AUDIODELAY_FB_PARAMS_LENGTH)
+	{
+		if(p_preset->p_fb_params != NULL) CopyMemory(this->p_fb_preset, p_preset->p_fb_params, (this->AUDIODELAY_FB_PARAMS_LENGTH)*sizeof(audiodelay_fx_params_t));
+		else ZeroMemory(this->p_fb_preset, (this->AUDIODELAY_FB_PARAMS_LENGTH)*sizeof(audiodelay_fx_params_t));
+	}
+
+	this->preset_dryinput_amp = p_preset->dryinput_amp;
+	this->preset_output_amp = p_preset->output_amp;
+
+	if(!this->delay_apply_preset(this->p_delay))
+	{
+		this->err_msg = TEXT("AudioRender::setPreset: Error: invalid preset.\r\nExtended error message: ") + this->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioRender::runRender(VOID)
+{
+	LARGE_INTEGER perf_freq;
+	LARGE_INTEGER perf_begin;
+	LARGE_INTEGER perf_end;
+	BOOL b_parallel = FALSE;
+	BOOL b_ret = FALSE;
+
+	if(this->status != this->STATUS_READY)
+	{
+		this->err_msg = TEXT("AudioRender::runRender: Error: AudioRender object is either not initialized or already rendering.");
+		return FALSE;
+	}
+
+	this->status = this->STATUS_RUNNING;
+
+	QueryPerformanceFrequency(&perf_freq);
+	QueryPerformanceCounter(&perf_begin);
+
+	b_parallel = this->parallel_check();
+
+	b_ret = this->fileout_open(b_parallel);
+	if(b_ret)
+	{
+		if(b_parallel) b_ret = this->render_parallel();
+		else b_ret = this->render_loop();
+	}
+
+	this->fileout_close(!b_ret);
+
+	QueryPerformanceCounter(&perf_end);
+
+	this->filein_close();
+	this->buffer_free();
+
+	if(b_ret)
+	{
+		this->stats.n_frames = this->OUTPUT_SIZE_FRAMES;
+		this->stats.n_threads = this->N_WORKERS;
+		this->stats.time_s = ((DOUBLE) (perf_end.QuadPart - perf_begin.QuadPart))/((DOUBLE) perf_freq.QuadPart);
+
+		if(this->stats.time_s > 0.0)
+		{
+			this->stats.frames_per_s = ((DOUBLE) this->stats.n_frames)/(this->stats.time_s);
+			this->stats.realtime_factor = (this->stats.frames_per_s)/((DOUBLE) this->SAMPLE_RATE);
+		}
+		else
+		{
+			this->stats.frames_per_s = 0.0;
+			this->stats.realtime_factor = 0.0;
+		}
+	}
+
+	this->status = this->STATUS_UNINITIALIZED;
+	return b_ret;
+}
+
+ULONG_PTR WINAPI AudioRender::getSampleRate(VOID)
+{
+	return this->SAMPLE_RATE;
+}
+
+ULONG_PTR WINAPI AudioRender::getChannelCount(VOID)
+{
+	return this->N_CHANNELS;
+}
+
+ULONG_PTR WINAPI AudioRender::getBitDepth(VOID)
+{
+	return this->BITS_PER_SAMPLE;
+}
+
+ULONG_PTR WINAPI AudioRender::getFormatTag(VOID)
+{
+	return this->FORMAT_TAG;
+}
+
+ULONG64 WINAPI AudioRender::getInputSizeFrames(VOID)
+{
+	return this->INPUT_SIZE_FRAMES;
+}
+
+ULONG64 WINAPI AudioRender::getOutputSizeFrames(VOID)
+{
+	return this->OUTPUT_SIZE_FRAMES;
+}
+
+BOOL WINAPI AudioRender::getRenderStats(audiorender_stats_t *p_stats)
+{
+	if(p_stats == NULL) return FALSE;
+
+	*p_stats = this->stats;
+	return TRUE;
+}
+
+INT WINAPI AudioRender::getStatus(VOID)
+{
+	return this->status;
+}
+
+__string WINAPI AudioRender::getLastErrorMessage(VOID)
+{
+	if(this->status == this->STATUS_UNINITIALIZED)
+		return TEXT("AudioRender object not initialized\r\nExtended error message: ") + this->err_msg;
+
+	return this->err_msg;
+}
+
+VOID WINAPI AudioRender::deinitialize(VOID)
+{
+	this->status = this->STATUS_UNINITIALIZED;
+
+	this->fileout_close(TRUE);
+	this->filein_close();
+	this->buffer_free();
+
+	if(this->p_delay != NULL)
+	{
+		delete this->p_delay;
+		this->p_delay = NULL;
+	}
+
+	return;
+}
+
+BOOL WINAPI AudioRender::filein_open(VOID)
+{
+	ULONG64 file_size = 0u;
+	wavfile_info_t wavinfo;
+
+	this->filein_close();
+
+	if(!this->filein.open(this->FILEIN_DIR.c_str()))
+	{
+		this->err_msg = TEXT("AudioRender::filein_open: Error: open input file failed.\r\nExtended error message: ") + this->filein.getLastErrorMessage();
+		return FALSE;
+	}
+
+	this->filein.setReadBlockSize(this->READBLOCK_SIZE_BYTES);
+
+	file_size = this->filein.getFileSize();
+
+	if(!wavfile_parse_header(&AudioRender::filein_read_proc, &(this->filein), file_size, &wavinfo, &(this->err_msg))) goto _l_filein_open_error;
+
+	this->pf_decode = NULL;
+	this->pf_encode = NULL;
+
+	if(wavinfo.format_tag == WAVFILE_FORMAT_IEEE_FLOAT)
+	{
+		switch(wavinfo.bits_per_sample)
+		{
+			case 32u:
+				this->pf_decode = &pcmconv_float32_to_f32;
+				this->pf_encode = &pcmconv_f32_to_float32;
+				break;
+
+			case 64u:
+				this->pf_decode = &pcmconv_float64_to_f32;
+				this->pf_encode = &pcmconv_f32_to_float64;
+				break;
+		}
+	}
+	else
+	{
+		switch(wavinfo.bits_per_sample)
+		{
+			case 16u:
+				this->pf_decode = &pcmconv_i16_to_f32;
+				this->pf_encode = &pcmconv_f32_to_i16;
+				break;
+
+			case 24u:
+				this->pf_decode = &pcmconv_i24_to_f32;
+				this->pf_encode = &pcmconv_f32_to_i24;
+				break;
+
+			case 32u:
+				this->pf_decode = &pcmconv_i32_to_f32;
+				this->pf_encode = &pcmconv_f32_to_i32;
+				break;
+		}
+	}
+
+	if(this->pf_decode == NULL)
+	{
+		this->err_msg = TEXT("AudioRender::filein_open: Error: audio format not supported.");
+		goto _l_filein_open_error;
+	}
+
+	if((!wavinfo.sample_rate) || (wavinfo.n_channels < this->N_CHANNELS_MIN))
+	{
+		this->err_msg = TEXT("AudioRender::filein_open: Error: invalid audio parameters in file header.");
+		goto _l_filein_open_error;
+	}
+
+	this->SAMPLE_RATE = wavinfo.sample_rate;
+	this->N_CHANNELS = wavinfo.n_channels;
+	this->BITS_PER_SAMPLE = wavinfo.bits_per_sample;
+	this->FORMAT_TAG = wavinfo.format_tag;
+	this->VALID_BITS_PER_SAMPLE = wavinfo.valid_bits_per_sample;
+	this->CHANNEL_MASK = wavinfo.channel_mask;
+	this->FORMAT_EXTENSIBLE = wavinfo.format_extensible;
+	this->BYTES_PER_SAMPLE = (this->BITS_PER_SAMPLE)/8u;
+	this->BYTES_PER_FRAME = (this->BYTES_PER_SAMPLE)*(this->N_CHANNELS);
+
+	/*Truncated files: wavfile_parse_header() clamps the audio data to the file size.*/
+	this->AUDIO_DATA_BEGIN = wavinfo.audio_data_begin;
+	this->AUDIO_DATA_END = wavinfo.audio_data_end;
+
+	this->TAIL_SIZE_FRAMES = (ULONG_PTR) ((((ULONG64) this->SAMPLE_RATE)*((ULONG64) this->TAIL_SIZE_MS))/1000u);
+
+	this->INPUT_SIZE_FRAMES = (this->AUDIO_DATA_END - this->AUDIO_DATA_BEGIN)/((ULONG64) this->BYTES_PER_FRAME);
+	this->OUTPUT_SIZE_FRAMES = this->INPUT_SIZE_FRAMES + ((ULONG64) this->TAIL_SIZE_FRAMES);
+
+	/*Only whole frames are rendered.*/
+	this->AUDIO_DATA_END = this->AUDIO_DATA_BEGIN + (this->INPUT_SIZE_FRAMES)*((ULONG64) this->BYTES_PER_FRAME);
+
+	return TRUE;
+
+_l_filein_open_error:
+	this->filein_close();
+	return FALSE;
+}
+
+VOID WINAPI AudioRender::filein_close(VOID)
+{
+	this->filein.close();
+	return;
+}
+
+/*wavfile_read_proc_t over the mapped input file (p_context is the FileMap object).*/
+
+ULONG_PTR WINAPI AudioRender::filein_read_proc(VOID *p_context, ULONG64 offset, VOID *p_dst, ULONG_PTR size)
+{
+	const BYTE *p_src = NULL;
+	ULONG_PTR size_ret = 0u;
+
+	p_src = ((FileMap*) p_context)->getRegion(offset, size, &size_ret);
+	if(p_src == NULL) return 0u;
+
+	CopyMemory(p_dst, p_src, size_ret);
+	return size_ret;
+}
+
+BOOL WINAPI AudioRender::fileout_open(BOOL random_access)
+{
+	wavfile_info_t wavinfo;
+	DWORD flags = 0u;
+
+	this->fileout_close(FALSE);
+
+	ZeroMemory(&wavinfo, sizeof(wavfile_info_t));
+	wavinfo.audio_data_begin = 0u;
+	wavinfo.audio_data_end = (this->OUTPUT_SIZE_FRAMES)*((ULONG64) this->BYTES_PER_FRAME);
+	wavinfo.sample_rate = this->SAMPLE_RATE;
+	wavinfo.n_channels = this->N_CHANNELS;
+	wavinfo.bits_per_sample = this->BITS_PER_SAMPLE;
+	wavinfo.format_tag = this->FORMAT_TAG;
+	wavinfo.valid_bits_per_sample = this->VALID_BITS_PER_SAMPLE;
+	wavinfo.channel_mask = this->CHANNEL_MASK;
+	wavinfo.format_extensible = this->FORMAT_EXTENSIBLE;
+
+	/*Outputs larger than 4 GiB are written as RF64.*/
+	this->OUTPUT_DATA_BEGIN = (ULONG64) wavfile_get_header_size(&wavinfo);
+
+	/*The chunk-parallel render writes the chunks in whatever order the workers finish them.*/
+	if(random_access) flags = FILE_FLAG_RANDOM_ACCESS;
+	else flags = FILE_FLAG_SEQUENTIAL_SCAN;
+
+	this->h_fileout = CreateFile(this->FILEOUT_DIR.c_str(), GENERIC_WRITE, 0u, NULL, CREATE_ALWAYS, (FILE_ATTRIBUTE_NORMAL | flags), NULL);
+	if(this->h_fileout == INVALID_HANDLE_VALUE)
+	{
+		this->err_msg = TEXT("AudioRender::fileout_open: Error: could not create output file.");
+		return FALSE;
+	}
+
+	if(!wavfile_write_header(this->h_fileout, &wavinfo))
+	{
+		this->err_msg = TEXT("AudioRender::fileout_open: Error: failed to write output file header.");
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+VOID WINAPI AudioRender::fileout_close(BOOL discard)
+{
+	if(this->h_fileout == INVALID_HANDLE_VALUE) return;
+
+	CloseHandle(this->h_fileout);
+	this->h_fileout = INVALID_HANDLE_VALUE;
+
+	if(discard) DeleteFile(this->FILEOUT_DIR.c_str());
+
+	return;
+}
+
+BOOL WINAPI AudioRender::buffer_alloc(VOID)
+{
+	this->buffer_free();
+
+	if(p_processheap == NULL)
+	{
+		this->err_msg = TEXT("AudioRender::buffer_alloc: Error: p_processheap is NULL.");
+		return FALSE;
+	}
+
+	this->p_writebuffer = (BYTE*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->WRITEBUFFER_SIZE_BYTES);
+	if(this->p_writebuffer == NULL) goto _l_buffer_alloc_error;
+
+	if(this->AUDIODELAY_FF_PARAMS_LENGTH)
+	{
+		this->p_ff_preset = (audiodelay_fx_params_t*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, (this->AUDIODELAY_FF_PARAMS_LENGTH)*sizeof(audiodelay_fx_params_t));
+		if(this->p_ff_preset == NULL) goto _l_buffer_alloc_error;
+	}
+
+	if(this->AUDIODELAY_FB_PARAMS_LENGTH)
+	{
+		this->p_fb_preset = (audiodelay_fx_params_t*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, (this->AUDIODELAY_FB_PARAMS_LENGTH)*sizeof(audiodelay_fx_params_t));
+		if(this->p_fb_preset == NULL) goto _l_buffer_alloc_error;
+	}
+
+	return TRUE;
+
+_l_buffer_alloc_error:
+	this->err_msg = TEXT("AudioRender::buffer_alloc: Error: failed to allocate heap memory.");
+	this->buffer_free();
+	return FALSE;
+}
+
+VOID WINAPI AudioRender::buffer_free(VOID)
+{
+	if(p_processheap == NULL) return;
+
+	if(this->p_writebuffer != NULL)
+	{
+		HeapFree(p_processheap, 0u, this->p_writebuffer);
+		this->p_writebuffer = NULL;
+	}
+
+	if(this->p_ff_preset != NULL)
+	{
+		HeapFree(p_processheap, 0u, this->p_ff_preset);
+		this->p_ff_preset = NULL;
+	}
+
+	if(this->p_fb_preset != NULL)
+	{
+		HeapFree(p_processheap, 0u, this->p_fb_preset);
+		this->p_fb_preset = NULL;
+	}
+
+	return;
+}
+
+BOOL WINAPI AudioRender::delay_params_match(const audiodelay_init_params_t *p_params)
+{
+	if(p_params->buffer_size_frames != this->delay_params.buffer_size_frames) return FALSE;
+	if(p_params->buffer_n_segments != this->delay_params.buffer_n_segments) return FALSE;
+	if(p_params->n_channels != this->delay_params.n_channels) return FALSE;
+	if(p_params->n_ff_delays != this->delay_params.n_ff_delays) return FALSE;
+	if(p_params->n_fb_delays != this->delay_params.n_fb_delays) return FALSE;
+	if(p_params->kernel_isa != this->delay_params.kernel_isa) return FALSE;
+	if(p_params->gain_ramp_mode != this->delay_params.gain_ramp_mode) return FALSE;
+	if(p_params->xfade_size_frames != this->delay_params.xfade_size_frames) return FALSE;
+	if(p_params->interp_mode != this->delay_params.interp_mode) return FALSE;
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioRender::delay_apply_preset(AudioDelay *p_dst)
+{
+	ULONG_PTR n_fx = 0u;
+	const audiodelay_fx_params_t *p_fx = NULL;
+	DOUBLE delay = 0.0;
+	BOOL b_ret = TRUE;
+
+	p_dst->beginParamsUpdate();
+
+	b_ret = (b_ret && p_dst->resetFFParams());
+	b_ret = (b_ret && p_dst->resetFBParams());
+	b_ret = (b_ret && p_dst->setDryInputAmplitude(this->preset_dryinput_amp));
+	b_ret = (b_ret && p_dst->setOutputAmplitude(this->preset_output_amp));
+
+	for(n_fx = 0u; b_ret && (n_fx < this->AUDIODELAY_FF_PARAMS_LENGTH); n_fx++)
+	{
+		p_fx = &(this->p_ff_preset[n_fx]);
+
+		if(p_fx->delay_frac)
+		{
+			delay = ((DOUBLE) p_fx->delay) + ((DOUBLE) p_fx->delay_frac)/4294967296.0;
+			b_ret = p_dst->setFFDelayFractional(n_fx, delay);
+		}
+		else b_ret = p_dst->setFFDelay(n_fx, (ULONG_PTR) p_fx->delay);
+
+		b_ret = (b_ret && p_dst->setFFAmplitude(n_fx, p_fx->amp));
+
+		if(b_ret && (p_fx->mod_shape != AudioDelay::MOD_NONE)) b_ret = p_dst->setFFModulation(n_fx, p_fx->mod_shape, p_fx->mod_depth, p_fx->mod_rate);
+	}
+
+	for(n_fx = 0u; b_ret && (n_fx < this->AUDIODELAY_FB_PARAMS_LENGTH); n_fx++)
+	{
+		p_fx = &(this->p_fb_preset[n_fx]);
+
+		if(p_fx->delay_frac)
+		{
+			delay = ((DOUBLE) p_fx->delay) + ((DOUBLE) p_fx->delay_frac)/4294967296.0;
+			b_ret = p_dst->setFBDelayFractional(n_fx, delay);
+		}
+		else b_ret = p_dst->setFBDelay(n_fx, (ULONG_PTR) p_fx->delay);
+
+		b_ret = (b_ret && p_dst->setFBAmplitude(n_fx, p_fx->amp));
+
+		if(b_ret && (p_fx->mod_shape != AudioDelay::MOD_NONE)) b_ret = p_dst->setFBModulation(n_fx, p_fx->mod_shape, p_fx->mod_depth, p_fx->mod_rate);
+	}
+
+	p_dst->commitParamsUpdate();
+
+	return b_ret;
+}
+
+/*
+	Loads the input segment that starts at input frame n_frame into p_seg_in.
+	Frames before the start or past the end of the input (pre-roll, tail) are silence.
+*/
+
+BOOL WINAPI AudioRender::segment_load(FileMap *p_file, FLOAT *p_seg_in, LONG64 n_frame, __string *p_err_msg)
+{
+	ULONG_PTR seg_nframe = 0u;
+	ULONG_PTR n_frames = 0u;
+	ULONG_PTR size = 0u;
+	const BYTE *p_src = NULL;
+
+	if(n_frame < 0)
+	{
+		if(n_frame <= -((LONG64) this->SEGMENT_SIZE_FRAMES))
+		{
+			ZeroMemory(p_seg_in, (this->SEGMENT_SIZE_SAMPLES)*sizeof(FLOAT));
+			return TRUE;
+		}
+
+		seg_nframe = (ULONG_PTR) (-n_frame);
+		n_frame = 0;
+
+		ZeroMemory(p_seg_in, seg_nframe*(this->N_CHANNELS)*sizeof(FLOAT));
+	}
+
+	if(((ULONG64) n_frame) < this->INPUT_SIZE_FRAMES)
+	{
+		n_frames = this->SEGMENT_SIZE_FRAMES - seg_nframe;
+		if((this->INPUT_SIZE_FRAMES - ((ULONG64) n_frame)) < ((ULONG64) n_frames)) n_frames = (ULONG_PTR) (this->INPUT_SIZE_FRAMES - ((ULONG64) n_frame));
+
+		p_src = p_file->getRegion((this->AUDIO_DATA_BEGIN + ((ULONG64) n_frame)*((ULONG64) this->BYTES_PER_FRAME)), n_frames*(this->BYTES_PER_FRAME), &size);
+		if(p_src == NULL)
+		{
+			*p_err_msg = TEXT("AudioRender::segment_load: Error: failed to read input file.\r\nExtended error message: ") + p_file->getLastErrorMessage();
+			return FALSE;
+		}
+
+		n_frames = size/(this->BYTES_PER_FRAME);
+		this->pf_decode(&p_seg_in[seg_nframe*(this->N_CHANNELS)], p_src, n_frames*(this->N_CHANNELS));
+
+		seg_nframe += n_frames;
+	}
+
+	/*Past the end of the input (tail): silence*/
+	if(seg_nframe < this->SEGMENT_SIZE_FRAMES) ZeroMemory(&p_seg_in[seg_nframe*(this->N_CHANNELS)], (this->SEGMENT_SIZE_FRAMES - seg_nframe)*(this->N_CHANNELS)*sizeof(FLOAT));
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioRender::render_loop(VOID)
+{
+	ULONG64 n_frame = 0u;
+	ULONG64 writebuffer_nframe = 0u;
+	ULONG_PTR n_segment = 0u;
+	ULONG_PTR n_frames = 0u;
+	ULONG_PTR writebuffer_pos = 0u;
+	FLOAT *p_seg_in = NULL;
+	FLOAT *p_seg_out = NULL;
+
+	while(n_frame < this->OUTPUT_SIZE_FRAMES)
+	{
+		p_seg_in = this->p_delay->getInputBufferSegment(n_segment);
+		p_seg_out = this->p_delay->getOutputBufferSegment(n_segment);
+
+		if((p_seg_in == NULL) || (p_seg_out == NULL))
+		{
+			this->err_msg = TEXT("AudioRender::render_loop: Error: AudioDelay returned a NULL buffer segment.\r\nExtended error message: ") + this->p_delay->getLastErrorMessage();
+			return FALSE;
+		}
+
+		if(!this->segment_load(&(this->filein), p_seg_in, (LONG64) n_frame, &(this->err_msg))) return FALSE;
+
+		if(!this->p_delay->runDSP(n_segment))
+		{
+			this->err_msg = TEXT("AudioRender::render_loop: Error: AudioDelay::runDSP failed.\r\nExtended error message: ") + this->p_delay->getLastErrorMessage();
+			return FALSE;
+		}
+
+		n_frames = this->SEGMENT_SIZE_FRAMES;
+		if((this->OUTPUT_SIZE_FRAMES - n_frame) < ((ULONG64) n_frames)) n_frames = (ULONG_PTR) (this->OUTPUT_SIZE_FRAMES - n_frame);
+
+		this->pf_encode(&(this->p_writebuffer[writebuffer_pos]), p_seg_out, n_frames*(this->N_CHANNELS));
+		writebuffer_pos += n_frames*(this->BYTES_PER_FRAME);
+
+		n_frame += (ULONG64) n_frames;
+
+		if(writebuffer_pos >= this->WRITEBUFFER_SIZE_BYTES)
+		{
+			if(!this->writebuffer_flush(this->p_writebuffer, writebuffer_pos, writebuffer_nframe, &(this->err_msg))) return FALSE;
+
+			writebuffer_nframe = n_frame;
+			writebuffer_pos = 0u;
+		}
+
+		n_segment++;
+		n_segment %= this->AUDIODELAY_BUFFER_N_SEGMENTS;
+	}
+
+	if(writebuffer_pos)
+	{
+		if(!this->writebuffer_flush(this->p_writebuffer, writebuffer_pos, writebuffer_nframe, &(this->err_msg))) return FALSE;
+	}
+
+	return TRUE;
+}
+
+/*
+	Checks whether the preset can be rendered in parallel, and sets up the chunks.
+	Feedback taps make every output frame depend on all the input before it. Modulated taps depend on the absolute LFO phase.
+*/
+
+BOOL WINAPI AudioRender::parallel_check(VOID)
+{
+	ULONG_PTR n_fx = 0u;
+	ULONG64 delay = 0u;
+	ULONG64 delay_max = 0u;
+	ULONG64 chunk_size = 0u;
+	ULONG64 size = 0u;
+
+	this->N_WORKERS = 1u;
+
+	if(this->N_THREADS < 2u) return FALSE;
+
+	for(n_fx = 0u; n_fx < this->AUDIODELAY_FB_PARAMS_LENGTH; n_fx++)
+	{
+		if(this->p_fb_preset[n_fx].amp != 0.0f) return FALSE;
+	}
+
+	for(n_fx = 0u; n_fx < this->AUDIODELAY_FF_PARAMS_LENGTH; n_fx++)
+	{
+		if(this->p_ff_preset[n_fx].amp == 0.0f) continue;
+		if(this->p_ff_preset[n_fx].mod_shape != AudioDelay::MOD_NONE) return FALSE;
+
+		delay = (ULONG64) this->p_ff_preset[n_fx].delay;
+		if(this->p_ff_preset[n_fx].delay_frac) delay++;
+
+		if(delay > delay_max) delay_max = delay;
+	}
+
+	/*Pre-roll: longest delay, plus the frames past it read by the 4 point interpolator, in whole segments.*/
+	this->PREROLL_SIZE_FRAMES = delay_max + 4u;
+	this->PREROLL_SIZE_FRAMES = (this->PREROLL_SIZE_FRAMES + ((ULONG64) this->SEGMENT_SIZE_FRAMES) - 1u)/((ULONG64) this->SEGMENT_SIZE_FRAMES)*((ULONG64) this->SEGMENT_SIZE_FRAMES);
+
+	chunk_size = this->CHUNK_SIZE_FRAMES_MIN;
+
+	size = (this->CHUNK_PREROLL_RATIO)*(this->PREROLL_SIZE_FRAMES);
+	if(size > chunk_size) chunk_size = size;
+
+	size = (this->OUTPUT_SIZE_FRAMES)/(((ULONG64) this->N_THREADS)*(this->CHUNKS_PER_THREAD));
+	if(size > chunk_size) chunk_size = size;
+
+	this->CHUNK_SIZE_FRAMES = (chunk_size + ((ULONG64) this->SEGMENT_SIZE_FRAMES) - 1u)/((ULONG64) this->SEGMENT_SIZE_FRAMES)*((ULONG64) this->SEGMENT_SIZE_FRAMES);
+	this->N_CHUNKS = (this->OUTPUT_SIZE_FRAMES + this->CHUNK_SIZE_FRAMES - 1u)/(this->CHUNK_SIZE_FRAMES);
+
+	/*Too short to be worth it.*/
+	if(this->N_CHUNKS < 2u) return FALSE;
+
+	this->N_WORKERS = this->N_THREADS;
+	if(((ULONG64) this->N_WORKERS) > this->N_CHUNKS) this->N_WORKERS = (ULONG_PTR) this->N_CHUNKS;
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioRender::render_parallel(VOID)
+{
+	ULONG_PTR n_worker = 0u;
+	BOOL b_ret = TRUE;
+
+	this->p_workers = (audiorender_worker_t*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, (this->N_WORKERS)*sizeof(audiorender_worker_t));
+	if(this->p_workers == NULL)
+	{
+		this->err_msg = TEXT("AudioRender::render_parallel: Error: failed to allocate heap memory.");
+		return FALSE;
+	}
+
+	this->chunk_next = 0;
+	this->worker_failed = 0;
+
+	for(n_worker = 0u; n_worker < this->N_WORKERS; n_worker++)
+	{
+		this->p_workers[n_worker].p_render = this;
+
+		b_ret = this->worker_init(&(this->p_workers[n_worker]));
+		if(!b_ret) break;
+	}
+
+	for(n_worker = 0u; b_ret && (n_worker < this->N_WORKERS); n_worker++)
+	{
+		this->p_workers[n_worker].p_thread = thread_create_default(&AudioRender::worker_thread_proc, &(this->p_workers[n_worker]), NULL);
+		if(this->p_workers[n_worker].p_thread == NULL)
+		{
+			/*Stops the workers already running.*/
+			this->worker_set_error(TEXT("AudioRender::render_parallel: Error: failed to create worker thread."));
+			b_ret = FALSE;
+		}
+	}
+
+	for(n_worker = 0u; n_worker < this->N_WORKERS; n_worker++)
+	{
+		if(this->p_workers[n_worker].p_thread != NULL) thread_wait(&(this->p_workers[n_worker].p_thread));
+	}
+
+	if(this->worker_failed) b_ret = FALSE;
+
+	for(n_worker = 0u; n_worker < this->N_WORKERS; n_worker++) this->worker_deinit(&(this->p_workers[n_worker]));
+
+	HeapFree(p_processheap, 0u, this->p_workers);
+	this->p_workers = NULL;
+
+	return b_ret;
+}
+
+BOOL WINAPI AudioRender::worker_init(audiorender_worker_t *p_worker)
+{
+	p_worker->p_delay = new AudioDelay(&(this->delay_params));
+	if(p_worker->p_delay == NULL)
+	{
+		this->err_msg = TEXT("AudioRender::worker_init: Error: AudioDelay object instance failed.");
+		return FALSE;
+	}
+
+	if(!p_worker->p_delay->initialize())
+	{
+		this->err_msg = TEXT("AudioRender::worker_init: Error: AudioDelay initialize failed.\r\nExtended error message: ") + p_worker->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	if(!this->delay_apply_preset(p_worker->p_delay))
+	{
+		this->err_msg = TEXT("AudioRender::worker_init: Error: invalid preset.\r\nExtended error message: ") + p_worker->p_delay->getLastErrorMessage();
+		return FALSE;
+	}
+
+	/*FileMap is not thread safe: every worker reads the input through its own view.*/
+	p_worker->p_filein = new FileMap();
+	if(p_worker->p_filein == NULL)
+	{
+		this->err_msg = TEXT("AudioRender::worker_init: Error: FileMap object instance failed.");
+		return FALSE;
+	}
+
+	if(!p_worker->p_filein->open(this->FILEIN_DIR.c_str()))
+	{
+		this->err_msg = TEXT("AudioRender::worker_init: Error: open input file failed.\r\nExtended error message: ") + p_worker->p_filein->getLastErrorMessage();
+		return FALSE;
+	}
+
+	p_worker->p_filein->setReadBlockSize(this->READBLOCK_SIZE_BYTES);
+
+	p_worker->p_writebuffer = (BYTE*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, this->WRITEBUFFER_SIZE_BYTES);
+	if(p_worker->p_writebuffer == NULL)
+	{
+		this->err_msg = TEXT("AudioRender::worker_init: Error: failed to allocate heap memory.");
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+VOID WINAPI AudioRender::worker_deinit(audiorender_worker_t *p_worker)
+{
+	if(p_worker->p_delay != NULL)
+	{
+		delete p_worker->p_delay;
+		p_worker->p_delay = NULL;
+	}
+
+	if(p_worker->p_filein != NULL)
+	{
+		delete p_worker->p_filein;
+		p_worker->p_filein = NULL;
+	}
+
+	if(p_worker->p_writebuffer != NULL)
+	{
+		HeapFree(p_processheap, 0u, p_worker->p_writebuffer);
+		p_worker->p_writebuffer = NULL;
+	}
+
+	return;
+}
+
+DWORD WINAPI AudioRender::worker_thread_proc(VOID *p_args)
+{
+	audiorender_worker_t *p_worker = (audiorender_worker_t*) p_args;
+
+	p_worker->p_render->worker_loop(p_worker);
+	return 0u;
+}
+
+/*Workers take the next chunk not yet taken until there are none left, so the faster ones render more chunks.*/
+
+VOID WINAPI AudioRender::worker_loop(audiorender_worker_t *p_worker)
+{
+	__string msg = TEXT("");
+	LONG n_chunk = 0;
+
+	while(!this->worker_failed)
+	{
+		n_chunk = InterlockedIncrement(&(this->chunk_next)) - 1;
+		if(((ULONG64) n_chunk) >= this->N_CHUNKS) break;
+
+		if(!this->worker_render_chunk(p_worker, (ULONG64) n_chunk, &msg))
+		{
+			this->worker_set_error(msg);
+			break;
+		}
+	}
+
+	return;
+}
+
+/*
+	Renders the output frames [n_chunk*CHUNK_SIZE_FRAMES, (n_chunk + 1)*CHUNK_SIZE_FRAMES) into the output file.
+	Rendering starts PREROLL_SIZE_FRAMES early, which fills the delay buffer with the input the chunk depends on
+	(and overwrites whatever the previous chunk left in there). The pre-roll output is dropped.
+*/
+
+BOOL WINAPI AudioRender::worker_render_chunk(audiorender_worker_t *p_worker, ULONG64 n_chunk, __string *p_err_msg)
+{
+	ULONG64 chunk_begin = 0u;
+	ULONG64 chunk_end = 0u;
+	ULONG64 writebuffer_nframe = 0u;
+	LONG64 n_frame = 0;
+	ULONG_PTR n_segment = 0u;
+	ULONG_PTR n_frames = 0u;
+	ULONG_PTR writebuffer_pos = 0u;
+	FLOAT *p_seg_in = NULL;
+	FLOAT *p_seg_out = NULL;
+
+	chunk_begin = n_chunk*(this->CHUNK_SIZE_FRAMES);
+	chunk_end = chunk_begin + this->CHUNK_SIZE_FRAMES;
+	if(chunk_end > this->OUTPUT_SIZE_FRAMES) chunk_end = this->OUTPUT_SIZE_FRAMES;
+
+	writebuffer_nframe = chunk_begin;
+	n_frame = ((LONG64) chunk_begin) - ((LONG64) this->PREROLL_SIZE_FRAMES);
+
+	while(n_frame < ((LONG64) chunk_end))
+	{
+		if(this->worker_failed) return TRUE;
+
+		p_seg_in = p_worker->p_delay->getInputBufferSegment(n_segment);
+		p_seg_out = p_worker->p_delay->getOutputBufferSegment(n_segment);
+
+		if((p_seg_in == NULL) || (p_seg_out == NULL))
+		{
+			*p_err_msg = TEXT("AudioRender::worker_render_chunk: Error: AudioDelay returned a NULL buffer segment.\r\nExtended error message: ") + p_worker->p_delay->getLastErrorMessage();
+			return FALSE;
+		}
+
+		if(!this->segment_load(p_worker->p_filein, p_seg_in, n_frame, p_err_msg)) return FALSE;
+
+		if(!p_worker->p_delay->runDSP(n_segment))
+		{
+			*p_err_msg = TEXT("AudioRender::worker_render_chunk: Error: AudioDelay::runDSP failed.\r\nExtended error message: ") + p_worker->p_delay->getLastErrorMessage();
+			return FALSE;
+		}
+
+		/*Chunk and pre-roll are whole segments: a segment is either all pre-roll or all chunk.*/
+		if(n_frame >= ((LONG64) chunk_begin))
+		{
+			n_frames = this->SEGMENT_SIZE_FRAMES;
+			if((chunk_end - ((ULONG64) n_frame)) < ((ULONG64) n_frames)) n_frames = (ULONG_PTR) (chunk_end - ((ULONG64) n_frame));
+
+			this->pf_encode(&(p_worker->p_writebuffer[writebuffer_pos]), p_seg_out, n_frames*(this->N_CHANNELS));
+			writebuffer_pos += n_frames*(this->BYTES_PER_FRAME);
+
+			if(writebuffer_pos >= this->WRITEBUFFER_SIZE_BYTES)
+			{
+				if(!this->writebuffer_flush(p_worker->p_writebuffer, writebuffer_pos, writebuffer_nframe, p_err_msg)) return FALSE;
+
+				writebuffer_nframe = ((ULONG64) n_frame) + ((ULONG64) n_frames);
+				writebuffer_pos = 0u;
+			}
+		}
+
+		n_frame += (LONG64) this->SEGMENT_SIZE_FRAMES;
+
+		n_segment++;
+		n_segment %= this->AUDIODELAY_BUFFER_N_SEGMENTS;
+	}
+
+	if(writebuffer_pos)
+	{
+		if(!this->writebuffer_flush(p_worker->p_writebuffer, writebuffer_pos, writebuffer_nframe, p_err_msg)) return FALSE;
+	}
+
+	return TRUE;
+}
+
+/*Called from the worker threads: only the first error is kept, and it makes the other workers stop.*/
+
+VOID WINAPI AudioRender::worker_set_error(const __string &msg)
+{
+	if(InterlockedCompareExchange(&(this->worker_failed), 1, 0) == 0) this->err_msg = msg;
+	return;
+}
+
+/*Writes size bytes from p_buffer into the output file, at output frame n_frame. Parallel workers share the output file handle.*/
+
+BOOL WINAPI AudioRender::writebuffer_flush(const BYTE *p_buffer, ULONG_PTR size, ULONG64 n_frame, __string *p_err_msg)
+{
+	OVERLAPPED overlapped;
+	ULONG64 file_pos = 0u;
+	DWORD n_written = 0u;
+
+	file_pos = this->OUTPUT_DATA_BEGIN + n_frame*((ULONG64) this->BYTES_PER_FRAME);
+
+	ZeroMemory(&overlapped, sizeof(OVERLAPPED));
+	overlapped.Offset = (DWORD) (file_pos & 0xffffffffu);
+	overlapped.OffsetHigh = (DWORD) (file_pos >> 32);
+
+	if(!WriteFile(this->h_fileout, p_buffer, (DWORD) size, &n_written, &overlapped) || (n_written != (DWORD) size))
+	{
+		*p_err_msg = TEXT("AudioRender::writebuffer_flush: Error: failed to write output file.");
+		return FALSE;
+	}
+
+	return TRUE;
+}
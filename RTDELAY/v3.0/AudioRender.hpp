@@ -0,0 +1,260 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*
+	Offline (non real-time) render: runs a WAVE file through the AudioDelay effect and writes the result to a new WAVE file.
+
+	There is no audio device and no playback clock: segments are decoded, processed and encoded back to back, as fast as the CPU
+	and the disk allow. The input is read straight from the mapped file (FileMap), the output is written in large blocks.
+	The output has the same sample rate, channel count and sample format as the input, and is tail_size_ms longer than the input
+	(the input is followed by silence, to let the delay taps ring out).
+
+	The effect parameters are set once, before rendering (setPreset()), and apply from the first frame on (no initial gain ramp).
+
+	Feedforward only presets (all feedback amplitudes 0, no delay modulation) are rendered in parallel:
+	an output frame then only depends on the input frames within the longest feedforward delay before it,
+	so the output is cut into chunks, and each chunk is rendered on its own worker thread, starting that many frames early (pre-roll).
+	Every worker has its own AudioDelay instance and input file view, and writes its chunks straight to their place in the output file.
+	The result is bit-identical to a sequential render. Presets with feedback or modulation are always rendered sequentially.
+*/
+
+#ifndef AUDIORENDER_HPP
+#define AUDIORENDER_HPP
+
+#include "globldef.h"
+#include "strdef.hpp"
+
+#include "AudioDelay.hpp"
+#include "FileMap.hpp"
+
+struct _audiorender_params {
+	const TCHAR *filein_dir;
+	const TCHAR *fileout_dir;
+	ULONG_PTR segment_size_frames; /*DSP block size*/
+	ULONG_PTR delay_buffer_size_frames;
+	ULONG_PTR n_ff_delays;
+	ULONG_PTR n_fb_delays;
+	ULONG_PTR delay_xfade_size_frames;
+	ULONG_PTR tail_size_ms; /*Output rendered past the end of the input (milliseconds).*/
+	ULONG_PTR readblock_size_bytes; /*Input file read granularity (see FileMap::setReadBlockSize()). 0 for the default size.*/
+	ULONG_PTR n_threads; /*Worker threads for parallel rendering. 0 for one per CPU, 1 to always render sequentially.*/
+};
+
+typedef struct _audiorender_params audiorender_params_t;
+
+/*Effect parameters for a render. p_ff_params/p_fb_params hold n_ff_delays/n_fb_delays entries, or are NULL for no taps.*/
+
+struct _audiorender_preset {
+	FLOAT dryinput_amp;
+	FLOAT output_amp;
+	const audiodelay_fx_params_t *p_ff_params;
+	const audiodelay_fx_params_t *p_fb_params;
+};
+
+typedef struct _audiorender_preset audiorender_preset_t;
+
+struct _audiorender_stats {
+	ULONG64 n_frames; /*output frames rendered*/
+	DOUBLE time_s; /*wall clock render time (seconds), file output included*/
+	DOUBLE frames_per_s; /*render throughput*/
+	DOUBLE realtime_factor; /*audio duration/render time: how many times faster than real-time playback*/
+	ULONG_PTR n_threads; /*worker threads used (1: sequential render)*/
+};
+
+typedef struct _audiorender_stats audiorender_stats_t;
+
+typedef VOID (WINAPI *audiorender_decode_proc_t)(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples);
+typedef VOID (WINAPI *audiorender_encode_proc_t)(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples);
+
+class AudioRender;
+
+/*Parallel render worker: one thread, with its own effect instance, input file view and write buffer.*/
+
+struct _audiorender_worker {
+	AudioRender *p_render;
+	HANDLE p_thread;
+	AudioDelay *p_delay;
+	FileMap *p_filein;
+	BYTE *p_writebuffer;
+};
+
+typedef struct _audiorender_worker audiorender_worker_t;
+
+class AudioRender {
+	public:
+		AudioRender(const audiorender_params_t *p_params);
+		~AudioRender(VOID);
+
+		BOOL WINAPI setParameters(const audiorender_params_t *p_params);
+
+		/*Opens and checks the input file and sets up the effect. The output file is only created by runRender().*/
+		BOOL WINAPI initialize(VOID);
+
+		/*Sets the effect parameters. Must be called after initialize(), before runRender().*/
+		BOOL WINAPI setPreset(const audiorender_preset_t *p_preset);
+
+		/*
+			Renders the whole input file into the output file. Blocks until done.
+			The output file is deleted if the render fails.
+			The object goes back to uninitialized afterwards (initialize() again to render another file).
+		*/
+		BOOL WINAPI runRender(VOID);
+
+		ULONG_PTR WINAPI getSampleRate(VOID);
+		ULONG_PTR WINAPI getChannelCount(VOID);
+		ULONG_PTR WINAPI getBitDepth(VOID);
+		ULONG_PTR WINAPI getFormatTag(VOID); /*WAVFILE_FORMAT_PCM or WAVFILE_FORMAT_IEEE_FLOAT*/
+		ULONG64 WINAPI getInputSizeFrames(VOID);
+		ULONG64 WINAPI getOutputSizeFrames(VOID);
+
+		/*Stats of the last completed render.*/
+		BOOL WINAPI getRenderStats(audiorender_stats_t *p_stats);
+
+		INT WINAPI getStatus(VOID);
+		__string WINAPI getLastErrorMessage(VOID);
+
+		enum Status {
+			STATUS_ERROR_INVALIDPARAMS = -4,
+			STATUS_ERROR_MEMORY = -3,
+			STATUS_ERROR_FILE = -2,
+			STATUS_ERROR_GENERIC = -1,
+			STATUS_UNINITIALIZED = 0,
+			STATUS_READY = 1,
+			STATUS_RUNNING = 2
+		};
+
+	private:
+		static constexpr ULONG_PTR N_CHANNELS_MIN = 1u;
+		static constexpr ULONG_PTR SEGMENT_SIZE_FRAMES_MIN = 32u;
+		static constexpr ULONG_PTR WRITEBUFFER_SIZE_BYTES_TARGET = 0x100000u; /*1 MiB*/
+
+		/*
+			Parallel render chunk size: at least CHUNK_SIZE_FRAMES_MIN, and at least CHUNK_PREROLL_RATIO times the pre-roll, to keep the pre-roll overhead low.
+			Above that, the output is cut into about CHUNKS_PER_THREAD chunks per worker, so that workers finishing early pick up the remaining chunks.
+		*/
+		static constexpr ULONG64 CHUNK_SIZE_FRAMES_MIN = 0x40000u;
+		static constexpr ULONG64 CHUNK_PREROLL_RATIO = 8u;
+		static constexpr ULONG64 CHUNKS_PER_THREAD = 4u;
+		static constexpr ULONG_PTR N_THREADS_MAX = 256u;
+
+		FileMap filein;
+
+		__declspec(align(PTR_SIZE_BYTES)) HANDLE h_fileout = INVALID_HANDLE_VALUE;
+
+		__declspec(align(PTR_SIZE_BYTES)) AudioDelay *p_delay = NULL;
+
+		__declspec(align(PTR_SIZE_BYTES)) audiodelay_init_params_t delay_params;
+
+		/*Copy of the preset, applied again to every parallel worker's AudioDelay instance.*/
+		__declspec(align(PTR_SIZE_BYTES)) audiodelay_fx_params_t *p_ff_preset = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) audiodelay_fx_params_t *p_fb_preset = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) FLOAT preset_dryinput_amp = 0.0f;
+		__declspec(align(PTR_SIZE_BYTES)) FLOAT preset_output_amp = 0.0f;
+
+		__declspec(align(PTR_SIZE_BYTES)) audiorender_worker_t *p_workers = NULL;
+
+		__declspec(align(PTR_SIZE_BYTES)) BYTE *p_writebuffer = NULL;
+
+		__declspec(align(PTR_SIZE_BYTES)) audiorender_decode_proc_t pf_decode = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) audiorender_encode_proc_t pf_encode = NULL;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 AUDIO_DATA_BEGIN = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 AUDIO_DATA_END = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 OUTPUT_DATA_BEGIN = 0u; /*output file header size*/
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 INPUT_SIZE_FRAMES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 OUTPUT_SIZE_FRAMES = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR SAMPLE_RATE = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR N_CHANNELS = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BITS_PER_SAMPLE = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR FORMAT_TAG = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BYTES_PER_SAMPLE = 0u;
+
+		/*Carried over to the output file header (speaker layout, container/valid bits split).*/
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR VALID_BITS_PER_SAMPLE = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR CHANNEL_MASK = 0u;
+		__declspec(align(4)) BOOL FORMAT_EXTENSIBLE = FALSE;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BYTES_PER_FRAME = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR SEGMENT_SIZE_FRAMES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR SEGMENT_SIZE_SAMPLES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR SEGMENT_SIZE_BYTES = 0u; /*file bytes*/
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR WRITEBUFFER_N_SEGMENTS = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR WRITEBUFFER_SIZE_BYTES = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODELAY_BUFFER_SIZE_FRAMES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODELAY_BUFFER_N_SEGMENTS = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODELAY_FF_PARAMS_LENGTH = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODELAY_FB_PARAMS_LENGTH = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR AUDIODELAY_XFADE_SIZE_FRAMES = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR TAIL_SIZE_MS = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR TAIL_SIZE_FRAMES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR READBLOCK_SIZE_BYTES = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR N_THREADS = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR N_WORKERS = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 PREROLL_SIZE_FRAMES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 CHUNK_SIZE_FRAMES = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 N_CHUNKS = 0u;
+
+		__declspec(align(4)) volatile LONG chunk_next = 0;
+		__declspec(align(4)) volatile LONG worker_failed = 0;
+
+		__declspec(align(PTR_SIZE_BYTES)) audiorender_stats_t stats = {
+			.n_frames = 0u,
+			.time_s = 0.0,
+			.frames_per_s = 0.0,
+			.realtime_factor = 0.0,
+			.n_threads = 0u
+		};
+
+		__declspec(align(PTR_SIZE_BYTES)) __string FILEIN_DIR = TEXT("");
+		__declspec(align(PTR_SIZE_BYTES)) __string FILEOUT_DIR = TEXT("");
+		__declspec(align(PTR_SIZE_BYTES)) __string err_msg = TEXT("");
+
+		__declspec(align(4)) INT status = this->STATUS_UNINITIALIZED;
+
+		VOID WINAPI deinitialize(VOID);
+
+		BOOL WINAPI filein_open(VOID);
+		VOID WINAPI filein_close(VOID);
+
+		static ULONG_PTR WINAPI filein_read_proc(VOID *p_context, ULONG64 offset, VOID *p_dst, ULONG_PTR size);
+
+		/*random_access: the output is written out of order (chunk-parallel render), the file is not opened for sequential access.*/
+		BOOL WINAPI fileout_open(BOOL random_access);
+		VOID WINAPI fileout_close(BOOL discard);
+
+		BOOL WINAPI buffer_alloc(VOID);
+		VOID WINAPI buffer_free(VOID);
+
+		BOOL WINAPI delay_params_match(const audiodelay_init_params_t *p_params);
+		BOOL WINAPI delay_apply_preset(AudioDelay *p_dst);
+
+		BOOL WINAPI segment_load(FileMap *p_file, FLOAT *p_seg_in, LONG64 n_frame, __string *p_err_msg);
+
+		BOOL WINAPI render_loop(VOID);
+
+		BOOL WINAPI parallel_check(VOID);
+		BOOL WINAPI render_parallel(VOID);
+		BOOL WINAPI worker_init(audiorender_worker_t *p_worker);
+		VOID WINAPI worker_deinit(audiorender_worker_t *p_worker);
+		VOID WINAPI worker_loop(audiorender_worker_t *p_worker);
+		BOOL WINAPI worker_render_chunk(audiorender_worker_t *p_worker, ULONG64 n_chunk, __string *p_err_msg);
+		VOID WINAPI worker_set_error(const __string &msg);
+
+		static DWORD WINAPI worker_thread_proc(VOID *p_args);
+
+		BOOL WINAPI writebuffer_flush(const BYTE *p_buffer, ULONG_PTR size, ULONG64 n_frame, __string *p_err_msg);
+};
+
+#endif /*AUDIORENDER_HPP*/
@@ -0,0 +1,243 @@
+/*
+	Real-Time Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#include "AudioSink.hpp"
+
+typedef HANDLE (WINAPI *audiosink_create_timer_proc_t)(SECURITY_ATTRIBUTES *p_attributes, const WCHAR *timer_name, DWORD flags, DWORD access);
+
+AudioSink::AudioSink(VOID)
+{
+	LARGE_INTEGER perf_freq;
+	HMODULE h_kernel32 = NULL;
+	audiosink_create_timer_proc_t pf_create_timer = NULL;
+
+	QueryPerformanceFrequency(&perf_freq);
+	this->PERF_FREQ = (LONG64) perf_freq.QuadPart;
+
+	/*CreateWaitableTimerExW() is not available before Windows Vista, high resolution timers not before Windows 10 1803*/
+	h_kernel32 = GetModuleHandle(TEXT("kernel32.dll"));
+	if(h_kernel32 != NULL) pf_create_timer = (audiosink_create_timer_proc_t) GetProcAddress(h_kernel32, "CreateWaitableTimerExW");
+
+	if(pf_create_timer != NULL) this->h_timer = pf_create_timer(NULL, NULL, this->CREATE_WAITABLE_TIMER_HIGH_RES, TIMER_ALL_ACCESS);
+	if(this->h_timer == NULL) this->h_timer = CreateWaitableTimer(NULL, FALSE, NULL);
+}
+
+AudioSink::~AudioSink(VOID)
+{
+	if(this->h_timer != NULL) CloseHandle(this->h_timer);
+}
+
+BOOL WINAPI AudioSink::waitBufferSpace(ULONG_PTR n_frames, DWORD timeout_ms)
+{
+	LARGE_INTEGER perf_now;
+	LONG64 time_end = 0;
+	LONG64 lateness = 0;
+	LONG_PTR padding = 0;
+	ULONG_PTR n_frames_free = 0u;
+	DWORD wait_ms = 0u;
+	BOOL ret = FALSE;
+
+	if(n_frames > this->format.buffer_size_frames)
+	{
+		this->err_msg = TEXT("AudioSink::waitBufferSpace: Error: requested size is larger than the buffer.");
+		return FALSE;
+	}
+
+	QueryPerformanceCounter(&perf_now);
+	time_end = ((LONG64) perf_now.QuadPart) + (((LONG64) timeout_ms)*(this->PERF_FREQ))/1000;
+
+	/*Another thread is already waiting on the device (event and timer are single waiter objects)*/
+	if(InterlockedCompareExchange(&(this->wait_busy), 1, 0))
+	{
+		while(TRUE)
+		{
+			padding = this->getPadding();
+			if(padding < 0) return FALSE;
+
+			if((this->format.buffer_size_frames - ((ULONG_PTR) padding)) >= n_frames) return TRUE;
+
+			QueryPerformanceCounter(&perf_now);
+			if(((LONG64) perf_now.QuadPart) >= time_end) return FALSE;
+
+			Sleep(1u);
+		}
+	}
+
+	while(TRUE)
+	{
+		padding = this->getPadding();
+		if(padding < 0) break;
+
+		n_frames_free = this->format.buffer_size_frames - ((ULONG_PTR) padding);
+		if(n_frames_free >= n_frames)
+		{
+			ret = TRUE;
+			break;
+		}
+
+		QueryPerformanceCounter(&perf_now);
+		if(((LONG64) perf_now.QuadPart) >= time_end)
+		{
+			InterlockedIncrement64(&(this->stat_timeouts));
+			break;
+		}
+
+		wait_ms = (DWORD) (((time_end - ((LONG64) perf_now.QuadPart))*1000)/(this->PERF_FREQ)) + 1u;
+
+		if(!this->wait_device(n_frames - n_frames_free, wait_ms, &lateness)) break;
+
+		if(lateness >= 0) this->wait_stats_add(lateness);
+	}
+
+	InterlockedExchange(&(this->wait_busy), 0);
+	return ret;
+}
+
+BOOL WINAPI AudioSink::getWaitStats(audiosink_wait_stats_t *p_stats)
+{
+	DOUBLE us_per_tick = 0.0;
+
+	if(p_stats == NULL)
+	{
+		this->err_msg = TEXT("AudioSink::getWaitStats: Error: given stats object is invalid.");
+		return FALSE;
+	}
+
+	us_per_tick = 1000000.0/((DOUBLE) this->PERF_FREQ);
+
+	p_stats->n_waits = (ULONG64) InterlockedCompareExchange64(&(this->stat_waits), 0, 0);
+	p_stats->n_timeouts = (ULONG64) InterlockedCompareExchange64(&(this->stat_timeouts), 0, 0);
+	p_stats->lateness_last_us = ((DOUBLE) InterlockedCompareExchange64(&(this->stat_lateness_last), 0, 0))*us_per_tick;
+	p_stats->lateness_max_us = ((DOUBLE) InterlockedCompareExchange64(&(this->stat_lateness_max), 0, 0))*us_per_tick;
+
+	p_stats->lateness_mean_us = 0.0;
+	if(p_stats->n_waits) p_stats->lateness_mean_us = ((DOUBLE) InterlockedCompareExchange64(&(this->stat_lateness_total), 0, 0))*us_per_tick/((DOUBLE) p_stats->n_waits);
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioSink::getFormat(audiosink_format_t *p_format)
+{
+	if(p_format == NULL)
+	{
+		this->err_msg = TEXT("AudioSink::getFormat: Error: given format object is invalid.");
+		return FALSE;
+	}
+
+	CopyMemory(p_format, &(this->format), sizeof(audiosink_format_t));
+	return TRUE;
+}
+
+ULONG_PTR WINAPI AudioSink::getBufferSizeFrames(VOID)
+{
+	return this->format.buffer_size_frames;
+}
+
+__string WINAPI AudioSink::getLastErrorMessage(VOID)
+{
+	return this->err_msg;
+}
+
+BOOL WINAPI AudioSink::format_set(const audiosink_format_t *p_format)
+{
+	if(p_format == NULL)
+	{
+		this->err_msg = TEXT("AudioSink::format_set: Error: given format object is invalid.");
+		return FALSE;
+	}
+
+	if(!p_format->sample_rate || !p_format->n_channels)
+	{
+		this->err_msg = TEXT("AudioSink::format_set: Error: invalid sample rate or channel count.");
+		return FALSE;
+	}
+
+	if(!p_format->bytes_per_sample || !p_format->bits_per_sample || (p_format->bits_per_sample > (p_format->bytes_per_sample)*8u))
+	{
+		this->err_msg = TEXT("AudioSink::format_set: Error: invalid sample size.");
+		return FALSE;
+	}
+
+	if(!p_format->buffer_size_frames)
+	{
+		this->err_msg = TEXT("AudioSink::format_set: Error: invalid buffer size.");
+		return FALSE;
+	}
+
+	CopyMemory(&(this->format), p_format, sizeof(audiosink_format_t));
+
+	this->BYTES_PER_FRAME = (this->format.n_channels)*(this->format.bytes_per_sample);
+
+	InterlockedExchange64(&(this->stat_waits), 0);
+	InterlockedExchange64(&(this->stat_timeouts), 0);
+	InterlockedExchange64(&(this->stat_lateness_last), 0);
+	InterlockedExchange64(&(this->stat_lateness_max), 0);
+	InterlockedExchange64(&(this->stat_lateness_total), 0);
+
+	return TRUE;
+}
+
+LONG64 WINAPI AudioSink::timer_wait(LONG64 deadline, DWORD timeout_ms, HANDLE h_cancel)
+{
+	LARGE_INTEGER perf_now;
+	LARGE_INTEGER due_time;
+	LONG64 wait_ticks = 0;
+	LONG64 timeout_ticks = 0;
+	HANDLE p_handles[2];
+	DWORD n_handles = 0u;
+
+	QueryPerformanceCounter(&perf_now);
+
+	wait_ticks = deadline - ((LONG64) perf_now.QuadPart);
+	if(wait_ticks <= 0) return -wait_ticks;
+
+	timeout_ticks = (((LONG64) timeout_ms)*(this->PERF_FREQ))/1000;
+	if(wait_ticks > timeout_ticks) wait_ticks = timeout_ticks;
+
+	if(this->h_timer == NULL)
+	{
+		if(h_cancel != NULL) WaitForSingleObject(h_cancel, (DWORD) ((wait_ticks*1000)/(this->PERF_FREQ)) + 1u);
+		else Sleep((DWORD) ((wait_ticks*1000)/(this->PERF_FREQ)) + 1u);
+	}
+	else
+	{
+		/*Relative due time, in 100 ns units (the absolute form of SetWaitableTimer() follows the system time, not the performance counter)*/
+		due_time.QuadPart = -((LONGLONG) ((wait_ticks/(this->PERF_FREQ))*10000000 + ((wait_ticks%(this->PERF_FREQ))*10000000)/(this->PERF_FREQ)));
+		if(!due_time.QuadPart) due_time.QuadPart = -1;
+
+		if(!SetWaitableTimer(this->h_timer, &due_time, 0, NULL, NULL, FALSE)) return -1;
+
+		p_handles[n_handles++] = this->h_timer;
+		if(h_cancel != NULL) p_handles[n_handles++] = h_cancel;
+
+		WaitForMultipleObjects(n_handles, p_handles, FALSE, timeout_ms + 1u);
+	}
+
+	QueryPerformanceCounter(&perf_now);
+
+	if(((LONG64) perf_now.QuadPart) < deadline) return -1;
+	return ((LONG64) perf_now.QuadPart) - deadline;
+}
+
+VOID WINAPI AudioSink::wait_stats_add(LONG64 lateness)
+{
+	LONG64 lateness_max = 0;
+
+	InterlockedIncrement64(&(this->stat_waits));
+	InterlockedExchange64(&(this->stat_lateness_last), lateness);
+	InterlockedExchangeAdd64(&(this->stat_lateness_total), lateness);
+
+	lateness_max = InterlockedCompareExchange64(&(this->stat_lateness_max), 0, 0);
+	while(lateness > lateness_max)
+	{
+		if(InterlockedCompareExchange64(&(this->stat_lateness_max), lateness, lateness_max) == lateness_max) break;
+		lateness_max = InterlockedCompareExchange64(&(this->stat_lateness_max), 0, 0);
+	}
+
+	return;
+}
@@ -0,0 +1,152 @@
+/*
+	Real-Time Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*
+	Audio output sink: the device end of the playback loop (see AudioPB).
+
+	Same model as IAudioClient/IAudioRenderClient: the sink owns a buffer of getBufferSizeFrames() frames that the device plays from.
+	getPadding() is the number of frames queued and not played yet, getBuffer()/releaseBuffer() append the next frames.
+	AudioPB only goes through this interface, so it plays to any sink the same way.
+
+	waitBufferSpace() blocks until the device has played enough of the buffer. The thread sleeps until the sink wakes it up
+	(device event, or a high resolution timer set to the time the device frees the space), the padding is not polled.
+	The wake-up lateness (how long after the device freed the space the thread woke up) is kept in the wait stats.
+
+	AudioSink_WASAPI plays to a WASAPI device in exclusive mode.
+	AudioSink_Virtual plays to a simulated device clocked by the performance counter, with no audio hardware at all.
+*/
+
+#ifndef AUDIOSINK_HPP
+#define AUDIOSINK_HPP
+
+#include "globldef.h"
+#include "strdef.hpp"
+
+struct _audiosink_format {
+	ULONG_PTR sample_rate;
+	ULONG_PTR n_channels;
+	ULONG_PTR bytes_per_sample; /*sample container size*/
+	ULONG_PTR bits_per_sample; /*valid bits in the container*/
+	BOOL is_float; /*IEEE float instead of PCM*/
+	ULONG_PTR buffer_size_frames; /*sink buffer size*/
+	ULONG_PTR period_frames; /*frames written per getBuffer()/releaseBuffer() pass (AudioPB: one stream segment)*/
+};
+
+typedef struct _audiosink_format audiosink_format_t;
+
+struct _audiosink_wait_stats {
+	ULONG64 n_waits; /*device wake-ups with a known lateness*/
+	ULONG64 n_timeouts; /*waitBufferSpace() calls that timed out*/
+	DOUBLE lateness_last_us;
+	DOUBLE lateness_mean_us;
+	DOUBLE lateness_max_us;
+};
+
+typedef struct _audiosink_wait_stats audiosink_wait_stats_t;
+
+class AudioSink {
+	public:
+		AudioSink(VOID);
+		virtual ~AudioSink(VOID);
+
+		/*Sets up the stream in the given format. The stream is stopped and the buffer is empty.*/
+		virtual BOOL WINAPI open(const audiosink_format_t *p_format) = 0;
+		virtual VOID WINAPI close(VOID) = 0;
+
+		/*Start/stop playing the buffer. Stopping keeps the queued frames, start() resumes from them.*/
+		virtual BOOL WINAPI start(VOID) = 0;
+		virtual BOOL WINAPI stop(VOID) = 0;
+
+		/*Returns the number of frames queued and not played yet, or -1 on error.*/
+		virtual LONG_PTR WINAPI getPadding(VOID) = 0;
+
+		/*
+			getPosition()
+			returns the device stream position: frames played since open(), including the silence the device played when the buffer ran dry.
+			returns -1 if the device does not report it.
+		*/
+		virtual LONG64 WINAPI getPosition(VOID) = 0;
+
+		/*
+			getBuffer() returns where to write the next n_frames frames, or NULL on error.
+			n_frames must fit in the free space (buffer size - padding).
+			releaseBuffer() queues them. Every getBuffer() is followed by one releaseBuffer() with the same n_frames.
+		*/
+		virtual BYTE* WINAPI getBuffer(ULONG_PTR n_frames) = 0;
+		virtual BOOL WINAPI releaseBuffer(ULONG_PTR n_frames) = 0;
+
+		/*
+			waitBufferSpace()
+			blocks until at least n_frames frames of the buffer are free.
+			returns TRUE when they are, FALSE if timeout_ms elapsed first (also while the sink is stopped) or on error.
+			Meant for the thread that feeds the sink: a concurrent call from another thread polls the padding instead.
+		*/
+		BOOL WINAPI waitBufferSpace(ULONG_PTR n_frames, DWORD timeout_ms);
+
+		/*Can be called from any thread while the sink is playing. Stats are reset by open().*/
+		BOOL WINAPI getWaitStats(audiosink_wait_stats_t *p_stats);
+
+		BOOL WINAPI getFormat(audiosink_format_t *p_format);
+		ULONG_PTR WINAPI getBufferSizeFrames(VOID);
+
+		__string WINAPI getLastErrorMessage(VOID);
+
+	protected:
+		__declspec(align(PTR_SIZE_BYTES)) audiosink_format_t format = {
+			.sample_rate = 0u,
+			.n_channels = 0u,
+			.bytes_per_sample = 0u,
+			.bits_per_sample = 0u,
+			.is_float = FALSE,
+			.buffer_size_frames = 0u,
+			.period_frames = 0u
+		};
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR BYTES_PER_FRAME = 0u;
+
+		__declspec(align(8)) LONG64 PERF_FREQ = 1; /*performance counter frequency*/
+
+		__declspec(align(PTR_SIZE_BYTES)) __string err_msg = TEXT("");
+
+		/*Checks and stores *p_format, resets the wait stats. For the implementations' open().*/
+		BOOL WINAPI format_set(const audiosink_format_t *p_format);
+
+		/*
+			wait_device()
+			blocks until the device may have freed more buffer space: the next device event or period end,
+			or the time n_frames_short more frames take to play. Returns after timeout_ms at most.
+			*p_lateness receives the wake-up lateness in performance counter ticks, or -1 if the device did not wake the thread up (timeout, stop).
+			returns FALSE on error.
+		*/
+		virtual BOOL WINAPI wait_device(ULONG_PTR n_frames_short, DWORD timeout_ms, LONG64 *p_lateness) = 0;
+
+		/*
+			timer_wait()
+			sleeps until the performance counter reaches deadline, timeout_ms elapses or h_cancel (if not NULL) is signaled.
+			returns the lateness (ticks past the deadline) if the deadline was reached, -1 otherwise.
+		*/
+		LONG64 WINAPI timer_wait(LONG64 deadline, DWORD timeout_ms, HANDLE h_cancel);
+
+	private:
+		static constexpr DWORD CREATE_WAITABLE_TIMER_HIGH_RES = 0x2u; /*CREATE_WAITABLE_TIMER_HIGH_RESOLUTION (Windows 10 1803)*/
+
+		/*High resolution waitable timer if the system has one, a regular waitable timer otherwise.*/
+		__declspec(align(PTR_SIZE_BYTES)) HANDLE h_timer = NULL;
+
+		__declspec(align(4)) volatile LONG wait_busy = 0;
+
+		__declspec(align(8)) volatile LONG64 stat_waits = 0;
+		__declspec(align(8)) volatile LONG64 stat_timeouts = 0;
+		__declspec(align(8)) volatile LONG64 stat_lateness_last = 0;
+		__declspec(align(8)) volatile LONG64 stat_lateness_max = 0;
+		__declspec(align(8)) volatile LONG64 stat_lateness_total = 0;
+
+		VOID WINAPI wait_stats_add(LONG64 lateness);
+};
+
+#endif /*AUDIOSINK_HPP*/
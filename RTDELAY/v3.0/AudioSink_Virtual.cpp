@@ -0,0 +1,431 @@
+/*
+	Real-Time Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#include "AudioSink_Virtual.hpp"
+
+AudioSink_Virtual::AudioSink_Virtual(const audiosink_virtual_params_t *p_params)
+{
+	InitializeCriticalSection(&(this->lock));
+	this->h_wake = CreateEvent(NULL, FALSE, FALSE, NULL);
+
+	ZeroMemory(&(this->params), sizeof(audiosink_virtual_params_t));
+	this->setParameters(p_params);
+}
+
+AudioSink_Virtual::~AudioSink_Virtual(VOID)
+{
+	this->close();
+
+	if(this->h_wake != NULL) CloseHandle(this->h_wake);
+	DeleteCriticalSection(&(this->lock));
+}
+
+BOOL WINAPI AudioSink_Virtual::setParameters(const audiosink_virtual_params_t *p_params)
+{
+	if(p_params == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_Virtual::setParameters: Error: given params object is invalid.");
+		return FALSE;
+	}
+
+	CopyMemory(&(this->params), p_params, sizeof(audiosink_virtual_params_t));
+	return TRUE;
+}
+
+BOOL WINAPI AudioSink_Virtual::open(const audiosink_format_t *p_format)
+{
+	LARGE_INTEGER perf_freq;
+
+	this->close();
+
+	if(!this->format_set(p_format)) return FALSE;
+
+	this->PERIOD_FRAMES = this->params.period_frames;
+	if(!this->PERIOD_FRAMES) this->PERIOD_FRAMES = (this->format.sample_rate*this->PERIOD_DEFAULT_MS)/1000u;
+	if(!this->PERIOD_FRAMES) this->PERIOD_FRAMES = 1u;
+	if(this->PERIOD_FRAMES > this->format.buffer_size_frames) this->PERIOD_FRAMES = this->format.buffer_size_frames;
+
+	QueryPerformanceFrequency(&perf_freq);
+
+	this->PERIOD_TICKS = ((DOUBLE) this->PERIOD_FRAMES)*((DOUBLE) perf_freq.QuadPart)/((DOUBLE) this->format.sample_rate);
+	this->JITTER_TICKS = (LONG64) ((((DOUBLE) this->params.jitter_us)*((DOUBLE) perf_freq.QuadPart))/1000000.0);
+
+	if(!this->buffer_alloc())
+	{
+		this->close();
+		return FALSE;
+	}
+
+	this->write_pos = 0u;
+	this->read_pos = 0u;
+	this->stage_used = FALSE;
+
+	this->running = FALSE;
+
+	/*xorshift32 never leaves state 0*/
+	this->jitter_state = this->params.jitter_seed;
+	if(!this->jitter_state) this->jitter_state = 0x6b8b4567u;
+
+	InterlockedExchange64(&(this->stat_frames_written), 0);
+	InterlockedExchange64(&(this->stat_frames_played), 0);
+	InterlockedExchange64(&(this->stat_periods), 0);
+	InterlockedExchange64(&(this->stat_underruns), 0);
+	InterlockedExchange64(&(this->stat_frames_silence), 0);
+
+	return TRUE;
+}
+
+VOID WINAPI AudioSink_Virtual::close(VOID)
+{
+	this->running = FALSE;
+	if(this->h_wake != NULL) SetEvent(this->h_wake);
+
+	this->buffer_free();
+	return;
+}
+
+BOOL WINAPI AudioSink_Virtual::start(VOID)
+{
+	LARGE_INTEGER perf_now;
+
+	if(this->p_buffer == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_Virtual::start: Error: sink is not open.");
+		return FALSE;
+	}
+
+	EnterCriticalSection(&(this->lock));
+
+	if(!this->running)
+	{
+		QueryPerformanceCounter(&perf_now);
+
+		this->clock_base = (LONG64) perf_now.QuadPart;
+		this->clock_n_period = 0u;
+		this->clock_set_deadline();
+
+		this->running = TRUE;
+		if(this->h_wake != NULL) SetEvent(this->h_wake);
+	}
+
+	LeaveCriticalSection(&(this->lock));
+	return TRUE;
+}
+
+BOOL WINAPI AudioSink_Virtual::stop(VOID)
+{
+	if(this->p_buffer == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_Virtual::stop: Error: sink is not open.");
+		return FALSE;
+	}
+
+	EnterCriticalSection(&(this->lock));
+
+	this->clock_update();
+	this->running = FALSE;
+	if(this->h_wake != NULL) SetEvent(this->h_wake);
+
+	LeaveCriticalSection(&(this->lock));
+	return TRUE;
+}
+
+LONG_PTR WINAPI AudioSink_Virtual::getPadding(VOID)
+{
+	LONG_PTR n_frames = 0;
+
+	if(this->p_buffer == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_Virtual::getPadding: Error: sink is not open.");
+		return -1;
+	}
+
+	EnterCriticalSection(&(this->lock));
+
+	this->clock_update();
+	n_frames = (LONG_PTR) (this->write_pos - this->read_pos);
+
+	LeaveCriticalSection(&(this->lock));
+	return n_frames;
+}
+
+LONG64 WINAPI AudioSink_Virtual::getPosition(VOID)
+{
+	LONG64 n_frames = 0;
+
+	if(this->p_buffer == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_Virtual::getPosition: Error: sink is not open.");
+		return -1;
+	}
+
+	EnterCriticalSection(&(this->lock));
+
+	this->clock_update();
+	n_frames = this->stat_frames_played;
+
+	LeaveCriticalSection(&(this->lock));
+	return n_frames;
+}
+
+BYTE* WINAPI AudioSink_Virtual::getBuffer(ULONG_PTR n_frames)
+{
+	BYTE *p_data = NULL;
+	ULONG_PTR offset = 0u;
+
+	if(this->p_buffer == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_Virtual::getBuffer: Error: sink is not open.");
+		return NULL;
+	}
+
+	EnterCriticalSection(&(this->lock));
+
+	this->clock_update();
+
+	if(n_frames > (this->format.buffer_size_frames - ((ULONG_PTR) (this->write_pos - this->read_pos))))
+	{
+		LeaveCriticalSection(&(this->lock));
+		this->err_msg = TEXT("AudioSink_Virtual::getBuffer: Error: requested size is larger than the free buffer space.");
+		return NULL;
+	}
+
+	offset = (ULONG_PTR) (this->write_pos%((ULONG64) this->format.buffer_size_frames));
+
+	/*Free space in one piece: write straight into the buffer. Otherwise write to the stage, releaseBuffer() copies it in.*/
+	if((offset + n_frames) <= this->format.buffer_size_frames)
+	{
+		this->stage_used = FALSE;
+		p_data = &(this->p_buffer[offset*(this->BYTES_PER_FRAME)]);
+	}
+	else
+	{
+		this->stage_used = TRUE;
+		p_data = this->p_stage;
+	}
+
+	LeaveCriticalSection(&(this->lock));
+	return p_data;
+}
+
+BOOL WINAPI AudioSink_Virtual::releaseBuffer(ULONG_PTR n_frames)
+{
+	if(this->p_buffer == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_Virtual::releaseBuffer: Error: sink is not open.");
+		return FALSE;
+	}
+
+	EnterCriticalSection(&(this->lock));
+
+	if(this->stage_used)
+	{
+		this->buffer_write(this->write_pos, this->p_stage, n_frames);
+		this->stage_used = FALSE;
+	}
+
+	this->write_pos += (ULONG64) n_frames;
+	InterlockedExchangeAdd64(&(this->stat_frames_written), (LONG64) n_frames);
+
+	LeaveCriticalSection(&(this->lock));
+	return TRUE;
+}
+
+BOOL WINAPI AudioSink_Virtual::getStats(audiosink_virtual_stats_t *p_stats)
+{
+	if(p_stats == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_Virtual::getStats: Error: given stats object is invalid.");
+		return FALSE;
+	}
+
+	p_stats->n_frames_written = (ULONG64) InterlockedCompareExchange64(&(this->stat_frames_written), 0, 0);
+	p_stats->n_frames_played = (ULONG64) InterlockedCompareExchange64(&(this->stat_frames_played), 0, 0);
+	p_stats->n_periods = (ULONG64) InterlockedCompareExchange64(&(this->stat_periods), 0, 0);
+	p_stats->n_underruns = (ULONG64) InterlockedCompareExchange64(&(this->stat_underruns), 0, 0);
+	p_stats->n_frames_silence = (ULONG64) InterlockedCompareExchange64(&(this->stat_frames_silence), 0, 0);
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioSink_Virtual::wait_device(ULONG_PTR n_frames_short, DWORD timeout_ms, LONG64 *p_lateness)
+{
+	LONG64 deadline = 0;
+	BOOL running = FALSE;
+
+	*p_lateness = -1;
+
+	if(this->p_buffer == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_Virtual::wait_device: Error: sink is not open.");
+		return FALSE;
+	}
+
+	EnterCriticalSection(&(this->lock));
+
+	this->clock_update();
+	running = this->running;
+	deadline = this->clock_deadline;
+
+	LeaveCriticalSection(&(this->lock));
+
+	/*Every period frees space (or underruns): wait for the next period end only, whatever n_frames_short is.*/
+	if(running) *p_lateness = this->timer_wait(deadline, timeout_ms, this->h_wake);
+	else if(this->h_wake != NULL) WaitForSingleObject(this->h_wake, timeout_ms);
+	else Sleep(1u);
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioSink_Virtual::buffer_alloc(VOID)
+{
+	ULONG_PTR buffer_size_bytes = 0u;
+
+	if(p_processheap == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_Virtual::buffer_alloc: Error: p_processheap is NULL.");
+		return FALSE;
+	}
+
+	buffer_size_bytes = (this->format.buffer_size_frames)*(this->BYTES_PER_FRAME);
+
+	this->p_buffer = (BYTE*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, buffer_size_bytes);
+	this->p_stage = (BYTE*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, buffer_size_bytes);
+	this->p_period = (BYTE*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, (this->PERIOD_FRAMES)*(this->BYTES_PER_FRAME));
+
+	if((this->p_buffer == NULL) || (this->p_stage == NULL) || (this->p_period == NULL))
+	{
+		this->buffer_free();
+		this->err_msg = TEXT("AudioSink_Virtual::buffer_alloc: Error: failed to allocate heap memory.");
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+VOID WINAPI AudioSink_Virtual::buffer_free(VOID)
+{
+	if(p_processheap == NULL) return;
+
+	if(this->p_buffer != NULL)
+	{
+		HeapFree(p_processheap, 0u, this->p_buffer);
+		this->p_buffer = NULL;
+	}
+
+	if(this->p_stage != NULL)
+	{
+		HeapFree(p_processheap, 0u, this->p_stage);
+		this->p_stage = NULL;
+	}
+
+	if(this->p_period != NULL)
+	{
+		HeapFree(p_processheap, 0u, this->p_period);
+		this->p_period = NULL;
+	}
+
+	return;
+}
+
+VOID WINAPI AudioSink_Virtual::clock_update(VOID)
+{
+	LARGE_INTEGER perf_now;
+
+	if(!this->running) return;
+
+	QueryPerformanceCounter(&perf_now);
+
+	while(((LONG64) perf_now.QuadPart) >= this->clock_deadline)
+	{
+		this->period_play();
+
+		this->clock_n_period++;
+		this->clock_set_deadline();
+	}
+
+	return;
+}
+
+VOID WINAPI AudioSink_Virtual::clock_set_deadline(VOID)
+{
+	UINT32 x = 0u;
+	LONG64 jitter = 0;
+
+	if(this->JITTER_TICKS > 0)
+	{
+		x = this->jitter_state;
+		x ^= (x << 13);
+		x ^= (x >> 17);
+		x ^= (x << 5);
+		this->jitter_state = x;
+
+		jitter = (LONG64) (((ULONG64) x)%((ULONG64) (this->JITTER_TICKS + 1)));
+	}
+
+	this->clock_deadline = this->clock_base + ((LONG64) (((DOUBLE) (this->clock_n_period + 1u))*(this->PERIOD_TICKS))) + jitter;
+	return;
+}
+
+VOID WINAPI AudioSink_Virtual::period_play(VOID)
+{
+	ULONG_PTR n_frames = 0u;
+
+	n_frames = (ULONG_PTR) (this->write_pos - this->read_pos);
+	if(n_frames > this->PERIOD_FRAMES) n_frames = this->PERIOD_FRAMES;
+
+	this->buffer_read(this->p_period, this->read_pos, n_frames);
+	this->read_pos += (ULONG64) n_frames;
+
+	if(n_frames < this->PERIOD_FRAMES)
+	{
+		ZeroMemory(&(this->p_period[n_frames*(this->BYTES_PER_FRAME)]), (this->PERIOD_FRAMES - n_frames)*(this->BYTES_PER_FRAME));
+
+		InterlockedIncrement64(&(this->stat_underruns));
+		InterlockedExchangeAdd64(&(this->stat_frames_silence), (LONG64) (this->PERIOD_FRAMES - n_frames));
+	}
+
+	InterlockedIncrement64(&(this->stat_periods));
+	InterlockedExchangeAdd64(&(this->stat_frames_played), (LONG64) this->PERIOD_FRAMES);
+
+	if(this->params.capture_proc != NULL) this->params.capture_proc(this->params.p_capture_context, this->p_period, this->PERIOD_FRAMES);
+
+	return;
+}
+
+VOID WINAPI AudioSink_Virtual::buffer_write(ULONG64 pos, const BYTE *p_src, ULONG_PTR n_frames)
+{
+	ULONG_PTR offset = 0u;
+	ULONG_PTR n_frames_1 = 0u;
+
+	offset = (ULONG_PTR) (pos%((ULONG64) this->format.buffer_size_frames));
+
+	n_frames_1 = this->format.buffer_size_frames - offset;
+	if(n_frames_1 > n_frames) n_frames_1 = n_frames;
+
+	CopyMemory(&(this->p_buffer[offset*(this->BYTES_PER_FRAME)]), p_src, n_frames_1*(this->BYTES_PER_FRAME));
+	CopyMemory(this->p_buffer, &(p_src[n_frames_1*(this->BYTES_PER_FRAME)]), (n_frames - n_frames_1)*(this->BYTES_PER_FRAME));
+
+	return;
+}
+
+VOID WINAPI AudioSink_Virtual::buffer_read(BYTE *p_dst, ULONG64 pos, ULONG_PTR n_frames)
+{
+	ULONG_PTR offset = 0u;
+	ULONG_PTR n_frames_1 = 0u;
+
+	offset = (ULONG_PTR) (pos%((ULONG64) this->format.buffer_size_frames));
+
+	n_frames_1 = this->format.buffer_size_frames - offset;
+	if(n_frames_1 > n_frames) n_frames_1 = n_frames;
+
+	CopyMemory(p_dst, &(this->p_buffer[offset*(this->BYTES_PER_FRAME)]), n_frames_1*(this->BYTES_PER_FRAME));
+	CopyMemory(&(p_dst[n_frames_1*(this->BYTES_PER_FRAME)]), this->p_buffer, (n_frames - n_frames_1)*(this->BYTES_PER_FRAME));
+
+	return;
+}
@@ -0,0 +1,127 @@
+/*
+	Real-Time Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*
+	Virtual audio sink: a simulated audio device, clocked by the performance counter. It needs no audio hardware.
+
+	Like a real device, it plays its buffer in periods of period_frames frames at the stream sample rate. Period n ends at
+	start time + (n + 1)*period time, plus a random delay of up to jitter_us microseconds (the deadlines do not drift:
+	the jitter of one period does not move the next ones).
+	Nothing plays a period until the sink is called again (any method): a late call plays every period that is due.
+	waitBufferSpace() sleeps until the end of the next period (absolute deadline on the performance counter clock),
+	the wake-up lateness is the time between that deadline and the wake-up.
+
+	A period that finds fewer frames queued than a full period is an underrun: the missing frames are played as silence.
+	The optional capture callback receives every period as played, silence included.
+*/
+
+#ifndef AUDIOSINK_VIRTUAL_HPP
+#define AUDIOSINK_VIRTUAL_HPP
+
+#include "AudioSink.hpp"
+
+typedef VOID (WINAPI *audiosink_capture_proc_t)(VOID *p_context, const BYTE *p_data, ULONG_PTR n_frames);
+
+struct _audiosink_virtual_params {
+	ULONG_PTR period_frames; /*Device period. 0 for 10 ms. Limited to the buffer size.*/
+	ULONG_PTR jitter_us; /*Maximum period end delay (microseconds). 0 for an exact clock.*/
+	UINT32 jitter_seed;
+	audiosink_capture_proc_t capture_proc; /*NULL for no capture*/
+	VOID *p_capture_context;
+};
+
+typedef struct _audiosink_virtual_params audiosink_virtual_params_t;
+
+struct _audiosink_virtual_stats {
+	ULONG64 n_frames_written;
+	ULONG64 n_frames_played; /*silence included*/
+	ULONG64 n_periods;
+	ULONG64 n_underruns; /*periods played short*/
+	ULONG64 n_frames_silence; /*frames played as silence in underruns*/
+};
+
+typedef struct _audiosink_virtual_stats audiosink_virtual_stats_t;
+
+class AudioSink_Virtual : public AudioSink {
+	public:
+		AudioSink_Virtual(const audiosink_virtual_params_t *p_params);
+		~AudioSink_Virtual(VOID);
+
+		/*Takes effect on the next open().*/
+		BOOL WINAPI setParameters(const audiosink_virtual_params_t *p_params);
+
+		BOOL WINAPI open(const audiosink_format_t *p_format) override;
+		VOID WINAPI close(VOID) override;
+
+		BOOL WINAPI start(VOID) override;
+		BOOL WINAPI stop(VOID) override;
+
+		LONG_PTR WINAPI getPadding(VOID) override;
+		LONG64 WINAPI getPosition(VOID) override;
+
+		BYTE* WINAPI getBuffer(ULONG_PTR n_frames) override;
+		BOOL WINAPI releaseBuffer(ULONG_PTR n_frames) override;
+
+		/*Can be called from any thread while the sink is playing. Stats are reset by open().*/
+		BOOL WINAPI getStats(audiosink_virtual_stats_t *p_stats);
+
+	protected:
+		BOOL WINAPI wait_device(ULONG_PTR n_frames_short, DWORD timeout_ms, LONG64 *p_lateness) override;
+
+	private:
+		static constexpr ULONG_PTR PERIOD_DEFAULT_MS = 10u;
+
+		__declspec(align(PTR_SIZE_BYTES)) audiosink_virtual_params_t params;
+
+		/*A pause can stop the sink from another thread while the playback loop uses it.*/
+		__declspec(align(PTR_SIZE_BYTES)) CRITICAL_SECTION lock;
+
+		/*Signaled by start(), stop() and close(): wakes a thread up from wait_device() to check the sink state again.*/
+		__declspec(align(PTR_SIZE_BYTES)) HANDLE h_wake = NULL;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR PERIOD_FRAMES = 0u;
+		__declspec(align(8)) DOUBLE PERIOD_TICKS = 0.0;
+		__declspec(align(8)) LONG64 JITTER_TICKS = 0;
+
+		__declspec(align(PTR_SIZE_BYTES)) BYTE *p_buffer = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) BYTE *p_period = NULL; /*one period, handed to the capture callback*/
+		__declspec(align(PTR_SIZE_BYTES)) BYTE *p_stage = NULL; /*getBuffer() space when the free space wraps around the buffer end*/
+		__declspec(align(4)) BOOL stage_used = FALSE;
+
+		/*Buffer positions (frames since open())*/
+		__declspec(align(8)) ULONG64 write_pos = 0u;
+		__declspec(align(8)) ULONG64 read_pos = 0u;
+
+		/*Clock*/
+		__declspec(align(4)) BOOL running = FALSE;
+		__declspec(align(8)) LONG64 clock_base = 0; /*performance counter at start()*/
+		__declspec(align(8)) ULONG64 clock_n_period = 0u; /*periods played since start()*/
+		__declspec(align(8)) LONG64 clock_deadline = 0; /*performance counter at which the next period ends*/
+		__declspec(align(4)) UINT32 jitter_state = 0u;
+
+		__declspec(align(8)) volatile LONG64 stat_frames_written = 0;
+		__declspec(align(8)) volatile LONG64 stat_frames_played = 0;
+		__declspec(align(8)) volatile LONG64 stat_periods = 0;
+		__declspec(align(8)) volatile LONG64 stat_underruns = 0;
+		__declspec(align(8)) volatile LONG64 stat_frames_silence = 0;
+
+		BOOL WINAPI buffer_alloc(VOID);
+		VOID WINAPI buffer_free(VOID);
+
+		/*Plays every period that is due.*/
+		VOID WINAPI clock_update(VOID);
+		VOID WINAPI clock_set_deadline(VOID);
+
+		VOID WINAPI period_play(VOID);
+
+		/*Copy n_frames frames to/from the buffer at position pos, wrapping around the buffer end.*/
+		VOID WINAPI buffer_write(ULONG64 pos, const BYTE *p_src, ULONG_PTR n_frames);
+		VOID WINAPI buffer_read(BYTE *p_dst, ULONG64 pos, ULONG_PTR n_frames);
+};
+
+#endif /*AUDIOSINK_VIRTUAL_HPP*/
@@ -0,0 +1,571 @@
+/*
+	Real-Time Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#include "AudioSink_WASAPI.hpp"
+#include "cstrdef.h"
+
+#include <combaseapi.h>
+
+AudioSink_WASAPI::AudioSink_WASAPI(VOID)
+{
+	this->h_event = CreateEvent(NULL, FALSE, FALSE, NULL);
+}
+
+AudioSink_WASAPI::~AudioSink_WASAPI(VOID)
+{
+	this->close();
+	this->devicelist_deinit();
+
+	if(this->p_devenum != NULL)
+	{
+		this->p_devenum->Release();
+		this->p_devenum = NULL;
+	}
+
+	if(this->h_event != NULL) CloseHandle(this->h_event);
+}
+
+BOOL WINAPI AudioSink_WASAPI::loadDeviceList(VOID)
+{
+	const PROPERTYKEY* const P_PKEY = (const PROPERTYKEY*) P_PKEY_Device_FriendlyName;
+	IMMDevice *p_dev = NULL;
+	IPropertyStore *p_devprop = NULL;
+	ULONG_PTR devicelist_byteoffset = 0u;
+	HRESULT n_ret = 0;
+	UINT n_dev = 0u;
+	PROPVARIANT propvar;
+
+	this->devicelist_deinit();
+
+	if(this->p_devenum == NULL)
+	{
+		n_ret = CoCreateInstance(__uuidof(MMDeviceEnumerator), NULL, CLSCTX_ALL, __uuidof(IMMDeviceEnumerator), (VOID**) &(this->p_devenum));
+		if(n_ret != S_OK)
+		{
+			this->err_msg = TEXT("AudioSink_WASAPI::loadDeviceList: Error: CoCreateInstance (IMMDeviceEnumerator) failed.");
+			return FALSE;
+		}
+	}
+
+	if(!this->devicelist_init()) return FALSE;
+
+	devicelist_byteoffset = 0u;
+
+	for(n_dev = 0u; n_dev < (UINT) this->devlist.devlist_n_entries; n_dev++)
+	{
+		n_ret = this->devlist.p_devcoll->Item(n_dev, &p_dev);
+		if(n_ret != S_OK)
+		{
+			this->devicelist_deinit();
+			this->err_msg = TEXT("AudioSink_WASAPI::loadDeviceList: Error: IMMDeviceCollection::Item failed.");
+			return FALSE;
+		}
+
+		n_ret = p_dev->OpenPropertyStore(STGM_READ, &p_devprop);
+		if(n_ret != S_OK)
+		{
+			p_dev->Release();
+			this->devicelist_deinit();
+			this->err_msg = TEXT("AudioSink_WASAPI::loadDeviceList: Error: IMMDevice::OpenPropertyStore failed.");
+			return FALSE;
+		}
+
+		PropVariantInit(&propvar);
+
+		n_ret = p_devprop->GetValue(*P_PKEY, &propvar);
+		if(n_ret != S_OK)
+		{
+			p_devprop->Release();
+			p_dev->Release();
+			this->devicelist_deinit();
+			this->err_msg = TEXT("AudioSink_WASAPI::loadDeviceList: Error: IPropertyStore::GetValue failed.");
+			return FALSE;
+		}
+
+		if(propvar.vt == VT_EMPTY) __SPRINTF((TCHAR*) (((ULONG_PTR) this->devlist.p_devlist) + devicelist_byteoffset), this->DEVICELIST_ENTRYLENGTH, TEXT("Unknown Audio Device"));
+		else cstr_copy_wchar_to_tchar(propvar.pwszVal, (TCHAR*) (((ULONG_PTR) this->devlist.p_devlist) + devicelist_byteoffset), this->DEVICELIST_ENTRYLENGTH);
+
+		PropVariantClear(&propvar);
+
+		p_devprop->Release();
+		p_devprop = NULL;
+
+		p_dev->Release();
+		p_dev = NULL;
+
+		devicelist_byteoffset += (this->DEVICELIST_ENTRYLENGTH)*(sizeof(TCHAR));
+	}
+
+	PropVariantClear(&propvar);
+
+	if(p_devprop != NULL) p_devprop->Release();
+	if(p_dev != NULL) p_dev->Release();
+
+	return TRUE;
+}
+
+LONG_PTR WINAPI AudioSink_WASAPI::getDeviceListEntryCount(VOID)
+{
+	return (LONG_PTR) this->devlist.devlist_n_entries;
+}
+
+const TCHAR* WINAPI AudioSink_WASAPI::getDeviceListEntry(ULONG_PTR index)
+{
+	if(this->devlist.p_devlist == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::getDeviceListEntry: Error: list is not loaded.");
+		return NULL;
+	}
+
+	if(index >= this->devlist.devlist_n_entries)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::getDeviceListEntry: Error: given entry index is out of bounds.");
+		return NULL;
+	}
+
+	return (const TCHAR*) (((ULONG_PTR) (this->devlist.p_devlist)) + index*(this->DEVICELIST_ENTRYLENGTH)*sizeof(TCHAR));
+}
+
+BOOL WINAPI AudioSink_WASAPI::chooseDevice(ULONG_PTR index)
+{
+	HRESULT n_ret = 0;
+
+	if(this->devlist.p_devcoll == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::chooseDevice: Error: audio device list is not loaded.");
+		return FALSE;
+	}
+
+	this->close();
+
+	n_ret = this->devlist.p_devcoll->Item((UINT) index, &(this->dev.p_device));
+	if(n_ret != S_OK)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::chooseDevice: Error: IMMDeviceCollection::Item failed.");
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioSink_WASAPI::chooseDefaultDevice(VOID)
+{
+	HRESULT n_ret = 0;
+
+	if(this->p_devenum == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::chooseDefaultDevice: Error: audio device enumerator is not loaded.");
+		return FALSE;
+	}
+
+	this->close();
+
+	n_ret = this->p_devenum->GetDefaultAudioEndpoint(eRender, eMultimedia, &(this->dev.p_device));
+	if(n_ret != S_OK)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::chooseDefaultDevice: Error: IMMDeviceEnumerator::GetDefaultAudioEndpoint failed.");
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioSink_WASAPI::open(const audiosink_format_t *p_format)
+{
+	ULONG64 audiobuffer_time;
+
+	ULONG_PTR n_channel;
+	HRESULT n_ret;
+
+	DWORD channel_mask;
+
+	WAVEFORMATEXTENSIBLE wavfmt;
+
+	this->stream_release();
+
+	if(this->dev.p_device == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::open: Error: audio device is not loaded.");
+		return FALSE;
+	}
+
+	if(!this->format_set(p_format))
+	{
+		this->stream_release();
+		return FALSE;
+	}
+
+	n_ret = this->dev.p_device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, NULL, (VOID**) &(this->dev.p_audioclient));
+	if(n_ret != S_OK)
+	{
+		this->stream_release();
+		this->err_msg = TEXT("AudioSink_WASAPI::open: Error: IMMDevice::Activate failed.");
+		return FALSE;
+	}
+
+	channel_mask = 0u;
+	for(n_channel = 0u; n_channel < this->format.n_channels; n_channel++) channel_mask |= (1 << n_channel);
+
+	ZeroMemory(&wavfmt, sizeof(WAVEFORMATEXTENSIBLE));
+
+	wavfmt.Format.wFormatTag = WAVE_FORMAT_EXTENSIBLE;
+	wavfmt.Format.nChannels = (WORD) this->format.n_channels;
+	wavfmt.Format.wBitsPerSample = (WORD) (this->format.bytes_per_sample)*8u;
+	wavfmt.Format.nBlockAlign = (wavfmt.Format.nChannels)*((WORD) this->format.bytes_per_sample);
+	wavfmt.Format.nSamplesPerSec = (DWORD) this->format.sample_rate;
+	wavfmt.Format.nAvgBytesPerSec = (wavfmt.Format.nSamplesPerSec)*((DWORD) wavfmt.Format.nBlockAlign);
+	wavfmt.Format.cbSize = sizeof(WAVEFORMATEXTENSIBLE) - sizeof(WAVEFORMATEX);
+	wavfmt.Samples.wValidBitsPerSample = (WORD) this->format.bits_per_sample;
+	wavfmt.dwChannelMask = channel_mask;
+	if(this->format.is_float) wavfmt.SubFormat = KSDATAFORMAT_SUBTYPE_IEEE_FLOAT;
+	else wavfmt.SubFormat = KSDATAFORMAT_SUBTYPE_PCM;
+
+	n_ret = this->dev.p_audioclient->IsFormatSupported(AUDCLNT_SHAREMODE_EXCLUSIVE, (WAVEFORMATEX*) &wavfmt, NULL);
+	if(n_ret != S_OK)
+	{
+		this->stream_release();
+		this->err_msg = TEXT("AudioSink_WASAPI::open: Error: audio stream format not supported.");
+		return FALSE;
+	}
+
+	audiobuffer_time = ((ULONG64) this->format.buffer_size_frames)*10000000/((ULONG64) this->format.sample_rate);
+
+	this->EVENT_MODE = (this->format.period_frames == this->format.buffer_size_frames) && (this->h_event != NULL);
+
+	/*Event callback mode in exclusive mode: the device period is the whole buffer (buffer duration == periodicity).*/
+	if(this->EVENT_MODE) n_ret = this->dev.p_audioclient->Initialize(AUDCLNT_SHAREMODE_EXCLUSIVE, AUDCLNT_STREAMFLAGS_EVENTCALLBACK, (REFERENCE_TIME) audiobuffer_time, (REFERENCE_TIME) audiobuffer_time, (WAVEFORMATEX*) &wavfmt, NULL);
+	else n_ret = this->dev.p_audioclient->Initialize(AUDCLNT_SHAREMODE_EXCLUSIVE, 0, (REFERENCE_TIME) audiobuffer_time, 0, (WAVEFORMATEX*) &wavfmt, NULL);
+
+	if(n_ret != S_OK)
+	{
+		this->stream_release();
+		this->err_msg = TEXT("AudioSink_WASAPI::open: Error: IAudioClient::Initialize failed.");
+		return FALSE;
+	}
+
+	if(this->EVENT_MODE)
+	{
+		n_ret = this->dev.p_audioclient->SetEventHandle(this->h_event);
+		if(n_ret != S_OK)
+		{
+			this->stream_release();
+			this->err_msg = TEXT("AudioSink_WASAPI::open: Error: IAudioClient::SetEventHandle failed.");
+			return FALSE;
+		}
+	}
+
+	/*The clock is only used for getPosition(), the wait deadlines and the lateness stats: playback works without it.*/
+	n_ret = this->dev.p_audioclient->GetService(__uuidof(IAudioClock), (VOID**) &(this->dev.p_clock));
+	if(n_ret == S_OK)
+	{
+		if((this->dev.p_clock->GetFrequency(&(this->CLOCK_FREQ)) != S_OK) || !this->CLOCK_FREQ)
+		{
+			this->dev.p_clock->Release();
+			this->dev.p_clock = NULL;
+		}
+	}
+	else this->dev.p_clock = NULL;
+
+	n_ret = this->dev.p_audioclient->GetService(__uuidof(IAudioRenderClient), (VOID**) &(this->dev.p_renderclient));
+	if(n_ret != S_OK)
+	{
+		this->stream_release();
+		this->err_msg = TEXT("AudioSink_WASAPI::open: Error: IAudioClient::GetService failed.");
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+VOID WINAPI AudioSink_WASAPI::close(VOID)
+{
+	this->stream_release();
+
+	if(this->dev.p_device != NULL)
+	{
+		this->dev.p_device->Release();
+		this->dev.p_device = NULL;
+	}
+
+	return;
+}
+
+VOID WINAPI AudioSink_WASAPI::stream_release(VOID)
+{
+	if(this->dev.p_clock != NULL)
+	{
+		this->dev.p_clock->Release();
+		this->dev.p_clock = NULL;
+	}
+
+	if(this->dev.p_renderclient != NULL)
+	{
+		this->dev.p_renderclient->Release();
+		this->dev.p_renderclient = NULL;
+	}
+
+	if(this->dev.p_audioclient != NULL)
+	{
+		this->dev.p_audioclient->Stop();
+		this->dev.p_audioclient->Release();
+		this->dev.p_audioclient = NULL;
+	}
+
+	return;
+}
+
+BOOL WINAPI AudioSink_WASAPI::start(VOID)
+{
+	if(this->dev.p_audioclient == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::start: Error: sink is not open.");
+		return FALSE;
+	}
+
+	if(FAILED(this->dev.p_audioclient->Start()))
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::start: Error: IAudioClient::Start failed.");
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioSink_WASAPI::stop(VOID)
+{
+	if(this->dev.p_audioclient == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::stop: Error: sink is not open.");
+		return FALSE;
+	}
+
+	if(FAILED(this->dev.p_audioclient->Stop()))
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::stop: Error: IAudioClient::Stop failed.");
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+LONG_PTR WINAPI AudioSink_WASAPI::getPadding(VOID)
+{
+	UINT32 u32 = 0u;
+
+	if(this->dev.p_audioclient == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::getPadding: Error: sink is not open.");
+		return -1;
+	}
+
+	if(this->dev.p_audioclient->GetCurrentPadding(&u32) != S_OK)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::getPadding: Error: IAudioClient::GetCurrentPadding failed.");
+		return -1;
+	}
+
+	return (LONG_PTR) u32;
+}
+
+LONG64 WINAPI AudioSink_WASAPI::getPosition(VOID)
+{
+	UINT64 clock_pos = 0u;
+
+	if(this->dev.p_clock == NULL) return -1;
+	if(this->dev.p_clock->GetPosition(&clock_pos, NULL) != S_OK) return -1;
+
+	return (LONG64) ((clock_pos*((UINT64) this->format.sample_rate))/(this->CLOCK_FREQ));
+}
+
+BYTE* WINAPI AudioSink_WASAPI::getBuffer(ULONG_PTR n_frames)
+{
+	BYTE *p_audiobuffer = NULL;
+
+	if(this->dev.p_renderclient == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::getBuffer: Error: sink is not open.");
+		return NULL;
+	}
+
+	if(this->dev.p_renderclient->GetBuffer((UINT32) n_frames, &p_audiobuffer) != S_OK)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::getBuffer: Error: IAudioRenderClient::GetBuffer failed.");
+		return NULL;
+	}
+
+	return p_audiobuffer;
+}
+
+BOOL WINAPI AudioSink_WASAPI::releaseBuffer(ULONG_PTR n_frames)
+{
+	if(this->dev.p_renderclient == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::releaseBuffer: Error: sink is not open.");
+		return FALSE;
+	}
+
+	if(this->dev.p_renderclient->ReleaseBuffer((UINT32) n_frames, 0u) != S_OK)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::releaseBuffer: Error: IAudioRenderClient::ReleaseBuffer failed.");
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioSink_WASAPI::wait_device(ULONG_PTR n_frames_short, DWORD timeout_ms, LONG64 *p_lateness)
+{
+	LARGE_INTEGER perf_now;
+	UINT64 clock_pos = 0u;
+	UINT64 clock_qpc = 0u;
+	UINT64 pos_frames = 0u;
+	UINT64 period_time = 0u;
+	LONG64 now_time = 0;
+	LONG64 deadline = 0;
+	LONG64 short_ticks = 0;
+
+	*p_lateness = -1;
+
+	if(this->dev.p_audioclient == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::wait_device: Error: sink is not open.");
+		return FALSE;
+	}
+
+	if(!this->EVENT_MODE)
+	{
+		/*
+			Timer driven: wake up when n_frames_short more frames have played.
+			The padding only moves when the device position does, so the frames are counted from the time of the last device clock position
+			(IAudioClock::GetPosition() timestamp, in 100 ns performance counter units), not from now.
+			Without a device clock, or if that deadline has already passed (stale position), they are counted from now.
+		*/
+		short_ticks = (LONG64) ((((ULONG64) n_frames_short)*((ULONG64) this->PERF_FREQ))/((ULONG64) this->format.sample_rate));
+
+		QueryPerformanceCounter(&perf_now);
+		deadline = ((LONG64) perf_now.QuadPart) + short_ticks;
+
+		if(this->dev.p_clock != NULL)
+		{
+			if(this->dev.p_clock->GetPosition(&clock_pos, &clock_qpc) == S_OK)
+			{
+				clock_qpc = (clock_qpc/10000000u)*((UINT64) this->PERF_FREQ) + ((clock_qpc%10000000u)*((UINT64) this->PERF_FREQ))/10000000u;
+				if((((LONG64) clock_qpc) + short_ticks) > ((LONG64) perf_now.QuadPart)) deadline = ((LONG64) clock_qpc) + short_ticks;
+			}
+		}
+
+		*p_lateness = this->timer_wait(deadline, timeout_ms, NULL);
+		return TRUE;
+	}
+
+	if(WaitForSingleObject(this->h_event, timeout_ms) != WAIT_OBJECT_0) return TRUE;
+
+	QueryPerformanceCounter(&perf_now);
+
+	if(this->dev.p_clock == NULL) return TRUE;
+	if(this->dev.p_clock->GetPosition(&clock_pos, &clock_qpc) != S_OK) return TRUE;
+
+	/*
+		The event is signaled at the period boundary (a multiple of the buffer size on the stream position).
+		Boundary time = position timestamp - time played since the last boundary. Times in 100 ns units, like the position timestamp.
+	*/
+	pos_frames = (clock_pos*((UINT64) this->format.sample_rate))/(this->CLOCK_FREQ);
+	period_time = ((pos_frames%((UINT64) this->format.buffer_size_frames))*10000000u)/((UINT64) this->format.sample_rate);
+
+	now_time = (LONG64) ((((UINT64) perf_now.QuadPart)/((UINT64) this->PERF_FREQ))*10000000u + ((((UINT64) perf_now.QuadPart)%((UINT64) this->PERF_FREQ))*10000000u)/((UINT64) this->PERF_FREQ));
+
+	*p_lateness = now_time - ((LONG64) (clock_qpc - period_time));
+	if(*p_lateness < 0) *p_lateness = 0;
+
+	*p_lateness = ((*p_lateness)*(this->PERF_FREQ))/10000000;
+	return TRUE;
+}
+
+BOOL WINAPI AudioSink_WASAPI::devicelist_init(VOID)
+{
+	HRESULT n_ret;
+	UINT devcoll_count;
+
+	if(p_processheap == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::devicelist_init: Error: p_processheap is NULL.");
+		return FALSE;
+	}
+
+	if(this->p_devenum == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::devicelist_init: Error: audio device enumerator not initialized.");
+		return FALSE;
+	}
+
+	if(!this->devicelist_deinit()) return FALSE;
+
+	n_ret = this->p_devenum->EnumAudioEndpoints(eRender, DEVICE_STATE_ACTIVE, &(this->devlist.p_devcoll));
+	if(n_ret != S_OK)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::devicelist_init: Error: IMMDeviceEnumerator::EnumAudioEndpoints failed.");
+		return FALSE;
+	}
+
+	n_ret = this->devlist.p_devcoll->GetCount(&devcoll_count);
+	if(n_ret != S_OK)
+	{
+		this->devicelist_deinit();
+		this->err_msg = TEXT("AudioSink_WASAPI::devicelist_init: Error: IMMDeviceCollection::GetCount failed.");
+		return FALSE;
+	}
+
+	if(!devcoll_count)
+	{
+		this->devicelist_deinit();
+		this->err_msg = TEXT("AudioSink_WASAPI::devicelist_init: Error: no audio devices found.");
+		return FALSE;
+	}
+
+	this->devlist.devlist_n_entries = (ULONG_PTR) devcoll_count;
+
+	this->devlist.p_devlist = (TCHAR*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, (this->devlist.devlist_n_entries)*(this->DEVICELIST_ENTRYLENGTH)*sizeof(TCHAR));
+	if(this->devlist.p_devlist == NULL)
+	{
+		this->devicelist_deinit();
+		this->err_msg = TEXT("AudioSink_WASAPI::devicelist_init: Error: failed to allocate heap memory.");
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL WINAPI AudioSink_WASAPI::devicelist_deinit(VOID)
+{
+	if(p_processheap == NULL)
+	{
+		this->err_msg = TEXT("AudioSink_WASAPI::devicelist_deinit: Error: p_processheap is NULL.");
+		return FALSE;
+	}
+
+	if(this->devlist.p_devlist != NULL)
+	{
+		if(!HeapFree(p_processheap, 0u, this->devlist.p_devlist))
+		{
+			this->err_msg = TEXT("AudioSink_WASAPI::devicelist_deinit: Error: failed to release heap memory.");
+			return FALSE;
+		}
+
+		this->devlist.p_devlist = NULL;
+	}
+
+	this->devlist.devlist_n_entries = 0u;
+
+	if(this->devlist.p_devcoll != NULL)
+	{
+		this->devlist.p_devcoll->Release();
+		this->devlist.p_devcoll = NULL;
+	}
+
+	return TRUE;
+}
@@ -0,0 +1,103 @@
+/*
+	Real-Time Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*
+	WASAPI audio sink: plays to an audio endpoint device in exclusive mode.
+	Choose the device first (chooseDevice() or chooseDefaultDevice()), then open().
+	close() releases the device as well: it must be chosen again before the next open().
+	A failed open() keeps the device, so open() can be retried with another format or buffer size.
+
+	When the buffer is a single period (format.period_frames == format.buffer_size_frames), the stream runs in event callback mode:
+	waitBufferSpace() sleeps until the device signals the end of the period, the lateness is measured from the device clock position.
+	Otherwise (exclusive mode event callback streams are written one whole buffer at a time) the stream is timer driven:
+	waitBufferSpace() sleeps on a high resolution timer until the missing frames have played, counted from the device clock position timestamp.
+*/
+
+#ifndef AUDIOSINK_WASAPI_HPP
+#define AUDIOSINK_WASAPI_HPP
+
+#include "AudioSink.hpp"
+#include "shared.hpp"
+
+#include <mmdeviceapi.h>
+#include <audioclient.h>
+
+struct _audiodevicelist {
+	IMMDeviceCollection *p_devcoll;
+	TCHAR *p_devlist;
+	ULONG_PTR devlist_n_entries;
+};
+
+typedef struct _audiodevicelist audiodevicelist_t;
+
+struct _audiodevice {
+	IMMDevice *p_device;
+	IAudioClient *p_audioclient;
+	IAudioRenderClient *p_renderclient;
+	IAudioClock *p_clock; /*NULL if the device has no clock*/
+};
+
+typedef struct _audiodevice audiodevice_t;
+
+class AudioSink_WASAPI : public AudioSink {
+	public:
+		AudioSink_WASAPI(VOID);
+		~AudioSink_WASAPI(VOID);
+
+		BOOL WINAPI loadDeviceList(VOID);
+		LONG_PTR WINAPI getDeviceListEntryCount(VOID);
+		const TCHAR* WINAPI getDeviceListEntry(ULONG_PTR index);
+
+		BOOL WINAPI chooseDevice(ULONG_PTR index);
+		BOOL WINAPI chooseDefaultDevice(VOID);
+
+		BOOL WINAPI open(const audiosink_format_t *p_format) override;
+		VOID WINAPI close(VOID) override;
+
+		BOOL WINAPI start(VOID) override;
+		BOOL WINAPI stop(VOID) override;
+
+		LONG_PTR WINAPI getPadding(VOID) override;
+		LONG64 WINAPI getPosition(VOID) override;
+
+		BYTE* WINAPI getBuffer(ULONG_PTR n_frames) override;
+		BOOL WINAPI releaseBuffer(ULONG_PTR n_frames) override;
+
+	protected:
+		BOOL WINAPI wait_device(ULONG_PTR n_frames_short, DWORD timeout_ms, LONG64 *p_lateness) override;
+
+	private:
+		static constexpr ULONG_PTR DEVICELIST_ENTRYLENGTH = 256u;
+
+		__declspec(align(PTR_SIZE_BYTES)) IMMDeviceEnumerator *p_devenum = NULL;
+
+		__declspec(align(PTR_SIZE_BYTES)) audiodevicelist_t devlist = {
+			.p_devcoll = NULL,
+			.p_devlist = NULL,
+			.devlist_n_entries = 0u
+		};
+
+		__declspec(align(PTR_SIZE_BYTES)) audiodevice_t dev = {
+			.p_device = NULL,
+			.p_audioclient = NULL,
+			.p_renderclient = NULL,
+			.p_clock = NULL
+		};
+
+		__declspec(align(PTR_SIZE_BYTES)) HANDLE h_event = NULL; /*device period event (event callback mode)*/
+		__declspec(align(4)) BOOL EVENT_MODE = FALSE;
+		__declspec(align(8)) UINT64 CLOCK_FREQ = 0u; /*IAudioClock position units per second*/
+
+		BOOL WINAPI devicelist_init(VOID);
+		BOOL WINAPI devicelist_deinit(VOID);
+
+		/*Releases the stream (clock, render client, audio client), keeps the device.*/
+		VOID WINAPI stream_release(VOID);
+};
+
+#endif /*AUDIOSINK_WASAPI_HPP*/
@@ -0,0 +1,235 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#include "FileMap.hpp"
+
+FileMap::FileMap(VOID)
+{
+	SYSTEM_INFO sysinfo;
+	HMODULE h_kernel32 = NULL;
+
+	GetSystemInfo(&sysinfo);
+	this->ALLOC_GRANULARITY = (ULONG_PTR) sysinfo.dwAllocationGranularity;
+
+	/*PrefetchVirtualMemory() is not available before Windows 8*/
+	h_kernel32 = GetModuleHandle(TEXT("kernel32.dll"));
+	if(h_kernel32 != NULL) this->pf_prefetch = (filemap_prefetch_proc_t) GetProcAddress(h_kernel32, "PrefetchVirtualMemory");
+}
+
+FileMap::~FileMap(VOID)
+{
+	this->close();
+}
+
+BOOL WINAPI FileMap::open(const TCHAR *file_dir)
+{
+	LARGE_INTEGER size;
+
+	this->close();
+
+	if(file_dir == NULL)
+	{
+		this->err_msg = TEXT("FileMap::open: Error: file directory is NULL.");
+		return FALSE;
+	}
+
+	this->h_file = CreateFile(file_dir, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, (FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN), NULL);
+	if(this->h_file == INVALID_HANDLE_VALUE)
+	{
+		this->err_msg = TEXT("FileMap::open: Error: could not open file.");
+		return FALSE;
+	}
+
+	if(!GetFileSizeEx(this->h_file, &size))
+	{
+		this->close();
+		this->err_msg = TEXT("FileMap::open: Error: could not get file size.");
+		return FALSE;
+	}
+
+	this->file_size = (ULONG64) size.QuadPart;
+
+	/*A zero length file cannot be mapped. It is kept open with no mapping, every getRegion() call will return end of file.*/
+	if(!this->file_size) return TRUE;
+
+	this->h_mapping = CreateFileMapping(this->h_file, NULL, PAGE_READONLY, 0u, 0u, NULL);
+	if(this->h_mapping == NULL)
+	{
+		this->close();
+		this->err_msg = TEXT("FileMap::open: Error: CreateFileMapping failed.");
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+VOID WINAPI FileMap::close(VOID)
+{
+	this->view_unmap();
+
+	if(this->h_mapping != NULL)
+	{
+		CloseHandle(this->h_mapping);
+		this->h_mapping = NULL;
+	}
+
+	if(this->h_file != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(this->h_file);
+		this->h_file = INVALID_HANDLE_VALUE;
+	}
+
+	this->file_size = 0u;
+	return;
+}
+
+BOOL WINAPI FileMap::isOpen(VOID)
+{
+	return (this->h_file != INVALID_HANDLE_VALUE);
+}
+
+ULONG64 WINAPI FileMap::getFileSize(VOID)
+{
+	return this->file_size;
+}
+
+const BYTE* WINAPI FileMap::getRegion(ULONG64 offset, ULONG_PTR size, ULONG_PTR *p_size_ret)
+{
+	ULONG64 region_end = 0u;
+
+	if(p_size_ret != NULL) *p_size_ret = 0u;
+
+	if(this->h_file == INVALID_HANDLE_VALUE)
+	{
+		this->err_msg = TEXT("FileMap::getRegion: Error: file is not open.");
+		return NULL;
+	}
+
+	if(size > this->getRegionSizeMax())
+	{
+		this->err_msg = TEXT("FileMap::getRegion: Error: region size is too large.");
+		return NULL;
+	}
+
+	if(offset >= this->file_size)
+	{
+		this->err_msg = TEXT("FileMap::getRegion: Error: offset is at or past the end of file.");
+		return NULL;
+	}
+
+	region_end = offset + ((ULONG64) size);
+	if(region_end > this->file_size) region_end = this->file_size;
+
+	if((this->p_view == NULL) || (offset < this->view_begin) || (region_end > (this->view_begin + ((ULONG64) this->view_size))))
+	{
+		if(!this->view_map(offset)) return NULL;
+	}
+
+	this->view_prefetch(region_end);
+
+	if(p_size_ret != NULL) *p_size_ret = (ULONG_PTR) (region_end - offset);
+
+	return &(this->p_view[offset - this->view_begin]);
+}
+
+ULONG_PTR WINAPI FileMap::getRegionSizeMax(VOID)
+{
+	/*View offsets are rounded down to the allocation granularity, so a region may start up to ALLOC_GRANULARITY bytes into the view.*/
+	return (this->VIEW_SIZE - this->ALLOC_GRANULARITY);
+}
+
+ULONG_PTR WINAPI FileMap::setReadBlockSize(ULONG_PTR size)
+{
+	if(!size) size = this->READ_BLOCK_SIZE_DEFAULT;
+	else if(size < this->READ_BLOCK_SIZE_MIN) size = this->READ_BLOCK_SIZE_MIN;
+	else if(size > this->READ_BLOCK_SIZE_MAX) size = this->READ_BLOCK_SIZE_MAX;
+
+	this->READ_BLOCK_SIZE = _get_closest_power2_ceil(size);
+	return this->READ_BLOCK_SIZE;
+}
+
+ULONG_PTR WINAPI FileMap::getReadBlockSize(VOID)
+{
+	return this->READ_BLOCK_SIZE;
+}
+
+__string WINAPI FileMap::getLastErrorMessage(VOID)
+{
+	return this->err_msg;
+}
+
+BOOL WINAPI FileMap::view_map(ULONG64 offset)
+{
+	ULONG64 size_64 = 0u;
+
+	this->view_unmap();
+
+	this->view_begin = offset - (offset%((ULONG64) this->ALLOC_GRANULARITY));
+
+	size_64 = this->file_size - this->view_begin;
+	if(size_64 > ((ULONG64) this->VIEW_SIZE)) size_64 = (ULONG64) this->VIEW_SIZE;
+
+	this->view_size = (ULONG_PTR) size_64;
+
+	this->p_view = (BYTE*) MapViewOfFile(this->h_mapping, FILE_MAP_READ, (DWORD) (this->view_begin >> 32), (DWORD) (this->view_begin & 0xffffffffu), (SIZE_T) this->view_size);
+	if(this->p_view == NULL)
+	{
+		this->view_size = 0u;
+		this->err_msg = TEXT("FileMap::view_map: Error: MapViewOfFile failed.");
+		return FALSE;
+	}
+
+	/*Prefetch starts at the read block holding offset*/
+	this->prefetch_end = offset - (offset%((ULONG64) this->READ_BLOCK_SIZE));
+	if(this->prefetch_end < this->view_begin) this->prefetch_end = this->view_begin;
+
+	return TRUE;
+}
+
+VOID WINAPI FileMap::view_unmap(VOID)
+{
+	if(this->p_view == NULL) return;
+
+	UnmapViewOfFile(this->p_view);
+	this->p_view = NULL;
+	this->view_begin = 0u;
+	this->view_size = 0u;
+	this->prefetch_end = 0u;
+
+	return;
+}
+
+VOID WINAPI FileMap::view_prefetch(ULONG64 offset)
+{
+	/*
+		Keeps the read block holding offset and the READ_BLOCKS_AHEAD blocks after it prefetched, within the current view.
+		All missing blocks are requested in a single call, so a new call is only made each time offset enters a new block.
+	*/
+
+	ULONG64 view_end = 0u;
+	ULONG64 target_end = 0u;
+	filemap_range_t range;
+
+	if(this->pf_prefetch == NULL) return;
+
+	view_end = this->view_begin + ((ULONG64) this->view_size);
+
+	target_end = offset - (offset%((ULONG64) this->READ_BLOCK_SIZE));
+	target_end += ((ULONG64) this->READ_BLOCK_SIZE)*((ULONG64) (this->READ_BLOCKS_AHEAD + 1u));
+	if(target_end > view_end) target_end = view_end;
+
+	if(this->prefetch_end >= target_end) return;
+
+	range.p_addr = &(this->p_view[this->prefetch_end - this->view_begin]);
+	range.size = (SIZE_T) (target_end - this->prefetch_end);
+
+	this->pf_prefetch(GetCurrentProcess(), 1u, &range, 0u);
+	this->prefetch_end = target_end;
+
+	return;
+}
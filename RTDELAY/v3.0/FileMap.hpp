@@ -0,0 +1,101 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*
+	Read only memory mapped file access.
+
+	The file is mapped through a sliding view of FileMap::VIEW_SIZE bytes, so files larger than the process address space
+	(32 bit builds) can still be read. getRegion() returns a pointer straight into the mapped view, so the caller reads the data
+	from the system file cache with no intermediate buffer or copy.
+
+	The file is opened with FILE_FLAG_SEQUENTIAL_SCAN, and the bytes ahead of the last requested region are prefetched
+	with PrefetchVirtualMemory() (Windows 8 and later, loaded at runtime, skipped on older systems).
+
+	Prefetching works in read blocks: aligned blocks of READ_BLOCK_SIZE bytes (setReadBlockSize()), with READ_BLOCKS_AHEAD blocks
+	kept in flight past the block being read. The disk sees a few large reads no matter how small the requested regions are.
+*/
+
+#ifndef FILEMAP_HPP
+#define FILEMAP_HPP
+
+#include "globldef.h"
+#include "strdef.hpp"
+
+struct _filemap_range {
+	VOID *p_addr;
+	SIZE_T size;
+};
+
+typedef struct _filemap_range filemap_range_t;
+
+typedef BOOL (WINAPI *filemap_prefetch_proc_t)(HANDLE h_process, ULONG_PTR n_entries, filemap_range_t *p_ranges, ULONG flags);
+
+class FileMap {
+	public:
+		FileMap(VOID);
+		~FileMap(VOID);
+
+		BOOL WINAPI open(const TCHAR *file_dir);
+		VOID WINAPI close(VOID);
+
+		BOOL WINAPI isOpen(VOID);
+		ULONG64 WINAPI getFileSize(VOID);
+
+		/*
+			getRegion()
+			maps the file region [offset, offset + size) and returns a pointer to its first byte.
+			The pointer stays valid until the next getRegion() or close() call.
+			The region is cut short at the end of file. *p_size_ret receives the number of valid bytes.
+			size must not be greater than getRegionSizeMax().
+			Returns NULL on error, or if offset is at or past the end of file.
+		*/
+		const BYTE* WINAPI getRegion(ULONG64 offset, ULONG_PTR size, ULONG_PTR *p_size_ret);
+
+		ULONG_PTR WINAPI getRegionSizeMax(VOID);
+
+		/*
+			setReadBlockSize()
+			sets the prefetch block size. It is rounded up to a power of 2 and clamped to [READ_BLOCK_SIZE_MIN, READ_BLOCK_SIZE_MAX].
+			0 selects READ_BLOCK_SIZE_DEFAULT. Returns the block size in use.
+		*/
+		ULONG_PTR WINAPI setReadBlockSize(ULONG_PTR size);
+		ULONG_PTR WINAPI getReadBlockSize(VOID);
+
+		__string WINAPI getLastErrorMessage(VOID);
+
+		static constexpr ULONG_PTR VIEW_SIZE = 0x1000000u; /*16 MiB*/
+
+		static constexpr ULONG_PTR READ_BLOCK_SIZE_MIN = 0x40000u; /*256 KiB*/
+		static constexpr ULONG_PTR READ_BLOCK_SIZE_MAX = 0x400000u; /*4 MiB*/
+		static constexpr ULONG_PTR READ_BLOCK_SIZE_DEFAULT = 0x100000u; /*1 MiB*/
+		static constexpr ULONG_PTR READ_BLOCKS_AHEAD = 2u;
+
+	private:
+		__declspec(align(PTR_SIZE_BYTES)) HANDLE h_file = INVALID_HANDLE_VALUE;
+		__declspec(align(PTR_SIZE_BYTES)) HANDLE h_mapping = NULL;
+
+		__declspec(align(PTR_SIZE_BYTES)) BYTE *p_view = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 view_begin = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR view_size = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 file_size = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG64 prefetch_end = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR ALLOC_GRANULARITY = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR READ_BLOCK_SIZE = READ_BLOCK_SIZE_DEFAULT;
+
+		__declspec(align(PTR_SIZE_BYTES)) filemap_prefetch_proc_t pf_prefetch = NULL;
+
+		__declspec(align(PTR_SIZE_BYTES)) __string err_msg = TEXT("");
+
+		BOOL WINAPI view_map(ULONG64 offset);
+		VOID WINAPI view_unmap(VOID);
+		VOID WINAPI view_prefetch(ULONG64 offset);
+};
+
+#endif /*FILEMAP_HPP*/
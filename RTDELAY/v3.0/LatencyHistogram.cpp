@@ -0,0 +1,140 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#include "LatencyHistogram.hpp"
+
+LatencyHistogram::LatencyHistogram(VOID)
+{
+	LARGE_INTEGER perf_freq;
+
+	QueryPerformanceFrequency(&perf_freq);
+	if(perf_freq.QuadPart > 0) this->NS_PER_TICK = 1000000000.0/((DOUBLE) perf_freq.QuadPart);
+
+	this->reset();
+}
+
+VOID WINAPI LatencyHistogram::reset(VOID)
+{
+	ULONG_PTR n_bucket = 0u;
+
+	for(n_bucket = 0u; n_bucket < this->N_BUCKETS; n_bucket++) InterlockedExchange64(&(this->p_buckets[n_bucket]), 0);
+
+	InterlockedExchange64(&(this->n_samples), 0);
+	InterlockedExchange64(&(this->total_ns), 0);
+	InterlockedExchange64(&(this->max_ns), 0);
+
+	return;
+}
+
+VOID WINAPI LatencyHistogram::add(LONG64 ticks)
+{
+	LONG64 value_ns = 0;
+
+	if(ticks > 0) value_ns = (LONG64) (((DOUBLE) ticks)*(this->NS_PER_TICK));
+
+	InterlockedIncrement64(&(this->p_buckets[this->bucket_index((ULONG64) value_ns)]));
+	InterlockedExchangeAdd64(&(this->total_ns), value_ns);
+
+	/*Single writer: nobody else can raise max_ns between the check and the store.*/
+	if(value_ns > this->max_ns) InterlockedExchange64(&(this->max_ns), value_ns);
+
+	/*Counted last, so a reader never sees more samples than bucket entries.*/
+	InterlockedIncrement64(&(this->n_samples));
+
+	return;
+}
+
+VOID WINAPI LatencyHistogram::getStats(latencyhist_stats_t *p_stats)
+{
+	ULONG64 p_counts[N_BUCKETS];
+	ULONG64 n_total = 0u;
+	ULONG_PTR n_bucket = 0u;
+	LONG64 n_samples = 0;
+
+	if(p_stats == NULL) return;
+
+	n_samples = InterlockedCompareExchange64(&(this->n_samples), 0, 0);
+
+	p_stats->mean_us = 0.0;
+	if(n_samples > 0) p_stats->mean_us = ((DOUBLE) InterlockedCompareExchange64(&(this->total_ns), 0, 0))/(((DOUBLE) n_samples)*1000.0);
+
+	p_stats->max_us = ((DOUBLE) InterlockedCompareExchange64(&(this->max_ns), 0, 0))/1000.0;
+
+	/*The buckets may hold a few samples more than n_samples (added meanwhile): the percentiles use the bucket total.*/
+	for(n_bucket = 0u; n_bucket < this->N_BUCKETS; n_bucket++)
+	{
+		p_counts[n_bucket] = (ULONG64) InterlockedCompareExchange64(&(this->p_buckets[n_bucket]), 0, 0);
+		n_total += p_counts[n_bucket];
+	}
+
+	p_stats->n_samples = n_total;
+
+	p_stats->p50_us = this->percentile_us(p_counts, n_total, 0.5);
+	p_stats->p99_us = this->percentile_us(p_counts, n_total, 0.99);
+	p_stats->p999_us = this->percentile_us(p_counts, n_total, 0.999);
+
+	if(p_stats->max_us < p_stats->p999_us) p_stats->max_us = p_stats->p999_us;
+	else
+	{
+		if(p_stats->p50_us > p_stats->max_us) p_stats->p50_us = p_stats->max_us;
+		if(p_stats->p99_us > p_stats->max_us) p_stats->p99_us = p_stats->max_us;
+		if(p_stats->p999_us > p_stats->max_us) p_stats->p999_us = p_stats->max_us;
+	}
+
+	return;
+}
+
+ULONG_PTR WINAPI LatencyHistogram::bucket_index(ULONG64 value_ns)
+{
+	ULONG_PTR exponent = 0u;
+
+	if(value_ns < SUB_BUCKET_COUNT) return (ULONG_PTR) value_ns;
+	if(value_ns >= (((ULONG64) 1u) << MAX_EXPONENT)) return N_BUCKETS - 1u;
+
+	exponent = SUB_BUCKET_BITS;
+	while((value_ns >> (exponent + 1u))) exponent++;
+
+	/*Power of 2 group, then the SUB_BUCKET_BITS bits right below the leading bit.*/
+	return (exponent - SUB_BUCKET_BITS + 1u)*SUB_BUCKET_COUNT + ((ULONG_PTR) ((value_ns >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1u)));
+}
+
+ULONG64 WINAPI LatencyHistogram::bucket_upper_ns(ULONG_PTR index)
+{
+	ULONG_PTR shift = 0u;
+
+	if(index < SUB_BUCKET_COUNT) return (ULONG64) index;
+
+	shift = index/SUB_BUCKET_COUNT - 1u;
+
+	return ((((ULONG64) (SUB_BUCKET_COUNT + index%SUB_BUCKET_COUNT)) + 1u) << shift) - 1u;
+}
+
+DOUBLE WINAPI LatencyHistogram::percentile_us(const ULONG64 *p_counts, ULONG64 n_total, DOUBLE fraction)
+{
+	ULONG64 n_rank = 0u;
+	ULONG64 n_sum = 0u;
+	ULONG_PTR n_bucket = 0u;
+
+	if(!n_total) return 0.0;
+
+	/*Rank of the sample the percentile falls on, 1 to n_total.*/
+	n_rank = (ULONG64) (fraction*((DOUBLE) n_total));
+	if(((DOUBLE) n_rank) < fraction*((DOUBLE) n_total)) n_rank++;
+	if(!n_rank) n_rank = 1u;
+	if(n_rank > n_total) n_rank = n_total;
+
+	for(n_bucket = 0u; n_bucket < this->N_BUCKETS; n_bucket++)
+	{
+		n_sum += p_counts[n_bucket];
+		if(n_sum >= n_rank) break;
+	}
+
+	if(n_bucket >= this->N_BUCKETS) n_bucket = this->N_BUCKETS - 1u;
+
+	return ((DOUBLE) this->bucket_upper_ns(n_bucket))/1000.0;
+}
@@ -0,0 +1,69 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*
+	Lock-free log-linear latency histogram.
+
+	Durations are kept in nanoseconds, in SUB_BUCKET_COUNT linear buckets per power of 2 (relative bucket width 1/SUB_BUCKET_COUNT, about 6%).
+	Below SUB_BUCKET_COUNT ns the buckets are 1 ns wide. Durations of 2^MAX_EXPONENT ns (about 18 minutes) and above land in the last bucket.
+
+	add() is meant for a single thread (the thread that runs the timed stage) and never blocks.
+	Every counter is updated on its own with an interlocked operation, so getStats() reads the histogram from any thread without stopping the writer.
+	A getStats() call running next to add() may miss the sample being added, the stats are never torn.
+*/
+
+#ifndef LATENCYHISTOGRAM_HPP
+#define LATENCYHISTOGRAM_HPP
+
+#include "globldef.h"
+
+struct _latencyhist_stats {
+	ULONG64 n_samples;
+	DOUBLE mean_us;
+	DOUBLE p50_us; /*percentiles: upper edge of the bucket they fall in, up to max_us*/
+	DOUBLE p99_us;
+	DOUBLE p999_us;
+	DOUBLE max_us;
+};
+
+typedef struct _latencyhist_stats latencyhist_stats_t;
+
+class LatencyHistogram {
+	public:
+		LatencyHistogram(VOID);
+
+		/*Clears the histogram. Must not be called while the writer thread is running.*/
+		VOID WINAPI reset(VOID);
+
+		/*Adds one duration, in performance counter ticks (negative durations count as 0).*/
+		VOID WINAPI add(LONG64 ticks);
+
+		VOID WINAPI getStats(latencyhist_stats_t *p_stats);
+
+	private:
+		static constexpr ULONG_PTR SUB_BUCKET_BITS = 4u;
+		static constexpr ULONG_PTR SUB_BUCKET_COUNT = (1u << SUB_BUCKET_BITS);
+		static constexpr ULONG_PTR MAX_EXPONENT = 40u;
+		static constexpr ULONG_PTR N_BUCKETS = (MAX_EXPONENT - SUB_BUCKET_BITS + 1u)*SUB_BUCKET_COUNT;
+
+		__declspec(align(8)) DOUBLE NS_PER_TICK = 1.0;
+
+		__declspec(align(8)) volatile LONG64 n_samples = 0;
+		__declspec(align(8)) volatile LONG64 total_ns = 0;
+		__declspec(align(8)) volatile LONG64 max_ns = 0;
+
+		__declspec(align(64)) volatile LONG64 p_buckets[N_BUCKETS];
+
+		static ULONG_PTR WINAPI bucket_index(ULONG64 value_ns);
+		static ULONG64 WINAPI bucket_upper_ns(ULONG_PTR index);
+
+		/*Returns the upper edge (us) of the bucket the given fraction (0.0 to 1.0) of the samples fall in.*/
+		DOUBLE WINAPI percentile_us(const ULONG64 *p_counts, ULONG64 n_total, DOUBLE fraction);
+};
+
+#endif /*LATENCYHISTOGRAM_HPP*/
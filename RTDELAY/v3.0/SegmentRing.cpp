@@ -0,0 +1,204 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#include "SegmentRing.hpp"
+
+SegmentRing::SegmentRing(VOID)
+{
+}
+
+SegmentRing::~SegmentRing(VOID)
+{
+	this->deinitialize();
+}
+
+BOOL WINAPI SegmentRing::initialize(ULONG_PTR n_slots, ULONG_PTR slot_size_bytes)
+{
+	ULONG_PTR n_slot = 0u;
+
+	this->deinitialize();
+
+	if(p_processheap == NULL)
+	{
+		this->err_msg = TEXT("SegmentRing::initialize: Error: p_processheap is NULL.");
+		return FALSE;
+	}
+
+	if(!n_slots || !slot_size_bytes)
+	{
+		this->err_msg = TEXT("SegmentRing::initialize: Error: invalid ring size.");
+		return FALSE;
+	}
+
+	this->N_SLOTS = _get_closest_power2_ceil(n_slots);
+	this->SLOT_SIZE_BYTES = slot_size_bytes;
+
+	this->p_slots = (segring_slot_t*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, (this->N_SLOTS)*sizeof(segring_slot_t));
+	this->p_data = HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, (this->N_SLOTS)*(this->SLOT_SIZE_BYTES));
+
+	if((this->p_slots == NULL) || (this->p_data == NULL))
+	{
+		this->deinitialize();
+		this->err_msg = TEXT("SegmentRing::initialize: Error: failed to allocate heap memory.");
+		return FALSE;
+	}
+
+	this->h_event_space = CreateEvent(NULL, FALSE, FALSE, NULL);
+	this->h_event_data = CreateEvent(NULL, FALSE, FALSE, NULL);
+
+	if((this->h_event_space == NULL) || (this->h_event_data == NULL))
+	{
+		this->deinitialize();
+		this->err_msg = TEXT("SegmentRing::initialize: Error: CreateEvent failed.");
+		return FALSE;
+	}
+
+	for(n_slot = 0u; n_slot < this->N_SLOTS; n_slot++) this->p_slots[n_slot].p_data = (VOID*) (((ULONG_PTR) (this->p_data)) + n_slot*(this->SLOT_SIZE_BYTES));
+
+	this->reset();
+	return TRUE;
+}
+
+VOID WINAPI SegmentRing::deinitialize(VOID)
+{
+	if(this->h_event_space != NULL)
+	{
+		CloseHandle(this->h_event_space);
+		this->h_event_space = NULL;
+	}
+
+	if(this->h_event_data != NULL)
+	{
+		CloseHandle(this->h_event_data);
+		this->h_event_data = NULL;
+	}
+
+	if(p_processheap != NULL)
+	{
+		if(this->p_slots != NULL) HeapFree(p_processheap, 0u, this->p_slots);
+		if(this->p_data != NULL) HeapFree(p_processheap, 0u, this->p_data);
+	}
+
+	this->p_slots = NULL;
+	this->p_data = NULL;
+	this->N_SLOTS = 0u;
+	this->SLOT_SIZE_BYTES = 0u;
+
+	this->reset();
+	return;
+}
+
+VOID WINAPI SegmentRing::reset(VOID)
+{
+	InterlockedExchange(&(this->n_write), 0);
+	InterlockedExchange(&(this->n_read), 0);
+
+	return;
+}
+
+segring_slot_t* WINAPI SegmentRing::pushBegin(VOID)
+{
+	LONG n_write = 0;
+	LONG n_read = 0;
+
+	if(this->p_slots == NULL) return NULL;
+
+	n_write = this->n_write;
+	n_read = InterlockedCompareExchange(&(this->n_read), 0, 0);
+
+	if(((ULONG_PTR) (((ULONG) n_write) - ((ULONG) n_read))) >= this->N_SLOTS) return NULL;
+
+	return &(this->p_slots[((ULONG_PTR) (ULONG) n_write) & (this->N_SLOTS - 1u)]);
+}
+
+VOID WINAPI SegmentRing::pushCommit(VOID)
+{
+	/*InterlockedExchange() is a full memory barrier: the slot contents are visible before the new write counter is.*/
+	InterlockedExchange(&(this->n_write), (LONG) (((ULONG) this->n_write) + 1u));
+	if(this->data_waiting) SetEvent(this->h_event_data);
+
+	return;
+}
+
+segring_slot_t* WINAPI SegmentRing::popBegin(VOID)
+{
+	LONG n_write = 0;
+	LONG n_read = 0;
+
+	if(this->p_slots == NULL) return NULL;
+
+	n_read = this->n_read;
+	n_write = InterlockedCompareExchange(&(this->n_write), 0, 0);
+
+	if(n_write == n_read) return NULL;
+
+	return &(this->p_slots[((ULONG_PTR) (ULONG) n_read) & (this->N_SLOTS - 1u)]);
+}
+
+VOID WINAPI SegmentRing::popCommit(VOID)
+{
+	InterlockedExchange(&(this->n_read), (LONG) (((ULONG) this->n_read) + 1u));
+	if(this->space_waiting) SetEvent(this->h_event_space);
+
+	return;
+}
+
+VOID WINAPI SegmentRing::waitSpace(DWORD timeout_ms)
+{
+	if(this->h_event_space == NULL) return;
+
+	/*
+		The waiting flag is raised before the ring is checked again, and the other side updates its counter before checking the flag.
+		Both are full barriers (InterlockedExchange()), so either this side sees the free slot or the other side sees the flag.
+	*/
+	InterlockedExchange(&(this->space_waiting), 1);
+	if(this->getFill() >= this->N_SLOTS) WaitForSingleObject(this->h_event_space, timeout_ms);
+	InterlockedExchange(&(this->space_waiting), 0);
+
+	return;
+}
+
+VOID WINAPI SegmentRing::waitData(DWORD timeout_ms)
+{
+	if(this->h_event_data == NULL) return;
+
+	InterlockedExchange(&(this->data_waiting), 1);
+	if(!this->getFill()) WaitForSingleObject(this->h_event_data, timeout_ms);
+	InterlockedExchange(&(this->data_waiting), 0);
+
+	return;
+}
+
+VOID WINAPI SegmentRing::wake(VOID)
+{
+	if(this->h_event_space != NULL) SetEvent(this->h_event_space);
+	if(this->h_event_data != NULL) SetEvent(this->h_event_data);
+
+	return;
+}
+
+ULONG_PTR WINAPI SegmentRing::getFill(VOID)
+{
+	LONG n_write = 0;
+	LONG n_read = 0;
+
+	n_write = InterlockedCompareExchange(&(this->n_write), 0, 0);
+	n_read = InterlockedCompareExchange(&(this->n_read), 0, 0);
+
+	return (ULONG_PTR) (((ULONG) n_write) - ((ULONG) n_read));
+}
+
+ULONG_PTR WINAPI SegmentRing::getSlotCount(VOID)
+{
+	return this->N_SLOTS;
+}
+
+__string WINAPI SegmentRing::getLastErrorMessage(VOID)
+{
+	return this->err_msg;
+}
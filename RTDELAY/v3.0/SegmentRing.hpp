@@ -0,0 +1,91 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*
+	Single producer/single consumer lock-free ring of fixed size data slots.
+
+	One thread fills slots (pushBegin()/pushCommit()), another thread drains them (popBegin()/popCommit()).
+	The write and read counters are each written by a single thread only and published with InterlockedExchange(),
+	so neither side ever takes a lock or waits for the other one.
+
+	waitSpace() and waitData() let a side sleep until the other side made progress, instead of polling.
+	The events are only signaled while a side is actually waiting, so a ring that never runs full or empty costs no system calls.
+*/
+
+#ifndef SEGMENTRING_HPP
+#define SEGMENTRING_HPP
+
+#include "globldef.h"
+#include "strdef.hpp"
+
+struct _segring_slot {
+	VOID *p_data; /*slot data buffer (slot_size_bytes), set by the ring*/
+	ULONG64 position; /*user data, e.g. source file position of the slot data*/
+	ULONG_PTR size; /*user data, e.g. number of valid samples in the slot*/
+	LONG tag; /*user data*/
+	LONG flags; /*user data*/
+};
+
+typedef struct _segring_slot segring_slot_t;
+
+class SegmentRing {
+	public:
+		SegmentRing(VOID);
+		~SegmentRing(VOID);
+
+		/*n_slots is rounded up to a power of 2.*/
+		BOOL WINAPI initialize(ULONG_PTR n_slots, ULONG_PTR slot_size_bytes);
+		VOID WINAPI deinitialize(VOID);
+
+		/*Drops all ready slots. Must not be called while either side is running.*/
+		VOID WINAPI reset(VOID);
+
+		/*Producer side: pushBegin() returns the next free slot (NULL if the ring is full), pushCommit() makes it visible to the consumer.*/
+		segring_slot_t* WINAPI pushBegin(VOID);
+		VOID WINAPI pushCommit(VOID);
+
+		/*Consumer side: popBegin() returns the oldest ready slot (NULL if the ring is empty), popCommit() releases it back to the producer.*/
+		segring_slot_t* WINAPI popBegin(VOID);
+		VOID WINAPI popCommit(VOID);
+
+		/*
+			Sleep until there is a free slot / a ready slot, or until timeout_ms expires.
+			They return right away if the ring already has a free slot / a ready slot.
+		*/
+		VOID WINAPI waitSpace(DWORD timeout_ms);
+		VOID WINAPI waitData(DWORD timeout_ms);
+
+		/*Wakes up any side waiting in waitSpace()/waitData().*/
+		VOID WINAPI wake(VOID);
+
+		ULONG_PTR WINAPI getFill(VOID);
+		ULONG_PTR WINAPI getSlotCount(VOID);
+
+		__string WINAPI getLastErrorMessage(VOID);
+
+	private:
+		__declspec(align(PTR_SIZE_BYTES)) segring_slot_t *p_slots = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) VOID *p_data = NULL;
+
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR N_SLOTS = 0u;
+		__declspec(align(PTR_SIZE_BYTES)) ULONG_PTR SLOT_SIZE_BYTES = 0u;
+
+		__declspec(align(PTR_SIZE_BYTES)) HANDLE h_event_space = NULL;
+		__declspec(align(PTR_SIZE_BYTES)) HANDLE h_event_data = NULL;
+
+		__declspec(align(4)) volatile LONG space_waiting = 0;
+		__declspec(align(4)) volatile LONG data_waiting = 0;
+
+		__declspec(align(PTR_SIZE_BYTES)) __string err_msg = TEXT("");
+
+		/*Free running counters (wrap around), kept on separate cache lines.*/
+		__declspec(align(64)) volatile LONG n_write = 0;
+		__declspec(align(64)) volatile LONG n_read = 0;
+};
+
+#endif /*SEGMENTRING_HPP*/
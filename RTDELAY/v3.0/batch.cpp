@@ -0,0 +1,487 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*
+	Batch render tool (console application, no GUI, no audio device).
+	Renders every input file of a manifest through every preset of the manifest, on all CPUs (see AudioBatch.hpp).
+
+	Usage: batch <manifest.txt> [options]
+
+	Options:
+	--threads <n>        worker threads (default 0: one per CPU)
+	--segment <frames>   DSP block size (default __BATCH_SEGMENT_SIZE_FRAMES)
+	--readblock <bytes>  input file read block size (default 1 MiB)
+
+	Manifest: one entry per line. Empty lines and lines starting with '#' are ignored.
+
+	in <input.wav>       adds an input file (rest of the line)
+	outdir <directory>   output directory (rest of the line, default: current directory)
+	tail <ms>            renders this much past the end of each input (default 0)
+	preset <name> [dry <amp>] [out <amp>] [ff <delay>:<amp>]... [fb <delay>:<amp>]...
+	                     adds a preset (delay times in frames, up to __BATCH_DELAY_N_FFCH/__BATCH_DELAY_N_FBCH taps, dry and out default 1.0)
+
+	Every (input, preset) pair is rendered into <outdir>\<input file name>_<preset name>.wav
+	A manifest where two pairs would render into the same file (input files with the same name in different directories) is rejected.
+
+	Prints every job's throughput, then the aggregate throughput of the whole batch.
+*/
+
+#include "globldef.h"
+#include "cstrdef.h"
+#include "strdef.hpp"
+
+#include "AudioBatch.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define __BATCH_SEGMENT_SIZE_FRAMES 1024U
+#define __BATCH_DELAY_BUFFER_SIZE_FRAMES 65536U
+#define __BATCH_DELAY_N_FFCH 4U
+#define __BATCH_DELAY_N_FBCH 4U
+
+#define __BATCH_N_FILES_MAX 256U
+#define __BATCH_N_PRESETS_MAX 64U
+#define __BATCH_PRESET_NAME_SIZE_CHARS 64U
+
+#define PRINTBUF_SIZE_CHARS 1024U
+
+struct _batch_preset {
+	CHAR name[__BATCH_PRESET_NAME_SIZE_CHARS];
+	audiodelay_fx_params_t ff_params[__BATCH_DELAY_N_FFCH];
+	audiodelay_fx_params_t fb_params[__BATCH_DELAY_N_FBCH];
+	audiorender_preset_t preset;
+};
+
+typedef struct _batch_preset batch_preset_t;
+
+static CHAR files[__BATCH_N_FILES_MAX][TEXTBUF_SIZE_CHARS];
+static ULONG_PTR n_files = 0u;
+
+static batch_preset_t presets[__BATCH_N_PRESETS_MAX];
+static ULONG_PTR n_presets = 0u;
+
+static CHAR outdir[TEXTBUF_SIZE_CHARS] = {'\0'};
+
+static __declspec(align(PTR_SIZE_BYTES)) audiobatch_params_t batch_params;
+
+static __declspec(align(PTR_SIZE_BYTES)) audiobatch_job_t *p_jobs = NULL;
+static __declspec(align(PTR_SIZE_BYTES)) TCHAR *p_jobs_dir = NULL;
+
+static BOOL WINAPI parse_args(INT argc, CHAR **argv);
+static BOOL WINAPI parse_manifest(const CHAR *manifest_dir);
+static BOOL WINAPI parse_preset(CHAR *args, batch_preset_t *p_preset);
+static BOOL WINAPI parse_tap(const CHAR *arg, audiodelay_fx_params_t *p_fx);
+static BOOL WINAPI jobs_create(VOID);
+static VOID WINAPI jobs_destroy(VOID);
+static BOOL WINAPI check_output_names(VOID);
+static VOID WINAPI get_output_name(ULONG_PTR n_job, CHAR *fileout_dir, SIZE_T fileout_dir_size);
+static VOID WINAPI get_file_title(const CHAR *file_dir, CHAR *title, SIZE_T title_size);
+static INT __cdecl compare_output_names(const VOID *p_a, const VOID *p_b);
+static VOID WINAPI print_error(const TCHAR *text);
+
+INT main(INT argc, CHAR **argv)
+{
+	AudioBatch *p_batch = NULL;
+	audiobatch_jobresult_t result;
+	audiobatch_stats_t stats;
+	ULONG_PTR n_job = 0u;
+	INT ret = 1;
+
+	p_processheap = GetProcessHeap();
+	if(p_processheap == NULL)
+	{
+		print_error(TEXT("Error: Failed to Retrieve Process Heap."));
+		return 1;
+	}
+
+	if(!parse_args(argc, argv))
+	{
+		fputs("Usage: batch <manifest.txt> [--threads <n>] [--segment <frames>] [--readblock <bytes>]\n", stderr);
+		return 1;
+	}
+
+	if(!jobs_create())
+	{
+		print_error(TEXT("Error: failed to allocate heap memory."));
+		return 1;
+	}
+
+	p_batch = new AudioBatch(&batch_params);
+	if(p_batch == NULL)
+	{
+		print_error(TEXT("Error: failed to create batch object instance."));
+		goto _l_main_exit;
+	}
+
+	if(!p_batch->initialize())
+	{
+		print_error(p_batch->getLastErrorMessage().c_str());
+		goto _l_main_exit;
+	}
+
+	printf("Rendering %lu files x %lu presets...\n", (unsigned long) n_files, (unsigned long) n_presets);
+
+	if(!p_batch->runBatch())
+	{
+		print_error(p_batch->getLastErrorMessage().c_str());
+		goto _l_main_exit;
+	}
+
+	for(n_job = 0u; n_job < batch_params.n_jobs; n_job++)
+	{
+		p_batch->getJobResult(n_job, &result);
+
+		printf("[%s] %s: ", presets[n_job % n_presets].name, files[n_job/n_presets]);
+
+		if(result.success)
+			printf("%llu frames in %.3f s, %.0f frames/s (%.1fx real-time), worker %lu\n", (unsigned long long) result.stats.n_frames, result.stats.time_s, result.stats.frames_per_s, result.stats.realtime_factor, (unsigned long) result.n_worker);
+		else
+		{
+			fputs("FAILED\n", stdout);
+			print_error(p_batch->getJobErrorMessage(n_job).c_str());
+		}
+	}
+
+	p_batch->getBatchStats(&stats);
+
+	printf("Done: %lu jobs (%lu failed) in %.3f s, %lu threads, %lu jobs stolen\n", (unsigned long) (stats.n_jobs_done + stats.n_jobs_failed), (unsigned long) stats.n_jobs_failed, stats.time_s, (unsigned long) stats.n_threads, (unsigned long) stats.n_jobs_stolen);
+	printf("Throughput: %.0f frames/s (%.1fx real-time)\n", stats.frames_per_s, stats.realtime_factor);
+
+	if(!stats.n_jobs_failed) ret = 0;
+
+_l_main_exit:
+	if(p_batch != NULL) delete p_batch;
+	jobs_destroy();
+	return ret;
+}
+
+static BOOL WINAPI parse_args(INT argc, CHAR **argv)
+{
+	INT n_arg = 0;
+	ULONG_PTR n_preset = 0u;
+	ULONG_PTR n_fx = 0u;
+	ULONG_PTR delay_max = 0u;
+	ULONG_PTR delay_buffer_size = 0u;
+
+	if(argc < 2) return FALSE;
+
+	ZeroMemory(&batch_params, sizeof(audiobatch_params_t));
+
+	batch_params.segment_size_frames = __BATCH_SEGMENT_SIZE_FRAMES;
+	batch_params.n_ff_delays = __BATCH_DELAY_N_FFCH;
+	batch_params.n_fb_delays = __BATCH_DELAY_N_FBCH;
+
+	for(n_arg = 2; n_arg < argc; n_arg++)
+	{
+		if((n_arg + 1) >= argc) return FALSE;
+
+		if(!strcmp(argv[n_arg], "--threads")) batch_params.n_threads = (ULONG_PTR) strtoul(argv[n_arg + 1], NULL, 10);
+		else if(!strcmp(argv[n_arg], "--segment")) batch_params.segment_size_frames = (ULONG_PTR) strtoul(argv[n_arg + 1], NULL, 10);
+		else if(!strcmp(argv[n_arg], "--readblock")) batch_params.readblock_size_bytes = (ULONG_PTR) strtoul(argv[n_arg + 1], NULL, 10);
+		else return FALSE;
+
+		n_arg++;
+	}
+
+	if(!parse_manifest(argv[1])) return FALSE;
+
+	if((!n_files) || (!n_presets))
+	{
+		fputs("Error: manifest needs at least one input file and one preset.\n", stderr);
+		return FALSE;
+	}
+
+	if(!check_output_names()) return FALSE;
+
+	/*The delay buffer must hold the longest delay time of all presets.*/
+
+	for(n_preset = 0u; n_preset < n_presets; n_preset++)
+	{
+		for(n_fx = 0u; n_fx < __BATCH_DELAY_N_FFCH; n_fx++)
+			if(presets[n_preset].ff_params[n_fx].delay > delay_max) delay_max = (ULONG_PTR) presets[n_preset].ff_params[n_fx].delay;
+
+		for(n_fx = 0u; n_fx < __BATCH_DELAY_N_FBCH; n_fx++)
+			if(presets[n_preset].fb_params[n_fx].delay > delay_max) delay_max = (ULONG_PTR) presets[n_preset].fb_params[n_fx].delay;
+	}
+
+	delay_buffer_size = __BATCH_DELAY_BUFFER_SIZE_FRAMES;
+	if(delay_max >= delay_buffer_size) delay_buffer_size = _get_closest_power2_ceil(delay_max + 1u);
+
+	batch_params.delay_buffer_size_frames = delay_buffer_size;
+
+	return TRUE;
+}
+
+static BOOL WINAPI parse_manifest(const CHAR *manifest_dir)
+{
+	FILE *p_file = NULL;
+	CHAR line[TEXTBUF_SIZE_CHARS];
+	CHAR *p_text = NULL;
+	CHAR *p_args = NULL;
+	SIZE_T len = 0u;
+	ULONG_PTR n_line = 0u;
+
+	p_file = fopen(manifest_dir, "r");
+	if(p_file == NULL)
+	{
+		fputs("Error: could not open manifest file.\n", stderr);
+		return FALSE;
+	}
+
+	while(fgets(line, TEXTBUF_SIZE_CHARS, p_file) != NULL)
+	{
+		n_line++;
+
+		len = strlen(line);
+		while(len && ((line[len - 1u] == '\n') || (line[len - 1u] == '\r') || (line[len - 1u] == ' ') || (line[len - 1u] == '\t'))) line[--len] = '\0';
+
+		p_text = line;
+		while((*p_text == ' ') || (*p_text == '\t')) p_text++;
+
+		if((*p_text == '\0') || (*p_text == '#')) continue;
+
+		/*Keyword, then arguments*/
+		p_args = p_text;
+		while((*p_args != '\0') && (*p_args != ' ') && (*p_args != '\t')) p_args++;
+
+		if(*p_args != '\0') *p_args++ = '\0';
+		while((*p_args == ' ') || (*p_args == '\t')) p_args++;
+
+		if(!strcmp(p_text, "in") && (*p_args != '\0') && (n_files < __BATCH_N_FILES_MAX))
+		{
+			strncpy(files[n_files], p_args, TEXTBUF_SIZE_CHARS - 1u);
+			n_files++;
+		}
+		else if(!strcmp(p_text, "outdir") && (*p_args != '\0')) strncpy(outdir, p_args, TEXTBUF_SIZE_CHARS - 1u);
+		else if(!strcmp(p_text, "tail") && (*p_args != '\0')) batch_params.tail_size_ms = (ULONG_PTR) strtoul(p_args, NULL, 10);
+		else if(!strcmp(p_text, "preset") && (n_presets < __BATCH_N_PRESETS_MAX) && parse_preset(p_args, &presets[n_presets])) n_presets++;
+		else
+		{
+			fprintf(stderr, "Error: manifest line %lu is invalid.\n", (unsigned long) n_line);
+			fclose(p_file);
+			return FALSE;
+		}
+	}
+
+	fclose(p_file);
+	return TRUE;
+}
+
+static BOOL WINAPI parse_preset(CHAR *args, batch_preset_t *p_preset)
+{
+	CHAR *p_token = NULL;
+	CHAR *p_value = NULL;
+	ULONG_PTR n_ff = 0u;
+	ULONG_PTR n_fb = 0u;
+
+	ZeroMemory(p_preset, sizeof(batch_preset_t));
+
+	p_preset->preset.dryinput_amp = 1.0f;
+	p_preset->preset.output_amp = 1.0f;
+	p_preset->preset.p_ff_params = p_preset->ff_params;
+	p_preset->preset.p_fb_params = p_preset->fb_params;
+
+	p_token = strtok(args, " \t");
+	if(p_token == NULL) return FALSE;
+
+	strncpy(p_preset->name, p_token, __BATCH_PRESET_NAME_SIZE_CHARS - 1u);
+
+	while((p_token = strtok(NULL, " \t")) != NULL)
+	{
+		p_value = strtok(NULL, " \t");
+		if(p_value == NULL) return FALSE;
+
+		if(!strcmp(p_token, "dry")) p_preset->preset.dryinput_amp = (FLOAT) atof(p_value);
+		else if(!strcmp(p_token, "out")) p_preset->preset.output_amp = (FLOAT) atof(p_value);
+		else if(!strcmp(p_token, "ff"))
+		{
+			if(n_ff >= __BATCH_DELAY_N_FFCH) return FALSE;
+			if(!parse_tap(p_value, &(p_preset->ff_params[n_ff]))) return FALSE;
+			n_ff++;
+		}
+		else if(!strcmp(p_token, "fb"))
+		{
+			if(n_fb >= __BATCH_DELAY_N_FBCH) return FALSE;
+			if(!parse_tap(p_value, &(p_preset->fb_params[n_fb]))) return FALSE;
+			n_fb++;
+		}
+		else return FALSE;
+	}
+
+	return TRUE;
+}
+
+static BOOL WINAPI parse_tap(const CHAR *arg, audiodelay_fx_params_t *p_fx)
+{
+	CHAR *p_end = NULL;
+	ULONG delay = 0u;
+
+	delay = strtoul(arg, &p_end, 10);
+	if((p_end == arg) || (*p_end != ':')) return FALSE;
+
+	p_fx->delay = (UINT32) delay;
+	p_fx->amp = (FLOAT) atof(&p_end[1]);
+
+	return TRUE;
+}
+
+/*Jobs are ordered file by file: job n renders files[n/n_presets] through presets[n%n_presets].*/
+
+static BOOL WINAPI jobs_create(VOID)
+{
+	ULONG_PTR n_jobs = 0u;
+	ULONG_PTR n_job = 0u;
+	TCHAR *p_filein_dir = NULL;
+	TCHAR *p_fileout_dir = NULL;
+	CHAR fileout_dir[TEXTBUF_SIZE_CHARS];
+
+	n_jobs = n_files*n_presets;
+
+	p_jobs = (audiobatch_job_t*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, n_jobs*sizeof(audiobatch_job_t));
+	p_jobs_dir = (TCHAR*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, 2u*n_jobs*TEXTBUF_SIZE_BYTES);
+
+	if((p_jobs == NULL) || (p_jobs_dir == NULL)) return FALSE;
+
+	for(n_job = 0u; n_job < n_jobs; n_job++)
+	{
+		p_filein_dir = &p_jobs_dir[2u*n_job*TEXTBUF_SIZE_CHARS];
+		p_fileout_dir = &p_filein_dir[TEXTBUF_SIZE_CHARS];
+
+		get_output_name(n_job, fileout_dir, TEXTBUF_SIZE_CHARS);
+
+		cstr_copy_char_to_tchar(files[n_job/n_presets], p_filein_dir, TEXTBUF_SIZE_CHARS);
+		cstr_copy_char_to_tchar(fileout_dir, p_fileout_dir, TEXTBUF_SIZE_CHARS);
+
+		p_jobs[n_job].filein_dir = p_filein_dir;
+		p_jobs[n_job].fileout_dir = p_fileout_dir;
+		p_jobs[n_job].p_preset = &(presets[n_job % n_presets].preset);
+	}
+
+	batch_params.p_jobs = p_jobs;
+	batch_params.n_jobs = n_jobs;
+
+	return TRUE;
+}
+
+static VOID WINAPI jobs_destroy(VOID)
+{
+	if(p_jobs != NULL)
+	{
+		HeapFree(p_processheap, 0u, p_jobs);
+		p_jobs = NULL;
+	}
+
+	if(p_jobs_dir != NULL)
+	{
+		HeapFree(p_processheap, 0u, p_jobs_dir);
+		p_jobs_dir = NULL;
+	}
+
+	return;
+}
+
+/*
+	Output names only keep the input file title, so two inputs with the same file name in different directories
+	(or names that run together with the preset name, like "a_b" + "c" and "a" + "b_c") would render into the same file,
+	from two workers at once. Such a manifest is rejected. File names compare case insensitive, as on Windows file systems.
+*/
+
+static BOOL WINAPI check_output_names(VOID)
+{
+	ULONG_PTR n_jobs = 0u;
+	ULONG_PTR n_job = 0u;
+	CHAR *p_names = NULL;
+	CHAR **pp_names = NULL;
+	BOOL ret = TRUE;
+
+	n_jobs = n_files*n_presets;
+
+	p_names = (CHAR*) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, n_jobs*TEXTBUF_SIZE_CHARS);
+	pp_names = (CHAR**) HeapAlloc(p_processheap, HEAP_ZERO_MEMORY, n_jobs*sizeof(CHAR*));
+
+	if((p_names == NULL) || (pp_names == NULL))
+	{
+		fputs("Error: failed to allocate heap memory.\n", stderr);
+		ret = FALSE;
+		goto _l_check_output_names_exit;
+	}
+
+	for(n_job = 0u; n_job < n_jobs; n_job++)
+	{
+		pp_names[n_job] = &p_names[n_job*TEXTBUF_SIZE_CHARS];
+		get_output_name(n_job, pp_names[n_job], TEXTBUF_SIZE_CHARS);
+	}
+
+	qsort(pp_names, n_jobs, sizeof(CHAR*), &compare_output_names);
+
+	for(n_job = 1u; n_job < n_jobs; n_job++)
+	{
+		if(_stricmp(pp_names[n_job - 1u], pp_names[n_job])) continue;
+
+		fprintf(stderr, "Error: more than one input file and preset pair renders into %s (input files with the same name, or duplicate preset names).\n", pp_names[n_job]);
+		ret = FALSE;
+		break;
+	}
+
+_l_check_output_names_exit:
+	if(p_names != NULL) HeapFree(p_processheap, 0u, p_names);
+	if(pp_names != NULL) HeapFree(p_processheap, 0u, pp_names);
+
+	return ret;
+}
+
+static VOID WINAPI get_output_name(ULONG_PTR n_job, CHAR *fileout_dir, SIZE_T fileout_dir_size)
+{
+	CHAR title[TEXTBUF_SIZE_CHARS];
+
+	get_file_title(files[n_job/n_presets], title, TEXTBUF_SIZE_CHARS);
+
+	if(outdir[0] != '\0') snprintf(fileout_dir, fileout_dir_size, "%s\\%s_%s.wav", outdir, title, presets[n_job % n_presets].name);
+	else snprintf(fileout_dir, fileout_dir_size, "%s_%s.wav", title, presets[n_job % n_presets].name);
+
+	return;
+}
+
+/*File name without directory and extension.*/
+
+static VOID WINAPI get_file_title(const CHAR *file_dir, CHAR *title, SIZE_T title_size)
+{
+	const CHAR *p_name = NULL;
+	CHAR *p_ext = NULL;
+
+	p_name = strrchr(file_dir, '\\');
+	if((p_name == NULL) || (strrchr(file_dir, '/') > p_name)) p_name = strrchr(file_dir, '/');
+
+	if(p_name == NULL) p_name = file_dir;
+	else p_name++;
+
+	strncpy(title, p_name, title_size - 1u);
+	title[title_size - 1u] = '\0';
+
+	p_ext = strrchr(title, '.');
+	if(p_ext != NULL) *p_ext = '\0';
+
+	return;
+}
+
+static INT __cdecl compare_output_names(const VOID *p_a, const VOID *p_b)
+{
+	return _stricmp(*((CHAR* const*) p_a), *((CHAR* const*) p_b));
+}
+
+static VOID WINAPI print_error(const TCHAR *text)
+{
+	CHAR printbuf[PRINTBUF_SIZE_CHARS];
+
+	cstr_copy_tchar_to_char(text, printbuf, PRINTBUF_SIZE_CHARS);
+
+	fputs(printbuf, stderr);
+	fputs("\n", stderr);
+	return;
+}
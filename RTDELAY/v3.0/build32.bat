@@ -1,24 +1,62 @@
-"C:\MinGW64\bin\g++.exe" globldef.c -c -std=c++11 -m32 -o globldef_32.o
-"C:\MinGW64\bin\g++.exe" cstrdef.c -c -std=c++11 -m32 -o cstrdef_32.o
-"C:\MinGW64\bin\g++.exe" thread.c -c -std=c++11 -m32 -o thread_32.o
-"C:\MinGW64\bin\g++.exe" strdef.cpp -c -std=c++11 -m32 -o strdef_32.o
-
-"C:\MinGW64\bin\g++.exe" main.cpp -c -std=c++11 -m32 -o main_32.o
-
-"C:\MinGW64\bin\g++.exe" AudioDelay.cpp -c -std=c++11 -m32 -o AudioDelay_32.o
-
-"C:\MinGW64\bin\g++.exe" AudioPB.cpp -c -std=c++11 -m32 -o AudioPB_32.o
-"C:\MinGW64\bin\g++.exe" AudioPB_i16.cpp -c -std=c++11 -m32 -o AudioPB_i16_32.o
-"C:\MinGW64\bin\g++.exe" AudioPB_i24.cpp -c -std=c++11 -m32 -o AudioPB_i24_32.o
-
-"C:\MinGW64\bin\g++.exe" main_32.o globldef_32.o cstrdef_32.o thread_32.o strdef_32.o AudioDelay_32.o AudioPB_32.o AudioPB_i16_32.o AudioPB_i24_32.o -lole32 -lcomctl32 -lksuser -mwindows -m32 -o delay32.exe
-
-del globldef_32.o
-del cstrdef_32.o
-del thread_32.o
-del strdef_32.o
-del main_32.o
-del AudioDelay_32.o
-del AudioPB_32.o
-del AudioPB_i16_32.o
-del AudioPB_i24_32.o
+"C:\MinGW64\bin\g++.exe" globldef.c -c -std=c++11 -m32 -msse2 -mfpmath=sse -o globldef_32.o
+"C:\MinGW64\bin\g++.exe" cstrdef.c -c -std=c++11 -m32 -msse2 -mfpmath=sse -o cstrdef_32.o
+"C:\MinGW64\bin\g++.exe" thread.c -c -std=c++11 -m32 -msse2 -mfpmath=sse -o thread_32.o
+"C:\MinGW64\bin\g++.exe" strdef.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o strdef_32.o
+
+"C:\MinGW64\bin\g++.exe" main.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o main_32.o
+
+"C:\MinGW64\bin\g++.exe" AudioDelay.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o AudioDelay_32.o
+"C:\MinGW64\bin\g++.exe" dspkernel.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o dspkernel_32.o
+"C:\MinGW64\bin\g++.exe" FileMap.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o FileMap_32.o
+"C:\MinGW64\bin\g++.exe" SegmentRing.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o SegmentRing_32.o
+"C:\MinGW64\bin\g++.exe" LatencyHistogram.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o LatencyHistogram_32.o
+"C:\MinGW64\bin\g++.exe" pcmconv.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o pcmconv_32.o
+"C:\MinGW64\bin\g++.exe" wavfile.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o wavfile_32.o
+
+"C:\MinGW64\bin\g++.exe" AudioPB.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o AudioPB_32.o
+"C:\MinGW64\bin\g++.exe" AudioPB_i16.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o AudioPB_i16_32.o
+"C:\MinGW64\bin\g++.exe" AudioPB_i24.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o AudioPB_i24_32.o
+"C:\MinGW64\bin\g++.exe" AudioPB_i32.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o AudioPB_i32_32.o
+"C:\MinGW64\bin\g++.exe" AudioPB_f32.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o AudioPB_f32_32.o
+"C:\MinGW64\bin\g++.exe" AudioPB_f64.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o AudioPB_f64_32.o
+"C:\MinGW64\bin\g++.exe" AudioSink.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o AudioSink_32.o
+"C:\MinGW64\bin\g++.exe" AudioSink_WASAPI.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o AudioSink_WASAPI_32.o
+"C:\MinGW64\bin\g++.exe" AudioSink_Virtual.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o AudioSink_Virtual_32.o
+
+"C:\MinGW64\bin\g++.exe" AudioRender.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o AudioRender_32.o
+"C:\MinGW64\bin\g++.exe" render.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o render_32.o
+"C:\MinGW64\bin\g++.exe" AudioBatch.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o AudioBatch_32.o
+"C:\MinGW64\bin\g++.exe" batch.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o batch_32.o
+"C:\MinGW64\bin\g++.exe" pbsim.cpp -c -std=c++11 -m32 -msse2 -mfpmath=sse -o pbsim_32.o
+
+"C:\MinGW64\bin\g++.exe" main_32.o globldef_32.o cstrdef_32.o thread_32.o strdef_32.o AudioDelay_32.o dspkernel_32.o FileMap_32.o SegmentRing_32.o LatencyHistogram_32.o pcmconv_32.o wavfile_32.o AudioPB_32.o AudioPB_i16_32.o AudioPB_i24_32.o AudioPB_i32_32.o AudioPB_f32_32.o AudioPB_f64_32.o AudioSink_32.o AudioSink_WASAPI_32.o AudioSink_Virtual_32.o -lole32 -lcomctl32 -lksuser -mwindows -m32 -o delay32.exe
+"C:\MinGW64\bin\g++.exe" pbsim_32.o globldef_32.o cstrdef_32.o thread_32.o strdef_32.o AudioDelay_32.o dspkernel_32.o FileMap_32.o SegmentRing_32.o LatencyHistogram_32.o pcmconv_32.o wavfile_32.o AudioPB_32.o AudioPB_i16_32.o AudioPB_i24_32.o AudioPB_i32_32.o AudioPB_f32_32.o AudioPB_f64_32.o AudioSink_32.o AudioSink_WASAPI_32.o AudioSink_Virtual_32.o -lole32 -lksuser -m32 -o pbsim32.exe
+"C:\MinGW64\bin\g++.exe" render_32.o globldef_32.o cstrdef_32.o thread_32.o strdef_32.o AudioDelay_32.o dspkernel_32.o FileMap_32.o pcmconv_32.o wavfile_32.o AudioRender_32.o -m32 -o render32.exe
+"C:\MinGW64\bin\g++.exe" batch_32.o globldef_32.o cstrdef_32.o thread_32.o strdef_32.o AudioDelay_32.o dspkernel_32.o FileMap_32.o pcmconv_32.o wavfile_32.o AudioRender_32.o AudioBatch_32.o -m32 -o batch32.exe
+
+del globldef_32.o
+del cstrdef_32.o
+del thread_32.o
+del strdef_32.o
+del main_32.o
+del AudioDelay_32.o
+del dspkernel_32.o
+del FileMap_32.o
+del SegmentRing_32.o
+del LatencyHistogram_32.o
+del pcmconv_32.o
+del wavfile_32.o
+del AudioPB_32.o
+del AudioPB_i16_32.o
+del AudioPB_i24_32.o
+del AudioPB_i32_32.o
+del AudioPB_f32_32.o
+del AudioPB_f64_32.o
+del AudioSink_32.o
+del AudioSink_WASAPI_32.o
+del AudioSink_Virtual_32.o
+del pbsim_32.o
+del AudioRender_32.o
+del render_32.o
+del AudioBatch_32.o
+del batch_32.o
@@ -1,24 +1,62 @@
-"C:\MinGW64\bin\g++.exe" globldef.c -c -std=c++11 -m64 -o globldef_64.o
-"C:\MinGW64\bin\g++.exe" cstrdef.c -c -std=c++11 -m64 -o cstrdef_64.o
-"C:\MinGW64\bin\g++.exe" thread.c -c -std=c++11 -m64 -o thread_64.o
-"C:\MinGW64\bin\g++.exe" strdef.cpp -c -std=c++11 -m64 -o strdef_64.o
-
-"C:\MinGW64\bin\g++.exe" main.cpp -c -std=c++11 -m64 -o main_64.o
-
-"C:\MinGW64\bin\g++.exe" AudioDelay.cpp -c -std=c++11 -m64 -o AudioDelay_64.o
-
-"C:\MinGW64\bin\g++.exe" AudioPB.cpp -c -std=c++11 -m64 -o AudioPB_64.o
-"C:\MinGW64\bin\g++.exe" AudioPB_i16.cpp -c -std=c++11 -m64 -o AudioPB_i16_64.o
-"C:\MinGW64\bin\g++.exe" AudioPB_i24.cpp -c -std=c++11 -m64 -o AudioPB_i24_64.o
-
-"C:\MinGW64\bin\g++.exe" main_64.o globldef_64.o cstrdef_64.o thread_64.o strdef_64.o AudioDelay_64.o AudioPB_64.o AudioPB_i16_64.o AudioPB_i24_64.o -lole32 -lcomctl32 -lksuser -mwindows -m64 -o delay64.exe
-
-del globldef_64.o
-del cstrdef_64.o
-del thread_64.o
-del strdef_64.o
-del main_64.o
-del AudioDelay_64.o
-del AudioPB_64.o
-del AudioPB_i16_64.o
-del AudioPB_i24_64.o
+"C:\MinGW64\bin\g++.exe" globldef.c -c -std=c++11 -m64 -o globldef_64.o
+"C:\MinGW64\bin\g++.exe" cstrdef.c -c -std=c++11 -m64 -o cstrdef_64.o
+"C:\MinGW64\bin\g++.exe" thread.c -c -std=c++11 -m64 -o thread_64.o
+"C:\MinGW64\bin\g++.exe" strdef.cpp -c -std=c++11 -m64 -o strdef_64.o
+
+"C:\MinGW64\bin\g++.exe" main.cpp -c -std=c++11 -m64 -o main_64.o
+
+"C:\MinGW64\bin\g++.exe" AudioDelay.cpp -c -std=c++11 -m64 -o AudioDelay_64.o
+"C:\MinGW64\bin\g++.exe" dspkernel.cpp -c -std=c++11 -m64 -o dspkernel_64.o
+"C:\MinGW64\bin\g++.exe" FileMap.cpp -c -std=c++11 -m64 -o FileMap_64.o
+"C:\MinGW64\bin\g++.exe" SegmentRing.cpp -c -std=c++11 -m64 -o SegmentRing_64.o
+"C:\MinGW64\bin\g++.exe" LatencyHistogram.cpp -c -std=c++11 -m64 -o LatencyHistogram_64.o
+"C:\MinGW64\bin\g++.exe" pcmconv.cpp -c -std=c++11 -m64 -o pcmconv_64.o
+"C:\MinGW64\bin\g++.exe" wavfile.cpp -c -std=c++11 -m64 -o wavfile_64.o
+
+"C:\MinGW64\bin\g++.exe" AudioPB.cpp -c -std=c++11 -m64 -o AudioPB_64.o
+"C:\MinGW64\bin\g++.exe" AudioPB_i16.cpp -c -std=c++11 -m64 -o AudioPB_i16_64.o
+"C:\MinGW64\bin\g++.exe" AudioPB_i24.cpp -c -std=c++11 -m64 -o AudioPB_i24_64.o
+"C:\MinGW64\bin\g++.exe" AudioPB_i32.cpp -c -std=c++11 -m64 -o AudioPB_i32_64.o
+"C:\MinGW64\bin\g++.exe" AudioPB_f32.cpp -c -std=c++11 -m64 -o AudioPB_f32_64.o
+"C:\MinGW64\bin\g++.exe" AudioPB_f64.cpp -c -std=c++11 -m64 -o AudioPB_f64_64.o
+"C:\MinGW64\bin\g++.exe" AudioSink.cpp -c -std=c++11 -m64 -o AudioSink_64.o
+"C:\MinGW64\bin\g++.exe" AudioSink_WASAPI.cpp -c -std=c++11 -m64 -o AudioSink_WASAPI_64.o
+"C:\MinGW64\bin\g++.exe" AudioSink_Virtual.cpp -c -std=c++11 -m64 -o AudioSink_Virtual_64.o
+
+"C:\MinGW64\bin\g++.exe" AudioRender.cpp -c -std=c++11 -m64 -o AudioRender_64.o
+"C:\MinGW64\bin\g++.exe" render.cpp -c -std=c++11 -m64 -o render_64.o
+"C:\MinGW64\bin\g++.exe" AudioBatch.cpp -c -std=c++11 -m64 -o AudioBatch_64.o
+"C:\MinGW64\bin\g++.exe" batch.cpp -c -std=c++11 -m64 -o batch_64.o
+"C:\MinGW64\bin\g++.exe" pbsim.cpp -c -std=c++11 -m64 -o pbsim_64.o
+
+"C:\MinGW64\bin\g++.exe" main_64.o globldef_64.o cstrdef_64.o thread_64.o strdef_64.o AudioDelay_64.o dspkernel_64.o FileMap_64.o SegmentRing_64.o LatencyHistogram_64.o pcmconv_64.o wavfile_64.o AudioPB_64.o AudioPB_i16_64.o AudioPB_i24_64.o AudioPB_i32_64.o AudioPB_f32_64.o AudioPB_f64_64.o AudioSink_64.o AudioSink_WASAPI_64.o AudioSink_Virtual_64.o -lole32 -lcomctl32 -lksuser -mwindows -m64 -o delay64.exe
+"C:\MinGW64\bin\g++.exe" pbsim_64.o globldef_64.o cstrdef_64.o thread_64.o strdef_64.o AudioDelay_64.o dspkernel_64.o FileMap_64.o SegmentRing_64.o LatencyHistogram_64.o pcmconv_64.o wavfile_64.o AudioPB_64.o AudioPB_i16_64.o AudioPB_i24_64.o AudioPB_i32_64.o AudioPB_f32_64.o AudioPB_f64_64.o AudioSink_64.o AudioSink_WASAPI_64.o AudioSink_Virtual_64.o -lole32 -lksuser -m64 -o pbsim64.exe
+"C:\MinGW64\bin\g++.exe" render_64.o globldef_64.o cstrdef_64.o thread_64.o strdef_64.o AudioDelay_64.o dspkernel_64.o FileMap_64.o pcmconv_64.o wavfile_64.o AudioRender_64.o -m64 -o render64.exe
+"C:\MinGW64\bin\g++.exe" batch_64.o globldef_64.o cstrdef_64.o thread_64.o strdef_64.o AudioDelay_64.o dspkernel_64.o FileMap_64.o pcmconv_64.o wavfile_64.o AudioRender_64.o AudioBatch_64.o -m64 -o batch64.exe
+
+del globldef_64.o
+del cstrdef_64.o
+del thread_64.o
+del strdef_64.o
+del main_64.o
+del AudioDelay_64.o
+del dspkernel_64.o
+del FileMap_64.o
+del SegmentRing_64.o
+del LatencyHistogram_64.o
+del pcmconv_64.o
+del wavfile_64.o
+del AudioPB_64.o
+del AudioPB_i16_64.o
+del AudioPB_i24_64.o
+del AudioPB_i32_64.o
+del AudioPB_f32_64.o
+del AudioPB_f64_64.o
+del AudioSink_64.o
+del AudioSink_WASAPI_64.o
+del AudioSink_Virtual_64.o
+del pbsim_64.o
+del AudioRender_64.o
+del render_64.o
+del AudioBatch_64.o
+del batch_64.o
@@ -0,0 +1,1175 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#include "dspkernel.hpp"
+#include "cstrdef.h"
+
+#include <math.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define DSPKERNEL_X86
+#endif
+
+#ifdef DSPKERNEL_X86
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+/*
+	GCC/MinGW only emits instructions enabled for the function, MSVC emits any intrinsic.
+	fp-contract=off keeps GCC from fusing multiply+add into FMA (AVX-512 implies FMA), which would break bit-exactness with the scalar kernels.
+*/
+#ifdef __GNUC__
+#define DSPKERNEL_TARGET(isa) __attribute__((target(isa), optimize("fp-contract=off")))
+#else
+#define DSPKERNEL_TARGET(isa)
+#endif
+
+#endif /*DSPKERNEL_X86*/
+
+/*Fully unrolls a loop with a constant trip count (the multi tap kernels). MSVC unrolls these on its own.*/
+#ifdef __GNUC__
+#define DSPKERNEL_UNROLL _Pragma("GCC unroll 8")
+#else
+#define DSPKERNEL_UNROLL
+#endif
+
+/*
+	LFO sine approximation: sin(2*pi*y) for y in [-0.25, 0.25], odd polynomial (Taylor series up to the 11th power of 2*pi*y, error below 1e-7).
+	The phase is first reduced to r in [-0.5, 0.5], then folded into y: |y| = min(|r|, 0.5 - |r|), with the sign of r.
+*/
+
+#define DSPKERNEL_LFO_TWOPI 6.283185307f
+#define DSPKERNEL_LFO_S3 (-1.0f/6.0f)
+#define DSPKERNEL_LFO_S5 (1.0f/120.0f)
+#define DSPKERNEL_LFO_S7 (-1.0f/5040.0f)
+#define DSPKERNEL_LFO_S9 (1.0f/362880.0f)
+#define DSPKERNEL_LFO_S11 (-1.0f/39916800.0f)
+
+/*======================================================================================*/
+/*Scalar reference kernels*/
+
+static VOID WINAPI scale_scalar(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_sample;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++) p_dst[n_sample] = amp*(p_src[n_sample]);
+
+	return;
+}
+
+static VOID WINAPI mac_scalar(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_sample;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++) p_dst[n_sample] += amp*(p_src[n_sample]);
+
+	return;
+}
+
+/*
+	Multi tap kernels. N_TAPS is the (constant) tap count, n_taps is only used by the generic versions.
+	The generic versions run the taps in groups of DSPKERNEL_MAC_TAPS_MAX, then one by one.
+*/
+
+template <ULONG_PTR N_TAPS> static VOID WINAPI mac_taps_scalar(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_amp, ULONG_PTR n_taps, ULONG_PTR n_samples)
+{
+	const FLOAT *p_src[N_TAPS];
+	FLOAT amp[N_TAPS];
+	ULONG_PTR n_sample;
+	ULONG_PTR n_tap;
+	FLOAT acc;
+
+	DSPKERNEL_UNROLL
+	for(n_tap = 0u; n_tap < N_TAPS; n_tap++)
+	{
+		p_src[n_tap] = pp_src[n_tap];
+		amp[n_tap] = p_amp[n_tap];
+	}
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++)
+	{
+		acc = p_dst[n_sample];
+
+		DSPKERNEL_UNROLL
+		for(n_tap = 0u; n_tap < N_TAPS; n_tap++) acc += amp[n_tap]*(p_src[n_tap][n_sample]);
+
+		p_dst[n_sample] = acc;
+	}
+
+	return;
+}
+
+static VOID WINAPI mac_taps_generic_scalar(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_amp, ULONG_PTR n_taps, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_tap = 0u;
+
+	for(; (n_tap + DSPKERNEL_MAC_TAPS_MAX) <= n_taps; n_tap += DSPKERNEL_MAC_TAPS_MAX) mac_taps_scalar<DSPKERNEL_MAC_TAPS_MAX>(p_dst, &pp_src[n_tap], &p_amp[n_tap], DSPKERNEL_MAC_TAPS_MAX, n_samples);
+
+	for(; n_tap < n_taps; n_tap++) mac_scalar(p_dst, pp_src[n_tap], p_amp[n_tap], n_samples);
+
+	return;
+}
+
+static VOID WINAPI scale_ramp_scalar(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, FLOAT damp, const FLOAT *p_ramp, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_sample;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++) p_dst[n_sample] = (amp + damp*(p_ramp[n_sample]))*(p_src[n_sample]);
+
+	return;
+}
+
+static VOID WINAPI mac_ramp_scalar(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, FLOAT damp, const FLOAT *p_ramp, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_sample;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++) p_dst[n_sample] += (amp + damp*(p_ramp[n_sample]))*(p_src[n_sample]);
+
+	return;
+}
+
+static VOID WINAPI mac_xfade_scalar(FLOAT *p_dst, const FLOAT *p_src0, const FLOAT *p_src1, FLOAT amp, FLOAT damp, const FLOAT *p_ramp, const FLOAT *p_xfade, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_sample;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++)
+		p_dst[n_sample] += (amp + damp*(p_ramp[n_sample]))*(p_src0[n_sample] + (p_xfade[n_sample])*(p_src1[n_sample] - p_src0[n_sample]));
+
+	return;
+}
+
+static VOID WINAPI interp2_scalar(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_coef, ULONG_PTR n_samples)
+{
+	const FLOAT *p_src0 = pp_src[0];
+	const FLOAT *p_src1 = pp_src[1];
+	const FLOAT c0 = p_coef[0];
+	const FLOAT c1 = p_coef[1];
+	ULONG_PTR n_sample;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++) p_dst[n_sample] = c0*(p_src0[n_sample]) + c1*(p_src1[n_sample]);
+
+	return;
+}
+
+static VOID WINAPI interp4_scalar(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_coef, ULONG_PTR n_samples)
+{
+	const FLOAT *p_src0 = pp_src[0];
+	const FLOAT *p_src1 = pp_src[1];
+	const FLOAT *p_src2 = pp_src[2];
+	const FLOAT *p_src3 = pp_src[3];
+	const FLOAT c0 = p_coef[0];
+	const FLOAT c1 = p_coef[1];
+	const FLOAT c2 = p_coef[2];
+	const FLOAT c3 = p_coef[3];
+	ULONG_PTR n_sample;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++)
+		p_dst[n_sample] = c0*(p_src0[n_sample]) + c1*(p_src1[n_sample]) + c2*(p_src2[n_sample]) + c3*(p_src3[n_sample]);
+
+	return;
+}
+
+static FLOAT WINAPI lfo_fold_scalar(FLOAT x)
+{
+	FLOAT r = 0.0f;
+	FLOAT a = 0.0f;
+
+	r = x - nearbyintf(x);
+	a = fabsf(r);
+	if(a > (0.5f - a)) a = 0.5f - a;
+
+	return copysignf(a, r);
+}
+
+static VOID WINAPI lfo_sine_scalar(FLOAT *p_dst, FLOAT phase, FLOAT phase_inc, FLOAT depth, ULONG_PTR n_frames)
+{
+	ULONG_PTR n_frame;
+	FLOAT z = 0.0f;
+	FLOAT z2 = 0.0f;
+
+	for(n_frame = 0u; n_frame < n_frames; n_frame++)
+	{
+		z = DSPKERNEL_LFO_TWOPI*lfo_fold_scalar(phase + ((FLOAT) n_frame)*phase_inc);
+		z2 = z*z;
+		p_dst[n_frame] = depth*(z + z*z2*(DSPKERNEL_LFO_S3 + z2*(DSPKERNEL_LFO_S5 + z2*(DSPKERNEL_LFO_S7 + z2*(DSPKERNEL_LFO_S9 + z2*DSPKERNEL_LFO_S11)))));
+	}
+
+	return;
+}
+
+static VOID WINAPI lfo_triangle_scalar(FLOAT *p_dst, FLOAT phase, FLOAT phase_inc, FLOAT depth, ULONG_PTR n_frames)
+{
+	ULONG_PTR n_frame;
+
+	for(n_frame = 0u; n_frame < n_frames; n_frame++) p_dst[n_frame] = depth*(4.0f*lfo_fold_scalar(phase + ((FLOAT) n_frame)*phase_inc));
+
+	return;
+}
+
+#ifdef DSPKERNEL_X86
+
+/*======================================================================================*/
+/*SSE2 kernels (4 samples per vector)*/
+
+DSPKERNEL_TARGET("sse2") static VOID WINAPI scale_sse2(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, ULONG_PTR n_samples)
+{
+	const __m128 v_amp = _mm_set1_ps(amp);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+		_mm_storeu_ps(&p_dst[n_sample], _mm_mul_ps(v_amp, _mm_loadu_ps(&p_src[n_sample])));
+
+	for(; n_sample < n_samples; n_sample++) p_dst[n_sample] = amp*(p_src[n_sample]);
+
+	return;
+}
+
+DSPKERNEL_TARGET("sse2") static VOID WINAPI mac_sse2(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, ULONG_PTR n_samples)
+{
+	const __m128 v_amp = _mm_set1_ps(amp);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+		_mm_storeu_ps(&p_dst[n_sample], _mm_add_ps(_mm_loadu_ps(&p_dst[n_sample]), _mm_mul_ps(v_amp, _mm_loadu_ps(&p_src[n_sample]))));
+
+	for(; n_sample < n_samples; n_sample++) p_dst[n_sample] += amp*(p_src[n_sample]);
+
+	return;
+}
+
+template <ULONG_PTR N_TAPS> DSPKERNEL_TARGET("sse2") static VOID WINAPI mac_taps_sse2(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_amp, ULONG_PTR n_taps, ULONG_PTR n_samples)
+{
+	const FLOAT *p_src[N_TAPS];
+	FLOAT amp[N_TAPS];
+	__m128 v_amp[N_TAPS];
+	__m128 v_acc;
+	ULONG_PTR n_sample = 0u;
+	ULONG_PTR n_tap;
+	FLOAT acc;
+
+	DSPKERNEL_UNROLL
+	for(n_tap = 0u; n_tap < N_TAPS; n_tap++)
+	{
+		p_src[n_tap] = pp_src[n_tap];
+		amp[n_tap] = p_amp[n_tap];
+		v_amp[n_tap] = _mm_set1_ps(amp[n_tap]);
+	}
+
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+	{
+		v_acc = _mm_loadu_ps(&p_dst[n_sample]);
+
+		DSPKERNEL_UNROLL
+		for(n_tap = 0u; n_tap < N_TAPS; n_tap++) v_acc = _mm_add_ps(v_acc, _mm_mul_ps(v_amp[n_tap], _mm_loadu_ps(&p_src[n_tap][n_sample])));
+
+		_mm_storeu_ps(&p_dst[n_sample], v_acc);
+	}
+
+	for(; n_sample < n_samples; n_sample++)
+	{
+		acc = p_dst[n_sample];
+
+		DSPKERNEL_UNROLL
+		for(n_tap = 0u; n_tap < N_TAPS; n_tap++) acc += amp[n_tap]*(p_src[n_tap][n_sample]);
+
+		p_dst[n_sample] = acc;
+	}
+
+	return;
+}
+
+DSPKERNEL_TARGET("sse2") static VOID WINAPI mac_taps_generic_sse2(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_amp, ULONG_PTR n_taps, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_tap = 0u;
+
+	for(; (n_tap + DSPKERNEL_MAC_TAPS_MAX) <= n_taps; n_tap += DSPKERNEL_MAC_TAPS_MAX) mac_taps_sse2<DSPKERNEL_MAC_TAPS_MAX>(p_dst, &pp_src[n_tap], &p_amp[n_tap], DSPKERNEL_MAC_TAPS_MAX, n_samples);
+
+	for(; n_tap < n_taps; n_tap++) mac_sse2(p_dst, pp_src[n_tap], p_amp[n_tap], n_samples);
+
+	return;
+}
+
+DSPKERNEL_TARGET("sse2") static VOID WINAPI scale_ramp_sse2(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, FLOAT damp, const FLOAT *p_ramp, ULONG_PTR n_samples)
+{
+	const __m128 v_amp = _mm_set1_ps(amp);
+	const __m128 v_damp = _mm_set1_ps(damp);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+		_mm_storeu_ps(&p_dst[n_sample], _mm_mul_ps(_mm_add_ps(v_amp, _mm_mul_ps(v_damp, _mm_loadu_ps(&p_ramp[n_sample]))), _mm_loadu_ps(&p_src[n_sample])));
+
+	for(; n_sample < n_samples; n_sample++) p_dst[n_sample] = (amp + damp*(p_ramp[n_sample]))*(p_src[n_sample]);
+
+	return;
+}
+
+DSPKERNEL_TARGET("sse2") static VOID WINAPI mac_ramp_sse2(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, FLOAT damp, const FLOAT *p_ramp, ULONG_PTR n_samples)
+{
+	const __m128 v_amp = _mm_set1_ps(amp);
+	const __m128 v_damp = _mm_set1_ps(damp);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+		_mm_storeu_ps(&p_dst[n_sample], _mm_add_ps(_mm_loadu_ps(&p_dst[n_sample]), _mm_mul_ps(_mm_add_ps(v_amp, _mm_mul_ps(v_damp, _mm_loadu_ps(&p_ramp[n_sample]))), _mm_loadu_ps(&p_src[n_sample]))));
+
+	for(; n_sample < n_samples; n_sample++) p_dst[n_sample] += (amp + damp*(p_ramp[n_sample]))*(p_src[n_sample]);
+
+	return;
+}
+
+DSPKERNEL_TARGET("sse2") static VOID WINAPI mac_xfade_sse2(FLOAT *p_dst, const FLOAT *p_src0, const FLOAT *p_src1, FLOAT amp, FLOAT damp, const FLOAT *p_ramp, const FLOAT *p_xfade, ULONG_PTR n_samples)
+{
+	const __m128 v_amp = _mm_set1_ps(amp);
+	const __m128 v_damp = _mm_set1_ps(damp);
+	__m128 v_src0;
+	__m128 v_blend;
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+	{
+		v_src0 = _mm_loadu_ps(&p_src0[n_sample]);
+		v_blend = _mm_add_ps(v_src0, _mm_mul_ps(_mm_loadu_ps(&p_xfade[n_sample]), _mm_sub_ps(_mm_loadu_ps(&p_src1[n_sample]), v_src0)));
+		_mm_storeu_ps(&p_dst[n_sample], _mm_add_ps(_mm_loadu_ps(&p_dst[n_sample]), _mm_mul_ps(_mm_add_ps(v_amp, _mm_mul_ps(v_damp, _mm_loadu_ps(&p_ramp[n_sample]))), v_blend)));
+	}
+
+	for(; n_sample < n_samples; n_sample++)
+		p_dst[n_sample] += (amp + damp*(p_ramp[n_sample]))*(p_src0[n_sample] + (p_xfade[n_sample])*(p_src1[n_sample] - p_src0[n_sample]));
+
+	return;
+}
+
+DSPKERNEL_TARGET("sse2") static VOID WINAPI interp2_sse2(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_coef, ULONG_PTR n_samples)
+{
+	const FLOAT *p_src0 = pp_src[0];
+	const FLOAT *p_src1 = pp_src[1];
+	const __m128 v_c0 = _mm_set1_ps(p_coef[0]);
+	const __m128 v_c1 = _mm_set1_ps(p_coef[1]);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+		_mm_storeu_ps(&p_dst[n_sample], _mm_add_ps(_mm_mul_ps(v_c0, _mm_loadu_ps(&p_src0[n_sample])), _mm_mul_ps(v_c1, _mm_loadu_ps(&p_src1[n_sample]))));
+
+	for(; n_sample < n_samples; n_sample++) p_dst[n_sample] = p_coef[0]*(p_src0[n_sample]) + p_coef[1]*(p_src1[n_sample]);
+
+	return;
+}
+
+DSPKERNEL_TARGET("sse2") static VOID WINAPI interp4_sse2(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_coef, ULONG_PTR n_samples)
+{
+	const FLOAT *p_src0 = pp_src[0];
+	const FLOAT *p_src1 = pp_src[1];
+	const FLOAT *p_src2 = pp_src[2];
+	const FLOAT *p_src3 = pp_src[3];
+	const __m128 v_c0 = _mm_set1_ps(p_coef[0]);
+	const __m128 v_c1 = _mm_set1_ps(p_coef[1]);
+	const __m128 v_c2 = _mm_set1_ps(p_coef[2]);
+	const __m128 v_c3 = _mm_set1_ps(p_coef[3]);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+		_mm_storeu_ps(&p_dst[n_sample], _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(v_c0, _mm_loadu_ps(&p_src0[n_sample])), _mm_mul_ps(v_c1, _mm_loadu_ps(&p_src1[n_sample]))), _mm_mul_ps(v_c2, _mm_loadu_ps(&p_src2[n_sample]))), _mm_mul_ps(v_c3, _mm_loadu_ps(&p_src3[n_sample]))));
+
+	for(; n_sample < n_samples; n_sample++)
+		p_dst[n_sample] = p_coef[0]*(p_src0[n_sample]) + p_coef[1]*(p_src1[n_sample]) + p_coef[2]*(p_src2[n_sample]) + p_coef[3]*(p_src3[n_sample]);
+
+	return;
+}
+
+DSPKERNEL_TARGET("sse2") static __m128 WINAPI lfo_fold_sse2(__m128 v_x)
+{
+	const __m128 v_signmask = _mm_castsi128_ps(_mm_set1_epi32((INT) 0x80000000));
+	__m128 v_r;
+	__m128 v_a;
+
+	v_r = _mm_sub_ps(v_x, _mm_cvtepi32_ps(_mm_cvtps_epi32(v_x)));
+	v_a = _mm_andnot_ps(v_signmask, v_r);
+	v_a = _mm_min_ps(v_a, _mm_sub_ps(_mm_set1_ps(0.5f), v_a));
+
+	return _mm_or_ps(v_a, _mm_and_ps(v_signmask, v_r));
+}
+
+DSPKERNEL_TARGET("sse2") static VOID WINAPI lfo_sine_sse2(FLOAT *p_dst, FLOAT phase, FLOAT phase_inc, FLOAT depth, ULONG_PTR n_frames)
+{
+	const __m128 v_depth = _mm_set1_ps(depth);
+	const __m128 v_inc = _mm_set1_ps(phase_inc);
+	const __m128 v_phase = _mm_set1_ps(phase);
+	__m128 v_n = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+	__m128 v_z;
+	__m128 v_z2;
+	__m128 v_p;
+	ULONG_PTR n_frame = 0u;
+	FLOAT z = 0.0f;
+	FLOAT z2 = 0.0f;
+
+	for(; (n_frame + 4u) <= n_frames; n_frame += 4u)
+	{
+		v_z = _mm_mul_ps(_mm_set1_ps(DSPKERNEL_LFO_TWOPI), lfo_fold_sse2(_mm_add_ps(v_phase, _mm_mul_ps(v_n, v_inc))));
+		v_z2 = _mm_mul_ps(v_z, v_z);
+		v_p = _mm_add_ps(_mm_set1_ps(DSPKERNEL_LFO_S9), _mm_mul_ps(v_z2, _mm_set1_ps(DSPKERNEL_LFO_S11)));
+		v_p = _mm_add_ps(_mm_set1_ps(DSPKERNEL_LFO_S7), _mm_mul_ps(v_z2, v_p));
+		v_p = _mm_add_ps(_mm_set1_ps(DSPKERNEL_LFO_S5), _mm_mul_ps(v_z2, v_p));
+		v_p = _mm_add_ps(_mm_set1_ps(DSPKERNEL_LFO_S3), _mm_mul_ps(v_z2, v_p));
+		_mm_storeu_ps(&p_dst[n_frame], _mm_mul_ps(v_depth, _mm_add_ps(v_z, _mm_mul_ps(_mm_mul_ps(v_z, v_z2), v_p))));
+		v_n = _mm_add_ps(v_n, _mm_set1_ps(4.0f));
+	}
+
+	for(; n_frame < n_frames; n_frame++)
+	{
+		z = DSPKERNEL_LFO_TWOPI*lfo_fold_scalar(phase + ((FLOAT) n_frame)*phase_inc);
+		z2 = z*z;
+		p_dst[n_frame] = depth*(z + z*z2*(DSPKERNEL_LFO_S3 + z2*(DSPKERNEL_LFO_S5 + z2*(DSPKERNEL_LFO_S7 + z2*(DSPKERNEL_LFO_S9 + z2*DSPKERNEL_LFO_S11)))));
+	}
+
+	return;
+}
+
+DSPKERNEL_TARGET("sse2") static VOID WINAPI lfo_triangle_sse2(FLOAT *p_dst, FLOAT phase, FLOAT phase_inc, FLOAT depth, ULONG_PTR n_frames)
+{
+	const __m128 v_depth = _mm_set1_ps(depth);
+	const __m128 v_inc = _mm_set1_ps(phase_inc);
+	const __m128 v_phase = _mm_set1_ps(phase);
+	__m128 v_n = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+	ULONG_PTR n_frame = 0u;
+
+	for(; (n_frame + 4u) <= n_frames; n_frame += 4u)
+	{
+		_mm_storeu_ps(&p_dst[n_frame], _mm_mul_ps(v_depth, _mm_mul_ps(_mm_set1_ps(4.0f), lfo_fold_sse2(_mm_add_ps(v_phase, _mm_mul_ps(v_n, v_inc))))));
+		v_n = _mm_add_ps(v_n, _mm_set1_ps(4.0f));
+	}
+
+	for(; n_frame < n_frames; n_frame++) p_dst[n_frame] = depth*(4.0f*lfo_fold_scalar(phase + ((FLOAT) n_frame)*phase_inc));
+
+	return;
+}
+
+/*======================================================================================*/
+/*AVX2 kernels (8 samples per vector)*/
+
+DSPKERNEL_TARGET("avx2") static VOID WINAPI scale_avx2(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, ULONG_PTR n_samples)
+{
+	const __m256 v_amp = _mm256_set1_ps(amp);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+		_mm256_storeu_ps(&p_dst[n_sample], _mm256_mul_ps(v_amp, _mm256_loadu_ps(&p_src[n_sample])));
+
+	for(; n_sample < n_samples; n_sample++) p_dst[n_sample] = amp*(p_src[n_sample]);
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx2") static VOID WINAPI mac_avx2(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, ULONG_PTR n_samples)
+{
+	const __m256 v_amp = _mm256_set1_ps(amp);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+		_mm256_storeu_ps(&p_dst[n_sample], _mm256_add_ps(_mm256_loadu_ps(&p_dst[n_sample]), _mm256_mul_ps(v_amp, _mm256_loadu_ps(&p_src[n_sample]))));
+
+	for(; n_sample < n_samples; n_sample++) p_dst[n_sample] += amp*(p_src[n_sample]);
+
+	return;
+}
+
+template <ULONG_PTR N_TAPS> DSPKERNEL_TARGET("avx2") static VOID WINAPI mac_taps_avx2(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_amp, ULONG_PTR n_taps, ULONG_PTR n_samples)
+{
+	const FLOAT *p_src[N_TAPS];
+	FLOAT amp[N_TAPS];
+	__m256 v_amp[N_TAPS];
+	__m256 v_acc;
+	ULONG_PTR n_sample = 0u;
+	ULONG_PTR n_tap;
+	FLOAT acc;
+
+	DSPKERNEL_UNROLL
+	for(n_tap = 0u; n_tap < N_TAPS; n_tap++)
+	{
+		p_src[n_tap] = pp_src[n_tap];
+		amp[n_tap] = p_amp[n_tap];
+		v_amp[n_tap] = _mm256_set1_ps(amp[n_tap]);
+	}
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+	{
+		v_acc = _mm256_loadu_ps(&p_dst[n_sample]);
+
+		DSPKERNEL_UNROLL
+		for(n_tap = 0u; n_tap < N_TAPS; n_tap++) v_acc = _mm256_add_ps(v_acc, _mm256_mul_ps(v_amp[n_tap], _mm256_loadu_ps(&p_src[n_tap][n_sample])));
+
+		_mm256_storeu_ps(&p_dst[n_sample], v_acc);
+	}
+
+	for(; n_sample < n_samples; n_sample++)
+	{
+		acc = p_dst[n_sample];
+
+		DSPKERNEL_UNROLL
+		for(n_tap = 0u; n_tap < N_TAPS; n_tap++) acc += amp[n_tap]*(p_src[n_tap][n_sample]);
+
+		p_dst[n_sample] = acc;
+	}
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx2") static VOID WINAPI mac_taps_generic_avx2(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_amp, ULONG_PTR n_taps, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_tap = 0u;
+
+	for(; (n_tap + DSPKERNEL_MAC_TAPS_MAX) <= n_taps; n_tap += DSPKERNEL_MAC_TAPS_MAX) mac_taps_avx2<DSPKERNEL_MAC_TAPS_MAX>(p_dst, &pp_src[n_tap], &p_amp[n_tap], DSPKERNEL_MAC_TAPS_MAX, n_samples);
+
+	for(; n_tap < n_taps; n_tap++) mac_avx2(p_dst, pp_src[n_tap], p_amp[n_tap], n_samples);
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx2") static VOID WINAPI scale_ramp_avx2(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, FLOAT damp, const FLOAT *p_ramp, ULONG_PTR n_samples)
+{
+	const __m256 v_amp = _mm256_set1_ps(amp);
+	const __m256 v_damp = _mm256_set1_ps(damp);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+		_mm256_storeu_ps(&p_dst[n_sample], _mm256_mul_ps(_mm256_add_ps(v_amp, _mm256_mul_ps(v_damp, _mm256_loadu_ps(&p_ramp[n_sample]))), _mm256_loadu_ps(&p_src[n_sample])));
+
+	for(; n_sample < n_samples; n_sample++) p_dst[n_sample] = (amp + damp*(p_ramp[n_sample]))*(p_src[n_sample]);
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx2") static VOID WINAPI mac_ramp_avx2(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, FLOAT damp, const FLOAT *p_ramp, ULONG_PTR n_samples)
+{
+	const __m256 v_amp = _mm256_set1_ps(amp);
+	const __m256 v_damp = _mm256_set1_ps(damp);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+		_mm256_storeu_ps(&p_dst[n_sample], _mm256_add_ps(_mm256_loadu_ps(&p_dst[n_sample]), _mm256_mul_ps(_mm256_add_ps(v_amp, _mm256_mul_ps(v_damp, _mm256_loadu_ps(&p_ramp[n_sample]))), _mm256_loadu_ps(&p_src[n_sample]))));
+
+	for(; n_sample < n_samples; n_sample++) p_dst[n_sample] += (amp + damp*(p_ramp[n_sample]))*(p_src[n_sample]);
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx2") static VOID WINAPI mac_xfade_avx2(FLOAT *p_dst, const FLOAT *p_src0, const FLOAT *p_src1, FLOAT amp, FLOAT damp, const FLOAT *p_ramp, const FLOAT *p_xfade, ULONG_PTR n_samples)
+{
+	const __m256 v_amp = _mm256_set1_ps(amp);
+	const __m256 v_damp = _mm256_set1_ps(damp);
+	__m256 v_src0;
+	__m256 v_blend;
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+	{
+		v_src0 = _mm256_loadu_ps(&p_src0[n_sample]);
+		v_blend = _mm256_add_ps(v_src0, _mm256_mul_ps(_mm256_loadu_ps(&p_xfade[n_sample]), _mm256_sub_ps(_mm256_loadu_ps(&p_src1[n_sample]), v_src0)));
+		_mm256_storeu_ps(&p_dst[n_sample], _mm256_add_ps(_mm256_loadu_ps(&p_dst[n_sample]), _mm256_mul_ps(_mm256_add_ps(v_amp, _mm256_mul_ps(v_damp, _mm256_loadu_ps(&p_ramp[n_sample]))), v_blend)));
+	}
+
+	for(; n_sample < n_samples; n_sample++)
+		p_dst[n_sample] += (amp + damp*(p_ramp[n_sample]))*(p_src0[n_sample] + (p_xfade[n_sample])*(p_src1[n_sample] - p_src0[n_sample]));
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx2") static VOID WINAPI interp2_avx2(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_coef, ULONG_PTR n_samples)
+{
+	const FLOAT *p_src0 = pp_src[0];
+	const FLOAT *p_src1 = pp_src[1];
+	const __m256 v_c0 = _mm256_set1_ps(p_coef[0]);
+	const __m256 v_c1 = _mm256_set1_ps(p_coef[1]);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+		_mm256_storeu_ps(&p_dst[n_sample], _mm256_add_ps(_mm256_mul_ps(v_c0, _mm256_loadu_ps(&p_src0[n_sample])), _mm256_mul_ps(v_c1, _mm256_loadu_ps(&p_src1[n_sample]))));
+
+	for(; n_sample < n_samples; n_sample++) p_dst[n_sample] = p_coef[0]*(p_src0[n_sample]) + p_coef[1]*(p_src1[n_sample]);
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx2") static VOID WINAPI interp4_avx2(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_coef, ULONG_PTR n_samples)
+{
+	const FLOAT *p_src0 = pp_src[0];
+	const FLOAT *p_src1 = pp_src[1];
+	const FLOAT *p_src2 = pp_src[2];
+	const FLOAT *p_src3 = pp_src[3];
+	const __m256 v_c0 = _mm256_set1_ps(p_coef[0]);
+	const __m256 v_c1 = _mm256_set1_ps(p_coef[1]);
+	const __m256 v_c2 = _mm256_set1_ps(p_coef[2]);
+	const __m256 v_c3 = _mm256_set1_ps(p_coef[3]);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+		_mm256_storeu_ps(&p_dst[n_sample], _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(v_c0, _mm256_loadu_ps(&p_src0[n_sample])), _mm256_mul_ps(v_c1, _mm256_loadu_ps(&p_src1[n_sample]))), _mm256_mul_ps(v_c2, _mm256_loadu_ps(&p_src2[n_sample]))), _mm256_mul_ps(v_c3, _mm256_loadu_ps(&p_src3[n_sample]))));
+
+	for(; n_sample < n_samples; n_sample++)
+		p_dst[n_sample] = p_coef[0]*(p_src0[n_sample]) + p_coef[1]*(p_src1[n_sample]) + p_coef[2]*(p_src2[n_sample]) + p_coef[3]*(p_src3[n_sample]);
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx2") static __m256 WINAPI lfo_fold_avx2(__m256 v_x)
+{
+	const __m256 v_signmask = _mm256_castsi256_ps(_mm256_set1_epi32((INT) 0x80000000));
+	__m256 v_r;
+	__m256 v_a;
+
+	v_r = _mm256_sub_ps(v_x, _mm256_round_ps(v_x, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)));
+	v_a = _mm256_andnot_ps(v_signmask, v_r);
+	v_a = _mm256_min_ps(v_a, _mm256_sub_ps(_mm256_set1_ps(0.5f), v_a));
+
+	return _mm256_or_ps(v_a, _mm256_and_ps(v_signmask, v_r));
+}
+
+DSPKERNEL_TARGET("avx2") static VOID WINAPI lfo_sine_avx2(FLOAT *p_dst, FLOAT phase, FLOAT phase_inc, FLOAT depth, ULONG_PTR n_frames)
+{
+	const __m256 v_depth = _mm256_set1_ps(depth);
+	const __m256 v_inc = _mm256_set1_ps(phase_inc);
+	const __m256 v_phase = _mm256_set1_ps(phase);
+	__m256 v_n = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+	__m256 v_z;
+	__m256 v_z2;
+	__m256 v_p;
+	ULONG_PTR n_frame = 0u;
+	FLOAT z = 0.0f;
+	FLOAT z2 = 0.0f;
+
+	for(; (n_frame + 8u) <= n_frames; n_frame += 8u)
+	{
+		v_z = _mm256_mul_ps(_mm256_set1_ps(DSPKERNEL_LFO_TWOPI), lfo_fold_avx2(_mm256_add_ps(v_phase, _mm256_mul_ps(v_n, v_inc))));
+		v_z2 = _mm256_mul_ps(v_z, v_z);
+		v_p = _mm256_add_ps(_mm256_set1_ps(DSPKERNEL_LFO_S9), _mm256_mul_ps(v_z2, _mm256_set1_ps(DSPKERNEL_LFO_S11)));
+		v_p = _mm256_add_ps(_mm256_set1_ps(DSPKERNEL_LFO_S7), _mm256_mul_ps(v_z2, v_p));
+		v_p = _mm256_add_ps(_mm256_set1_ps(DSPKERNEL_LFO_S5), _mm256_mul_ps(v_z2, v_p));
+		v_p = _mm256_add_ps(_mm256_set1_ps(DSPKERNEL_LFO_S3), _mm256_mul_ps(v_z2, v_p));
+		_mm256_storeu_ps(&p_dst[n_frame], _mm256_mul_ps(v_depth, _mm256_add_ps(v_z, _mm256_mul_ps(_mm256_mul_ps(v_z, v_z2), v_p))));
+		v_n = _mm256_add_ps(v_n, _mm256_set1_ps(8.0f));
+	}
+
+	for(; n_frame < n_frames; n_frame++)
+	{
+		z = DSPKERNEL_LFO_TWOPI*lfo_fold_scalar(phase + ((FLOAT) n_frame)*phase_inc);
+		z2 = z*z;
+		p_dst[n_frame] = depth*(z + z*z2*(DSPKERNEL_LFO_S3 + z2*(DSPKERNEL_LFO_S5 + z2*(DSPKERNEL_LFO_S7 + z2*(DSPKERNEL_LFO_S9 + z2*DSPKERNEL_LFO_S11)))));
+	}
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx2") static VOID WINAPI lfo_triangle_avx2(FLOAT *p_dst, FLOAT phase, FLOAT phase_inc, FLOAT depth, ULONG_PTR n_frames)
+{
+	const __m256 v_depth = _mm256_set1_ps(depth);
+	const __m256 v_inc = _mm256_set1_ps(phase_inc);
+	const __m256 v_phase = _mm256_set1_ps(phase);
+	__m256 v_n = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+	ULONG_PTR n_frame = 0u;
+
+	for(; (n_frame + 8u) <= n_frames; n_frame += 8u)
+	{
+		_mm256_storeu_ps(&p_dst[n_frame], _mm256_mul_ps(v_depth, _mm256_mul_ps(_mm256_set1_ps(4.0f), lfo_fold_avx2(_mm256_add_ps(v_phase, _mm256_mul_ps(v_n, v_inc))))));
+		v_n = _mm256_add_ps(v_n, _mm256_set1_ps(8.0f));
+	}
+
+	for(; n_frame < n_frames; n_frame++) p_dst[n_frame] = depth*(4.0f*lfo_fold_scalar(phase + ((FLOAT) n_frame)*phase_inc));
+
+	return;
+}
+
+/*======================================================================================*/
+/*AVX-512 kernels (16 samples per vector, masked tail)*/
+
+DSPKERNEL_TARGET("avx512f") static VOID WINAPI scale_avx512(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, ULONG_PTR n_samples)
+{
+	const __m512 v_amp = _mm512_set1_ps(amp);
+	ULONG_PTR n_sample = 0u;
+	__mmask16 tailmask;
+
+	for(; (n_sample + 16u) <= n_samples; n_sample += 16u)
+		_mm512_storeu_ps(&p_dst[n_sample], _mm512_mul_ps(v_amp, _mm512_loadu_ps(&p_src[n_sample])));
+
+	if(n_sample < n_samples)
+	{
+		tailmask = (__mmask16) ((1u << (n_samples - n_sample)) - 1u);
+		_mm512_mask_storeu_ps(&p_dst[n_sample], tailmask, _mm512_mul_ps(v_amp, _mm512_maskz_loadu_ps(tailmask, &p_src[n_sample])));
+	}
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx512f") static VOID WINAPI mac_avx512(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, ULONG_PTR n_samples)
+{
+	const __m512 v_amp = _mm512_set1_ps(amp);
+	ULONG_PTR n_sample = 0u;
+	__mmask16 tailmask;
+
+	for(; (n_sample + 16u) <= n_samples; n_sample += 16u)
+		_mm512_storeu_ps(&p_dst[n_sample], _mm512_add_ps(_mm512_loadu_ps(&p_dst[n_sample]), _mm512_mul_ps(v_amp, _mm512_loadu_ps(&p_src[n_sample]))));
+
+	if(n_sample < n_samples)
+	{
+		tailmask = (__mmask16) ((1u << (n_samples - n_sample)) - 1u);
+		_mm512_mask_storeu_ps(&p_dst[n_sample], tailmask, _mm512_add_ps(_mm512_maskz_loadu_ps(tailmask, &p_dst[n_sample]), _mm512_mul_ps(v_amp, _mm512_maskz_loadu_ps(tailmask, &p_src[n_sample]))));
+	}
+
+	return;
+}
+
+template <ULONG_PTR N_TAPS> DSPKERNEL_TARGET("avx512f") static VOID WINAPI mac_taps_avx512(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_amp, ULONG_PTR n_taps, ULONG_PTR n_samples)
+{
+	const FLOAT *p_src[N_TAPS];
+	__m512 v_amp[N_TAPS];
+	__m512 v_acc;
+	ULONG_PTR n_sample = 0u;
+	ULONG_PTR n_tap;
+	__mmask16 tailmask;
+
+	DSPKERNEL_UNROLL
+	for(n_tap = 0u; n_tap < N_TAPS; n_tap++)
+	{
+		p_src[n_tap] = pp_src[n_tap];
+		v_amp[n_tap] = _mm512_set1_ps(p_amp[n_tap]);
+	}
+
+	for(; (n_sample + 16u) <= n_samples; n_sample += 16u)
+	{
+		v_acc = _mm512_loadu_ps(&p_dst[n_sample]);
+
+		DSPKERNEL_UNROLL
+		for(n_tap = 0u; n_tap < N_TAPS; n_tap++) v_acc = _mm512_add_ps(v_acc, _mm512_mul_ps(v_amp[n_tap], _mm512_loadu_ps(&p_src[n_tap][n_sample])));
+
+		_mm512_storeu_ps(&p_dst[n_sample], v_acc);
+	}
+
+	if(n_sample < n_samples)
+	{
+		tailmask = (__mmask16) ((1u << (n_samples - n_sample)) - 1u);
+
+		v_acc = _mm512_maskz_loadu_ps(tailmask, &p_dst[n_sample]);
+
+		DSPKERNEL_UNROLL
+		for(n_tap = 0u; n_tap < N_TAPS; n_tap++) v_acc = _mm512_add_ps(v_acc, _mm512_mul_ps(v_amp[n_tap], _mm512_maskz_loadu_ps(tailmask, &p_src[n_tap][n_sample])));
+
+		_mm512_mask_storeu_ps(&p_dst[n_sample], tailmask, v_acc);
+	}
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx512f") static VOID WINAPI mac_taps_generic_avx512(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_amp, ULONG_PTR n_taps, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_tap = 0u;
+
+	for(; (n_tap + DSPKERNEL_MAC_TAPS_MAX) <= n_taps; n_tap += DSPKERNEL_MAC_TAPS_MAX) mac_taps_avx512<DSPKERNEL_MAC_TAPS_MAX>(p_dst, &pp_src[n_tap], &p_amp[n_tap], DSPKERNEL_MAC_TAPS_MAX, n_samples);
+
+	for(; n_tap < n_taps; n_tap++) mac_avx512(p_dst, pp_src[n_tap], p_amp[n_tap], n_samples);
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx512f") static VOID WINAPI scale_ramp_avx512(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, FLOAT damp, const FLOAT *p_ramp, ULONG_PTR n_samples)
+{
+	const __m512 v_amp = _mm512_set1_ps(amp);
+	const __m512 v_damp = _mm512_set1_ps(damp);
+	ULONG_PTR n_sample = 0u;
+	__mmask16 tailmask;
+
+	for(; (n_sample + 16u) <= n_samples; n_sample += 16u)
+		_mm512_storeu_ps(&p_dst[n_sample], _mm512_mul_ps(_mm512_add_ps(v_amp, _mm512_mul_ps(v_damp, _mm512_loadu_ps(&p_ramp[n_sample]))), _mm512_loadu_ps(&p_src[n_sample])));
+
+	if(n_sample < n_samples)
+	{
+		tailmask = (__mmask16) ((1u << (n_samples - n_sample)) - 1u);
+		_mm512_mask_storeu_ps(&p_dst[n_sample], tailmask, _mm512_mul_ps(_mm512_add_ps(v_amp, _mm512_mul_ps(v_damp, _mm512_maskz_loadu_ps(tailmask, &p_ramp[n_sample]))), _mm512_maskz_loadu_ps(tailmask, &p_src[n_sample])));
+	}
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx512f") static VOID WINAPI mac_ramp_avx512(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, FLOAT damp, const FLOAT *p_ramp, ULONG_PTR n_samples)
+{
+	const __m512 v_amp = _mm512_set1_ps(amp);
+	const __m512 v_damp = _mm512_set1_ps(damp);
+	ULONG_PTR n_sample = 0u;
+	__mmask16 tailmask;
+
+	for(; (n_sample + 16u) <= n_samples; n_sample += 16u)
+		_mm512_storeu_ps(&p_dst[n_sample], _mm512_add_ps(_mm512_loadu_ps(&p_dst[n_sample]), _mm512_mul_ps(_mm512_add_ps(v_amp, _mm512_mul_ps(v_damp, _mm512_loadu_ps(&p_ramp[n_sample]))), _mm512_loadu_ps(&p_src[n_sample]))));
+
+	if(n_sample < n_samples)
+	{
+		tailmask = (__mmask16) ((1u << (n_samples - n_sample)) - 1u);
+		_mm512_mask_storeu_ps(&p_dst[n_sample], tailmask, _mm512_add_ps(_mm512_maskz_loadu_ps(tailmask, &p_dst[n_sample]), _mm512_mul_ps(_mm512_add_ps(v_amp, _mm512_mul_ps(v_damp, _mm512_maskz_loadu_ps(tailmask, &p_ramp[n_sample]))), _mm512_maskz_loadu_ps(tailmask, &p_src[n_sample]))));
+	}
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx512f") static VOID WINAPI mac_xfade_avx512(FLOAT *p_dst, const FLOAT *p_src0, const FLOAT *p_src1, FLOAT amp, FLOAT damp, const FLOAT *p_ramp, const FLOAT *p_xfade, ULONG_PTR n_samples)
+{
+	const __m512 v_amp = _mm512_set1_ps(amp);
+	const __m512 v_damp = _mm512_set1_ps(damp);
+	__m512 v_src0;
+	__m512 v_blend;
+	ULONG_PTR n_sample = 0u;
+	__mmask16 tailmask;
+
+	for(; (n_sample + 16u) <= n_samples; n_sample += 16u)
+	{
+		v_src0 = _mm512_loadu_ps(&p_src0[n_sample]);
+		v_blend = _mm512_add_ps(v_src0, _mm512_mul_ps(_mm512_loadu_ps(&p_xfade[n_sample]), _mm512_sub_ps(_mm512_loadu_ps(&p_src1[n_sample]), v_src0)));
+		_mm512_storeu_ps(&p_dst[n_sample], _mm512_add_ps(_mm512_loadu_ps(&p_dst[n_sample]), _mm512_mul_ps(_mm512_add_ps(v_amp, _mm512_mul_ps(v_damp, _mm512_loadu_ps(&p_ramp[n_sample]))), v_blend)));
+	}
+
+	if(n_sample < n_samples)
+	{
+		tailmask = (__mmask16) ((1u << (n_samples - n_sample)) - 1u);
+		v_src0 = _mm512_maskz_loadu_ps(tailmask, &p_src0[n_sample]);
+		v_blend = _mm512_add_ps(v_src0, _mm512_mul_ps(_mm512_maskz_loadu_ps(tailmask, &p_xfade[n_sample]), _mm512_sub_ps(_mm512_maskz_loadu_ps(tailmask, &p_src1[n_sample]), v_src0)));
+		_mm512_mask_storeu_ps(&p_dst[n_sample], tailmask, _mm512_add_ps(_mm512_maskz_loadu_ps(tailmask, &p_dst[n_sample]), _mm512_mul_ps(_mm512_add_ps(v_amp, _mm512_mul_ps(v_damp, _mm512_maskz_loadu_ps(tailmask, &p_ramp[n_sample]))), v_blend)));
+	}
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx512f") static VOID WINAPI interp2_avx512(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_coef, ULONG_PTR n_samples)
+{
+	const FLOAT *p_src0 = pp_src[0];
+	const FLOAT *p_src1 = pp_src[1];
+	const __m512 v_c0 = _mm512_set1_ps(p_coef[0]);
+	const __m512 v_c1 = _mm512_set1_ps(p_coef[1]);
+	ULONG_PTR n_sample = 0u;
+	__mmask16 tailmask;
+
+	for(; (n_sample + 16u) <= n_samples; n_sample += 16u)
+		_mm512_storeu_ps(&p_dst[n_sample], _mm512_add_ps(_mm512_mul_ps(v_c0, _mm512_loadu_ps(&p_src0[n_sample])), _mm512_mul_ps(v_c1, _mm512_loadu_ps(&p_src1[n_sample]))));
+
+	if(n_sample < n_samples)
+	{
+		tailmask = (__mmask16) ((1u << (n_samples - n_sample)) - 1u);
+		_mm512_mask_storeu_ps(&p_dst[n_sample], tailmask, _mm512_add_ps(_mm512_mul_ps(v_c0, _mm512_maskz_loadu_ps(tailmask, &p_src0[n_sample])), _mm512_mul_ps(v_c1, _mm512_maskz_loadu_ps(tailmask, &p_src1[n_sample]))));
+	}
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx512f") static VOID WINAPI interp4_avx512(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_coef, ULONG_PTR n_samples)
+{
+	const FLOAT *p_src0 = pp_src[0];
+	const FLOAT *p_src1 = pp_src[1];
+	const FLOAT *p_src2 = pp_src[2];
+	const FLOAT *p_src3 = pp_src[3];
+	const __m512 v_c0 = _mm512_set1_ps(p_coef[0]);
+	const __m512 v_c1 = _mm512_set1_ps(p_coef[1]);
+	const __m512 v_c2 = _mm512_set1_ps(p_coef[2]);
+	const __m512 v_c3 = _mm512_set1_ps(p_coef[3]);
+	ULONG_PTR n_sample = 0u;
+	__mmask16 tailmask;
+
+	for(; (n_sample + 16u) <= n_samples; n_sample += 16u)
+		_mm512_storeu_ps(&p_dst[n_sample], _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(v_c0, _mm512_loadu_ps(&p_src0[n_sample])), _mm512_mul_ps(v_c1, _mm512_loadu_ps(&p_src1[n_sample]))), _mm512_mul_ps(v_c2, _mm512_loadu_ps(&p_src2[n_sample]))), _mm512_mul_ps(v_c3, _mm512_loadu_ps(&p_src3[n_sample]))));
+
+	if(n_sample < n_samples)
+	{
+		tailmask = (__mmask16) ((1u << (n_samples - n_sample)) - 1u);
+		_mm512_mask_storeu_ps(&p_dst[n_sample], tailmask, _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(v_c0, _mm512_maskz_loadu_ps(tailmask, &p_src0[n_sample])), _mm512_mul_ps(v_c1, _mm512_maskz_loadu_ps(tailmask, &p_src1[n_sample]))), _mm512_mul_ps(v_c2, _mm512_maskz_loadu_ps(tailmask, &p_src2[n_sample]))), _mm512_mul_ps(v_c3, _mm512_maskz_loadu_ps(tailmask, &p_src3[n_sample]))));
+	}
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx512f") static __m512 WINAPI lfo_fold_avx512(__m512 v_x)
+{
+	const __m512i v_signmask = _mm512_set1_epi32((INT) 0x80000000);
+	__m512 v_r;
+	__m512 v_a;
+
+	v_r = _mm512_sub_ps(v_x, _mm512_roundscale_ps(v_x, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)));
+	v_a = _mm512_castsi512_ps(_mm512_andnot_si512(v_signmask, _mm512_castps_si512(v_r)));
+	v_a = _mm512_min_ps(v_a, _mm512_sub_ps(_mm512_set1_ps(0.5f), v_a));
+
+	return _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(v_a), _mm512_and_si512(v_signmask, _mm512_castps_si512(v_r))));
+}
+
+DSPKERNEL_TARGET("avx512f") static VOID WINAPI lfo_sine_avx512(FLOAT *p_dst, FLOAT phase, FLOAT phase_inc, FLOAT depth, ULONG_PTR n_frames)
+{
+	const __m512 v_depth = _mm512_set1_ps(depth);
+	const __m512 v_inc = _mm512_set1_ps(phase_inc);
+	const __m512 v_phase = _mm512_set1_ps(phase);
+	__m512 v_n = _mm512_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f);
+	__m512 v_z;
+	__m512 v_z2;
+	__m512 v_p;
+	ULONG_PTR n_frame = 0u;
+	__mmask16 tailmask = 0xffff;
+
+	for(; n_frame < n_frames; n_frame += 16u)
+	{
+		if((n_frame + 16u) > n_frames) tailmask = (__mmask16) ((1u << (n_frames - n_frame)) - 1u);
+
+		v_z = _mm512_mul_ps(_mm512_set1_ps(DSPKERNEL_LFO_TWOPI), lfo_fold_avx512(_mm512_add_ps(v_phase, _mm512_mul_ps(v_n, v_inc))));
+		v_z2 = _mm512_mul_ps(v_z, v_z);
+		v_p = _mm512_add_ps(_mm512_set1_ps(DSPKERNEL_LFO_S9), _mm512_mul_ps(v_z2, _mm512_set1_ps(DSPKERNEL_LFO_S11)));
+		v_p = _mm512_add_ps(_mm512_set1_ps(DSPKERNEL_LFO_S7), _mm512_mul_ps(v_z2, v_p));
+		v_p = _mm512_add_ps(_mm512_set1_ps(DSPKERNEL_LFO_S5), _mm512_mul_ps(v_z2, v_p));
+		v_p = _mm512_add_ps(_mm512_set1_ps(DSPKERNEL_LFO_S3), _mm512_mul_ps(v_z2, v_p));
+		_mm512_mask_storeu_ps(&p_dst[n_frame], tailmask, _mm512_mul_ps(v_depth, _mm512_add_ps(v_z, _mm512_mul_ps(_mm512_mul_ps(v_z, v_z2), v_p))));
+		v_n = _mm512_add_ps(v_n, _mm512_set1_ps(16.0f));
+	}
+
+	return;
+}
+
+DSPKERNEL_TARGET("avx512f") static VOID WINAPI lfo_triangle_avx512(FLOAT *p_dst, FLOAT phase, FLOAT phase_inc, FLOAT depth, ULONG_PTR n_frames)
+{
+	const __m512 v_depth = _mm512_set1_ps(depth);
+	const __m512 v_inc = _mm512_set1_ps(phase_inc);
+	const __m512 v_phase = _mm512_set1_ps(phase);
+	__m512 v_n = _mm512_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f);
+	ULONG_PTR n_frame = 0u;
+	__mmask16 tailmask = 0xffff;
+
+	for(; n_frame < n_frames; n_frame += 16u)
+	{
+		if((n_frame + 16u) > n_frames) tailmask = (__mmask16) ((1u << (n_frames - n_frame)) - 1u);
+
+		_mm512_mask_storeu_ps(&p_dst[n_frame], tailmask, _mm512_mul_ps(v_depth, _mm512_mul_ps(_mm512_set1_ps(4.0f), lfo_fold_avx512(_mm512_add_ps(v_phase, _mm512_mul_ps(v_n, v_inc))))));
+		v_n = _mm512_add_ps(v_n, _mm512_set1_ps(16.0f));
+	}
+
+	return;
+}
+
+#endif /*DSPKERNEL_X86*/
+
+/*======================================================================================*/
+/*Kernel tables*/
+
+static const dspkernel_table_t DSPKERNEL_TABLE_SCALAR = {
+	.isa = DSPKERNEL_ISA_SCALAR,
+	.scale = &scale_scalar,
+	.mac = &mac_scalar,
+	.mac_taps = {&mac_taps_generic_scalar, &mac_taps_scalar<1u>, &mac_taps_scalar<2u>, &mac_taps_scalar<3u>, &mac_taps_scalar<4u>, &mac_taps_scalar<5u>, &mac_taps_scalar<6u>, &mac_taps_scalar<7u>, &mac_taps_scalar<8u>},
+	.scale_ramp = &scale_ramp_scalar,
+	.mac_ramp = &mac_ramp_scalar,
+	.mac_xfade = &mac_xfade_scalar,
+	.interp2 = &interp2_scalar,
+	.interp4 = &interp4_scalar,
+	.lfo_sine = &lfo_sine_scalar,
+	.lfo_triangle = &lfo_triangle_scalar
+};
+
+#ifdef DSPKERNEL_X86
+
+static const dspkernel_table_t DSPKERNEL_TABLE_SSE2 = {
+	.isa = DSPKERNEL_ISA_SSE2,
+	.scale = &scale_sse2,
+	.mac = &mac_sse2,
+	.mac_taps = {&mac_taps_generic_sse2, &mac_taps_sse2<1u>, &mac_taps_sse2<2u>, &mac_taps_sse2<3u>, &mac_taps_sse2<4u>, &mac_taps_sse2<5u>, &mac_taps_sse2<6u>, &mac_taps_sse2<7u>, &mac_taps_sse2<8u>},
+	.scale_ramp = &scale_ramp_sse2,
+	.mac_ramp = &mac_ramp_sse2,
+	.mac_xfade = &mac_xfade_sse2,
+	.interp2 = &interp2_sse2,
+	.interp4 = &interp4_sse2,
+	.lfo_sine = &lfo_sine_sse2,
+	.lfo_triangle = &lfo_triangle_sse2
+};
+
+static const dspkernel_table_t DSPKERNEL_TABLE_AVX2 = {
+	.isa = DSPKERNEL_ISA_AVX2,
+	.scale = &scale_avx2,
+	.mac = &mac_avx2,
+	.mac_taps = {&mac_taps_generic_avx2, &mac_taps_avx2<1u>, &mac_taps_avx2<2u>, &mac_taps_avx2<3u>, &mac_taps_avx2<4u>, &mac_taps_avx2<5u>, &mac_taps_avx2<6u>, &mac_taps_avx2<7u>, &mac_taps_avx2<8u>},
+	.scale_ramp = &scale_ramp_avx2,
+	.mac_ramp = &mac_ramp_avx2,
+	.mac_xfade = &mac_xfade_avx2,
+	.interp2 = &interp2_avx2,
+	.interp4 = &interp4_avx2,
+	.lfo_sine = &lfo_sine_avx2,
+	.lfo_triangle = &lfo_triangle_avx2
+};
+
+static const dspkernel_table_t DSPKERNEL_TABLE_AVX512 = {
+	.isa = DSPKERNEL_ISA_AVX512,
+	.scale = &scale_avx512,
+	.mac = &mac_avx512,
+	.mac_taps = {&mac_taps_generic_avx512, &mac_taps_avx512<1u>, &mac_taps_avx512<2u>, &mac_taps_avx512<3u>, &mac_taps_avx512<4u>, &mac_taps_avx512<5u>, &mac_taps_avx512<6u>, &mac_taps_avx512<7u>, &mac_taps_avx512<8u>},
+	.scale_ramp = &scale_ramp_avx512,
+	.mac_ramp = &mac_ramp_avx512,
+	.mac_xfade = &mac_xfade_avx512,
+	.interp2 = &interp2_avx512,
+	.interp4 = &interp4_avx512,
+	.lfo_sine = &lfo_sine_avx512,
+	.lfo_triangle = &lfo_triangle_avx512
+};
+
+static VOID WINAPI cpuid_query(UINT32 leaf, UINT32 subleaf, UINT32 *p_regs)
+{
+#ifdef _MSC_VER
+	__cpuidex((int*) p_regs, (int) leaf, (int) subleaf);
+#else
+	__cpuid_count(leaf, subleaf, p_regs[0], p_regs[1], p_regs[2], p_regs[3]);
+#endif
+	return;
+}
+
+static ULONG64 WINAPI xgetbv_query(VOID)
+{
+#ifdef _MSC_VER
+	return (ULONG64) _xgetbv(0);
+#else
+	UINT32 eax = 0u;
+	UINT32 edx = 0u;
+
+	__asm__ __volatile__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0u));
+	return ((((ULONG64) edx) << 32) | ((ULONG64) eax));
+#endif
+}
+
+#endif /*DSPKERNEL_X86*/
+
+INT WINAPI dspkernel_detect_isa(VOID)
+{
+#ifdef DSPKERNEL_X86
+	UINT32 regs[4] = {0u, 0u, 0u, 0u};
+	UINT32 max_leaf = 0u;
+	UINT32 leaf1_ecx = 0u;
+	UINT32 leaf1_edx = 0u;
+	UINT32 leaf7_ebx = 0u;
+	ULONG64 xcr0 = 0u;
+
+	cpuid_query(0u, 0u, regs);
+	max_leaf = regs[0];
+
+	if(max_leaf < 1u) return DSPKERNEL_ISA_SCALAR;
+
+	cpuid_query(1u, 0u, regs);
+	leaf1_ecx = regs[2];
+	leaf1_edx = regs[3];
+
+	if(!(leaf1_edx & (1u << 26))) return DSPKERNEL_ISA_SCALAR;
+
+	/*AVX and above also require the OS to save the extended register state (OSXSAVE + XCR0).*/
+
+	if(max_leaf < 7u) return DSPKERNEL_ISA_SSE2;
+	if(!(leaf1_ecx & (1u << 27))) return DSPKERNEL_ISA_SSE2;
+	if(!(leaf1_ecx & (1u << 28))) return DSPKERNEL_ISA_SSE2;
+
+	xcr0 = xgetbv_query();
+	if((xcr0 & 0x6) != 0x6) return DSPKERNEL_ISA_SSE2;
+
+	cpuid_query(7u, 0u, regs);
+	leaf7_ebx = regs[1];
+
+	if(!(leaf7_ebx & (1u << 5))) return DSPKERNEL_ISA_SSE2;
+
+	if(!(leaf7_ebx & (1u << 16))) return DSPKERNEL_ISA_AVX2;
+	if((xcr0 & 0xe0) != 0xe0) return DSPKERNEL_ISA_AVX2;
+
+	return DSPKERNEL_ISA_AVX512;
+#else
+	return DSPKERNEL_ISA_SCALAR;
+#endif
+}
+
+UINT32 WINAPI dspkernel_detect_extensions(VOID)
+{
+#ifdef DSPKERNEL_X86
+	UINT32 regs[4] = {0u, 0u, 0u, 0u};
+	UINT32 max_leaf = 0u;
+	UINT32 extensions = 0u;
+
+	cpuid_query(0u, 0u, regs);
+	max_leaf = regs[0];
+
+	if(max_leaf < 1u) return 0u;
+
+	cpuid_query(1u, 0u, regs);
+	if(regs[2] & (1u << 9)) extensions |= DSPKERNEL_EXT_SSSE3;
+
+	if(max_leaf < 7u) return extensions;
+
+	/*AVX-512 VBMI (leaf 7 ECX bit 1), with AVX-512 BW (leaf 7 EBX bit 30) for the byte masks.*/
+	cpuid_query(7u, 0u, regs);
+	if((regs[1] & (1u << 30)) && (regs[2] & (1u << 1))) extensions |= DSPKERNEL_EXT_AVX512VBMI;
+
+	return extensions;
+#else
+	return 0u;
+#endif
+}
+
+INT WINAPI dspkernel_select_isa(INT requested_isa)
+{
+	TCHAR envbuf[16];
+	INT isa_max = DSPKERNEL_ISA_SCALAR;
+	DWORD envlen = 0u;
+
+	isa_max = dspkernel_detect_isa();
+
+	envlen = GetEnvironmentVariable(DSPKERNEL_ISA_ENVVAR, envbuf, 16u);
+	if((envlen > 0u) && (envlen < 16u))
+	{
+		cstr_tolower(envbuf, 16u);
+
+		if(cstr_compare(envbuf, TEXT("scalar"))) requested_isa = DSPKERNEL_ISA_SCALAR;
+		else if(cstr_compare(envbuf, TEXT("sse2"))) requested_isa = DSPKERNEL_ISA_SSE2;
+		else if(cstr_compare(envbuf, TEXT("avx2"))) requested_isa = DSPKERNEL_ISA_AVX2;
+		else if(cstr_compare(envbuf, TEXT("avx512"))) requested_isa = DSPKERNEL_ISA_AVX512;
+		else if(cstr_compare(envbuf, TEXT("auto"))) requested_isa = DSPKERNEL_ISA_AUTO;
+	}
+
+	if(requested_isa < DSPKERNEL_ISA_SCALAR) return isa_max;
+	if(requested_isa > isa_max) return isa_max;
+
+	return requested_isa;
+}
+
+const dspkernel_table_t* WINAPI dspkernel_get_table(INT isa)
+{
+#ifdef DSPKERNEL_X86
+	switch(isa)
+	{
+		case DSPKERNEL_ISA_SSE2:
+			return &DSPKERNEL_TABLE_SSE2;
+
+		case DSPKERNEL_ISA_AVX2:
+			return &DSPKERNEL_TABLE_AVX2;
+
+		case DSPKERNEL_ISA_AVX512:
+			return &DSPKERNEL_TABLE_AVX512;
+	}
+#endif
+
+	return &DSPKERNEL_TABLE_SCALAR;
+}
+
+const TCHAR* WINAPI dspkernel_get_isa_name(INT isa)
+{
+	switch(isa)
+	{
+		case DSPKERNEL_ISA_SCALAR:
+			return TEXT("scalar");
+
+		case DSPKERNEL_ISA_SSE2:
+			return TEXT("sse2");
+
+		case DSPKERNEL_ISA_AVX2:
+			return TEXT("avx2");
+
+		case DSPKERNEL_ISA_AVX512:
+			return TEXT("avx512");
+	}
+
+	return TEXT("unknown");
+}
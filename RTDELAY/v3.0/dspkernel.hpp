@@ -0,0 +1,145 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*
+	DSP kernels used by the AudioDelay block engine.
+
+	Every kernel has a scalar reference version, which is always available, and SSE2/AVX2/AVX-512 versions on x86 CPUs.
+	The kernel table is chosen once (normally at AudioDelay::initialize()) by checking the CPU features with CPUID.
+
+	The SIMD versions use separate multiply and add instructions (no FMA), so their output is bit-identical to the scalar version,
+	provided the scalar version does single precision SSE math: x87 math keeps extra precision between the multiply and the add.
+	x64 builds always use SSE math, build32.bat compiles with -msse2 -mfpmath=sse.
+*/
+
+#ifndef DSPKERNEL_HPP
+#define DSPKERNEL_HPP
+
+#include "globldef.h"
+
+#define DSPKERNEL_ISA_AUTO -1
+#define DSPKERNEL_ISA_SCALAR 0
+#define DSPKERNEL_ISA_SSE2 1
+#define DSPKERNEL_ISA_AVX2 2
+#define DSPKERNEL_ISA_AVX512 3
+
+/*
+	Environment variable that forces a given ISA level, overriding whatever was requested in code.
+	Accepted values: "scalar", "sse2", "avx2", "avx512", "auto".
+	A level above what the CPU supports is lowered to the highest supported level.
+*/
+
+#define DSPKERNEL_ISA_ENVVAR TEXT("AUDIODELAY_ISA")
+
+/*
+	CPU extensions outside the ISA levels, for the sample format conversions (see pcmconv.hpp).
+	SSSE3: byte shuffle (pshufb). AVX512VBMI: byte permute (vpermb), reported with AVX-512 BW only.
+*/
+
+#define DSPKERNEL_EXT_SSSE3 0x1U
+#define DSPKERNEL_EXT_AVX512VBMI 0x2U
+
+/*Largest tap count with its own specialized mac_taps kernel.*/
+
+#define DSPKERNEL_MAC_TAPS_MAX 8u
+
+struct _dspkernel_table {
+	INT isa;
+
+	/*p_dst[n] = amp*p_src[n]*/
+	VOID (WINAPI *scale)(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, ULONG_PTR n_samples);
+
+	/*p_dst[n] += amp*p_src[n]*/
+	VOID (WINAPI *mac)(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, ULONG_PTR n_samples);
+
+	/*
+		Multi tap kernels: several taps accumulated in one pass over p_dst.
+		p_dst[n] += p_amp[0]*pp_src[0][n] + p_amp[1]*pp_src[1][n] + ... + p_amp[n_taps - 1]*pp_src[n_taps - 1][n]
+		The taps are added one after the other, so the result is bit-identical to n_taps calls to mac.
+
+		mac_taps[n_taps] is specialized (fully unrolled) for its tap count, for n_taps up to DSPKERNEL_MAC_TAPS_MAX.
+		mac_taps[0] is the generic version, for any tap count.
+	*/
+	VOID (WINAPI *mac_taps[DSPKERNEL_MAC_TAPS_MAX + 1u])(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_amp, ULONG_PTR n_taps, ULONG_PTR n_samples);
+
+	/*
+		Gain ramp kernels: the gain is (amp + damp*p_ramp[n]) for each sample.
+		p_ramp is a precomputed ramp shape, running from (almost) 0.0 to 1.0 over the ramp.
+	*/
+
+	/*p_dst[n] = (amp + damp*p_ramp[n])*p_src[n]*/
+	VOID (WINAPI *scale_ramp)(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, FLOAT damp, const FLOAT *p_ramp, ULONG_PTR n_samples);
+
+	/*p_dst[n] += (amp + damp*p_ramp[n])*p_src[n]*/
+	VOID (WINAPI *mac_ramp)(FLOAT *p_dst, const FLOAT *p_src, FLOAT amp, FLOAT damp, const FLOAT *p_ramp, ULONG_PTR n_samples);
+
+	/*
+		Crossfade kernel: blends two sources, p_src0 fading out and p_src1 fading in, following p_xfade (0.0 to 1.0), with a ramped gain.
+		p_dst[n] += (amp + damp*p_ramp[n])*(p_src0[n] + p_xfade[n]*(p_src1[n] - p_src0[n]))
+	*/
+	VOID (WINAPI *mac_xfade)(FLOAT *p_dst, const FLOAT *p_src0, const FLOAT *p_src1, FLOAT amp, FLOAT damp, const FLOAT *p_ramp, const FLOAT *p_xfade, ULONG_PTR n_samples);
+
+	/*
+		Interpolation kernels (fractional delay reads): weighted sum of 2 or 4 sources with constant coefficients.
+		p_dst[n] = p_coef[0]*pp_src[0][n] + p_coef[1]*pp_src[1][n] (+ p_coef[2]*pp_src[2][n] + p_coef[3]*pp_src[3][n])
+	*/
+	VOID (WINAPI *interp2)(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_coef, ULONG_PTR n_samples);
+	VOID (WINAPI *interp4)(FLOAT *p_dst, const FLOAT *const *pp_src, const FLOAT *p_coef, ULONG_PTR n_samples);
+
+	/*
+		LFO kernels (delay tap modulation): one value per frame.
+		phase is in cycles, x = phase + n*phase_inc
+		lfo_sine: p_dst[n] = depth*sin(2*pi*x)
+		lfo_triangle: p_dst[n] = depth*triangle(x), a triangle wave with the same phase and range as the sine.
+		The sine is a polynomial approximation (error below 1e-6), the same on every ISA level.
+	*/
+	VOID (WINAPI *lfo_sine)(FLOAT *p_dst, FLOAT phase, FLOAT phase_inc, FLOAT depth, ULONG_PTR n_frames);
+	VOID (WINAPI *lfo_triangle)(FLOAT *p_dst, FLOAT phase, FLOAT phase_inc, FLOAT depth, ULONG_PTR n_frames);
+};
+
+typedef struct _dspkernel_table dspkernel_table_t;
+
+/*
+	dspkernel_detect_isa()
+	returns the highest ISA level supported by both the CPU and the operating system.
+*/
+
+extern INT WINAPI dspkernel_detect_isa(VOID);
+
+/*
+	dspkernel_detect_extensions()
+	returns the DSPKERNEL_EXT_* flags supported by the CPU.
+	The operating system support is not checked here: an extension is only meant to be used on top of an ISA level that implies it.
+*/
+
+extern UINT32 WINAPI dspkernel_detect_extensions(VOID);
+
+/*
+	dspkernel_select_isa()
+	resolves the ISA level to be used from a requested level (DSPKERNEL_ISA_AUTO to detect),
+	the DSPKERNEL_ISA_ENVVAR override and the CPU capabilities.
+*/
+
+extern INT WINAPI dspkernel_select_isa(INT requested_isa);
+
+/*
+	dspkernel_get_table()
+	returns the kernel table for the given ISA level (as resolved by dspkernel_select_isa()).
+	Never returns NULL. Unknown levels return the scalar table.
+*/
+
+extern const dspkernel_table_t* WINAPI dspkernel_get_table(INT isa);
+
+/*
+	dspkernel_get_isa_name()
+	returns a short printable name for the given ISA level.
+*/
+
+extern const TCHAR* WINAPI dspkernel_get_isa_name(INT isa);
+
+#endif /*DSPKERNEL_HPP*/
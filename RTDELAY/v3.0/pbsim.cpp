@@ -0,0 +1,612 @@
+/*
+	Real-Time Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*
+	Simulated playback tool (console application, no GUI, no audio hardware).
+	Runs the real-time playback loop (AudioPB) on a virtual clocked audio device (AudioSink_Virtual) instead of the WASAPI device,
+	in real-time, and reports the device underruns.
+
+	Usage: pbsim <input.wav> [options]
+
+	Options:
+	--ff <delay>:<amp>   adds a feedforward delay tap (delay time in frames), up to __PBSIM_DELAY_N_FFCH taps
+	--fb <delay>:<amp>   adds a feedback delay tap (delay time in frames), up to __PBSIM_DELAY_N_FBCH taps
+	--buffer <frames>    device buffer size (default: sample rate rounded up to a power of 2, like the application)
+	--segment <frames>   stream segment size (default: a quarter of the device buffer)
+	--depth <segments>   pipeline depth, processed segments queued ahead of the device feed (default __PBSIM_STREAMBUFFER_N_SEGMENTS)
+	--period <frames>    device period (default 0: 10 ms)
+	--jitter <us>        maximum device period end delay (default 0: exact clock)
+	--seed <n>           jitter random seed (default 1)
+	--seconds <s>        stops playback after this many seconds (default 0: whole file)
+	--report <ms>        stats report interval (default 1000)
+	--capture <out.wav>  writes everything the virtual device played (silence included) to a WAVE file (up to 4 GiB)
+	--xrun <policy>      underrun recovery: silence (default), skip (stay in sync with the device clock) or grow (double the device buffer)
+
+	Prints the device stats (underruns, wake-up lateness of the playback thread) and the DSP load every report interval,
+	then the totals and the playback loop stage timings when playback ends.
+	The device stats restart when the device buffer grows (the device is re-opened), the playback loop underrun counts do not.
+	Exits with code 2 if the device had any underrun.
+*/
+
+#include "globldef.h"
+#include "cstrdef.h"
+#include "strdef.hpp"
+#include "thread.h"
+
+#include "AudioPB_i16.hpp"
+#include "AudioPB_i24.hpp"
+#include "AudioPB_i32.hpp"
+#include "AudioPB_f32.hpp"
+#include "AudioPB_f64.hpp"
+#include "AudioSink_Virtual.hpp"
+#include "wavfile.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define __PBSIM_STREAMBUFFER_N_SEGMENTS 2U
+#define __PBSIM_DELAY_BUFFER_SIZE_FRAMES 65536U
+#define __PBSIM_DELAY_N_FFCH 4U
+#define __PBSIM_DELAY_N_FBCH 4U
+#define __PBSIM_DELAY_XFADE_SIZE_MS 20U
+#define __PBSIM_READAHEAD_SIZE_MS 500U
+#define __PBSIM_REPORT_INTERVAL_MS 1000U
+
+#define PRINTBUF_SIZE_CHARS 1024U
+
+/*Same PROPERTYKEY as the application (see shared.hpp). Only the WASAPI sink uses it.*/
+__declspec(align(4)) const ULONG32 P_PKEY_Device_FriendlyName[] = {0xa45c254e, 0x4efddf1c, 0xd1672080, 0xe050a846, 14u};
+
+static __declspec(align(PTR_SIZE_BYTES)) TCHAR filein_dir[TEXTBUF_SIZE_CHARS] = {'\0'};
+static __declspec(align(PTR_SIZE_BYTES)) TCHAR capture_dir[TEXTBUF_SIZE_CHARS] = {'\0'};
+
+static __declspec(align(PTR_SIZE_BYTES)) audiodelay_fx_params_t p_ff_params[__PBSIM_DELAY_N_FFCH];
+static __declspec(align(PTR_SIZE_BYTES)) audiodelay_fx_params_t p_fb_params[__PBSIM_DELAY_N_FBCH];
+static __declspec(align(PTR_SIZE_BYTES)) ULONG_PTR n_ff_taps = 0u;
+static __declspec(align(PTR_SIZE_BYTES)) ULONG_PTR n_fb_taps = 0u;
+
+static __declspec(align(PTR_SIZE_BYTES)) audiopb_params_t pb_params;
+static __declspec(align(PTR_SIZE_BYTES)) audiosink_virtual_params_t sink_params;
+
+static __declspec(align(PTR_SIZE_BYTES)) ULONG_PTR run_seconds = 0u;
+static __declspec(align(4)) DWORD report_ms = __PBSIM_REPORT_INTERVAL_MS;
+
+static __declspec(align(PTR_SIZE_BYTES)) AudioPB *p_audio = NULL;
+
+/*Capture file (written from the playback thread, inside the sink)*/
+static __declspec(align(PTR_SIZE_BYTES)) HANDLE h_capture = INVALID_HANDLE_VALUE;
+static __declspec(align(PTR_SIZE_BYTES)) ULONG64 capture_size = 0u;
+static __declspec(align(PTR_SIZE_BYTES)) ULONG_PTR capture_bytes_per_frame = 0u;
+static __declspec(align(PTR_SIZE_BYTES)) ULONG_PTR capture_header_size = 0u;
+static __declspec(align(4)) BOOL capture_error = FALSE;
+
+static BOOL WINAPI parse_args(INT argc, CHAR **argv);
+static BOOL WINAPI parse_tap(const CHAR *arg, audiodelay_fx_params_t *p_fx);
+static INT WINAPI filein_get_params(VOID);
+static AudioPB* WINAPI audio_create(INT format);
+static BOOL WINAPI capture_open(const audiosink_format_t *p_format);
+static BOOL WINAPI capture_close(const audiosink_format_t *p_format);
+static VOID WINAPI capture_get_info(const audiosink_format_t *p_format, wavfile_info_t *p_info);
+static VOID WINAPI capture_proc(VOID *p_context, const BYTE *p_data, ULONG_PTR n_frames);
+static DWORD WINAPI audiothread_proc(VOID *p_args);
+static VOID WINAPI delay_set_taps(VOID);
+static VOID WINAPI print_stats(const CHAR *label, AudioSink_Virtual *p_sink, DOUBLE time_s);
+static VOID WINAPI print_xrun_events(VOID);
+static VOID WINAPI print_stage_stats(VOID);
+static VOID WINAPI print_error(const TCHAR *text);
+
+enum _pbsim_formats {
+	__PBSIM_I16 = 0,
+	__PBSIM_I24 = 1,
+	__PBSIM_I32 = 2,
+	__PBSIM_F32 = 3,
+	__PBSIM_F64 = 4
+};
+
+INT main(INT argc, CHAR **argv)
+{
+	AudioSink_Virtual *p_sink = NULL;
+	HANDLE p_audiothread = NULL;
+	audiosink_format_t format;
+	audiosink_virtual_stats_t stats;
+	audiopb_xrun_stats_t xrun_stats;
+	LARGE_INTEGER perf_freq;
+	LARGE_INTEGER perf_start;
+	LARGE_INTEGER perf_now;
+	DOUBLE time_s = 0.0;
+	BOOL taps_set = FALSE;
+	INT audio_format = -1;
+	INT ret = 1;
+
+	p_processheap = GetProcessHeap();
+	if(p_processheap == NULL)
+	{
+		print_error(TEXT("Error: Failed to Retrieve Process Heap."));
+		return 1;
+	}
+
+	if(!parse_args(argc, argv))
+	{
+		fputs("Usage: pbsim <input.wav> [--ff <delay>:<amp>]... [--fb <delay>:<amp>]... [--buffer <frames>] [--segment <frames>] [--depth <segments>] [--period <frames>] [--jitter <us>] [--seed <n>] [--seconds <s>] [--report <ms>] [--capture <out.wav>] [--xrun <silence|skip|grow>]\n", stderr);
+		return 1;
+	}
+
+	audio_format = filein_get_params();
+	if(audio_format < 0) return 1;
+
+	/*The capture file is created once the device format is known.*/
+	if(capture_dir[0] != '\0') sink_params.capture_proc = &capture_proc;
+
+	p_sink = new AudioSink_Virtual(&sink_params);
+	if(p_sink == NULL)
+	{
+		print_error(TEXT("Error: failed to create virtual sink object instance."));
+		goto _l_main_exit;
+	}
+
+	p_audio = audio_create(audio_format);
+	if(p_audio == NULL)
+	{
+		print_error(TEXT("Error: failed to create audio object instance."));
+		goto _l_main_exit;
+	}
+
+	if(!p_audio->setSink(p_sink))
+	{
+		print_error(p_audio->getLastErrorMessage().c_str());
+		goto _l_main_exit;
+	}
+
+	if(!p_audio->initialize())
+	{
+		print_error(p_audio->getLastErrorMessage().c_str());
+		goto _l_main_exit;
+	}
+
+	p_sink->getFormat(&format);
+	capture_bytes_per_frame = (format.n_channels)*(format.bytes_per_sample);
+
+	if(capture_dir[0] != '\0')
+	{
+		if(!capture_open(&format))
+		{
+			print_error(TEXT("Error: failed to create capture file."));
+			goto _l_main_exit;
+		}
+	}
+
+	printf("Playing %lld frames (%lu Hz, %lu channels) on the virtual device: buffer %lu frames, segment %lu frames, pipeline depth %lu segments, jitter %lu us\n", (long long) p_audio->getAudioDataSizeFrames(), (unsigned long) pb_params.sample_rate, (unsigned long) pb_params.n_channels, (unsigned long) pb_params.audiobuffer_size_frames, (unsigned long) pb_params.streambuffer_segment_size_frames, (unsigned long) pb_params.streambuffer_n_segments, (unsigned long) sink_params.jitter_us);
+
+	QueryPerformanceFrequency(&perf_freq);
+	QueryPerformanceCounter(&perf_start);
+
+	p_audiothread = thread_create_default(&audiothread_proc, NULL, NULL);
+	if(p_audiothread == NULL)
+	{
+		print_error(TEXT("Error: failed to create audio thread."));
+		goto _l_main_exit;
+	}
+
+	/*
+		Playback resets the delay parameters when it starts:
+		the taps are set once the playback is running, then the stats are reported until the playback thread is done.
+	*/
+	while(WaitForSingleObject(p_audiothread, (taps_set) ? report_ms : 1u) == WAIT_TIMEOUT)
+	{
+		QueryPerformanceCounter(&perf_now);
+		time_s = ((DOUBLE) (perf_now.QuadPart - perf_start.QuadPart))/((DOUBLE) perf_freq.QuadPart);
+
+		if(!taps_set)
+		{
+			if(p_audio->getStatus() != AudioPB::STATUS_RUNNING) continue;
+
+			delay_set_taps();
+			taps_set = TRUE;
+			continue;
+		}
+
+		print_stats("", p_sink, time_s);
+
+		if(run_seconds && (time_s >= ((DOUBLE) run_seconds))) p_audio->stopPlayback();
+	}
+
+	thread_wait(&p_audiothread);
+
+	QueryPerformanceCounter(&perf_now);
+	time_s = ((DOUBLE) (perf_now.QuadPart - perf_start.QuadPart))/((DOUBLE) perf_freq.QuadPart);
+
+	print_stats("Done: ", p_sink, time_s);
+
+	if(h_capture != INVALID_HANDLE_VALUE)
+	{
+		if(!capture_close(&format)) print_error(TEXT("Error: failed to write capture file."));
+	}
+
+	print_xrun_events();
+	print_stage_stats();
+
+	p_sink->getStats(&stats);
+	p_audio->getXrunStats(&xrun_stats);
+	ret = (stats.n_underruns || xrun_stats.n_xruns) ? 2 : 0;
+
+_l_main_exit:
+	if(h_capture != INVALID_HANDLE_VALUE) CloseHandle(h_capture);
+
+	/*p_audio uses p_sink: delete p_audio first.*/
+	if(p_audio != NULL) delete p_audio;
+	if(p_sink != NULL) delete p_sink;
+
+	return ret;
+}
+
+__declspec(noreturn) VOID WINAPI app_exit(UINT exit_code, const TCHAR *exit_msg)
+{
+	if(exit_msg != NULL) print_error(exit_msg);
+
+	ExitProcess(exit_code);
+
+	while(TRUE) Sleep(16u);
+}
+
+static BOOL WINAPI parse_args(INT argc, CHAR **argv)
+{
+	INT n_arg = 0;
+	ULONG_PTR delay_max = 0u;
+
+	if(argc < 2) return FALSE;
+
+	ZeroMemory(&pb_params, sizeof(audiopb_params_t));
+	ZeroMemory(&sink_params, sizeof(audiosink_virtual_params_t));
+	ZeroMemory(p_ff_params, sizeof(p_ff_params));
+	ZeroMemory(p_fb_params, sizeof(p_fb_params));
+
+	cstr_copy_char_to_tchar(argv[1], filein_dir, TEXTBUF_SIZE_CHARS);
+
+	sink_params.jitter_seed = 1u;
+
+	for(n_arg = 2; n_arg < argc; n_arg++)
+	{
+		if((n_arg + 1) >= argc) return FALSE;
+
+		if(!strcmp(argv[n_arg], "--ff"))
+		{
+			if(n_ff_taps >= __PBSIM_DELAY_N_FFCH) return FALSE;
+			if(!parse_tap(argv[n_arg + 1], &p_ff_params[n_ff_taps])) return FALSE;
+			if(p_ff_params[n_ff_taps].delay > delay_max) delay_max = (ULONG_PTR) p_ff_params[n_ff_taps].delay;
+			n_ff_taps++;
+		}
+		else if(!strcmp(argv[n_arg], "--fb"))
+		{
+			if(n_fb_taps >= __PBSIM_DELAY_N_FBCH) return FALSE;
+			if(!parse_tap(argv[n_arg + 1], &p_fb_params[n_fb_taps])) return FALSE;
+			if(p_fb_params[n_fb_taps].delay > delay_max) delay_max = (ULONG_PTR) p_fb_params[n_fb_taps].delay;
+			n_fb_taps++;
+		}
+		else if(!strcmp(argv[n_arg], "--buffer")) pb_params.audiobuffer_size_frames = (ULONG_PTR) strtoul(argv[n_arg + 1], NULL, 10);
+		else if(!strcmp(argv[n_arg], "--segment")) pb_params.streambuffer_segment_size_frames = (ULONG_PTR) strtoul(argv[n_arg + 1], NULL, 10);
+		else if(!strcmp(argv[n_arg], "--depth")) pb_params.streambuffer_n_segments = (ULONG_PTR) strtoul(argv[n_arg + 1], NULL, 10);
+		else if(!strcmp(argv[n_arg], "--period")) sink_params.period_frames = (ULONG_PTR) strtoul(argv[n_arg + 1], NULL, 10);
+		else if(!strcmp(argv[n_arg], "--jitter")) sink_params.jitter_us = (ULONG_PTR) strtoul(argv[n_arg + 1], NULL, 10);
+		else if(!strcmp(argv[n_arg], "--seed")) sink_params.jitter_seed = (UINT32) strtoul(argv[n_arg + 1], NULL, 10);
+		else if(!strcmp(argv[n_arg], "--seconds")) run_seconds = (ULONG_PTR) strtoul(argv[n_arg + 1], NULL, 10);
+		else if(!strcmp(argv[n_arg], "--report")) report_ms = (DWORD) strtoul(argv[n_arg + 1], NULL, 10);
+		else if(!strcmp(argv[n_arg], "--capture")) cstr_copy_char_to_tchar(argv[n_arg + 1], capture_dir, TEXTBUF_SIZE_CHARS);
+		else if(!strcmp(argv[n_arg], "--xrun"))
+		{
+			if(!strcmp(argv[n_arg + 1], "silence")) pb_params.xrun_policy = AudioPB::XRUN_POLICY_SILENCE;
+			else if(!strcmp(argv[n_arg + 1], "skip")) pb_params.xrun_policy = AudioPB::XRUN_POLICY_SKIP;
+			else if(!strcmp(argv[n_arg + 1], "grow")) pb_params.xrun_policy = AudioPB::XRUN_POLICY_GROW;
+			else return FALSE;
+		}
+		else return FALSE;
+
+		n_arg++;
+	}
+
+	if(!report_ms) report_ms = __PBSIM_REPORT_INTERVAL_MS;
+
+	/*The delay buffer must hold the longest delay time.*/
+	pb_params.delay_buffer_size_frames = __PBSIM_DELAY_BUFFER_SIZE_FRAMES;
+	if(delay_max >= pb_params.delay_buffer_size_frames) pb_params.delay_buffer_size_frames = _get_closest_power2_ceil(delay_max + 1u);
+
+	pb_params.file_dir = filein_dir;
+	pb_params.n_ff_delays = __PBSIM_DELAY_N_FFCH;
+	pb_params.n_fb_delays = __PBSIM_DELAY_N_FBCH;
+	pb_params.dither = FALSE; /*Keeps the capture of 16 bit files bit-exact.*/
+
+	return TRUE;
+}
+
+static BOOL WINAPI parse_tap(const CHAR *arg, audiodelay_fx_params_t *p_fx)
+{
+	CHAR *p_end = NULL;
+	ULONG delay = 0u;
+
+	delay = strtoul(arg, &p_end, 10);
+	if((p_end == arg) || (*p_end != ':')) return FALSE;
+
+	p_fx->delay = (UINT32) delay;
+	p_fx->amp = (FLOAT) atof(&p_end[1]);
+
+	return TRUE;
+}
+
+static INT WINAPI filein_get_params(VOID)
+{
+	HANDLE h_filein = INVALID_HANDLE_VALUE;
+	wavfile_info_t wavinfo;
+	__string err_msg = TEXT("");
+	ULONG64 file_size = 0u;
+	LARGE_INTEGER size;
+	BOOL parsed = FALSE;
+
+	h_filein = CreateFile(filein_dir, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, INVALID_HANDLE_VALUE);
+	if(h_filein == INVALID_HANDLE_VALUE)
+	{
+		print_error(TEXT("Error: failed to open input file."));
+		return -1;
+	}
+
+	if(!GetFileSizeEx(h_filein, &size))
+	{
+		CloseHandle(h_filein);
+		print_error(TEXT("Error: could not get input file size."));
+		return -1;
+	}
+
+	file_size = (ULONG64) size.QuadPart;
+
+	parsed = wavfile_parse_header(&wavfile_read_handle, (VOID*) h_filein, file_size, &wavinfo, &err_msg);
+
+	CloseHandle(h_filein);
+
+	if(!parsed)
+	{
+		print_error(err_msg.c_str());
+		return -1;
+	}
+
+	pb_params.n_channels = wavinfo.n_channels;
+	pb_params.sample_rate = wavinfo.sample_rate;
+	pb_params.audio_data_begin = wavinfo.audio_data_begin;
+	pb_params.audio_data_end = wavinfo.audio_data_end;
+
+	if(!pb_params.audiobuffer_size_frames) pb_params.audiobuffer_size_frames = _get_closest_power2_ceil(pb_params.sample_rate);
+	if(!pb_params.streambuffer_segment_size_frames) pb_params.streambuffer_segment_size_frames = pb_params.audiobuffer_size_frames/4u;
+	if(!pb_params.streambuffer_n_segments) pb_params.streambuffer_n_segments = __PBSIM_STREAMBUFFER_N_SEGMENTS;
+
+	pb_params.delay_xfade_size_frames = (pb_params.sample_rate*__PBSIM_DELAY_XFADE_SIZE_MS)/1000u;
+	pb_params.readahead_size_frames = (pb_params.sample_rate*__PBSIM_READAHEAD_SIZE_MS)/1000u;
+
+	if(wavinfo.format_tag == WAVFILE_FORMAT_IEEE_FLOAT)
+	{
+		switch(wavinfo.bits_per_sample)
+		{
+			case 32u:
+				return __PBSIM_F32;
+
+			case 64u:
+				return __PBSIM_F64;
+		}
+	}
+	else
+	{
+		switch(wavinfo.bits_per_sample)
+		{
+			case 16u:
+				return __PBSIM_I16;
+
+			case 24u:
+				return __PBSIM_I24;
+
+			case 32u:
+				return __PBSIM_I32;
+		}
+	}
+
+	print_error(TEXT("Error: audio format not supported."));
+	return -1;
+}
+
+static AudioPB* WINAPI audio_create(INT format)
+{
+	switch(format)
+	{
+		case __PBSIM_I16:
+			return new AudioPB_i16(&pb_params);
+
+		case __PBSIM_I24:
+			return new AudioPB_i24(&pb_params);
+
+		case __PBSIM_I32:
+			return new AudioPB_i32(&pb_params);
+
+		case __PBSIM_F32:
+			return new AudioPB_f32(&pb_params);
+
+		case __PBSIM_F64:
+			return new AudioPB_f64(&pb_params);
+	}
+
+	return NULL;
+}
+
+static BOOL WINAPI capture_open(const audiosink_format_t *p_format)
+{
+	wavfile_info_t wavinfo;
+	LARGE_INTEGER data_begin;
+
+	h_capture = CreateFile(capture_dir, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(h_capture == INVALID_HANDLE_VALUE) return FALSE;
+
+	/*Room for the header, written when playback is done. The capture stays a 32 bit RIFF file: the header size only depends on the format.*/
+	capture_get_info(p_format, &wavinfo);
+	capture_header_size = wavfile_get_header_size(&wavinfo);
+
+	data_begin.QuadPart = (LONGLONG) capture_header_size;
+	if(!SetFilePointerEx(h_capture, data_begin, NULL, FILE_BEGIN)) return FALSE;
+
+	capture_size = 0u;
+	capture_error = FALSE;
+	return TRUE;
+}
+
+static BOOL WINAPI capture_close(const audiosink_format_t *p_format)
+{
+	wavfile_info_t wavinfo;
+	BOOL ret = FALSE;
+
+	capture_get_info(p_format, &wavinfo);
+	wavinfo.audio_data_end = wavinfo.audio_data_begin + capture_size;
+
+	ret = wavfile_write_header(h_capture, &wavinfo) && !capture_error;
+
+	CloseHandle(h_capture);
+	h_capture = INVALID_HANDLE_VALUE;
+	return ret;
+}
+
+/*Capture file header info for the device format, with no audio data.*/
+
+static VOID WINAPI capture_get_info(const audiosink_format_t *p_format, wavfile_info_t *p_info)
+{
+	ZeroMemory(p_info, sizeof(wavfile_info_t));
+
+	p_info->audio_data_begin = (ULONG64) capture_header_size;
+	p_info->audio_data_end = p_info->audio_data_begin;
+	p_info->sample_rate = p_format->sample_rate;
+	p_info->n_channels = p_format->n_channels;
+	p_info->bits_per_sample = (p_format->bytes_per_sample)*8u; /*container size: the device stream is left-justified*/
+	p_info->valid_bits_per_sample = p_format->bits_per_sample;
+	p_info->format_tag = (p_format->is_float) ? WAVFILE_FORMAT_IEEE_FLOAT : WAVFILE_FORMAT_PCM;
+
+	return;
+}
+
+static VOID WINAPI capture_proc(VOID *p_context, const BYTE *p_data, ULONG_PTR n_frames)
+{
+	ULONG64 size = 0u;
+	DWORD n_written = 0u;
+
+	if(capture_error) return;
+
+	size = (ULONG64) (n_frames*capture_bytes_per_frame);
+
+	/*The capture is a 32 bit RIFF file (room left for the data pad byte).*/
+	if((capture_size + size) > ((ULONG64) (0xffffffffu - capture_header_size - 1u))) return;
+
+	if(!WriteFile(h_capture, p_data, (DWORD) size, &n_written, NULL) || (((ULONG64) n_written) != size))
+	{
+		capture_error = TRUE;
+		return;
+	}
+
+	capture_size += size;
+	return;
+}
+
+static DWORD WINAPI audiothread_proc(VOID *p_args)
+{
+	if(!p_audio->runPlayback()) print_error(p_audio->getLastErrorMessage().c_str());
+	return 0u;
+}
+
+static VOID WINAPI delay_set_taps(VOID)
+{
+	ULONG_PTR n_fx = 0u;
+
+	p_audio->delayBeginParamsUpdate();
+
+	for(n_fx = 0u; n_fx < n_ff_taps; n_fx++)
+	{
+		p_audio->delaySetFFDelay(n_fx, (ULONG_PTR) p_ff_params[n_fx].delay);
+		p_audio->delaySetFFAmplitude(n_fx, p_ff_params[n_fx].amp);
+	}
+
+	for(n_fx = 0u; n_fx < n_fb_taps; n_fx++)
+	{
+		p_audio->delaySetFBDelay(n_fx, (ULONG_PTR) p_fb_params[n_fx].delay);
+		p_audio->delaySetFBAmplitude(n_fx, p_fb_params[n_fx].amp);
+	}
+
+	p_audio->delayCommitParamsUpdate();
+	return;
+}
+
+static VOID WINAPI print_stats(const CHAR *label, AudioSink_Virtual *p_sink, DOUBLE time_s)
+{
+	audiosink_virtual_stats_t stats;
+	audiosink_wait_stats_t wait_stats;
+	audiopb_readahead_stats_t ra_stats;
+	audiopb_pipeline_stats_t pl_stats;
+	audiopb_xrun_stats_t xrun_stats;
+	audiopb_stage_stats_t stage_stats;
+
+	p_sink->getStats(&stats);
+	p_sink->getWaitStats(&wait_stats);
+	if(!p_audio->getReadAheadStats(&ra_stats)) ZeroMemory(&ra_stats, sizeof(audiopb_readahead_stats_t));
+	if(!p_audio->getPipelineStats(&pl_stats)) ZeroMemory(&pl_stats, sizeof(audiopb_pipeline_stats_t));
+	p_audio->getXrunStats(&xrun_stats);
+	p_audio->getStageStats(&stage_stats);
+
+	printf("%s%.3f s: played %llu frames (%llu periods), underruns %llu (%llu frames of silence), read-ahead starved %llu\n", label, time_s, (unsigned long long) stats.n_frames_played, (unsigned long long) stats.n_periods, (unsigned long long) stats.n_underruns, (unsigned long long) stats.n_frames_silence, (unsigned long long) ra_stats.n_starved);
+	printf("    pipeline: %llu segments processed, fill %lu/%lu (min %lu), DSP starved %llu\n", (unsigned long long) pl_stats.n_segments_processed, (unsigned long) pl_stats.fill_segments, (unsigned long) pl_stats.depth_segments, (unsigned long) pl_stats.fill_min_segments, (unsigned long long) pl_stats.n_starved);
+	printf("    playback loop underruns %llu (%.1f per hour): %llu frames lost, %llu segments skipped, buffer %lu frames (grown %lu times)\n", (unsigned long long) xrun_stats.n_xruns, xrun_stats.xruns_per_hour, (unsigned long long) xrun_stats.n_frames_lost, (unsigned long long) xrun_stats.n_segments_skipped, (unsigned long) xrun_stats.buffer_size_frames, (unsigned long) xrun_stats.n_buffer_grows);
+	printf("    device wake-ups %llu: lateness mean %.1f us, max %.1f us\n", (unsigned long long) wait_stats.n_waits, wait_stats.lateness_mean_us, wait_stats.lateness_max_us);
+	printf("    DSP load: mean %.1f %%, p99 %.1f %%, max %.1f %% of %.1f us per segment\n", stage_stats.dsp_load_mean_pct, stage_stats.dsp_load_p99_pct, stage_stats.dsp_load_max_pct, stage_stats.segment_budget_us);
+
+	fflush(stdout);
+	return;
+}
+
+static VOID WINAPI print_xrun_events(VOID)
+{
+	audiopb_xrun_stats_t xrun_stats;
+	ULONG_PTR n_event = 0u;
+
+	p_audio->getXrunStats(&xrun_stats);
+	if(!xrun_stats.n_events) return;
+
+	printf("Last %lu underruns:\n", (unsigned long) xrun_stats.n_events);
+
+	for(n_event = 0u; n_event < xrun_stats.n_events; n_event++)
+		printf("    %.3f s: position %llu frames, %lu frames lost\n", xrun_stats.events[n_event].time_s, (unsigned long long) xrun_stats.events[n_event].position_frames, (unsigned long) xrun_stats.events[n_event].lost_frames);
+
+	fflush(stdout);
+	return;
+}
+
+static VOID WINAPI print_stage_stats(VOID)
+{
+	const CHAR *p_names[AUDIOPB_N_STAGES] = {"buffer_play", "loadin", "runDSP", "loadout", "device wait"};
+	audiopb_stage_stats_t stage_stats;
+	ULONG_PTR n_stage = 0u;
+
+	p_audio->getStageStats(&stage_stats);
+
+	printf("Stage timings (us):          calls        p50        p99      p99.9        max\n");
+
+	for(n_stage = 0u; n_stage < AUDIOPB_N_STAGES; n_stage++)
+		printf("    %-20s %12llu %10.1f %10.1f %10.1f %10.1f\n", p_names[n_stage], (unsigned long long) stage_stats.stages[n_stage].n_samples, stage_stats.stages[n_stage].p50_us, stage_stats.stages[n_stage].p99_us, stage_stats.stages[n_stage].p999_us, stage_stats.stages[n_stage].max_us);
+
+	printf("    %-20s %12llu %10.1f %10.1f %10.1f %10.1f\n", "DSP per segment", (unsigned long long) stage_stats.dsp_segment.n_samples, stage_stats.dsp_segment.p50_us, stage_stats.dsp_segment.p99_us, stage_stats.dsp_segment.p999_us, stage_stats.dsp_segment.max_us);
+
+	fflush(stdout);
+	return;
+}
+
+static VOID WINAPI print_error(const TCHAR *text)
+{
+	CHAR printbuf[PRINTBUF_SIZE_CHARS];
+
+	cstr_copy_tchar_to_char(text, printbuf, PRINTBUF_SIZE_CHARS);
+
+	fputs(printbuf, stderr);
+	fputs("\n", stderr);
+	return;
+}
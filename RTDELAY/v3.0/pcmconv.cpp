@@ -0,0 +1,1207 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#include "pcmconv.hpp"
+#include "dspkernel.hpp"
+
+#include <math.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define PCMCONV_X86
+#endif
+
+#ifdef PCMCONV_X86
+#include <immintrin.h>
+
+/*GCC/MinGW only emits instructions enabled for the function, MSVC emits any intrinsic.*/
+#ifdef __GNUC__
+#define PCMCONV_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PCMCONV_TARGET(isa)
+#endif
+
+#endif /*PCMCONV_X86*/
+
+#define PCMCONV_I16_FACTOR 32768.0f
+#define PCMCONV_I24_FACTOR 8388608.0f
+#define PCMCONV_I32_FACTOR 2147483648.0f
+
+/*TPDF dither: the difference of two 16 bit uniform values, scaled to (-1.0, 1.0) LSB.*/
+#define PCMCONV_DITHER_SCALE (1.0f/65536.0f)
+
+/*(full scale - 1) for 32 bit is not exact in single precision: 32 bit encoding is done in double precision.*/
+#define PCMCONV_I32_ENCODE_FACTOR 2147483647.0
+
+struct _pcmconv_table {
+	VOID (WINAPI *i16_to_f32)(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples);
+	VOID (WINAPI *f32_to_i16)(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples);
+	VOID (WINAPI *f32_to_i16_dither)(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples, pcmconv_dither_t *p_dither);
+	VOID (WINAPI *i24_to_f32)(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples);
+	VOID (WINAPI *f32_to_i24)(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples);
+	VOID (WINAPI *f32_to_i24in32)(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples);
+	VOID (WINAPI *i32_to_f32)(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples);
+	VOID (WINAPI *f32_to_i32)(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples);
+	VOID (WINAPI *f32_to_float32)(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples);
+	VOID (WINAPI *float64_to_f32)(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples);
+	VOID (WINAPI *f32_to_float64)(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples);
+};
+
+typedef struct _pcmconv_table pcmconv_table_t;
+
+static const pcmconv_table_t* WINAPI pcmconv_get_table(VOID);
+
+/*======================================================================================*/
+/*Scalar reference conversions*/
+
+/*The clamps send NaN to -1.0, like the SIMD max/min pair (maxps returns its second operand, -1.0, when the first one is NaN).*/
+
+static VOID WINAPI i16_to_f32_scalar(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_sample = 0u;
+	const INT16 *p_input = NULL;
+
+	FLOAT f32 = 0.0f;
+
+	p_input = (const INT16*) p_src;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++)
+	{
+		f32 = (FLOAT) p_input[n_sample];
+		f32 /= PCMCONV_I16_FACTOR;
+		p_dst[n_sample] = f32;
+	}
+
+	return;
+}
+
+static VOID WINAPI f32_to_i16_scalar(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_sample = 0u;
+	INT16 *p_output = NULL;
+
+	FLOAT factor = 0.0f;
+	FLOAT f32 = 0.0f;
+
+	p_output = (INT16*) p_dst;
+
+	factor = PCMCONV_I16_FACTOR - 1.0f;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++)
+	{
+		f32 = p_src[n_sample];
+
+		if(f32 > 1.0f) f32 = 1.0f;
+		else if(!(f32 >= -1.0f)) f32 = -1.0f;
+
+		f32 *= factor;
+
+		p_output[n_sample] = (INT16) roundf(f32);
+	}
+
+	return;
+}
+
+/*
+	Dithered 16 bit: every group of PCMCONV_DITHER_N_LANES samples steps all the generator lanes once, sample n takes lane (n % PCMCONV_DITHER_N_LANES).
+	A group cut short at the end still steps all the lanes. The SIMD versions run the same lanes, so every version gives the same output.
+*/
+
+static UINT32 WINAPI dither_step_scalar(UINT32 *p_state)
+{
+	UINT32 x = *p_state;
+
+	x ^= (x << 13);
+	x ^= (x >> 17);
+	x ^= (x << 5);
+
+	*p_state = x;
+	return x;
+}
+
+static VOID WINAPI f32_to_i16_dither_scalar(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples, pcmconv_dither_t *p_dither)
+{
+	ULONG_PTR n_sample = 0u;
+	ULONG_PTR n_lane = 0u;
+	INT16 *p_output = NULL;
+
+	UINT32 rnd = 0u;
+	INT32 i32 = 0;
+
+	FLOAT factor = 0.0f;
+	FLOAT f32 = 0.0f;
+
+	p_output = (INT16*) p_dst;
+
+	factor = PCMCONV_I16_FACTOR - 1.0f;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample += PCMCONV_DITHER_N_LANES)
+	{
+		for(n_lane = 0u; n_lane < PCMCONV_DITHER_N_LANES; n_lane++)
+		{
+			rnd = dither_step_scalar(&(p_dither->state[n_lane]));
+
+			if((n_sample + n_lane) >= n_samples) continue;
+
+			f32 = p_src[n_sample + n_lane];
+
+			if(f32 > 1.0f) f32 = 1.0f;
+			else if(!(f32 >= -1.0f)) f32 = -1.0f;
+
+			f32 *= factor;
+			f32 += ((FLOAT) (((INT32) (rnd >> 16)) - ((INT32) (rnd & 0xffff))))*PCMCONV_DITHER_SCALE;
+
+			/*The dither can push a full scale sample one step past the 16 bit range.*/
+			i32 = (INT32) roundf(f32);
+
+			if(i32 > 32767) i32 = 32767;
+			else if(i32 < -32768) i32 = -32768;
+
+			p_output[n_sample + n_lane] = (INT16) i32;
+		}
+	}
+
+	return;
+}
+
+static VOID WINAPI i24_to_f32_scalar(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_sample = 0u;
+	ULONG_PTR n_byte = 0u;
+
+	INT32 i32 = 0;
+
+	FLOAT f32 = 0.0f;
+
+	n_byte = 0u;
+	for(n_sample = 0u; n_sample < n_samples; n_sample++)
+	{
+		i32 = ((p_src[n_byte + 2u] << 16) | (p_src[n_byte + 1u] << 8) | (p_src[n_byte]));
+
+		if(i32 & 0x00800000) i32 |= 0xff800000;
+		else i32 &= 0x007fffff; /*Not really necessary, but just to be safe.*/
+
+		f32 = (FLOAT) i32;
+		f32 /= PCMCONV_I24_FACTOR;
+		p_dst[n_sample] = f32;
+
+		n_byte += 3u;
+	}
+
+	return;
+}
+
+static VOID WINAPI f32_to_i24_scalar(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_sample = 0u;
+	ULONG_PTR n_byte = 0u;
+
+	INT32 i32 = 0;
+
+	FLOAT factor = 0.0f;
+	FLOAT f32 = 0.0f;
+
+	factor = PCMCONV_I24_FACTOR - 1.0f;
+
+	n_byte = 0u;
+	for(n_sample = 0u; n_sample < n_samples; n_sample++)
+	{
+		f32 = p_src[n_sample];
+
+		if(f32 > 1.0f) f32 = 1.0f;
+		else if(!(f32 >= -1.0f)) f32 = -1.0f;
+
+		f32 *= factor;
+
+		i32 = (INT32) roundf(f32);
+
+		p_dst[n_byte] = (BYTE) (i32 & 0xff);
+		p_dst[n_byte + 1u] = (BYTE) ((i32 >> 8) & 0xff);
+		p_dst[n_byte + 2u] = (BYTE) ((i32 >> 16) & 0xff);
+
+		n_byte += 3u;
+	}
+
+	return;
+}
+
+static VOID WINAPI f32_to_i24in32_scalar(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_sample = 0u;
+	INT32 *p_output = NULL;
+
+	INT32 i32 = 0;
+
+	FLOAT factor = 0.0f;
+	FLOAT f32 = 0.0f;
+
+	p_output = (INT32*) p_dst;
+
+	factor = PCMCONV_I24_FACTOR - 1.0f;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++)
+	{
+		f32 = p_src[n_sample];
+
+		if(f32 > 1.0f) f32 = 1.0f;
+		else if(!(f32 >= -1.0f)) f32 = -1.0f;
+
+		f32 *= factor;
+
+		i32 = (INT32) roundf(f32);
+
+		p_output[n_sample] = (i32 << 8);
+	}
+
+	return;
+}
+
+static VOID WINAPI i32_to_f32_scalar(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_sample = 0u;
+	const INT32 *p_input = NULL;
+
+	FLOAT f32 = 0.0f;
+
+	p_input = (const INT32*) p_src;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++)
+	{
+		f32 = (FLOAT) p_input[n_sample];
+		f32 /= PCMCONV_I32_FACTOR;
+		p_dst[n_sample] = f32;
+	}
+
+	return;
+}
+
+/*Rounds half away from zero as (x + 0.5*sign(x)) truncated, which is exact in double precision in the 32 bit range. The SIMD versions do the same.*/
+
+static VOID WINAPI f32_to_i32_scalar(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_sample = 0u;
+	INT32 *p_output = NULL;
+
+	FLOAT f32 = 0.0f;
+	DOUBLE f64 = 0.0;
+
+	p_output = (INT32*) p_dst;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++)
+	{
+		f32 = p_src[n_sample];
+
+		if(f32 > 1.0f) f32 = 1.0f;
+		else if(!(f32 >= -1.0f)) f32 = -1.0f;
+
+		f64 = ((DOUBLE) f32)*PCMCONV_I32_ENCODE_FACTOR;
+
+		if(f64 < 0.0) f64 -= 0.5;
+		else f64 += 0.5;
+
+		p_output[n_sample] = (INT32) f64;
+	}
+
+	return;
+}
+
+static VOID WINAPI f32_to_float32_scalar(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_sample = 0u;
+	FLOAT *p_output = NULL;
+
+	FLOAT f32 = 0.0f;
+
+	p_output = (FLOAT*) p_dst;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++)
+	{
+		f32 = p_src[n_sample];
+
+		if(f32 > 1.0f) f32 = 1.0f;
+		else if(!(f32 >= -1.0f)) f32 = -1.0f;
+
+		p_output[n_sample] = f32;
+	}
+
+	return;
+}
+
+static VOID WINAPI float64_to_f32_scalar(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_sample = 0u;
+	const DOUBLE *p_input = NULL;
+
+	p_input = (const DOUBLE*) p_src;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++) p_dst[n_sample] = (FLOAT) p_input[n_sample];
+
+	return;
+}
+
+static VOID WINAPI f32_to_float64_scalar(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	ULONG_PTR n_sample = 0u;
+	DOUBLE *p_output = NULL;
+
+	FLOAT f32 = 0.0f;
+
+	p_output = (DOUBLE*) p_dst;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample++)
+	{
+		f32 = p_src[n_sample];
+
+		if(f32 > 1.0f) f32 = 1.0f;
+		else if(!(f32 >= -1.0f)) f32 = -1.0f;
+
+		p_output[n_sample] = (DOUBLE) f32;
+	}
+
+	return;
+}
+
+#ifdef PCMCONV_X86
+
+/*======================================================================================*/
+/*SSE2 conversions (4 samples per vector)*/
+
+/*
+	Same result as roundf() (half away from zero): the fraction left after truncation, (x - trunc(x)), is exact,
+	so comparing it against +-0.5 gives the rounding direction exactly. Adding 0.5 before truncating would not be exact.
+*/
+
+PCMCONV_TARGET("sse2") static __m128i WINAPI f32_round_i32_sse2(__m128 v_x)
+{
+	__m128i v_i32 = _mm_cvttps_epi32(v_x);
+	__m128 v_frac = _mm_sub_ps(v_x, _mm_cvtepi32_ps(v_i32));
+
+	/*Compare masks are -1 where true.*/
+	v_i32 = _mm_sub_epi32(v_i32, _mm_castps_si128(_mm_cmpge_ps(v_frac, _mm_set1_ps(0.5f))));
+	v_i32 = _mm_add_epi32(v_i32, _mm_castps_si128(_mm_cmple_ps(v_frac, _mm_set1_ps(-0.5f))));
+
+	return v_i32;
+}
+
+/*
+	Packed 24 bit: 4 samples (12 bytes) per 128 bit vector, loaded and stored as 8 + 4 bytes, so nothing is accessed past the last sample.
+	The 4 byte part goes through CopyMemory: the address is not aligned.
+*/
+
+PCMCONV_TARGET("sse2") static __m128i WINAPI i24_load_12_sse2(const BYTE *p_src)
+{
+	INT32 i32 = 0;
+
+	CopyMemory(&i32, &p_src[8u], 4u);
+	return _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*) p_src), _mm_cvtsi32_si128(i32));
+}
+
+PCMCONV_TARGET("sse2") static VOID WINAPI i24_store_12_sse2(BYTE *p_dst, __m128i v_packed)
+{
+	INT32 i32 = 0;
+
+	_mm_storel_epi64((__m128i*) p_dst, v_packed);
+
+	i32 = _mm_cvtsi128_si32(_mm_srli_si128(v_packed, 8));
+	CopyMemory(&p_dst[8u], &i32, 4u);
+	return;
+}
+
+/*
+	16 bit: 8 samples per step, packssdw saturates to the 16 bit range.
+	A tail shorter than a step goes through one zero padded step on the stack instead of the scalar version,
+	so the dithered version steps the generator lanes the same way on every path.
+*/
+
+PCMCONV_TARGET("sse2") static __m128 WINAPI f32_to_i16_scale_sse2(__m128 v_f32)
+{
+	v_f32 = _mm_min_ps(_mm_max_ps(v_f32, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+	return _mm_mul_ps(v_f32, _mm_set1_ps(PCMCONV_I16_FACTOR - 1.0f));
+}
+
+/*xorshift32 step on 4 lanes, returns the TPDF dither value of every lane.*/
+
+PCMCONV_TARGET("sse2") static __m128 WINAPI dither_tpdf_sse2(__m128i *p_state)
+{
+	__m128i v_x = *p_state;
+
+	v_x = _mm_xor_si128(v_x, _mm_slli_epi32(v_x, 13));
+	v_x = _mm_xor_si128(v_x, _mm_srli_epi32(v_x, 17));
+	v_x = _mm_xor_si128(v_x, _mm_slli_epi32(v_x, 5));
+
+	*p_state = v_x;
+
+	return _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(v_x, 16), _mm_and_si128(v_x, _mm_set1_epi32(0xffff)))), _mm_set1_ps(PCMCONV_DITHER_SCALE));
+}
+
+PCMCONV_TARGET("sse2") static VOID WINAPI f32_to_i16_sse2(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	FLOAT pad_f32[8] = {0.0f};
+	INT16 pad_i16[8];
+	const FLOAT *p_input = NULL;
+	__m128i *p_output = NULL;
+	ULONG_PTR n_tail = 0u;
+	ULONG_PTR n_sample = 0u;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample += 8u)
+	{
+		p_input = &p_src[n_sample];
+		p_output = (__m128i*) &p_dst[n_sample*2u];
+
+		if((n_sample + 8u) > n_samples)
+		{
+			n_tail = n_samples - n_sample;
+			CopyMemory(pad_f32, p_input, n_tail*sizeof(FLOAT));
+			p_input = pad_f32;
+			p_output = (__m128i*) pad_i16;
+		}
+
+		_mm_storeu_si128(p_output, _mm_packs_epi32(f32_round_i32_sse2(f32_to_i16_scale_sse2(_mm_loadu_ps(p_input))), f32_round_i32_sse2(f32_to_i16_scale_sse2(_mm_loadu_ps(&p_input[4u])))));
+	}
+
+	if(n_tail) CopyMemory(&p_dst[(n_samples - n_tail)*2u], pad_i16, n_tail*sizeof(INT16));
+	return;
+}
+
+PCMCONV_TARGET("sse2") static VOID WINAPI f32_to_i16_dither_sse2(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples, pcmconv_dither_t *p_dither)
+{
+	FLOAT pad_f32[8] = {0.0f};
+	INT16 pad_i16[8];
+	const FLOAT *p_input = NULL;
+	__m128i *p_output = NULL;
+	__m128i v_state_lo;
+	__m128i v_state_hi;
+	__m128 v_lo;
+	__m128 v_hi;
+	ULONG_PTR n_tail = 0u;
+	ULONG_PTR n_sample = 0u;
+
+	v_state_lo = _mm_loadu_si128((const __m128i*) &(p_dither->state[0u]));
+	v_state_hi = _mm_loadu_si128((const __m128i*) &(p_dither->state[4u]));
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample += 8u)
+	{
+		p_input = &p_src[n_sample];
+		p_output = (__m128i*) &p_dst[n_sample*2u];
+
+		if((n_sample + 8u) > n_samples)
+		{
+			n_tail = n_samples - n_sample;
+			CopyMemory(pad_f32, p_input, n_tail*sizeof(FLOAT));
+			p_input = pad_f32;
+			p_output = (__m128i*) pad_i16;
+		}
+
+		v_lo = _mm_add_ps(f32_to_i16_scale_sse2(_mm_loadu_ps(p_input)), dither_tpdf_sse2(&v_state_lo));
+		v_hi = _mm_add_ps(f32_to_i16_scale_sse2(_mm_loadu_ps(&p_input[4u])), dither_tpdf_sse2(&v_state_hi));
+
+		_mm_storeu_si128(p_output, _mm_packs_epi32(f32_round_i32_sse2(v_lo), f32_round_i32_sse2(v_hi)));
+	}
+
+	if(n_tail) CopyMemory(&p_dst[(n_samples - n_tail)*2u], pad_i16, n_tail*sizeof(INT16));
+
+	_mm_storeu_si128((__m128i*) &(p_dither->state[0u]), v_state_lo);
+	_mm_storeu_si128((__m128i*) &(p_dither->state[4u]), v_state_hi);
+	return;
+}
+
+PCMCONV_TARGET("sse2") static VOID WINAPI f32_to_i24in32_sse2(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	const __m128 v_max = _mm_set1_ps(1.0f);
+	const __m128 v_min = _mm_set1_ps(-1.0f);
+	const __m128 v_factor = _mm_set1_ps(PCMCONV_I24_FACTOR - 1.0f);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+		_mm_storeu_si128((__m128i*) &p_dst[n_sample*4u], _mm_slli_epi32(f32_round_i32_sse2(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&p_src[n_sample]), v_min), v_max), v_factor)), 8));
+
+	f32_to_i24in32_scalar(&p_dst[n_sample*4u], &p_src[n_sample], n_samples - n_sample);
+	return;
+}
+
+PCMCONV_TARGET("sse2") static VOID WINAPI i32_to_f32_sse2(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	const __m128 v_scale = _mm_set1_ps(1.0f/PCMCONV_I32_FACTOR);
+	ULONG_PTR n_sample = 0u;
+
+	/*Scaling by a power of 2: the multiply gives the same result as the division in the scalar version.*/
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+		_mm_storeu_ps(&p_dst[n_sample], _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) &p_src[n_sample*4u])), v_scale));
+
+	i32_to_f32_scalar(&p_dst[n_sample], &p_src[n_sample*4u], n_samples - n_sample);
+	return;
+}
+
+PCMCONV_TARGET("sse2") static __m128i WINAPI f64_round_i32_sse2(__m128d v_lo, __m128d v_hi)
+{
+	const __m128d v_sign = _mm_set1_pd(-0.0);
+	const __m128d v_half = _mm_set1_pd(0.5);
+
+	v_lo = _mm_add_pd(v_lo, _mm_or_pd(v_half, _mm_and_pd(v_lo, v_sign)));
+	v_hi = _mm_add_pd(v_hi, _mm_or_pd(v_half, _mm_and_pd(v_hi, v_sign)));
+
+	return _mm_unpacklo_epi64(_mm_cvttpd_epi32(v_lo), _mm_cvttpd_epi32(v_hi));
+}
+
+PCMCONV_TARGET("sse2") static VOID WINAPI f32_to_i32_sse2(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	const __m128 v_max = _mm_set1_ps(1.0f);
+	const __m128 v_min = _mm_set1_ps(-1.0f);
+	const __m128d v_factor = _mm_set1_pd(PCMCONV_I32_ENCODE_FACTOR);
+	__m128 v_f32;
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+	{
+		v_f32 = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&p_src[n_sample]), v_min), v_max);
+		_mm_storeu_si128((__m128i*) &p_dst[n_sample*4u], f64_round_i32_sse2(_mm_mul_pd(_mm_cvtps_pd(v_f32), v_factor), _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(v_f32, v_f32)), v_factor)));
+	}
+
+	f32_to_i32_scalar(&p_dst[n_sample*4u], &p_src[n_sample], n_samples - n_sample);
+	return;
+}
+
+PCMCONV_TARGET("sse2") static VOID WINAPI f32_to_float32_sse2(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	const __m128 v_max = _mm_set1_ps(1.0f);
+	const __m128 v_min = _mm_set1_ps(-1.0f);
+	FLOAT *p_output = (FLOAT*) p_dst;
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+		_mm_storeu_ps(&p_output[n_sample], _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&p_src[n_sample]), v_min), v_max));
+
+	f32_to_float32_scalar(&p_dst[n_sample*4u], &p_src[n_sample], n_samples - n_sample);
+	return;
+}
+
+PCMCONV_TARGET("sse2") static VOID WINAPI float64_to_f32_sse2(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	const DOUBLE *p_input = (const DOUBLE*) p_src;
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+		_mm_storeu_ps(&p_dst[n_sample], _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(&p_input[n_sample])), _mm_cvtpd_ps(_mm_loadu_pd(&p_input[n_sample + 2u]))));
+
+	float64_to_f32_scalar(&p_dst[n_sample], &p_src[n_sample*8u], n_samples - n_sample);
+	return;
+}
+
+PCMCONV_TARGET("sse2") static VOID WINAPI f32_to_float64_sse2(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	const __m128 v_max = _mm_set1_ps(1.0f);
+	const __m128 v_min = _mm_set1_ps(-1.0f);
+	DOUBLE *p_output = (DOUBLE*) p_dst;
+	__m128 v_f32;
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+	{
+		v_f32 = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&p_src[n_sample]), v_min), v_max);
+		_mm_storeu_pd(&p_output[n_sample], _mm_cvtps_pd(v_f32));
+		_mm_storeu_pd(&p_output[n_sample + 2u], _mm_cvtps_pd(_mm_movehl_ps(v_f32, v_f32)));
+	}
+
+	f32_to_float64_scalar(&p_dst[n_sample*8u], &p_src[n_sample], n_samples - n_sample);
+	return;
+}
+
+/*======================================================================================*/
+/*SSSE3 conversions (packed 24 bit, 4 samples per vector)*/
+
+/*
+	Unpack: the shuffle puts the 3 bytes of every sample in the upper 3 bytes of a 32 bit word (the low byte is zeroed),
+	then an arithmetic shift right by 8 sign-extends it.
+*/
+
+PCMCONV_TARGET("ssse3") static VOID WINAPI i24_to_f32_ssse3(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	const __m128i v_shuffle = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+	const __m128 v_scale = _mm_set1_ps(1.0f/PCMCONV_I24_FACTOR);
+	__m128i v_i32;
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+	{
+		v_i32 = _mm_srai_epi32(_mm_shuffle_epi8(i24_load_12_sse2(&p_src[n_sample*3u]), v_shuffle), 8);
+
+		/*Scaling by a power of 2: same result as the division in the scalar version.*/
+		_mm_storeu_ps(&p_dst[n_sample], _mm_mul_ps(_mm_cvtepi32_ps(v_i32), v_scale));
+	}
+
+	i24_to_f32_scalar(&p_dst[n_sample], &p_src[n_sample*3u], n_samples - n_sample);
+	return;
+}
+
+/*Pack: the reverse shuffle packs the low 3 bytes of every 32 bit word into the first 12 bytes.*/
+
+PCMCONV_TARGET("ssse3") static VOID WINAPI f32_to_i24_ssse3(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	const __m128i v_shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+	const __m128 v_max = _mm_set1_ps(1.0f);
+	const __m128 v_min = _mm_set1_ps(-1.0f);
+	const __m128 v_factor = _mm_set1_ps(PCMCONV_I24_FACTOR - 1.0f);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 4u) <= n_samples; n_sample += 4u)
+		i24_store_12_sse2(&p_dst[n_sample*3u], _mm_shuffle_epi8(f32_round_i32_sse2(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&p_src[n_sample]), v_min), v_max), v_factor)), v_shuffle));
+
+	f32_to_i24_scalar(&p_dst[n_sample*3u], &p_src[n_sample], n_samples - n_sample);
+	return;
+}
+
+/*======================================================================================*/
+/*AVX2 conversions (8 samples per vector)*/
+
+PCMCONV_TARGET("avx2") static __m256i WINAPI f32_round_i32_avx2(__m256 v_x)
+{
+	__m256i v_i32 = _mm256_cvttps_epi32(v_x);
+	__m256 v_frac = _mm256_sub_ps(v_x, _mm256_cvtepi32_ps(v_i32));
+
+	v_i32 = _mm256_sub_epi32(v_i32, _mm256_castps_si256(_mm256_cmp_ps(v_frac, _mm256_set1_ps(0.5f), _CMP_GE_OQ)));
+	v_i32 = _mm256_add_epi32(v_i32, _mm256_castps_si256(_mm256_cmp_ps(v_frac, _mm256_set1_ps(-0.5f), _CMP_LE_OQ)));
+
+	return v_i32;
+}
+
+/*16 bit: packssdw works within each 128 bit lane, the qword permute puts the 8 samples back in order.*/
+
+PCMCONV_TARGET("avx2") static __m128i WINAPI i32_pack_i16_avx2(__m256i v_i32)
+{
+	return _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packs_epi32(v_i32, v_i32), 0xd8));
+}
+
+PCMCONV_TARGET("avx2") static __m256 WINAPI f32_to_i16_scale_avx2(__m256 v_f32)
+{
+	v_f32 = _mm256_min_ps(_mm256_max_ps(v_f32, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+	return _mm256_mul_ps(v_f32, _mm256_set1_ps(PCMCONV_I16_FACTOR - 1.0f));
+}
+
+PCMCONV_TARGET("avx2") static __m256 WINAPI dither_tpdf_avx2(__m256i *p_state)
+{
+	__m256i v_x = *p_state;
+
+	v_x = _mm256_xor_si256(v_x, _mm256_slli_epi32(v_x, 13));
+	v_x = _mm256_xor_si256(v_x, _mm256_srli_epi32(v_x, 17));
+	v_x = _mm256_xor_si256(v_x, _mm256_slli_epi32(v_x, 5));
+
+	*p_state = v_x;
+
+	return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(v_x, 16), _mm256_and_si256(v_x, _mm256_set1_epi32(0xffff)))), _mm256_set1_ps(PCMCONV_DITHER_SCALE));
+}
+
+PCMCONV_TARGET("avx2") static VOID WINAPI f32_to_i16_avx2(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	FLOAT pad_f32[8] = {0.0f};
+	INT16 pad_i16[8];
+	const FLOAT *p_input = NULL;
+	__m128i *p_output = NULL;
+	ULONG_PTR n_tail = 0u;
+	ULONG_PTR n_sample = 0u;
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample += 8u)
+	{
+		p_input = &p_src[n_sample];
+		p_output = (__m128i*) &p_dst[n_sample*2u];
+
+		if((n_sample + 8u) > n_samples)
+		{
+			n_tail = n_samples - n_sample;
+			CopyMemory(pad_f32, p_input, n_tail*sizeof(FLOAT));
+			p_input = pad_f32;
+			p_output = (__m128i*) pad_i16;
+		}
+
+		_mm_storeu_si128(p_output, i32_pack_i16_avx2(f32_round_i32_avx2(f32_to_i16_scale_avx2(_mm256_loadu_ps(p_input)))));
+	}
+
+	if(n_tail) CopyMemory(&p_dst[(n_samples - n_tail)*2u], pad_i16, n_tail*sizeof(INT16));
+	return;
+}
+
+PCMCONV_TARGET("avx2") static VOID WINAPI f32_to_i16_dither_avx2(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples, pcmconv_dither_t *p_dither)
+{
+	FLOAT pad_f32[8] = {0.0f};
+	INT16 pad_i16[8];
+	const FLOAT *p_input = NULL;
+	__m128i *p_output = NULL;
+	__m256i v_state;
+	__m256 v_f32;
+	ULONG_PTR n_tail = 0u;
+	ULONG_PTR n_sample = 0u;
+
+	v_state = _mm256_loadu_si256((const __m256i*) p_dither->state);
+
+	for(n_sample = 0u; n_sample < n_samples; n_sample += 8u)
+	{
+		p_input = &p_src[n_sample];
+		p_output = (__m128i*) &p_dst[n_sample*2u];
+
+		if((n_sample + 8u) > n_samples)
+		{
+			n_tail = n_samples - n_sample;
+			CopyMemory(pad_f32, p_input, n_tail*sizeof(FLOAT));
+			p_input = pad_f32;
+			p_output = (__m128i*) pad_i16;
+		}
+
+		v_f32 = _mm256_add_ps(f32_to_i16_scale_avx2(_mm256_loadu_ps(p_input)), dither_tpdf_avx2(&v_state));
+
+		_mm_storeu_si128(p_output, i32_pack_i16_avx2(f32_round_i32_avx2(v_f32)));
+	}
+
+	if(n_tail) CopyMemory(&p_dst[(n_samples - n_tail)*2u], pad_i16, n_tail*sizeof(INT16));
+
+	_mm256_storeu_si256((__m256i*) p_dither->state, v_state);
+	return;
+}
+
+/*Packed 24 bit unpack: 8 samples (24 bytes) per vector, 4 samples (12 bytes) per 128 bit lane, same shuffle as the SSSE3 version in each lane.*/
+
+PCMCONV_TARGET("avx2") static VOID WINAPI i24_to_f32_avx2(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	const __m256i v_shuffle = _mm256_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+	const __m256 v_scale = _mm256_set1_ps(1.0f/PCMCONV_I24_FACTOR);
+	const BYTE *p_input = NULL;
+	__m256i v_i32;
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+	{
+		p_input = &p_src[n_sample*3u];
+
+		v_i32 = _mm256_inserti128_si256(_mm256_castsi128_si256(i24_load_12_sse2(p_input)), i24_load_12_sse2(&p_input[12u]), 1);
+		v_i32 = _mm256_srai_epi32(_mm256_shuffle_epi8(v_i32, v_shuffle), 8);
+
+		/*Scaling by a power of 2: same result as the division in the scalar version.*/
+		_mm256_storeu_ps(&p_dst[n_sample], _mm256_mul_ps(_mm256_cvtepi32_ps(v_i32), v_scale));
+	}
+
+	i24_to_f32_scalar(&p_dst[n_sample], &p_src[n_sample*3u], n_samples - n_sample);
+	return;
+}
+
+/*Packed 24 bit pack: same shuffle as the SSSE3 version in each lane.*/
+
+PCMCONV_TARGET("avx2") static VOID WINAPI f32_to_i24_avx2(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	const __m256i v_shuffle = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+	const __m256 v_max = _mm256_set1_ps(1.0f);
+	const __m256 v_min = _mm256_set1_ps(-1.0f);
+	const __m256 v_factor = _mm256_set1_ps(PCMCONV_I24_FACTOR - 1.0f);
+	BYTE *p_output = NULL;
+	__m256i v_packed;
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+	{
+		p_output = &p_dst[n_sample*3u];
+
+		v_packed = _mm256_shuffle_epi8(f32_round_i32_avx2(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&p_src[n_sample]), v_min), v_max), v_factor)), v_shuffle);
+
+		i24_store_12_sse2(p_output, _mm256_castsi256_si128(v_packed));
+		i24_store_12_sse2(&p_output[12u], _mm256_extracti128_si256(v_packed, 1));
+	}
+
+	f32_to_i24_scalar(&p_dst[n_sample*3u], &p_src[n_sample], n_samples - n_sample);
+	return;
+}
+
+PCMCONV_TARGET("avx2") static VOID WINAPI f32_to_i24in32_avx2(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	const __m256 v_max = _mm256_set1_ps(1.0f);
+	const __m256 v_min = _mm256_set1_ps(-1.0f);
+	const __m256 v_factor = _mm256_set1_ps(PCMCONV_I24_FACTOR - 1.0f);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+		_mm256_storeu_si256((__m256i*) &p_dst[n_sample*4u], _mm256_slli_epi32(f32_round_i32_avx2(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&p_src[n_sample]), v_min), v_max), v_factor)), 8));
+
+	f32_to_i24in32_scalar(&p_dst[n_sample*4u], &p_src[n_sample], n_samples - n_sample);
+	return;
+}
+
+PCMCONV_TARGET("avx2") static VOID WINAPI i32_to_f32_avx2(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	const __m256 v_scale = _mm256_set1_ps(1.0f/PCMCONV_I32_FACTOR);
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+		_mm256_storeu_ps(&p_dst[n_sample], _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i*) &p_src[n_sample*4u])), v_scale));
+
+	i32_to_f32_scalar(&p_dst[n_sample], &p_src[n_sample*4u], n_samples - n_sample);
+	return;
+}
+
+PCMCONV_TARGET("avx2") static __m128i WINAPI f64_round_i32_avx2(__m256d v_f64)
+{
+	v_f64 = _mm256_add_pd(v_f64, _mm256_or_pd(_mm256_set1_pd(0.5), _mm256_and_pd(v_f64, _mm256_set1_pd(-0.0))));
+	return _mm256_cvttpd_epi32(v_f64);
+}
+
+PCMCONV_TARGET("avx2") static VOID WINAPI f32_to_i32_avx2(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	const __m256 v_max = _mm256_set1_ps(1.0f);
+	const __m256 v_min = _mm256_set1_ps(-1.0f);
+	const __m256d v_factor = _mm256_set1_pd(PCMCONV_I32_ENCODE_FACTOR);
+	__m256 v_f32;
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+	{
+		v_f32 = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&p_src[n_sample]), v_min), v_max);
+		_mm_storeu_si128((__m128i*) &p_dst[n_sample*4u], f64_round_i32_avx2(_mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(v_f32)), v_factor)));
+		_mm_storeu_si128((__m128i*) &p_dst[(n_sample + 4u)*4u], f64_round_i32_avx2(_mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(v_f32, 1)), v_factor)));
+	}
+
+	f32_to_i32_scalar(&p_dst[n_sample*4u], &p_src[n_sample], n_samples - n_sample);
+	return;
+}
+
+PCMCONV_TARGET("avx2") static VOID WINAPI f32_to_float32_avx2(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	const __m256 v_max = _mm256_set1_ps(1.0f);
+	const __m256 v_min = _mm256_set1_ps(-1.0f);
+	FLOAT *p_output = (FLOAT*) p_dst;
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+		_mm256_storeu_ps(&p_output[n_sample], _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&p_src[n_sample]), v_min), v_max));
+
+	f32_to_float32_scalar(&p_dst[n_sample*4u], &p_src[n_sample], n_samples - n_sample);
+	return;
+}
+
+PCMCONV_TARGET("avx2") static VOID WINAPI float64_to_f32_avx2(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	const DOUBLE *p_input = (const DOUBLE*) p_src;
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+		_mm256_storeu_ps(&p_dst[n_sample], _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(_mm256_loadu_pd(&p_input[n_sample]))), _mm256_cvtpd_ps(_mm256_loadu_pd(&p_input[n_sample + 4u])), 1));
+
+	float64_to_f32_scalar(&p_dst[n_sample], &p_src[n_sample*8u], n_samples - n_sample);
+	return;
+}
+
+PCMCONV_TARGET("avx2") static VOID WINAPI f32_to_float64_avx2(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	const __m256 v_max = _mm256_set1_ps(1.0f);
+	const __m256 v_min = _mm256_set1_ps(-1.0f);
+	DOUBLE *p_output = (DOUBLE*) p_dst;
+	__m256 v_f32;
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 8u) <= n_samples; n_sample += 8u)
+	{
+		v_f32 = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&p_src[n_sample]), v_min), v_max);
+		_mm256_storeu_pd(&p_output[n_sample], _mm256_cvtps_pd(_mm256_castps256_ps128(v_f32)));
+		_mm256_storeu_pd(&p_output[n_sample + 4u], _mm256_cvtps_pd(_mm256_extractf128_ps(v_f32, 1)));
+	}
+
+	f32_to_float64_scalar(&p_dst[n_sample*8u], &p_src[n_sample], n_samples - n_sample);
+	return;
+}
+
+/*======================================================================================*/
+/*AVX-512 VBMI conversions (packed 24 bit, 16 samples per vector)*/
+
+/*
+	vpermb moves bytes across the whole 512 bit vector: one permute unpacks or packs 16 samples (48 bytes).
+	The 48 bytes are loaded and stored with a byte mask, so nothing is accessed past the last sample.
+*/
+
+#define PCMCONV_I24_AVX512_BYTEMASK 0x0000ffffffffffffULL
+
+/*Unpack: byte 4k + 1 + b of the result is byte 3k + b of the input, byte 4k is zeroed (mask 0xeeee...).*/
+
+static const BYTE PCMCONV_I24_UNPACK_PERM[64] = {
+	0, 0, 1, 2, 0, 3, 4, 5, 0, 6, 7, 8, 0, 9, 10, 11, 0, 12, 13, 14, 0, 15, 16, 17, 0, 18, 19, 20, 0, 21, 22, 23,
+	0, 24, 25, 26, 0, 27, 28, 29, 0, 30, 31, 32, 0, 33, 34, 35, 0, 36, 37, 38, 0, 39, 40, 41, 0, 42, 43, 44, 0, 45, 46, 47
+};
+
+/*Pack: byte 3k + b of the result is byte 4k + b of the input, for the first 48 bytes.*/
+
+static const BYTE PCMCONV_I24_PACK_PERM[64] = {
+	0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 16, 17, 18, 20, 21, 22, 24, 25, 26, 28, 29, 30, 32, 33, 34, 36, 37, 38, 40, 41,
+	42, 44, 45, 46, 48, 49, 50, 52, 53, 54, 56, 57, 58, 60, 61, 62, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+PCMCONV_TARGET("avx512f,avx512bw,avx512vbmi") static __m512i WINAPI f32_round_i32_avx512(__m512 v_x)
+{
+	__m512i v_i32 = _mm512_cvttps_epi32(v_x);
+	__m512 v_frac = _mm512_sub_ps(v_x, _mm512_cvtepi32_ps(v_i32));
+
+	v_i32 = _mm512_mask_add_epi32(v_i32, _mm512_cmp_ps_mask(v_frac, _mm512_set1_ps(0.5f), _CMP_GE_OQ), v_i32, _mm512_set1_epi32(1));
+	v_i32 = _mm512_mask_sub_epi32(v_i32, _mm512_cmp_ps_mask(v_frac, _mm512_set1_ps(-0.5f), _CMP_LE_OQ), v_i32, _mm512_set1_epi32(1));
+
+	return v_i32;
+}
+
+PCMCONV_TARGET("avx512f,avx512bw,avx512vbmi") static VOID WINAPI i24_to_f32_avx512(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	const __m512i v_perm = _mm512_loadu_si512((const VOID*) PCMCONV_I24_UNPACK_PERM);
+	const __m512 v_scale = _mm512_set1_ps(1.0f/PCMCONV_I24_FACTOR);
+	__m512i v_i32;
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 16u) <= n_samples; n_sample += 16u)
+	{
+		v_i32 = _mm512_maskz_loadu_epi8(PCMCONV_I24_AVX512_BYTEMASK, &p_src[n_sample*3u]);
+		v_i32 = _mm512_srai_epi32(_mm512_maskz_permutexvar_epi8(0xeeeeeeeeeeeeeeeeULL, v_perm, v_i32), 8);
+
+		_mm512_storeu_ps(&p_dst[n_sample], _mm512_mul_ps(_mm512_cvtepi32_ps(v_i32), v_scale));
+	}
+
+	i24_to_f32_avx2(&p_dst[n_sample], &p_src[n_sample*3u], n_samples - n_sample);
+	return;
+}
+
+PCMCONV_TARGET("avx512f,avx512bw,avx512vbmi") static VOID WINAPI f32_to_i24_avx512(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	const __m512i v_perm = _mm512_loadu_si512((const VOID*) PCMCONV_I24_PACK_PERM);
+	const __m512 v_max = _mm512_set1_ps(1.0f);
+	const __m512 v_min = _mm512_set1_ps(-1.0f);
+	const __m512 v_factor = _mm512_set1_ps(PCMCONV_I24_FACTOR - 1.0f);
+	__m512i v_i32;
+	ULONG_PTR n_sample = 0u;
+
+	for(; (n_sample + 16u) <= n_samples; n_sample += 16u)
+	{
+		v_i32 = f32_round_i32_avx512(_mm512_mul_ps(_mm512_min_ps(_mm512_max_ps(_mm512_loadu_ps(&p_src[n_sample]), v_min), v_max), v_factor));
+
+		_mm512_mask_storeu_epi8(&p_dst[n_sample*3u], PCMCONV_I24_AVX512_BYTEMASK, _mm512_permutexvar_epi8(v_perm, v_i32));
+	}
+
+	f32_to_i24_avx2(&p_dst[n_sample*3u], &p_src[n_sample], n_samples - n_sample);
+	return;
+}
+
+#endif /*PCMCONV_X86*/
+
+/*======================================================================================*/
+/*Conversion tables*/
+
+static const pcmconv_table_t PCMCONV_TABLE_SCALAR = {
+	.i16_to_f32 = &i16_to_f32_scalar,
+	.f32_to_i16 = &f32_to_i16_scalar,
+	.f32_to_i16_dither = &f32_to_i16_dither_scalar,
+	.i24_to_f32 = &i24_to_f32_scalar,
+	.f32_to_i24 = &f32_to_i24_scalar,
+	.f32_to_i24in32 = &f32_to_i24in32_scalar,
+	.i32_to_f32 = &i32_to_f32_scalar,
+	.f32_to_i32 = &f32_to_i32_scalar,
+	.f32_to_float32 = &f32_to_float32_scalar,
+	.float64_to_f32 = &float64_to_f32_scalar,
+	.f32_to_float64 = &f32_to_float64_scalar
+};
+
+#ifdef PCMCONV_X86
+
+/*Packed 24 bit needs a byte shuffle (SSSE3 pshufb): the SSE2 table keeps the scalar versions for it, the SSSE3 table has its own.*/
+
+static const pcmconv_table_t PCMCONV_TABLE_SSE2 = {
+	.i16_to_f32 = &i16_to_f32_scalar,
+	.f32_to_i16 = &f32_to_i16_sse2,
+	.f32_to_i16_dither = &f32_to_i16_dither_sse2,
+	.i24_to_f32 = &i24_to_f32_scalar,
+	.f32_to_i24 = &f32_to_i24_scalar,
+	.f32_to_i24in32 = &f32_to_i24in32_sse2,
+	.i32_to_f32 = &i32_to_f32_sse2,
+	.f32_to_i32 = &f32_to_i32_sse2,
+	.f32_to_float32 = &f32_to_float32_sse2,
+	.float64_to_f32 = &float64_to_f32_sse2,
+	.f32_to_float64 = &f32_to_float64_sse2
+};
+
+static const pcmconv_table_t PCMCONV_TABLE_SSSE3 = {
+	.i16_to_f32 = &i16_to_f32_scalar,
+	.f32_to_i16 = &f32_to_i16_sse2,
+	.f32_to_i16_dither = &f32_to_i16_dither_sse2,
+	.i24_to_f32 = &i24_to_f32_ssse3,
+	.f32_to_i24 = &f32_to_i24_ssse3,
+	.f32_to_i24in32 = &f32_to_i24in32_sse2,
+	.i32_to_f32 = &i32_to_f32_sse2,
+	.f32_to_i32 = &f32_to_i32_sse2,
+	.f32_to_float32 = &f32_to_float32_sse2,
+	.float64_to_f32 = &float64_to_f32_sse2,
+	.f32_to_float64 = &f32_to_float64_sse2
+};
+
+static const pcmconv_table_t PCMCONV_TABLE_AVX2 = {
+	.i16_to_f32 = &i16_to_f32_scalar,
+	.f32_to_i16 = &f32_to_i16_avx2,
+	.f32_to_i16_dither = &f32_to_i16_dither_avx2,
+	.i24_to_f32 = &i24_to_f32_avx2,
+	.f32_to_i24 = &f32_to_i24_avx2,
+	.f32_to_i24in32 = &f32_to_i24in32_avx2,
+	.i32_to_f32 = &i32_to_f32_avx2,
+	.f32_to_i32 = &f32_to_i32_avx2,
+	.f32_to_float32 = &f32_to_float32_avx2,
+	.float64_to_f32 = &float64_to_f32_avx2,
+	.f32_to_float64 = &f32_to_float64_avx2
+};
+
+/*
+	AVX-512 with VBMI: vpermb for packed 24 bit. The other conversions are bound by memory bandwidth, not by the vector width,
+	so they keep the AVX2 versions (AVX-512 without VBMI uses the AVX2 table as a whole).
+*/
+
+static const pcmconv_table_t PCMCONV_TABLE_AVX512VBMI = {
+	.i16_to_f32 = &i16_to_f32_scalar,
+	.f32_to_i16 = &f32_to_i16_avx2,
+	.f32_to_i16_dither = &f32_to_i16_dither_avx2,
+	.i24_to_f32 = &i24_to_f32_avx512,
+	.f32_to_i24 = &f32_to_i24_avx512,
+	.f32_to_i24in32 = &f32_to_i24in32_avx2,
+	.i32_to_f32 = &i32_to_f32_avx2,
+	.f32_to_i32 = &f32_to_i32_avx2,
+	.f32_to_float32 = &f32_to_float32_avx2,
+	.float64_to_f32 = &float64_to_f32_avx2,
+	.f32_to_float64 = &f32_to_float64_avx2
+};
+
+#endif /*PCMCONV_X86*/
+
+static const pcmconv_table_t *volatile p_pcmconv_table = NULL;
+
+/*Resolved on the first call. Concurrent first calls resolve the same table, so the race is harmless.*/
+
+static const pcmconv_table_t* WINAPI pcmconv_get_table(VOID)
+{
+	const pcmconv_table_t *p_table = p_pcmconv_table;
+	UINT32 extensions = 0u;
+
+	if(p_table != NULL) return p_table;
+
+	p_table = &PCMCONV_TABLE_SCALAR;
+
+#ifdef PCMCONV_X86
+	extensions = dspkernel_detect_extensions();
+
+	switch(dspkernel_select_isa(DSPKERNEL_ISA_AUTO))
+	{
+		case DSPKERNEL_ISA_SSE2:
+			if(extensions & DSPKERNEL_EXT_SSSE3) p_table = &PCMCONV_TABLE_SSSE3;
+			else p_table = &PCMCONV_TABLE_SSE2;
+			break;
+
+		case DSPKERNEL_ISA_AVX2:
+			p_table = &PCMCONV_TABLE_AVX2;
+			break;
+
+		case DSPKERNEL_ISA_AVX512:
+			if(extensions & DSPKERNEL_EXT_AVX512VBMI) p_table = &PCMCONV_TABLE_AVX512VBMI;
+			else p_table = &PCMCONV_TABLE_AVX2;
+			break;
+	}
+#endif
+
+	p_pcmconv_table = p_table;
+	return p_table;
+}
+
+/*======================================================================================*/
+
+VOID WINAPI pcmconv_i16_to_f32(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	pcmconv_get_table()->i16_to_f32(p_dst, p_src, n_samples);
+	return;
+}
+
+VOID WINAPI pcmconv_f32_to_i16(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	pcmconv_get_table()->f32_to_i16(p_dst, p_src, n_samples);
+	return;
+}
+
+VOID WINAPI pcmconv_f32_to_i16_dither(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples, pcmconv_dither_t *p_dither)
+{
+	pcmconv_get_table()->f32_to_i16_dither(p_dst, p_src, n_samples, p_dither);
+	return;
+}
+
+/*Lane seeds are spread with a 32 bit integer hash. xorshift32 never leaves state 0, so a lane that hashes to 0 is moved off it.*/
+
+VOID WINAPI pcmconv_dither_init(pcmconv_dither_t *p_dither, UINT32 seed)
+{
+	ULONG_PTR n_lane = 0u;
+	UINT32 x = 0u;
+
+	for(n_lane = 0u; n_lane < PCMCONV_DITHER_N_LANES; n_lane++)
+	{
+		x = seed + ((UINT32) n_lane)*0x9e3779b9u;
+
+		x ^= (x >> 16);
+		x *= 0x85ebca6bu;
+		x ^= (x >> 13);
+		x *= 0xc2b2ae35u;
+		x ^= (x >> 16);
+
+		if(!x) x = ((UINT32) n_lane) + 1u;
+
+		p_dither->state[n_lane] = x;
+	}
+
+	return;
+}
+
+VOID WINAPI pcmconv_i24_to_f32(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	pcmconv_get_table()->i24_to_f32(p_dst, p_src, n_samples);
+	return;
+}
+
+VOID WINAPI pcmconv_f32_to_i24(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	pcmconv_get_table()->f32_to_i24(p_dst, p_src, n_samples);
+	return;
+}
+
+VOID WINAPI pcmconv_f32_to_i24in32(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	pcmconv_get_table()->f32_to_i24in32(p_dst, p_src, n_samples);
+	return;
+}
+
+VOID WINAPI pcmconv_i32_to_f32(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	pcmconv_get_table()->i32_to_f32(p_dst, p_src, n_samples);
+	return;
+}
+
+VOID WINAPI pcmconv_f32_to_i32(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	pcmconv_get_table()->f32_to_i32(p_dst, p_src, n_samples);
+	return;
+}
+
+/*Same sample format as AudioDelay: no conversion.*/
+
+VOID WINAPI pcmconv_float32_to_f32(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	CopyMemory(p_dst, p_src, n_samples*sizeof(FLOAT));
+	return;
+}
+
+VOID WINAPI pcmconv_f32_to_float32(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	pcmconv_get_table()->f32_to_float32(p_dst, p_src, n_samples);
+	return;
+}
+
+VOID WINAPI pcmconv_float64_to_f32(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples)
+{
+	pcmconv_get_table()->float64_to_f32(p_dst, p_src, n_samples);
+	return;
+}
+
+VOID WINAPI pcmconv_f32_to_float64(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples)
+{
+	pcmconv_get_table()->f32_to_float64(p_dst, p_src, n_samples);
+	return;
+}
@@ -0,0 +1,70 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*
+	PCM sample format conversion (file/device samples to and from the FLOAT samples used by AudioDelay).
+
+	Integer decoding divides by the full scale value (32768 for 16 bit, 8388608 for 24 bit, 2147483648 for 32 bit).
+	Encoding clamps to [-1.0, 1.0], multiplies by (full scale - 1) and rounds to the nearest integer.
+	Float decoding is a plain copy (32 bit) or a conversion to single precision (64 bit). Float encoding clamps to [-1.0, 1.0].
+	NaN samples are encoded as -1.0.
+	Playback (AudioPB) and offline rendering (AudioRender) use the same conversions, so both produce the same samples.
+
+	Like the DSP kernels (see dspkernel.hpp), every conversion has a scalar version and SIMD versions with the same output,
+	chosen on the first call with dspkernel_select_isa(DSPKERNEL_ISA_AUTO).
+	The same output needs the scalar code to round to single precision at every step, as SSE math does: x87 math (32 bit builds
+	without -mfpmath=sse) keeps extra precision in the scaling and the dither add. build32.bat compiles with -msse2 -mfpmath=sse.
+*/
+
+#ifndef PCMCONV_HPP
+#define PCMCONV_HPP
+
+#include "globldef.h"
+
+#define PCMCONV_DITHER_N_LANES 8U
+
+struct _pcmconv_dither {
+	UINT32 state[PCMCONV_DITHER_N_LANES];
+};
+
+typedef struct _pcmconv_dither pcmconv_dither_t;
+
+/*16 bit signed little endian (2 bytes per sample)*/
+extern VOID WINAPI pcmconv_i16_to_f32(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples);
+extern VOID WINAPI pcmconv_f32_to_i16(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples);
+
+/*
+	16 bit with TPDF dither: adds triangular noise of +-1 LSB peak before rounding, which turns the rounding error into
+	a constant noise floor instead of distortion that follows the signal (audible on quiet passages and fades).
+	The noise comes from PCMCONV_DITHER_N_LANES xorshift32 generators run side by side in vector registers.
+	p_dither keeps the generator state between calls, set it up once with pcmconv_dither_init().
+	Output is the same on every ISA level for the same seed and the same sequence of calls.
+*/
+extern VOID WINAPI pcmconv_f32_to_i16_dither(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples, pcmconv_dither_t *p_dither);
+extern VOID WINAPI pcmconv_dither_init(pcmconv_dither_t *p_dither, UINT32 seed);
+
+/*24 bit signed little endian, packed (3 bytes per sample)*/
+extern VOID WINAPI pcmconv_i24_to_f32(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples);
+extern VOID WINAPI pcmconv_f32_to_i24(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples);
+
+/*24 bit, left justified in a 32 bit signed little endian container (4 bytes per sample, low byte 0). Exclusive mode devices take 24 bit audio this way.*/
+extern VOID WINAPI pcmconv_f32_to_i24in32(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples);
+
+/*32 bit signed little endian (4 bytes per sample)*/
+extern VOID WINAPI pcmconv_i32_to_f32(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples);
+extern VOID WINAPI pcmconv_f32_to_i32(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples);
+
+/*32 bit IEEE float (4 bytes per sample)*/
+extern VOID WINAPI pcmconv_float32_to_f32(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples);
+extern VOID WINAPI pcmconv_f32_to_float32(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples);
+
+/*64 bit IEEE float (8 bytes per sample)*/
+extern VOID WINAPI pcmconv_float64_to_f32(FLOAT *p_dst, const BYTE *p_src, ULONG_PTR n_samples);
+extern VOID WINAPI pcmconv_f32_to_float64(BYTE *p_dst, const FLOAT *p_src, ULONG_PTR n_samples);
+
+#endif /*PCMCONV_HPP*/
@@ -0,0 +1,209 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*
+	Offline render tool (console application, no GUI, no audio device).
+	Runs a WAVE file through the delay effect as fast as possible and writes the result to a new WAVE file.
+
+	Usage: render <input.wav> <output.wav> [options]
+
+	Options:
+	--dry <amp>          dry input amplitude (default 1.0)
+	--out <amp>          output amplitude (default 1.0)
+	--ff <delay>:<amp>   adds a feedforward delay tap (delay time in frames), up to __RENDER_DELAY_N_FFCH taps
+	--fb <delay>:<amp>   adds a feedback delay tap (delay time in frames), up to __RENDER_DELAY_N_FBCH taps
+	--tail <ms>          renders this much past the end of the input (default 0)
+	--segment <frames>   DSP block size (default __RENDER_SEGMENT_SIZE_FRAMES)
+	--readblock <bytes>  input file read block size (default 1 MiB)
+	--threads <n>        worker threads for parallel rendering (default 0: one per CPU; 1: sequential)
+
+	Presets with no feedback taps and no modulation are rendered in parallel (see AudioRender.hpp).
+
+	Prints the render throughput (frames per second, and how many times faster than real-time) when done.
+*/
+
+#include "globldef.h"
+#include "cstrdef.h"
+#include "strdef.hpp"
+
+#include "AudioRender.hpp"
+#include "wavfile.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define __RENDER_SEGMENT_SIZE_FRAMES 1024U
+#define __RENDER_DELAY_BUFFER_SIZE_FRAMES 65536U
+#define __RENDER_DELAY_N_FFCH 4U
+#define __RENDER_DELAY_N_FBCH 4U
+
+#define PRINTBUF_SIZE_CHARS 1024U
+
+static __declspec(align(PTR_SIZE_BYTES)) TCHAR filein_dir[TEXTBUF_SIZE_CHARS] = {'\0'};
+static __declspec(align(PTR_SIZE_BYTES)) TCHAR fileout_dir[TEXTBUF_SIZE_CHARS] = {'\0'};
+
+static __declspec(align(PTR_SIZE_BYTES)) audiodelay_fx_params_t p_ff_params[__RENDER_DELAY_N_FFCH];
+static __declspec(align(PTR_SIZE_BYTES)) audiodelay_fx_params_t p_fb_params[__RENDER_DELAY_N_FBCH];
+
+static __declspec(align(PTR_SIZE_BYTES)) audiorender_params_t render_params;
+static __declspec(align(PTR_SIZE_BYTES)) audiorender_preset_t render_preset;
+
+static BOOL WINAPI parse_args(INT argc, CHAR **argv);
+static BOOL WINAPI parse_tap(const CHAR *arg, audiodelay_fx_params_t *p_fx);
+static VOID WINAPI print_error(const TCHAR *text);
+
+INT main(INT argc, CHAR **argv)
+{
+	AudioRender *p_render = NULL;
+	audiorender_stats_t stats;
+	INT ret = 1;
+
+	p_processheap = GetProcessHeap();
+	if(p_processheap == NULL)
+	{
+		print_error(TEXT("Error: Failed to Retrieve Process Heap."));
+		return 1;
+	}
+
+	if(!parse_args(argc, argv))
+	{
+		fputs("Usage: render <input.wav> <output.wav> [--dry <amp>] [--out <amp>] [--ff <delay>:<amp>]... [--fb <delay>:<amp>]... [--tail <ms>] [--segment <frames>] [--readblock <bytes>] [--threads <n>]\n", stderr);
+		return 1;
+	}
+
+	p_render = new AudioRender(&render_params);
+	if(p_render == NULL)
+	{
+		print_error(TEXT("Error: failed to create render object instance."));
+		return 1;
+	}
+
+	if(!p_render->initialize())
+	{
+		print_error(p_render->getLastErrorMessage().c_str());
+		goto _l_main_exit;
+	}
+
+	if(!p_render->setPreset(&render_preset))
+	{
+		print_error(p_render->getLastErrorMessage().c_str());
+		goto _l_main_exit;
+	}
+
+	printf("Rendering %llu frames (%lu Hz, %lu channels, %lu bit %s)...\n", (unsigned long long) p_render->getOutputSizeFrames(), (unsigned long) p_render->getSampleRate(), (unsigned long) p_render->getChannelCount(), (unsigned long) p_render->getBitDepth(), (p_render->getFormatTag() == WAVFILE_FORMAT_IEEE_FLOAT) ? "float" : "PCM");
+
+	if(!p_render->runRender())
+	{
+		print_error(p_render->getLastErrorMessage().c_str());
+		goto _l_main_exit;
+	}
+
+	p_render->getRenderStats(&stats);
+
+	printf("Done: %llu frames in %.3f s (%lu threads)\n", (unsigned long long) stats.n_frames, stats.time_s, (unsigned long) stats.n_threads);
+	printf("Throughput: %.0f frames/s (%.1fx real-time)\n", stats.frames_per_s, stats.realtime_factor);
+
+	ret = 0;
+
+_l_main_exit:
+	delete p_render;
+	return ret;
+}
+
+static BOOL WINAPI parse_args(INT argc, CHAR **argv)
+{
+	INT n_arg = 0;
+	ULONG_PTR n_ff = 0u;
+	ULONG_PTR n_fb = 0u;
+	ULONG_PTR delay_max = 0u;
+	ULONG_PTR delay_buffer_size = 0u;
+
+	if(argc < 3) return FALSE;
+
+	ZeroMemory(&render_params, sizeof(audiorender_params_t));
+	ZeroMemory(&render_preset, sizeof(audiorender_preset_t));
+	ZeroMemory(p_ff_params, sizeof(p_ff_params));
+	ZeroMemory(p_fb_params, sizeof(p_fb_params));
+
+	cstr_copy_char_to_tchar(argv[1], filein_dir, TEXTBUF_SIZE_CHARS);
+	cstr_copy_char_to_tchar(argv[2], fileout_dir, TEXTBUF_SIZE_CHARS);
+
+	render_params.filein_dir = filein_dir;
+	render_params.fileout_dir = fileout_dir;
+	render_params.segment_size_frames = __RENDER_SEGMENT_SIZE_FRAMES;
+	render_params.n_ff_delays = __RENDER_DELAY_N_FFCH;
+	render_params.n_fb_delays = __RENDER_DELAY_N_FBCH;
+	render_params.delay_xfade_size_frames = 0u; /*Parameters never change during a render: no crossfades.*/
+
+	render_preset.dryinput_amp = 1.0f;
+	render_preset.output_amp = 1.0f;
+	render_preset.p_ff_params = p_ff_params;
+	render_preset.p_fb_params = p_fb_params;
+
+	for(n_arg = 3; n_arg < argc; n_arg++)
+	{
+		if((n_arg + 1) >= argc) return FALSE;
+
+		if(!strcmp(argv[n_arg], "--dry")) render_preset.dryinput_amp = (FLOAT) atof(argv[n_arg + 1]);
+		else if(!strcmp(argv[n_arg], "--out")) render_preset.output_amp = (FLOAT) atof(argv[n_arg + 1]);
+		else if(!strcmp(argv[n_arg], "--ff"))
+		{
+			if(n_ff >= __RENDER_DELAY_N_FFCH) return FALSE;
+			if(!parse_tap(argv[n_arg + 1], &p_ff_params[n_ff])) return FALSE;
+			if(p_ff_params[n_ff].delay > delay_max) delay_max = (ULONG_PTR) p_ff_params[n_ff].delay;
+			n_ff++;
+		}
+		else if(!strcmp(argv[n_arg], "--fb"))
+		{
+			if(n_fb >= __RENDER_DELAY_N_FBCH) return FALSE;
+			if(!parse_tap(argv[n_arg + 1], &p_fb_params[n_fb])) return FALSE;
+			if(p_fb_params[n_fb].delay > delay_max) delay_max = (ULONG_PTR) p_fb_params[n_fb].delay;
+			n_fb++;
+		}
+		else if(!strcmp(argv[n_arg], "--tail")) render_params.tail_size_ms = (ULONG_PTR) strtoul(argv[n_arg + 1], NULL, 10);
+		else if(!strcmp(argv[n_arg], "--segment")) render_params.segment_size_frames = (ULONG_PTR) strtoul(argv[n_arg + 1], NULL, 10);
+		else if(!strcmp(argv[n_arg], "--readblock")) render_params.readblock_size_bytes = (ULONG_PTR) strtoul(argv[n_arg + 1], NULL, 10);
+		else if(!strcmp(argv[n_arg], "--threads")) render_params.n_threads = (ULONG_PTR) strtoul(argv[n_arg + 1], NULL, 10);
+		else return FALSE;
+
+		n_arg++;
+	}
+
+	/*The delay buffer must hold the longest delay time.*/
+	delay_buffer_size = __RENDER_DELAY_BUFFER_SIZE_FRAMES;
+	if(delay_max >= delay_buffer_size) delay_buffer_size = _get_closest_power2_ceil(delay_max + 1u);
+
+	render_params.delay_buffer_size_frames = delay_buffer_size;
+
+	return TRUE;
+}
+
+static BOOL WINAPI parse_tap(const CHAR *arg, audiodelay_fx_params_t *p_fx)
+{
+	CHAR *p_end = NULL;
+	ULONG delay = 0u;
+
+	delay = strtoul(arg, &p_end, 10);
+	if((p_end == arg) || (*p_end != ':')) return FALSE;
+
+	p_fx->delay = (UINT32) delay;
+	p_fx->amp = (FLOAT) atof(&p_end[1]);
+
+	return TRUE;
+}
+
+static VOID WINAPI print_error(const TCHAR *text)
+{
+	CHAR printbuf[PRINTBUF_SIZE_CHARS];
+
+	cstr_copy_tchar_to_char(text, printbuf, PRINTBUF_SIZE_CHARS);
+
+	fputs(printbuf, stderr);
+	fputs("\n", stderr);
+	return;
+}
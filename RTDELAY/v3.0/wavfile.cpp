@@ -0,0 +1,476 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+#include "wavfile.hpp"
+
+/*Chunk size value meaning "see ds64" (RF64/BW64), or unknown size (file still being written).*/
+#define WAVFILE_SIZE_32_UNKNOWN 0xffffffffu
+
+#define WAVFILE_DS64_SIZE_MIN 28u
+#define WAVFILE_DS64_TABLE_ENTRY_SIZE 12u
+#define WAVFILE_DS64_TABLE_N_ENTRIES_MAX 16u
+
+#define WAVFILE_FMT_SIZE_MIN 16u
+#define WAVFILE_FMT_SIZE_EXTENSIBLE 40u
+
+struct _wavfile_ds64 {
+	ULONG64 data_size;
+	ULONG_PTR n_entries;
+	BYTE p_entry_id[WAVFILE_DS64_TABLE_N_ENTRIES_MAX][4u];
+	ULONG64 p_entry_size[WAVFILE_DS64_TABLE_N_ENTRIES_MAX];
+};
+
+typedef struct _wavfile_ds64 wavfile_ds64_t;
+
+/*Last 12 bytes of the KSDATAFORMAT_SUBTYPE_... GUIDs ({xxxxxxxx-0000-0010-8000-00aa00389b71}), the first 4 are the format tag.*/
+static const BYTE WAVFILE_SUBTYPE_GUID_TAIL[12u] = {0x00u, 0x00u, 0x10u, 0x00u, 0x80u, 0x00u, 0x00u, 0xaau, 0x00u, 0x38u, 0x9bu, 0x71u};
+
+static BOOL WINAPI wavfile_parse_ds64(wavfile_read_proc_t pf_read, VOID *p_context, ULONG64 pos, ULONG64 chunk_size, wavfile_ds64_t *p_ds64, __string *p_err_msg);
+static BOOL WINAPI wavfile_parse_fmt(wavfile_read_proc_t pf_read, VOID *p_context, ULONG64 pos, ULONG64 chunk_size, wavfile_info_t *p_info, __string *p_err_msg);
+static BOOL WINAPI wavfile_write_extensible(const wavfile_info_t *p_info);
+static BOOL WINAPI wavfile_compare_signature(const CHAR *auth, const BYTE *buf);
+static UINT16 WINAPI wavfile_get_u16(const BYTE *p_src);
+static UINT32 WINAPI wavfile_get_u32(const BYTE *p_src);
+static ULONG64 WINAPI wavfile_get_u64(const BYTE *p_src);
+static VOID WINAPI wavfile_put_u16(BYTE *p_dst, UINT16 value);
+static VOID WINAPI wavfile_put_u32(BYTE *p_dst, UINT32 value);
+static VOID WINAPI wavfile_put_u64(BYTE *p_dst, ULONG64 value);
+
+BOOL WINAPI wavfile_parse_header(wavfile_read_proc_t pf_read, VOID *p_context, ULONG64 file_size, wavfile_info_t *p_info, __string *p_err_msg)
+{
+	BYTE p_buf[12u];
+	wavfile_ds64_t ds64;
+	ULONG64 chunk_pos = 0u;
+	ULONG64 chunk_size = 0u;
+	ULONG_PTR n_entry = 0u;
+	UINT32 u32 = 0u;
+	BOOL is_64 = FALSE;
+	BOOL has_ds64 = FALSE;
+	BOOL has_fmt = FALSE;
+	__string err_msg = TEXT("");
+
+	if((pf_read == NULL) || (p_info == NULL))
+	{
+		err_msg = TEXT("wavfile_parse_header: Error: invalid arguments.");
+		goto _l_wavfile_parse_header_error;
+	}
+
+	ZeroMemory(p_info, sizeof(wavfile_info_t));
+	ZeroMemory(&ds64, sizeof(wavfile_ds64_t));
+
+	if(pf_read(p_context, 0u, p_buf, 12u) < 12u)
+	{
+		err_msg = TEXT("wavfile_parse_header: Error: file format not supported.");
+		goto _l_wavfile_parse_header_error;
+	}
+
+	if(wavfile_compare_signature("RF64", p_buf) || wavfile_compare_signature("BW64", p_buf)) is_64 = TRUE;
+	else if(!wavfile_compare_signature("RIFF", p_buf))
+	{
+		err_msg = TEXT("wavfile_parse_header: Error: file format not supported.");
+		goto _l_wavfile_parse_header_error;
+	}
+
+	if(!wavfile_compare_signature("WAVE", &p_buf[8u]))
+	{
+		err_msg = TEXT("wavfile_parse_header: Error: file format not supported.");
+		goto _l_wavfile_parse_header_error;
+	}
+
+	chunk_pos = 12u;
+
+	while(TRUE)
+	{
+		if(pf_read(p_context, chunk_pos, p_buf, 8u) < 8u)
+		{
+			if(has_fmt) err_msg = TEXT("wavfile_parse_header: Error: broken header (missing subchunk \"data\").\r\nFile probably corrupted.");
+			else err_msg = TEXT("wavfile_parse_header: Error: broken header (missing subchunk \"fmt \").\r\nFile probably corrupted.");
+			goto _l_wavfile_parse_header_error;
+		}
+
+		u32 = wavfile_get_u32(&p_buf[4u]);
+		chunk_size = (ULONG64) u32;
+
+		if(wavfile_compare_signature("data", p_buf)) break;
+
+		/*RF64/BW64: chunks other than "data" that do not fit in 32 bits have their size in the ds64 table.*/
+		if(has_ds64 && (u32 == WAVFILE_SIZE_32_UNKNOWN))
+		{
+			for(n_entry = 0u; n_entry < ds64.n_entries; n_entry++)
+			{
+				if(!wavfile_compare_signature((const CHAR*) ds64.p_entry_id[n_entry], p_buf)) continue;
+
+				chunk_size = ds64.p_entry_size[n_entry];
+				break;
+			}
+		}
+
+		if(chunk_size > file_size)
+		{
+			err_msg = TEXT("wavfile_parse_header: Error: broken header (invalid subchunk size).\r\nFile probably corrupted.");
+			goto _l_wavfile_parse_header_error;
+		}
+
+		if(wavfile_compare_signature("ds64", p_buf) && is_64)
+		{
+			if(!wavfile_parse_ds64(pf_read, p_context, chunk_pos + 8u, chunk_size, &ds64, &err_msg)) goto _l_wavfile_parse_header_error;
+			has_ds64 = TRUE;
+		}
+		else if(wavfile_compare_signature("fmt ", p_buf))
+		{
+			if(!wavfile_parse_fmt(pf_read, p_context, chunk_pos + 8u, chunk_size, p_info, &err_msg)) goto _l_wavfile_parse_header_error;
+			has_fmt = TRUE;
+		}
+
+		/*Chunks are word aligned: odd sized chunks are followed by a pad byte.*/
+		chunk_pos += chunk_size + (chunk_size & 1u) + 8u;
+	}
+
+	if(!has_fmt)
+	{
+		err_msg = TEXT("wavfile_parse_header: Error: broken header (missing subchunk \"fmt \").\r\nFile probably corrupted.");
+		goto _l_wavfile_parse_header_error;
+	}
+
+	p_info->audio_data_begin = chunk_pos + 8u;
+
+	if(u32 == WAVFILE_SIZE_32_UNKNOWN)
+	{
+		/*No ds64: the data size is unknown (file still being written, or written by a program that could not seek back). Data runs to the end of the file.*/
+		if(has_ds64) p_info->audio_data_end = p_info->audio_data_begin + ds64.data_size;
+		else p_info->audio_data_end = file_size;
+	}
+	else p_info->audio_data_end = p_info->audio_data_begin + chunk_size;
+
+	if(p_info->audio_data_end > file_size) p_info->audio_data_end = file_size;
+	if(p_info->audio_data_begin > p_info->audio_data_end) p_info->audio_data_begin = p_info->audio_data_end;
+
+	return TRUE;
+
+_l_wavfile_parse_header_error:
+	if(p_err_msg != NULL) *p_err_msg = err_msg;
+	return FALSE;
+}
+
+ULONG_PTR WINAPI wavfile_read_handle(VOID *p_context, ULONG64 offset, VOID *p_dst, ULONG_PTR size)
+{
+	OVERLAPPED overlapped;
+	DWORD n_read = 0u;
+
+	if(((HANDLE) p_context) == INVALID_HANDLE_VALUE) return 0u;
+	if(p_dst == NULL) return 0u;
+
+	ZeroMemory(&overlapped, sizeof(OVERLAPPED));
+	overlapped.Offset = (DWORD) (offset & 0xffffffffu);
+	overlapped.OffsetHigh = (DWORD) (offset >> 32);
+
+	/*Reading at or past the end of the file fails with ERROR_HANDLE_EOF.*/
+	if(!ReadFile((HANDLE) p_context, p_dst, (DWORD) size, &n_read, &overlapped)) return 0u;
+
+	return (ULONG_PTR) n_read;
+}
+
+ULONG_PTR WINAPI wavfile_get_header_size(const wavfile_info_t *p_info)
+{
+	ULONG64 data_size = 0u;
+	ULONG_PTR header_size = 0u;
+
+	if(p_info == NULL) return 0u;
+	if(p_info->audio_data_end < p_info->audio_data_begin) return 0u;
+
+	data_size = p_info->audio_data_end - p_info->audio_data_begin;
+
+	if(wavfile_write_extensible(p_info)) header_size = WAVFILE_HEADER_SIZE_RIFF_EXTENSIBLE;
+	else header_size = WAVFILE_HEADER_SIZE_RIFF;
+
+	/*RIFF chunk sizes are 32 bit (the RIFF size counts the data pad byte).*/
+	if((data_size + (data_size & 1u)) > ((ULONG64) (0xffffffffu - (header_size - 8u)))) return header_size + (WAVFILE_HEADER_SIZE_RF64 - WAVFILE_HEADER_SIZE_RIFF);
+
+	return header_size;
+}
+
+BOOL WINAPI wavfile_write_header(HANDLE h_file, const wavfile_info_t *p_info)
+{
+	BYTE p_header[WAVFILE_HEADER_SIZE_RF64_EXTENSIBLE];
+	LARGE_INTEGER file_pos;
+	ULONG64 data_size = 0u;
+	ULONG64 riff_size = 0u;
+	ULONG_PTR header_size = 0u;
+	ULONG_PTR bytes_per_frame = 0u;
+	ULONG_PTR valid_bits = 0u;
+	ULONG_PTR fmt_pos = 0u;
+	ULONG_PTR data_pos = 0u;
+	BOOL is_64 = FALSE;
+	DWORD n_written = 0u;
+
+	if(h_file == INVALID_HANDLE_VALUE) return FALSE;
+	if(p_info == NULL) return FALSE;
+
+	if(p_info->audio_data_end < p_info->audio_data_begin) return FALSE;
+
+	data_size = p_info->audio_data_end - p_info->audio_data_begin;
+	header_size = wavfile_get_header_size(p_info);
+	is_64 = (header_size == WAVFILE_HEADER_SIZE_RF64) || (header_size == WAVFILE_HEADER_SIZE_RF64_EXTENSIBLE);
+
+	bytes_per_frame = (p_info->n_channels)*(p_info->bits_per_sample/8u);
+	if(!bytes_per_frame) return FALSE;
+
+	if((p_info->format_tag != WAVFILE_FORMAT_PCM) && (p_info->format_tag != WAVFILE_FORMAT_IEEE_FLOAT)) return FALSE;
+
+	valid_bits = p_info->valid_bits_per_sample;
+	if((!valid_bits) || (valid_bits > p_info->bits_per_sample)) valid_bits = p_info->bits_per_sample;
+
+	/*Everything after the RIFF chunk header, data pad byte included.*/
+	riff_size = data_size + (data_size & 1u) + ((ULONG64) (header_size - 8u));
+
+	if(is_64)
+	{
+		CopyMemory(&p_header[0u], "RF64", 4u);
+		wavfile_put_u32(&p_header[4u], WAVFILE_SIZE_32_UNKNOWN);
+		CopyMemory(&p_header[8u], "WAVE", 4u);
+
+		CopyMemory(&p_header[12u], "ds64", 4u);
+		wavfile_put_u32(&p_header[16u], WAVFILE_DS64_SIZE_MIN);
+		wavfile_put_u64(&p_header[20u], riff_size);
+		wavfile_put_u64(&p_header[28u], data_size);
+		wavfile_put_u64(&p_header[36u], data_size/((ULONG64) bytes_per_frame));
+		wavfile_put_u32(&p_header[44u], 0u);
+
+		fmt_pos = 48u;
+	}
+	else
+	{
+		CopyMemory(&p_header[0u], "RIFF", 4u);
+		wavfile_put_u32(&p_header[4u], (UINT32) riff_size);
+		CopyMemory(&p_header[8u], "WAVE", 4u);
+
+		fmt_pos = 12u;
+	}
+
+	CopyMemory(&p_header[fmt_pos], "fmt ", 4u);
+	wavfile_put_u16(&p_header[fmt_pos + 10u], (UINT16) p_info->n_channels);
+	wavfile_put_u32(&p_header[fmt_pos + 12u], (UINT32) p_info->sample_rate);
+	wavfile_put_u32(&p_header[fmt_pos + 16u], (UINT32) ((p_info->sample_rate)*bytes_per_frame));
+	wavfile_put_u16(&p_header[fmt_pos + 20u], (UINT16) bytes_per_frame);
+	wavfile_put_u16(&p_header[fmt_pos + 22u], (UINT16) p_info->bits_per_sample);
+
+	if(wavfile_write_extensible(p_info))
+	{
+		wavfile_put_u32(&p_header[fmt_pos + 4u], WAVFILE_FMT_SIZE_EXTENSIBLE);
+		wavfile_put_u16(&p_header[fmt_pos + 8u], (UINT16) WAVFILE_FORMAT_EXTENSIBLE);
+
+		/*cbSize, wValidBitsPerSample, dwChannelMask, SubFormat GUID (format tag + KSDATAFORMAT_SUBTYPE_... tail).*/
+		wavfile_put_u16(&p_header[fmt_pos + 24u], (UINT16) (WAVFILE_FMT_SIZE_EXTENSIBLE - 18u));
+		wavfile_put_u16(&p_header[fmt_pos + 26u], (UINT16) valid_bits);
+		wavfile_put_u32(&p_header[fmt_pos + 28u], (UINT32) p_info->channel_mask);
+		wavfile_put_u32(&p_header[fmt_pos + 32u], (UINT32) p_info->format_tag);
+		CopyMemory(&p_header[fmt_pos + 36u], WAVFILE_SUBTYPE_GUID_TAIL, 12u);
+
+		data_pos = fmt_pos + 8u + WAVFILE_FMT_SIZE_EXTENSIBLE;
+	}
+	else
+	{
+		wavfile_put_u32(&p_header[fmt_pos + 4u], WAVFILE_FMT_SIZE_MIN);
+		wavfile_put_u16(&p_header[fmt_pos + 8u], (UINT16) p_info->format_tag);
+
+		data_pos = fmt_pos + 8u + WAVFILE_FMT_SIZE_MIN;
+	}
+
+	CopyMemory(&p_header[data_pos], "data", 4u);
+	if(is_64) wavfile_put_u32(&p_header[data_pos + 4u], WAVFILE_SIZE_32_UNKNOWN);
+	else wavfile_put_u32(&p_header[data_pos + 4u], (UINT32) data_size);
+
+	file_pos.QuadPart = 0;
+	if(!SetFilePointerEx(h_file, file_pos, NULL, FILE_BEGIN)) return FALSE;
+
+	if(!WriteFile(h_file, p_header, (DWORD) header_size, &n_written, NULL)) return FALSE;
+	if(n_written != (DWORD) header_size) return FALSE;
+
+	if(!(data_size & 1u)) return TRUE;
+
+	/*Chunks are word aligned: pad byte after an odd sized data chunk.*/
+	file_pos.QuadPart = (LONGLONG) (((ULONG64) header_size) + data_size);
+	if(!SetFilePointerEx(h_file, file_pos, NULL, FILE_BEGIN)) return FALSE;
+
+	p_header[0u] = 0u;
+	if(!WriteFile(h_file, p_header, 1u, &n_written, NULL)) return FALSE;
+
+	return (n_written == 1u);
+}
+
+static BOOL WINAPI wavfile_parse_ds64(wavfile_read_proc_t pf_read, VOID *p_context, ULONG64 pos, ULONG64 chunk_size, wavfile_ds64_t *p_ds64, __string *p_err_msg)
+{
+	BYTE p_buf[WAVFILE_DS64_SIZE_MIN];
+	ULONG_PTR n_entries = 0u;
+	ULONG_PTR n_entry = 0u;
+
+	if(chunk_size < ((ULONG64) WAVFILE_DS64_SIZE_MIN))
+	{
+		*p_err_msg = TEXT("wavfile_parse_header: Error: broken header (error on subchunk \"ds64\").\r\nFile might be corrupted.");
+		return FALSE;
+	}
+
+	if(pf_read(p_context, pos, p_buf, WAVFILE_DS64_SIZE_MIN) < WAVFILE_DS64_SIZE_MIN)
+	{
+		*p_err_msg = TEXT("wavfile_parse_header: Error: broken header (error on subchunk \"ds64\").\r\nFile might be corrupted.");
+		return FALSE;
+	}
+
+	/*riffSize (0), dataSize (8), sampleCount (16), tableLength (24), table.*/
+	p_ds64->data_size = wavfile_get_u64(&p_buf[8u]);
+	n_entries = (ULONG_PTR) wavfile_get_u32(&p_buf[24u]);
+
+	/*Table entries that do not fit in the chunk are ignored. So are the ones past WAVFILE_DS64_TABLE_N_ENTRIES_MAX.*/
+	if(((ULONG64) n_entries) > ((chunk_size - WAVFILE_DS64_SIZE_MIN)/WAVFILE_DS64_TABLE_ENTRY_SIZE)) n_entries = (ULONG_PTR) ((chunk_size - WAVFILE_DS64_SIZE_MIN)/WAVFILE_DS64_TABLE_ENTRY_SIZE);
+	if(n_entries > WAVFILE_DS64_TABLE_N_ENTRIES_MAX) n_entries = WAVFILE_DS64_TABLE_N_ENTRIES_MAX;
+
+	pos += WAVFILE_DS64_SIZE_MIN;
+
+	for(n_entry = 0u; n_entry < n_entries; n_entry++)
+	{
+		if(pf_read(p_context, pos, p_buf, WAVFILE_DS64_TABLE_ENTRY_SIZE) < WAVFILE_DS64_TABLE_ENTRY_SIZE) break;
+
+		CopyMemory(p_ds64->p_entry_id[n_entry], p_buf, 4u);
+		p_ds64->p_entry_size[n_entry] = wavfile_get_u64(&p_buf[4u]);
+
+		pos += WAVFILE_DS64_TABLE_ENTRY_SIZE;
+	}
+
+	p_ds64->n_entries = n_entry;
+	return TRUE;
+}
+
+static BOOL WINAPI wavfile_parse_fmt(wavfile_read_proc_t pf_read, VOID *p_context, ULONG64 pos, ULONG64 chunk_size, wavfile_info_t *p_info, __string *p_err_msg)
+{
+	BYTE p_fmt[WAVFILE_FMT_SIZE_EXTENSIBLE];
+	ULONG_PTR size = 0u;
+	ULONG_PTR nbyte = 0u;
+	UINT32 format_tag = 0u;
+
+	if(chunk_size < ((ULONG64) WAVFILE_FMT_SIZE_MIN))
+	{
+		*p_err_msg = TEXT("wavfile_parse_header: Error: broken header (error on subchunk \"fmt \").\r\nFile might be corrupted.");
+		return FALSE;
+	}
+
+	if(chunk_size < ((ULONG64) WAVFILE_FMT_SIZE_EXTENSIBLE)) size = (ULONG_PTR) chunk_size;
+	else size = WAVFILE_FMT_SIZE_EXTENSIBLE;
+
+	if(pf_read(p_context, pos, p_fmt, size) < size)
+	{
+		*p_err_msg = TEXT("wavfile_parse_header: Error: broken header (error on subchunk \"fmt \").\r\nFile might be corrupted.");
+		return FALSE;
+	}
+
+	format_tag = (UINT32) wavfile_get_u16(&p_fmt[0u]);
+
+	p_info->n_channels = (ULONG_PTR) wavfile_get_u16(&p_fmt[2u]);
+	p_info->sample_rate = (ULONG_PTR) wavfile_get_u32(&p_fmt[4u]);
+	p_info->bits_per_sample = (ULONG_PTR) wavfile_get_u16(&p_fmt[14u]);
+	p_info->valid_bits_per_sample = p_info->bits_per_sample;
+	p_info->channel_mask = 0u;
+
+	if(format_tag == WAVFILE_FORMAT_EXTENSIBLE)
+	{
+		/*cbSize (16), wValidBitsPerSample (18), dwChannelMask (20), SubFormat GUID (24).*/
+		if((size < WAVFILE_FMT_SIZE_EXTENSIBLE) || (wavfile_get_u16(&p_fmt[16u]) < (WAVFILE_FMT_SIZE_EXTENSIBLE - 18u)))
+		{
+			*p_err_msg = TEXT("wavfile_parse_header: Error: broken header (error on subchunk \"fmt \").\r\nFile might be corrupted.");
+			return FALSE;
+		}
+
+		for(nbyte = 0u; nbyte < 12u; nbyte++)
+		{
+			if(p_fmt[28u + nbyte] == WAVFILE_SUBTYPE_GUID_TAIL[nbyte]) continue;
+
+			*p_err_msg = TEXT("wavfile_parse_header: Error: audio encoding format not supported.");
+			return FALSE;
+		}
+
+		format_tag = wavfile_get_u32(&p_fmt[24u]);
+
+		p_info->valid_bits_per_sample = (ULONG_PTR) wavfile_get_u16(&p_fmt[18u]);
+		p_info->channel_mask = (ULONG_PTR) wavfile_get_u32(&p_fmt[20u]);
+		p_info->format_extensible = TRUE;
+
+		/*Valid bits are left justified in the container: samples decode as container sized samples.*/
+		if((!p_info->valid_bits_per_sample) || (p_info->valid_bits_per_sample > p_info->bits_per_sample)) p_info->valid_bits_per_sample = p_info->bits_per_sample;
+	}
+
+	if((format_tag != WAVFILE_FORMAT_PCM) && (format_tag != WAVFILE_FORMAT_IEEE_FLOAT))
+	{
+		*p_err_msg = TEXT("wavfile_parse_header: Error: audio encoding format not supported.");
+		return FALSE;
+	}
+
+	p_info->format_tag = (ULONG_PTR) format_tag;
+	return TRUE;
+}
+
+static BOOL WINAPI wavfile_write_extensible(const wavfile_info_t *p_info)
+{
+	if(p_info->format_extensible) return TRUE;
+	if(p_info->n_channels > 2u) return TRUE;
+	if(p_info->bits_per_sample > 16u) return TRUE;
+	if(p_info->channel_mask) return TRUE;
+
+	/*valid_bits_per_sample 0 means same as the container.*/
+	if(p_info->valid_bits_per_sample && (p_info->valid_bits_per_sample != p_info->bits_per_sample)) return TRUE;
+
+	return FALSE;
+}
+
+static BOOL WINAPI wavfile_compare_signature(const CHAR *auth, const BYTE *buf)
+{
+	ULONG_PTR nbyte;
+
+	if(auth == NULL) return FALSE;
+	if(buf == NULL) return FALSE;
+
+	for(nbyte = 0u; nbyte < 4u; nbyte++) if(auth[nbyte] != ((CHAR) buf[nbyte])) return FALSE;
+
+	return TRUE;
+}
+
+static UINT16 WINAPI wavfile_get_u16(const BYTE *p_src)
+{
+	return (UINT16) (((UINT16) p_src[0u]) | (((UINT16) p_src[1u]) << 8));
+}
+
+static UINT32 WINAPI wavfile_get_u32(const BYTE *p_src)
+{
+	return (((UINT32) p_src[0u]) | (((UINT32) p_src[1u]) << 8) | (((UINT32) p_src[2u]) << 16) | (((UINT32) p_src[3u]) << 24));
+}
+
+static ULONG64 WINAPI wavfile_get_u64(const BYTE *p_src)
+{
+	return (((ULONG64) wavfile_get_u32(p_src)) | (((ULONG64) wavfile_get_u32(&p_src[4u])) << 32));
+}
+
+static VOID WINAPI wavfile_put_u16(BYTE *p_dst, UINT16 value)
+{
+	p_dst[0u] = (BYTE) (value & 0xffu);
+	p_dst[1u] = (BYTE) ((value >> 8) & 0xffu);
+	return;
+}
+
+static VOID WINAPI wavfile_put_u32(BYTE *p_dst, UINT32 value)
+{
+	p_dst[0u] = (BYTE) (value & 0xffu);
+	p_dst[1u] = (BYTE) ((value >> 8) & 0xffu);
+	p_dst[2u] = (BYTE) ((value >> 16) & 0xffu);
+	p_dst[3u] = (BYTE) ((value >> 24) & 0xffu);
+	return;
+}
+
+static VOID WINAPI wavfile_put_u64(BYTE *p_dst, ULONG64 value)
+{
+	wavfile_put_u32(p_dst, (UINT32) (value & 0xffffffffu));
+	wavfile_put_u32(&p_dst[4u], (UINT32) (value >> 32));
+	return;
+}
@@ -0,0 +1,104 @@
+/*
+	Audio Delay 2 application for Windows
+	Version 3.0
+
+	Author: Rafael Sabe
+	Email: rafaelmsabe@gmail.com
+*/
+
+/*
+	WAVE (.wav) file header parsing and writing.
+
+	Files larger than 4 GiB are supported in the RF64/BW64 layout (EBU Tech 3306/ITU-R BS.2088): the RIFF and data chunk sizes
+	are set to 0xffffffff and the actual 64 bit sizes are stored in a "ds64" chunk, placed right after the "WAVE" signature.
+
+	The writer uses a WAVE_FORMAT_EXTENSIBLE "fmt " chunk (speaker layout, container/valid bits split) whenever a plain one
+	would not be valid (more than 2 channels, more than 16 bits, valid bits smaller than the container, a channel mask),
+	or when the parsed input was WAVE_FORMAT_EXTENSIBLE.
+*/
+
+#ifndef WAVFILE_HPP
+#define WAVFILE_HPP
+
+#include "globldef.h"
+#include "strdef.hpp"
+
+/*Header sizes written by wavfile_write_header() (see wavfile_get_header_size()).*/
+#define WAVFILE_HEADER_SIZE_RIFF 44u
+#define WAVFILE_HEADER_SIZE_RF64 80u
+#define WAVFILE_HEADER_SIZE_RIFF_EXTENSIBLE 68u
+#define WAVFILE_HEADER_SIZE_RF64_EXTENSIBLE 104u
+
+#define WAVFILE_FORMAT_PCM 1u
+#define WAVFILE_FORMAT_IEEE_FLOAT 3u
+#define WAVFILE_FORMAT_EXTENSIBLE 0xfffeu
+
+struct _wavfile_info {
+	ULONG64 audio_data_begin; /*file offset of the first audio data byte*/
+	ULONG64 audio_data_end; /*file offset past the last audio data byte*/
+	ULONG_PTR sample_rate;
+	ULONG_PTR n_channels;
+	ULONG_PTR bits_per_sample; /*container size*/
+	ULONG_PTR valid_bits_per_sample; /*WAVE_FORMAT_EXTENSIBLE wValidBitsPerSample. Same as bits_per_sample otherwise.*/
+	ULONG_PTR channel_mask; /*WAVE_FORMAT_EXTENSIBLE dwChannelMask. 0 otherwise.*/
+	ULONG_PTR format_tag; /*WAVFILE_FORMAT_... For WAVE_FORMAT_EXTENSIBLE files, the format from the SubFormat GUID.*/
+	BOOL format_extensible; /*"fmt " chunk is WAVE_FORMAT_EXTENSIBLE*/
+};
+
+typedef struct _wavfile_info wavfile_info_t;
+
+/*
+	wavfile_read_proc_t
+	reads up to size bytes at file offset into p_dst.
+
+	returns the number of bytes read (less than size only at the end of the file), 0 if error.
+*/
+
+typedef ULONG_PTR (WINAPI *wavfile_read_proc_t)(VOID *p_context, ULONG64 offset, VOID *p_dst, ULONG_PTR size);
+
+/*
+	wavfile_parse_header()
+	walks the RIFF/RF64/BW64 chunk list through pf_read and fills in *p_info.
+	Only the chunk headers, "ds64" and "fmt " are read: every other chunk is skipped, whatever its size.
+	Only PCM and IEEE float encoded files are accepted (directly, or as WAVE_FORMAT_EXTENSIBLE with a PCM/IEEE float SubFormat).
+
+	file_size is the input file size. The audio data end is clamped to it, so truncated files and files still being written
+	(data chunk size 0xffffffff with no "ds64") return whatever audio data is actually there.
+
+	returns TRUE if successful, FALSE if the header is invalid or not supported (*p_err_msg receives the reason, if not NULL).
+*/
+
+extern BOOL WINAPI wavfile_parse_header(wavfile_read_proc_t pf_read, VOID *p_context, ULONG64 file_size, wavfile_info_t *p_info, __string *p_err_msg);
+
+/*
+	wavfile_read_handle()
+	wavfile_read_proc_t for a file HANDLE opened for reading (p_context is the HANDLE).
+	The file pointer is left at an undefined position.
+*/
+
+extern ULONG_PTR WINAPI wavfile_read_handle(VOID *p_context, ULONG64 offset, VOID *p_dst, ULONG_PTR size);
+
+/*
+	wavfile_get_header_size()
+	returns the size of the header wavfile_write_header() writes for *p_info:
+	WAVFILE_HEADER_SIZE_RIFF, or WAVFILE_HEADER_SIZE_RF64 if the data does not fit in a 32 bit RIFF file
+	(WAVFILE_HEADER_SIZE_..._EXTENSIBLE with a WAVE_FORMAT_EXTENSIBLE "fmt " chunk).
+*/
+
+extern ULONG_PTR WINAPI wavfile_get_header_size(const wavfile_info_t *p_info);
+
+/*
+	wavfile_write_header()
+	writes a wavfile_get_header_size() bytes header at the beginning of the file.
+	format_tag is WAVFILE_FORMAT_PCM or WAVFILE_FORMAT_IEEE_FLOAT. valid_bits_per_sample (0: same as bits_per_sample), channel_mask
+	and format_extensible are only used by the WAVE_FORMAT_EXTENSIBLE "fmt " chunk.
+	The data chunk size is taken from (audio_data_end - audio_data_begin). audio_data_begin is ignored otherwise.
+	An odd sized data chunk gets its pad byte, written right after the data (the audio data may be written before or after the header).
+	The file pointer is left at an undefined position.
+
+	returns TRUE if successful, FALSE if error.
+*/
+
+extern BOOL WINAPI wavfile_write_header(HANDLE h_file, const wavfile_info_t *p_info);
+
+#endif /*WAVFILE_HPP*/